@@ -4,7 +4,9 @@
 // SPDX-License-Identifier: MIT
 //------------------------------------------------------------------------------
 #include "pyslang.h"
+#include <pybind11/chrono.h>
 
+#include "slang/analysis/AnalysisCache.h"
 #include "slang/analysis/AnalysisManager.h"
 #include "slang/analysis/AnalysisOptions.h"
 #include "slang/text/SourceManager.h"
@@ -19,14 +21,53 @@ void registerAnalysis(py::module_& m) {
         .value("FullCaseFourState", AnalysisFlags::FullCaseFourState)
         .value("AllowMultiDrivenLocals", AnalysisFlags::AllowMultiDrivenLocals)
         .value("AllowDupInitialDrivers", AnalysisFlags::AllowDupInitialDrivers)
+        .value("Profile", AnalysisFlags::Profile)
         .finalize();
 
+    EXPOSE_ENUM(m, CaseAnalysisEngine);
+    EXPOSE_ENUM(m, LoopAnalysisMode);
+
     py::classh<AnalysisOptions>(m, "AnalysisOptions")
         .def(py::init<>())
         .def_readwrite("flags", &AnalysisOptions::flags)
         .def_readwrite("numThreads", &AnalysisOptions::numThreads)
         .def_readwrite("maxCaseAnalysisSteps", &AnalysisOptions::maxCaseAnalysisSteps)
-        .def_readwrite("maxLoopAnalysisSteps", &AnalysisOptions::maxLoopAnalysisSteps);
+        .def_readwrite("caseAnalysisEngine", &AnalysisOptions::caseAnalysisEngine)
+        .def_readwrite("maxLoopAnalysisSteps", &AnalysisOptions::maxLoopAnalysisSteps)
+        .def_readwrite("loopAnalysisMode", &AnalysisOptions::loopAnalysisMode)
+        .def_readwrite("scopeSplitCost", &AnalysisOptions::scopeSplitCost);
+
+    py::classh<AnalysisWorkerStats>(m, "AnalysisWorkerStats")
+        .def_readonly("tasks", &AnalysisWorkerStats::tasks)
+        .def_readonly("estimatedCost", &AnalysisWorkerStats::estimatedCost)
+        .def_readonly("busyTime", &AnalysisWorkerStats::busyTime);
+
+    py::classh<AnalysisCacheStats>(m, "AnalysisCacheStats")
+        .def_readonly("reusedProcedures", &AnalysisCacheStats::reusedProcedures)
+        .def_readonly("analyzedProcedures", &AnalysisCacheStats::analyzedProcedures)
+        .def_readonly("uncacheableProcedures", &AnalysisCacheStats::uncacheableProcedures)
+        .def_readonly("evictedScopes", &AnalysisCacheStats::evictedScopes);
+
+    py::classh<AnalysisProfileEntry>(m, "AnalysisProfileEntry")
+        .def_property_readonly("symbol", [](const AnalysisProfileEntry& e) { return e.symbol; })
+        .def_property_readonly("statement",
+                               [](const AnalysisProfileEntry& e) { return e.statement; })
+        .def_readonly("count", &AnalysisProfileEntry::count)
+        .def_readonly("steps", &AnalysisProfileEntry::steps)
+        .def_readonly("engine", &AnalysisProfileEntry::engine)
+        .def_readonly("time", &AnalysisProfileEntry::time);
+
+    py::classh<AnalysisProfile>(m, "AnalysisProfile")
+        .def_readonly("scopes", &AnalysisProfile::scopes)
+        .def_readonly("procedures", &AnalysisProfile::procedures)
+        .def_readonly("caseStatements", &AnalysisProfile::caseStatements)
+        .def_readonly("loops", &AnalysisProfile::loops);
+
+    py::classh<AnalysisCache>(m, "AnalysisCache")
+        .def(py::init<>())
+        .def("clear", &AnalysisCache::clear)
+        .def_property_readonly("size", &AnalysisCache::size)
+        .def_property_readonly("stats", &AnalysisCache::getStats);
 
     py::classh<AnalyzedScope>(m, "AnalyzedScope")
         .def_property_readonly("scope", [](const AnalyzedScope& s) { return &s.scope; })
@@ -60,13 +101,16 @@ void registerAnalysis(py::module_& m) {
 
     py::classh<AnalysisManager>(m, "AnalysisManager")
         .def(py::init<AnalysisOptions>(), "options"_a = AnalysisOptions())
-        .def("analyze", &AnalysisManager::analyze, "compilation"_a)
+        .def("analyze", &AnalysisManager::analyze, "compilation"_a, "cache"_a = nullptr)
         .def("getDrivers", &AnalysisManager::getDrivers, "symbol"_a, byrefint)
         .def("getDiagnostics", &AnalysisManager::getDiagnostics, "sourceManager"_a)
         .def("analyzeScopeBlocking", &AnalysisManager::analyzeScopeBlocking, "scope"_a,
              "parentProcedure"_a = nullptr, byrefint)
         .def("getAnalyzedScope", &AnalysisManager::getAnalyzedScope, "scope"_a, byrefint)
         .def("getAnalyzedSubroutine", &AnalysisManager::getAnalyzedSubroutine, "symbol"_a, byrefint)
+        .def("getWorkerStats", &AnalysisManager::getWorkerStats)
+        .def("getCacheStats", &AnalysisManager::getCacheStats)
+        .def("getProfile", &AnalysisManager::getProfile)
         .def_property_readonly("options", &AnalysisManager::getOptions);
 
     py::classh<AnalyzedProcedure>(m, "AnalyzedProcedure")
@@ -57,6 +57,8 @@ void registerCompilation(py::module_& m) {
         .value("DisableInstanceCaching", CompilationFlags::DisableInstanceCaching)
         .value("DisallowRefsToUnknownInstances", CompilationFlags::DisallowRefsToUnknownInstances)
         .value("AllowUnnamedGenerate", CompilationFlags::AllowUnnamedGenerate)
+        .value("DisableConstEvalBytecode", CompilationFlags::DisableConstEvalBytecode)
+        .value("ProfileConstEval", CompilationFlags::ProfileConstEval)
         .finalize();
 
     py::classh<CompilationOptions>(m, "CompilationOptions")
@@ -325,12 +325,20 @@ void registerNumeric(py::module_& m) {
                         return py::cast(arg);
                     else if constexpr (std::is_same_v<T, std::string>)
                         return py::cast(arg);
-                    else if constexpr (std::is_same_v<T, ConstantValue::Map>)
-                        return py::cast(*arg);
+                    else if constexpr (std::is_same_v<T, ConstantValue::Map>) {
+                        py::dict result;
+                        for (auto& [key, val] : *arg)
+                            result[py::cast(key)] = py::cast(val);
+                        return result;
+                    }
                     else if constexpr (std::is_same_v<T, ConstantValue::Queue>)
                         return py::cast(*arg);
                     else if constexpr (std::is_same_v<T, ConstantValue::Union>)
                         return py::cast(*arg);
+                    else if constexpr (std::is_same_v<T, ConstantValue::DenseArray>)
+                        return py::cast(arg->toElements());
+                    else if constexpr (std::is_same_v<T, ConstantValue::RunArray>)
+                        return py::cast(arg->toElements());
                     else
                         static_assert(always_false<T>::value, "Missing case");
                 },
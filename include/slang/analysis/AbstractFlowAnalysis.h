@@ -7,6 +7,8 @@
 //------------------------------------------------------------------------------
 #pragma once
 
+#include <chrono>
+
 #include "slang/analysis/AnalysisOptions.h"
 #include "slang/ast/ASTVisitor.h"
 #include "slang/ast/EvalContext.h"
@@ -18,6 +20,8 @@ namespace slang::analysis {
 
 using namespace ast;
 
+struct AnalysisProfile;
+
 /// A base class for flow analysis passes that contains
 /// non-specialized helper functions.
 class SLANG_EXPORT FlowAnalysisBase {
@@ -31,6 +35,10 @@ public:
     /// Set to true if the analysis detected an error.
     bool bad = false;
 
+    /// If set, the costs of analyzing wildcard case statements
+    /// and for loops are recorded here.
+    AnalysisProfile* profile = nullptr;
+
     /// Gets an evaluation context for use during analysis.
     EvalContext& getEvalContext() const { return evalContext; }
 
@@ -46,12 +54,47 @@ protected:
                                      SmallVector<ConstantValue>& values,
                                      SmallVector<ConstantValue*>& localPtrs);
 
+    /// The range of values taken on by the induction variable of a for loop.
+    struct LoopBounds {
+        /// The number of times the loop body executes.
+        uint64_t iterations = 0;
+
+        /// The amount by which the loop variable changes each iteration.
+        int64_t stride = 0;
+
+        /// The values of the loop variable in the first and last iterations.
+        ConstantValue first;
+        ConstantValue last;
+    };
+
+    std::optional<LoopBounds> tryGetLoopBounds(const ForLoopStatement& stmt);
+    bool fitsLoopStepLimit(uint64_t iterations) const;
+
+    void noteLoopCost(const ForLoopStatement& stmt, uint64_t steps,
+                      std::chrono::steady_clock::time_point start) const;
+
+    /// A loop variable that is being tracked as its full range of values
+    /// instead of a single value per iteration.
+    struct WidenedLoopVar {
+        const ValueSymbol* symbol;
+        ConstantValue first;
+        ConstantValue last;
+    };
+
+    const WidenedLoopVar* findWidenedLoopVar(const Expression& selector) const;
+
     bool isFullyCovered(const CaseStatement& stmt, const Statement* knownBranch,
                         bool isKnown) const;
 
     /// Tracking for how many steps we've taken while analyzing the body of a loop.
     uint32_t forLoopSteps = 0;
 
+    /// The total number of loop iterations stepped through so far, for profiling.
+    uint64_t totalLoopSteps = 0;
+
+    /// Loop variables of the widened loops currently being analyzed.
+    SmallVector<WidenedLoopVar> widenedLoopVars;
+
     /// An optional diagnostics collection. If provided, warnings encountered during
     /// analysis will be added to it.
     Diagnostics* diagnostics;
@@ -409,10 +452,16 @@ protected:
                 visit(*init);
         }
 
+        std::chrono::steady_clock::time_point startTime;
+        auto oldTotalLoopSteps = totalLoopSteps;
+        if (profile)
+            startTime = std::chrono::steady_clock::now();
+
         SmallVector<ConstantValue> iterValues;
         SmallVector<ConstantValue*> localPtrs;
         auto oldForLoopSteps = forLoopSteps;
         auto bodyWillExecute = WillExecute::Maybe;
+        bool widenedVar = false;
         TState bodyState, exitState;
         if (stmt.stopExpr) {
             auto cv = visitCondition(*stmt.stopExpr);
@@ -424,8 +473,32 @@ protected:
             // guaranteed, and if so whether we can know exactly how many times.
             // If we have a deterministic set of iteration values we can "unroll" the
             // loop and get finer grained tracking of data flow within it.
-            if (!cv)
-                bodyWillExecute = tryGetLoopIterValues(stmt, iterValues, localPtrs);
+            if (!cv) {
+                // Loops that would run past the step limit if unrolled (or all loops,
+                // if so configured) are widened: the body is visited a single time with
+                // the loop variable standing in for its whole range of values,
+                // so the cost doesn't depend on the trip count.
+                std::optional<LoopBounds> bounds;
+                auto mode = options.loopAnalysisMode;
+                if (mode != LoopAnalysisMode::Unroll)
+                    bounds = tryGetLoopBounds(stmt);
+
+                const bool canWiden = bounds && bounds->iterations &&
+                                      options.maxLoopAnalysisSteps &&
+                                      (bounds->stride == 1 || bounds->stride == -1);
+                if (bounds && (mode == LoopAnalysisMode::Widen ||
+                               (canWiden && !fitsLoopStepLimit(bounds->iterations)))) {
+                    bodyWillExecute = bounds->iterations ? WillExecute::Yes : WillExecute::No;
+                    if (canWiden) {
+                        widenedLoopVars.push_back(
+                            {stmt.loopVars[0], std::move(bounds->first), std::move(bounds->last)});
+                        widenedVar = true;
+                    }
+                }
+                else if (mode != LoopAnalysisMode::Widen) {
+                    bodyWillExecute = tryGetLoopIterValues(stmt, iterValues, localPtrs);
+                }
+            }
         }
         else {
             // If there's no stop expression, the loop is infinite.
@@ -464,12 +537,18 @@ protected:
                 evalContext.deleteLocal(var);
         }
 
+        if (widenedVar)
+            widenedLoopVars.pop_back();
+
         forLoopSteps = oldForLoopSteps;
 
         if (bodyWillExecute == WillExecute::Yes)
             (DERIVED).meetState(exitState, state);
 
         loopTail(std::move(exitState), std::move(oldBreakStates));
+
+        if (profile)
+            noteLoopCost(stmt, totalLoopSteps - oldTotalLoopSteps, startTime);
     }
 
     void visitStmt(const RepeatLoopStatement& stmt) {
@@ -0,0 +1,185 @@
+//------------------------------------------------------------------------------
+//! @file AnalysisCache.h
+//! @brief Retains analysis results across compilations
+//
+// SPDX-FileCopyrightText: Michael Popoloski
+// SPDX-License-Identifier: MIT
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "slang/analysis/ValueDriver.h"
+#include "slang/diagnostics/Diagnostics.h"
+#include "slang/util/FlatMap.h"
+
+namespace slang::ast {
+
+class Compilation;
+class Scope;
+class Symbol;
+
+} // namespace slang::ast
+
+namespace slang::syntax {
+
+class SyntaxTree;
+
+} // namespace slang::syntax
+
+namespace slang::analysis {
+
+class AnalysisContext;
+class AnalyzedProcedure;
+struct AnalysisOptions;
+
+/// Statistics about how much work an AnalysisCache saved during an analysis.
+struct SLANG_EXPORT AnalysisCacheStats {
+    /// The number of procedures whose results were reused from the cache.
+    uint64_t reusedProcedures = 0;
+
+    /// The number of procedures that had to be analyzed.
+    uint64_t analyzedProcedures = 0;
+
+    /// The number of analyzed procedures whose results could not be cached,
+    /// because they depend on state outside of their instance body.
+    uint64_t uncacheableProcedures = 0;
+
+    /// The number of cached instance bodies that were dropped at the
+    /// end of the analysis because nothing in the design used them anymore.
+    uint64_t evictedScopes = 0;
+};
+
+/// Retains the results of analyzing instance bodies across compilations,
+/// so that a design can be cheaply re-analyzed after some of its files change.
+///
+/// Results are keyed by the syntax of the instance's definition along with
+/// its parameter values. Procedures in a body whose syntax tree was reparsed
+/// won't find their old results and are analyzed again; everything else
+/// is mapped onto the new compilation's symbols instead of being recomputed.
+///
+/// Identical instance bodies within a single design share results as well.
+///
+/// Procedures that refer to symbols in other instances (via hierarchical
+/// references, interface ports, etc), that contain procedural checkers, or
+/// that call subroutines from timing controls or assertions are never cached.
+/// Bodies with interface ports are also keyed by the definitions and parameters
+/// of the connected interfaces.
+///
+/// @note The cache assumes that each compilation it sees uses the same
+/// source manager and compilation options. Changes to packages, compilation
+/// unit members, or analysis options clear the cache entirely.
+class SLANG_EXPORT AnalysisCache {
+public:
+    /// Constructs a new, empty analysis cache.
+    AnalysisCache();
+    ~AnalysisCache();
+
+    /// Removes all cached results.
+    void clear();
+
+    /// Gets the number of instance bodies that have cached results.
+    size_t size() const;
+
+    /// Gets statistics about the most recent analysis that used the cache.
+    const AnalysisCacheStats& getStats() const { return stats; }
+
+private:
+    friend class AnalysisManager;
+    friend struct AnalysisScopeVisitor;
+
+    struct CachedDriver {
+        uint32_t prefixExpression;
+        uint32_t containingSymbol;
+        uint32_t procCallExpression;
+        DriverKind kind;
+        bitmask<DriverFlags> flags;
+        bool isFromSideEffect;
+        DriverBitRange bounds;
+    };
+
+    struct CachedProcedure {
+        uint32_t symbol;
+        uint32_t inferredClock;
+        uint32_t numAssertions;
+        std::vector<std::pair<uint32_t, std::vector<CachedDriver>>> drivers;
+        std::vector<uint32_t> callExpressions;
+        std::vector<uint32_t> timingControls;
+        std::vector<Diagnostic> diagnostics;
+    };
+
+    struct CachedScope {
+        size_t shapeHash;
+        size_t numNodes;
+        uint64_t generation;
+        std::vector<std::shared_ptr<const CachedProcedure>> procedures;
+    };
+
+    // Tracks the reuse of cached results while a single scope is analyzed.
+    class ScopeSession {
+    public:
+        ScopeSession(AnalysisCache& cache, std::string key, const ast::Scope& scope);
+
+        // Sets the number of procedures up front, for when they
+        // will be analyzed out of order.
+        void prepare(size_t numProcedures);
+
+        // Analyzes the procedure at position @a index in the scope, reusing
+        // cached results if possible, and appends it to @a results.
+        void analyze(AnalysisContext& context, size_t index, const ast::Symbol& symbol,
+                     std::vector<AnalyzedProcedure>& results);
+
+        // Stores the scope's results back into the cache.
+        void finish();
+
+    private:
+        bool tryReuse(AnalysisContext& context, size_t index, const ast::Symbol& symbol,
+                      std::vector<AnalyzedProcedure>& results);
+        std::shared_ptr<const CachedProcedure> capture(const AnalysisContext& context,
+                                                       size_t firstDiag,
+                                                       const AnalyzedProcedure& procedure);
+        uint32_t getId(const void* node) const;
+
+        AnalysisCache& cache;
+        std::string key;
+        std::shared_ptr<const CachedScope> previous;
+        std::vector<std::shared_ptr<const CachedProcedure>> procedures;
+
+        // Every symbol and AST node in the scope, in a deterministic order,
+        // which lets cached results refer to nodes by position.
+        flat_hash_map<const void*, uint32_t> nodeIds;
+        std::vector<const void*> nodes;
+        size_t shapeHash = 0;
+
+        // Procedures that depend on symbols in other instances, or whose
+        // drivers aren't all captured in their results.
+        flat_hash_set<const ast::Symbol*> uncachedProcedures;
+    };
+
+    void beginAnalysis(const ast::Compilation& compilation, const AnalysisOptions& options,
+                       bool repeatsOnly);
+    void endAnalysis(const ast::Compilation& compilation);
+    std::unique_ptr<ScopeSession> beginScope(const ast::Scope& scope);
+
+    mutable std::mutex mutex;
+    flat_hash_map<std::string, std::shared_ptr<const CachedScope>> scopes;
+    std::vector<std::shared_ptr<syntax::SyntaxTree>> syntaxTrees;
+    size_t fingerprint = 0;
+    uint64_t generation = 0;
+
+    // If set, only scopes whose key has been seen before in the current
+    // analysis are tracked, since nothing else could share their results.
+    bool repeatsOnly = false;
+    flat_hash_set<std::string> seenKeys;
+
+    std::atomic<uint64_t> reusedProcedures = 0;
+    std::atomic<uint64_t> analyzedProcedures = 0;
+    std::atomic<uint64_t> uncacheableProcedures = 0;
+    AnalysisCacheStats stats;
+};
+
+} // namespace slang::analysis
@@ -10,9 +10,11 @@
 #if defined(SLANG_USE_THREADS)
 #    include <BS_thread_pool.hpp>
 #endif
+#include <chrono>
 #include <mutex>
 #include <optional>
 
+#include "slang/analysis/AnalysisCache.h"
 #include "slang/analysis/AnalysisOptions.h"
 #include "slang/analysis/AnalyzedProcedure.h"
 #include "slang/analysis/DriverTracker.h"
@@ -25,6 +27,7 @@ namespace slang::ast {
 
 class Compilation;
 class Scope;
+class Statement;
 class SubroutineSymbol;
 class Symbol;
 
@@ -34,6 +37,7 @@ namespace slang::analysis {
 
 class AnalysisManager;
 class AnalyzedScope;
+struct AnalysisProfile;
 
 /// Represents a pending analysis for a particular AST symbol,
 /// such as a module or interface instance, a class type, etc.
@@ -105,6 +109,10 @@ public:
     /// Diagnostics collected during analysis.
     Diagnostics diagnostics;
 
+    /// If set, the costs of analyzing procedures and the statements
+    /// within them are recorded here.
+    AnalysisProfile* profile = nullptr;
+
     /// Constructs a new AnalysisContext object.
     explicit AnalysisContext(AnalysisManager& manager) : manager(&manager) {}
 
@@ -115,6 +123,61 @@ public:
     Diagnostic& addDiag(const ast::Symbol& symbol, DiagCode code, SourceRange sourceRange);
 };
 
+/// Statistics about the work done by one of the analysis manager's worker threads.
+struct SLANG_EXPORT AnalysisWorkerStats {
+    /// The number of tasks the worker ran. A task is either a whole scope
+    /// or a batch of procedures split off from a large scope.
+    uint64_t tasks = 0;
+
+    /// The sum of the estimated costs of the tasks the worker ran.
+    uint64_t estimatedCost = 0;
+
+    /// The total time the worker spent running tasks.
+    std::chrono::nanoseconds busyTime{};
+};
+
+/// An entry in the report returned by @a AnalysisManager::getProfile.
+struct SLANG_EXPORT AnalysisProfileEntry {
+    /// The symbol that was analyzed. For statement entries this is
+    /// the procedure that contains the statement.
+    const ast::Symbol* symbol = nullptr;
+
+    /// The case statement or for loop, for per-statement entries.
+    const ast::Statement* statement = nullptr;
+
+    /// The number of times the symbol or statement was analyzed. Statements
+    /// in the bodies of unrolled loops are analyzed once per iteration.
+    uint64_t count = 0;
+
+    /// For case statements, the number of steps taken by the case analysis engine.
+    /// For loops, the number of iterations stepped through while unrolling
+    /// the loop and any loops nested inside of it.
+    uint64_t steps = 0;
+
+    /// For case statements, the engine that analyzed the case items.
+    CaseAnalysisEngine engine = CaseAnalysisEngine::Auto;
+
+    /// The total time spent analyzing the symbol or statement.
+    std::chrono::nanoseconds time{};
+};
+
+/// The results of profiling an analysis, as returned by @a AnalysisManager::getProfile.
+/// Each list is ordered with the most expensive (by time taken) entries first.
+struct SLANG_EXPORT AnalysisProfile {
+    /// Costs per scope. Scopes whose procedures were split into batches
+    /// include the time taken by all of the batches.
+    std::vector<AnalysisProfileEntry> scopes;
+
+    /// Costs per procedure, continuous assignment, and subroutine.
+    std::vector<AnalysisProfileEntry> procedures;
+
+    /// Costs per wildcard case statement that was checked for coverage or overlaps.
+    std::vector<AnalysisProfileEntry> caseStatements;
+
+    /// Costs per for loop.
+    std::vector<AnalysisProfileEntry> loops;
+};
+
 /// The analysis manager coordinates running various analyses on AST symbols.
 ///
 /// Analysis is done downstream from one or more Compilation objects.
@@ -133,11 +196,17 @@ public:
 
     /// Analyzes the given compilation and returns a representation of the design.
     ///
+    /// If @a cache is provided, results for instance bodies that haven't changed
+    /// since a previous analysis that used the same cache are reused instead of
+    /// being recomputed, and the cache is updated with the new results.
+    ///
     /// @note The provided compilation must be finalized and frozen
     ///       before it can be analyzed.
-    AnalyzedDesign analyze(const ast::Compilation& compilation);
+    AnalyzedDesign analyze(const ast::Compilation& compilation, AnalysisCache* cache = nullptr);
 
     /// Returns all of the known drivers for the given symbol.
+    /// Drivers are collected as analysis runs and only become
+    /// visible here once @a analyze has finished.
     DriverList getDrivers(const ast::ValueSymbol& symbol) const;
 
     /// Collects and returns all issued analysis diagnostics.
@@ -178,6 +247,26 @@ public:
                                SmallSet<const ast::SubroutineSymbol*, 2>& visited,
                                std::vector<const ast::Statement*>& controls);
 
+    /// Gets statistics about how many procedures had their results reused during
+    /// the last call to @a analyze, either from the AnalysisCache passed to it or
+    /// from identical instance bodies elsewhere in the design.
+    const AnalysisCacheStats& getCacheStats() const { return cacheStats; }
+
+    /// Gets statistics about the work done by each worker thread.
+    /// This should only be called once analysis has finished.
+    std::vector<AnalysisWorkerStats> getWorkerStats() const;
+
+    /// Gets the costs recorded for the parts of the design that were analyzed,
+    /// which is only populated when the @a AnalysisFlags::Profile flag is set.
+    /// Procedures whose results were reused from an AnalysisCache (or from an
+    /// identical instance body) are recorded with the time it took to reuse them.
+    /// This should only be called once analysis has finished.
+    AnalysisProfile getProfile() const;
+
+    /// Describes a procedure (or other analyzed symbol) for use in reports,
+    /// since most procedures don't have names. For example, "always_comb in top.u1".
+    static std::string describeProcedure(const ast::Symbol& symbol);
+
 private:
     friend struct AnalysisScopeVisitor;
 
@@ -185,19 +274,50 @@ private:
     struct WorkerState {
         AnalysisContext context;
         TypedBumpAllocator<AnalyzedScope> scopeAlloc;
-        DriverTracker::SymbolDriverMap::allocator_type driverAlloc;
+        DriverTracker::DriverBuffer driverBuffer;
+        AnalysisWorkerStats stats;
+        AnalysisProfile profile;
 
-        WorkerState(AnalysisManager& manager) : context(manager), driverAlloc(context.alloc) {}
+        WorkerState(AnalysisManager& manager) : context(manager), driverBuffer(context.alloc) {}
     };
 
+    struct SplitScope;
+
     PendingAnalysis analyzeSymbol(const ast::Symbol& symbol);
     void analyzeScopeAsync(const ast::Scope& scope);
+    const AnalyzedScope& analyzeScopeImpl(const ast::Scope& scope,
+                                          const AnalyzedProcedure* parentProcedure,
+                                          AnalysisCache::ScopeSession* cacheSession);
+    void analyzeScopeSplit(const ast::Scope& scope,
+                           std::unique_ptr<AnalysisCache::ScopeSession> cacheSession);
+    void analyzeProcedure(WorkerState& state, AnalysisCache::ScopeSession* cacheSession,
+                          size_t index, const ast::Symbol& symbol,
+                          const AnalyzedProcedure* parentProcedure,
+                          std::vector<AnalyzedProcedure>& results);
+    std::unique_ptr<AnalyzedProcedure> analyzeSubroutine(AnalysisContext& context,
+                                                         const ast::SubroutineSymbol& symbol,
+                                                         const AnalyzedProcedure* parentProcedure);
+    void noteScopeTime(WorkerState& state, const ast::Scope& scope,
+                       std::chrono::steady_clock::time_point start);
+    void publishScope(const ast::Scope& scope, const AnalyzedScope& result);
+    void mergeDrivers();
+    size_t getThreadCount() const;
     void wait();
     WorkerState& getState();
 
+    template<typename TFunc>
+    void runTask(uint64_t cost, TFunc&& func);
+
     const AnalysisOptions options;
     std::vector<WorkerState> workerStates;
 
+    // Instance bodies that don't share a canonical body but are otherwise
+    // identical reuse procedure results through this cache, unless the
+    // user provides their own.
+    AnalysisCache* cache = nullptr;
+    AnalysisCache instanceCache;
+    AnalysisCacheStats cacheStats;
+
     concurrent_map<const ast::Scope*, std::optional<const AnalyzedScope*>> analyzedScopes;
     concurrent_map<const ast::SubroutineSymbol*, std::unique_ptr<AnalyzedProcedure>>
         analyzedSubroutines;
@@ -205,7 +325,9 @@ private:
     DriverTracker driverTracker;
 
 #if defined(SLANG_USE_THREADS)
-    BS::thread_pool<> threadPool;
+    // Tasks are prioritized by their estimated cost so that the largest
+    // scopes get started first instead of being left for the tail end.
+    BS::priority_thread_pool threadPool;
 
     // A mutex for shared state; anything protected by it is declared below.
     std::mutex mutex;
@@ -33,8 +33,31 @@ enum class SLANG_EXPORT AnalysisFlags {
     /// by any other process. This flag allows initial blocks to
     /// also drive such signals.
     AllowDupInitialDrivers = 1 << 4,
+
+    /// Record how long it takes to analyze each scope, procedure, wildcard
+    /// case statement, and for loop, along with the number of steps taken
+    /// for case statements and loops. The results are available via
+    /// @a AnalysisManager::getProfile.
+    Profile = 1 << 5,
 };
-SLANG_BITMASK(AnalysisFlags, AllowDupInitialDrivers)
+SLANG_BITMASK(AnalysisFlags, Profile)
+
+/// Specifies the engine used to analyze wildcard case statements
+/// for coverage and overlapping items.
+/// - Auto: pick an engine based on the width of the case expression
+/// - Dag: explore the case items bit by bit via a decision DAG
+/// - Cube: treat case items as cubes and use cube cover checks
+#define CASE_ENGINE(x) x(Auto) x(Dag) x(Cube)
+SLANG_ENUM(CaseAnalysisEngine, CASE_ENGINE)
+#undef CASE_ENGINE
+
+/// Specifies how the bodies of for loops are analyzed.
+/// - Auto: unroll loops that fit within the step limit and widen the rest
+/// - Unroll: unroll any loop whose iterations can be determined, up to the step limit
+/// - Widen: analyze the body once with the loop variable widened to its range of values
+#define LOOP_MODE(x) x(Auto) x(Unroll) x(Widen)
+SLANG_ENUM(LoopAnalysisMode, LOOP_MODE)
+#undef LOOP_MODE
 
 /// Contains various options that can control analysis behavior.
 struct SLANG_EXPORT AnalysisOptions {
@@ -47,8 +70,19 @@ struct SLANG_EXPORT AnalysisOptions {
     /// The maximum number of case analysis steps to perform before giving up.
     uint32_t maxCaseAnalysisSteps = 65535;
 
+    /// The engine to use for analyzing wildcard case statements.
+    CaseAnalysisEngine caseAnalysisEngine = CaseAnalysisEngine::Auto;
+
     /// The maximum number of loop analysis steps to perform before giving up.
     uint32_t maxLoopAnalysisSteps = 65535;
+
+    /// The way in which the bodies of for loops are analyzed.
+    LoopAnalysisMode loopAnalysisMode = LoopAnalysisMode::Auto;
+
+    /// Scopes with at least this estimated cost (roughly the number of statements
+    /// in their procedures) have their procedures split into batches that are
+    /// analyzed in parallel. Zero disables splitting.
+    uint32_t scopeSplitCost = 4096;
 };
 
 } // namespace slang::analysis
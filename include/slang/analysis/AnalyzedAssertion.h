@@ -20,6 +20,7 @@ class TimingControl;
 
 namespace slang::analysis {
 
+class AnalysisCache;
 class AnalysisContext;
 class AnalyzedProcedure;
 class AnalyzedScope;
@@ -40,6 +41,15 @@ public:
     AnalyzedAssertion(AnalysisContext& context, const ast::TimingControl* contextualClock,
                       const AnalyzedProcedure* procedure, const ast::Symbol& parentSymbol,
                       const ast::Expression& expr);
+
+private:
+    friend class AnalysisCache;
+
+    // Used by the analysis cache to stand in for an assertion whose results
+    // (only diagnostics) are replayed from the cache. This must stay equivalent
+    // to analyzing an assertion that isn't a procedural checker, so any state
+    // added to this class also has to be captured by the cache.
+    AnalyzedAssertion() = default;
 };
 
 } // namespace slang::analysis
@@ -25,6 +25,7 @@ class TimingControl;
 
 namespace slang::analysis {
 
+class AnalysisCache;
 class AnalysisContext;
 
 /// Represents an analyzed procedure.
@@ -67,6 +68,12 @@ public:
     std::span<const ast::Statement* const> getTimingControls() const { return timingControls; }
 
 private:
+    friend class AnalysisCache;
+
+    // Used by the analysis cache to rebuild a procedure from cached results.
+    explicit AnalyzedProcedure(const ast::Symbol& symbol) :
+        analyzedSymbol(&symbol), parentProcedure(nullptr) {}
+
     const ast::TimingControl* inferredClock = nullptr;
     std::vector<SymbolDriverListPair> drivers;
     std::vector<AnalyzedAssertion> assertions;
@@ -9,6 +9,7 @@
 
 #include <span>
 
+#include "slang/analysis/AnalysisOptions.h"
 #include "slang/numeric/SVInt.h"
 #include "slang/util/BumpAllocator.h"
 #include "slang/util/FlatMap.h"
@@ -24,6 +25,12 @@ namespace slang::analysis {
 /// The DAG is used to determine if a set of clauses covers all possible
 /// input values for a given case expression bit width, as well as to identify
 /// overlapping and redundant clauses for issuing diagnostics.
+///
+/// The same results can alternatively be computed by the cube engine, which
+/// treats each clause as a cube (a set of fixed bits plus wildcards) and
+/// answers coverage questions with word-parallel cube operations and a
+/// recursive tautology check. That scales much better to wide case
+/// expressions and large numbers of clauses than walking the DAG bit by bit.
 class SLANG_EXPORT CaseDecisionDag {
 public:
     using ClauseIndex = uint32_t;
@@ -46,15 +53,25 @@ public:
     /// the analysis was halted.
     bool gaveUp = false;
 
+    /// The engine that was used to perform the analysis.
+    /// This is never CaseAnalysisEngine::Auto.
+    CaseAnalysisEngine engine;
+
     /// Constructs a new case decision DAG.
     CaseDecisionDag(std::span<const SVInt> clauses, uint32_t bitWidth, bool wildcardX,
-                    uint32_t maxSteps = UINT32_MAX);
+                    uint32_t maxSteps = UINT32_MAX,
+                    CaseAnalysisEngine engine = CaseAnalysisEngine::Dag);
+
+    /// Gets the number of steps taken to perform the analysis.
+    uint32_t getSteps() const { return steps; }
 
     /// Indicates whether the DAG is exhaustive, meaning that all possible
     /// input values are covered by the case statement clauses.
     bool isExhaustive() const { return !counterexample.has_value(); }
 
 private:
+    void buildCubes(std::span<const SVInt> clauses, uint32_t bitWidth, bool wildcardX,
+                    uint32_t maxSteps);
     void build(uint32_t level, std::span<const SVInt> clauses, uint32_t bitWidth, bool wildcardX,
                uint32_t maxSteps, SVInt curPath, std::vector<ClauseIndex>&& activeIndices);
 
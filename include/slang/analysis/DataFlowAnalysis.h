@@ -22,7 +22,13 @@ using SymbolLSPMap = IntervalMap<uint64_t, const Expression*, 5>;
 
 /// Represents the state of a data flow analysis at a single point in a procedure.
 struct SLANG_EXPORT DataFlowState {
-    /// Each tracked variable has its assigned intervals stored here.
+    /// Assigned bits of all densely tracked variables, packed one after
+    /// another according to the layout chosen by the owning analysis.
+    /// Words beyond the end of the vector are implicitly unassigned.
+    SmallVector<uint64_t, 2> dense;
+
+    /// Each variable that is too large to track densely has its
+    /// assigned intervals stored here.
     SmallVector<SymbolBitMap, 2> assigned;
 
     /// Whether the control flow that arrived at this point is reachable.
@@ -31,6 +37,17 @@ struct SLANG_EXPORT DataFlowState {
     DataFlowState() = default;
     DataFlowState(DataFlowState&& other) = default;
     DataFlowState& operator=(DataFlowState&& other) = default;
+
+    /// Marks the dense bits in the range [first, last] as assigned.
+    void setDense(uint64_t first, uint64_t last);
+
+    /// Returns true if every dense bit in the range [first, last] is assigned.
+    bool allDense(uint64_t first, uint64_t last) const;
+
+    /// Finds the first run of assigned dense bits that starts at or after @a first,
+    /// clipped to end at or before @a last. Returns std::nullopt if there is none.
+    std::optional<std::pair<uint64_t, uint64_t>> findDenseRun(uint64_t first,
+                                                               uint64_t last) const;
 };
 
 /// Performs data flow analysis on a single procedure, tracking the assigned ranges
@@ -94,9 +111,26 @@ public:
         not_null<const ValueSymbol*> symbol;
         SymbolLSPMap assigned;
 
+        // The bit offset of the symbol in the dense flow state, or the index
+        // of its interval map in the sparse state if it isn't tracked densely.
+        uint64_t stateIndex = 0;
+
+        // The number of bits tracked in the dense flow state,
+        // or zero if the symbol is tracked via an interval map.
+        uint64_t denseWidth = 0;
+
         LValueSymbol(const ValueSymbol& symbol) : symbol(&symbol) {}
     };
 
+    /// The largest symbol, in selectable bits, that will be tracked in the
+    /// dense flow state. Larger symbols fall back to interval maps.
+    static constexpr uint64_t MaxDenseSymbolWidth = 1024;
+
+    /// The maximum number of bits that will be tracked in the dense flow state
+    /// across all symbols in a procedure. Once exhausted, additional symbols
+    /// fall back to interval maps.
+    static constexpr uint64_t MaxDenseStateWidth = 1 << 16;
+
     /// Gets all of the lvalues used in the procedure.
     std::span<const LValueSymbol> getLValues() const { return lvalues; }
 
@@ -112,9 +146,15 @@ private:
     SymbolBitMap::allocator_type bitMapAllocator;
     SymbolLSPMap::allocator_type lspMapAllocator;
 
-    // Maps visited symbols to slots in assigned vectors.
+    // Maps visited symbols to slots in the lvalues vector.
     SmallMap<const ValueSymbol*, uint32_t, 4> symbolToSlot;
 
+    // The total number of bits allocated in the dense flow state.
+    uint64_t denseStateWidth = 0;
+
+    // The number of symbols tracked via interval maps in the flow state.
+    uint32_t sparseStateCount = 0;
+
     // Tracks the assigned ranges of each variable across the entire procedure,
     // even if not all branches assign to it.
     SmallVector<LValueSymbol> lvalues;
@@ -127,6 +167,11 @@ private:
     bool isLValue = false;
     bool prohibitLValue = false;
 
+    // An element select of a widened loop variable that is the current LSP,
+    // along with the loop variable it selects with.
+    const Expression* widenedLSP = nullptr;
+    const WidenedLoopVar* widenedLSPVar = nullptr;
+
     // All statements that have timing controls associated with them.
     SmallVector<const Statement*> timedStatements;
 
@@ -143,6 +188,7 @@ private:
     }
 
     void noteReference(const ValueSymbol& symbol, const Expression& lsp);
+    std::optional<DriverBitRange> getWidenedBounds(const Expression& lsp, const Type& rootType);
 
     // **** AST Handlers ****
 
@@ -183,6 +229,7 @@ private:
         }
     }
 
+    void handle(const ElementSelectExpression& expr);
     void handle(const AssignmentExpression& expr);
     void handle(const CallExpression& expr);
     void handle(const ExpressionStatement& stmt);
@@ -217,13 +264,24 @@ void DataFlowAnalysis::visitPartiallyAssigned(bool skipAutomatic, F&& func) cons
 
         // Each interval in the left map is a range that needs to be fully covered
         // by our final state, otherwise that interval is not fully assigned.
-        if (currState.assigned.size() <= index) {
+        if (symbolState.denseWidth) {
+            auto offset = symbolState.stateIndex;
+            for (auto lit = left.begin(); lit != left.end(); ++lit) {
+                auto lbounds = lit.bounds();
+                if (!currState.allDense(offset + lbounds.first, offset + lbounds.second))
+                    func(symbol, **lit);
+            }
+            continue;
+        }
+
+        auto stateIndex = symbolState.stateIndex;
+        if (currState.assigned.size() <= stateIndex) {
             for (auto it = left.begin(); it != left.end(); ++it)
                 func(symbol, **it);
             continue;
         }
 
-        auto& right = currState.assigned[index];
+        auto& right = currState.assigned[stateIndex];
         for (auto lit = left.begin(); lit != left.end(); ++lit) {
             auto lbounds = lit.bounds();
             if (auto rit = right.find(lbounds); rit != right.end()) {
@@ -243,7 +301,7 @@ void DataFlowAnalysis::visitPartiallyAssigned(bool skipAutomatic, F&& func) cons
 template<typename F>
 void DataFlowAnalysis::visitDefinitelyAssigned(bool skipAutomatic, F&& func) const {
     auto& currState = getState();
-    for (size_t index = 0; index < currState.assigned.size(); index++) {
+    for (size_t index = 0; index < lvalues.size(); index++) {
         auto& symbolState = lvalues[index];
         auto& symbol = *symbolState.symbol;
 
@@ -252,13 +310,12 @@ void DataFlowAnalysis::visitDefinitelyAssigned(bool skipAutomatic, F&& func) con
             continue;
         }
 
-        auto& imap = currState.assigned[index];
-        for (auto it = imap.begin(); it != imap.end(); ++it) {
-            // We know this range is definitely assigned. In order to provide an
-            // example expression for the LSP we need to look up a range that
-            // overlaps from the procedure-wide tracking map.
+        // We know this range is definitely assigned. In order to provide an
+        // example expression for the LSP we need to look up a range that
+        // overlaps from the procedure-wide tracking map.
+        auto visitRange = [&](std::pair<uint64_t, uint64_t> bounds) {
             std::optional<std::pair<uint64_t, uint64_t>> prevBounds;
-            for (auto lspIt = symbolState.assigned.find(it.bounds());
+            for (auto lspIt = symbolState.assigned.find(bounds);
                  lspIt != symbolState.assigned.end(); ++lspIt) {
                 // Skip over ranges that partially overlap previously visited ranges,
                 // as it's not clear that there's additional value in reporting them.
@@ -270,6 +327,22 @@ void DataFlowAnalysis::visitDefinitelyAssigned(bool skipAutomatic, F&& func) con
 
                 prevBounds = curBounds;
             }
+        };
+
+        if (symbolState.denseWidth) {
+            auto offset = symbolState.stateIndex;
+            auto last = offset + symbolState.denseWidth - 1;
+            for (auto run = currState.findDenseRun(offset, last); run;
+                 run = currState.findDenseRun(run->second + 1, last)) {
+                visitRange({run->first - offset, run->second - offset});
+                if (run->second == last)
+                    break;
+            }
+        }
+        else if (symbolState.stateIndex < currState.assigned.size()) {
+            auto& imap = currState.assigned[symbolState.stateIndex];
+            for (auto it = imap.begin(); it != imap.end(); ++it)
+                visitRange(it.bounds());
         }
     }
 }
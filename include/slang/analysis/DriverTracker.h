@@ -7,8 +7,12 @@
 //------------------------------------------------------------------------------
 #pragma once
 
+#include <array>
+#include <atomic>
+
 #include "slang/analysis/ValueDriver.h"
 #include "slang/util/ConcurrentMap.h"
+#include "slang/util/FlatMap.h"
 #include "slang/util/IntervalMap.h"
 
 namespace slang::ast {
@@ -31,43 +35,78 @@ class AnalysisContext;
 class AnalyzedProcedure;
 
 /// A helper class that tracks drivers for all symbols in a thread-safe manner.
+///
+/// Drivers are first appended to a per-worker DriverBuffer without any
+/// synchronization. Once all of them have been collected they are merged
+/// into the tracker and checked for conflicts, one shard of symbols at a
+/// time, via @a mergeShard.
 class DriverTracker {
 public:
     using SymbolDriverMap = IntervalMap<uint64_t, const ValueDriver*, 5>;
     using DriverAlloc = SymbolDriverMap::allocator_type;
 
+    /// The number of shards that driven symbols are split into for merging.
+    static constexpr size_t NumShards = 64;
+
+    /// Holds drivers that have been added by a single worker
+    /// but not yet merged into the tracker.
+    class DriverBuffer {
+    public:
+        /// The allocator used for driver maps created by the owning worker.
+        DriverAlloc alloc;
+
+        explicit DriverBuffer(BumpAllocator& alloc) : alloc(alloc) {}
+
+    private:
+        friend class DriverTracker;
+
+        struct PendingDriver {
+            not_null<const ast::ValueSymbol*> symbol;
+            not_null<const ValueDriver*> driver;
+            DriverBitRange bounds;
+            uint64_t order;
+        };
+
+        std::array<std::vector<PendingDriver>, NumShards> shards;
+    };
+
     /// Adds drivers for the given procedure to the tracker.
-    void add(AnalysisContext& context, DriverAlloc& driverAlloc,
-             const AnalyzedProcedure& procedure);
+    void add(AnalysisContext& context, DriverBuffer& buffer, const AnalyzedProcedure& procedure);
 
     // Adds drivers for the given port connection to the tracker.
-    void add(AnalysisContext& context, DriverAlloc& driverAlloc,
-             const ast::PortConnection& connection, const ast::Symbol& containingSymbol);
+    void add(AnalysisContext& context, DriverBuffer& buffer, const ast::PortConnection& connection,
+             const ast::Symbol& containingSymbol);
 
     // Adds drivers for the given port symbol to the tracker.
-    void add(AnalysisContext& context, DriverAlloc& driverAlloc, const ast::PortSymbol& symbol);
+    void add(AnalysisContext& context, DriverBuffer& buffer, const ast::PortSymbol& symbol);
 
     // Adds drivers for the given clock variable to the tracker.
-    void add(AnalysisContext& context, DriverAlloc& driverAlloc, const ast::ClockVarSymbol& symbol);
+    void add(AnalysisContext& context, DriverBuffer& buffer, const ast::ClockVarSymbol& symbol);
 
     // Adds drivers for the given expression to the tracker.
-    void add(AnalysisContext& context, DriverAlloc& driverAlloc, const ast::Expression& expr,
+    void add(AnalysisContext& context, DriverBuffer& buffer, const ast::Expression& expr,
              const ast::Symbol& containingSymbol);
 
     /// Adds the given drivers to the tracker.
-    void add(AnalysisContext& context, DriverAlloc& driverAlloc,
-             std::span<const SymbolDriverListPair> drivers);
+    void add(DriverBuffer& buffer, std::span<const SymbolDriverListPair> drivers);
 
     /// Records the existence of a non-canonical instance, which may imply that
     /// additional drivers should be applied based on the canonical instance.
-    void noteNonCanonicalInstance(AnalysisContext& context, DriverAlloc& driverAlloc,
+    void noteNonCanonicalInstance(AnalysisContext& context, DriverBuffer& buffer,
                                   const ast::InstanceSymbol& instance);
 
     /// Propagates drivers to modport ports down to the targets of the
     /// modport port connections.
-    void propagateModportDrivers(AnalysisContext& context, DriverAlloc& driverAlloc);
+    void propagateModportDrivers(AnalysisContext& context, DriverBuffer& buffer);
+
+    /// Merges the drivers for one shard of symbols from all of the given
+    /// buffers into the tracker, reporting any conflicts between them.
+    /// Different shards can safely be merged concurrently.
+    void mergeShard(AnalysisContext& context, DriverAlloc& driverAlloc,
+                    std::span<DriverBuffer* const> buffers, size_t shard);
 
     /// Returns all of the tracked drivers for the given symbol.
+    /// Only drivers that have been merged are included.
     DriverList getDrivers(const ast::ValueSymbol& symbol) const;
 
 private:
@@ -85,24 +124,35 @@ private:
         std::vector<const ast::InstanceSymbol*> nonCanonicalInstances;
     };
 
-    const ast::HierarchicalReference* addDriver(AnalysisContext& context, DriverAlloc& driverAlloc,
+    const ast::HierarchicalReference* addDriver(DriverBuffer& buffer,
                                                 const ast::ValueSymbol& symbol,
-                                                SymbolDriverMap& driverMap,
                                                 const ValueDriver& driver, DriverBitRange bounds);
-    void noteInterfacePortDriver(AnalysisContext& context, DriverAlloc& driverAlloc,
+    void mergeDriver(AnalysisContext& context, DriverAlloc& driverAlloc,
+                     const ast::ValueSymbol& symbol, SymbolDriverMap& driverMap,
+                     const ValueDriver& driver, DriverBitRange bounds);
+    void noteInterfacePortDriver(AnalysisContext& context, DriverBuffer& buffer,
                                  const ast::HierarchicalReference& ref, const ValueDriver& driver);
-    void applyInstanceSideEffect(AnalysisContext& context, DriverAlloc& driverAlloc,
+    void applyInstanceSideEffect(AnalysisContext& context, DriverBuffer& buffer,
                                  const InstanceState::IfacePortDriver& ifacePortDriver,
                                  const ast::InstanceSymbol& instance);
-    void propagateModportDriver(AnalysisContext& context, DriverAlloc& driverAlloc,
+    void propagateModportDriver(AnalysisContext& context, DriverBuffer& buffer,
                                 const ast::Expression& connectionExpr,
                                 const ValueDriver& originalDriver);
-    void addDrivers(AnalysisContext& context, DriverAlloc& driverAlloc, const ast::Expression& expr,
+    void addDrivers(AnalysisContext& context, DriverBuffer& buffer, const ast::Expression& expr,
                     DriverKind driverKind, bitmask<DriverFlags> driverFlags,
                     const ast::Symbol& containingSymbol,
                     const ast::Expression* initialLSP = nullptr);
 
-    concurrent_map<const ast::ValueSymbol*, SymbolDriverMap> symbolDrivers;
+    static size_t getShard(const ast::ValueSymbol& symbol);
+
+    // Merged drivers for each symbol, split into shards by symbol.
+    // Each shard is only ever modified by a single merge task.
+    std::array<flat_hash_map<const ast::ValueSymbol*, SymbolDriverMap>, NumShards> symbolDrivers;
+
+    // Gives each added driver a sequence number so that merging can
+    // apply them in the same order in which they were added.
+    std::atomic<uint64_t> nextDriverOrder = 0;
+
     concurrent_map<const ast::InstanceBodySymbol*, InstanceState> instanceMap;
     concurrent_map<const ast::ValueSymbol*, DriverList> modportPortDrivers;
 };
@@ -27,6 +27,10 @@ public:
     /// If the @a sourceManager is provided it will be used to sort the diagnostics.
     Diagnostics coalesce(const SourceManager* sourceManager);
 
+    /// Gets an estimate of the number of bytes of memory held by the map,
+    /// including the issued diagnostics and their arguments, ranges, and notes.
+    size_t getMemoryUsage() const;
+
 private:
     flat_hash_map<std::tuple<DiagCode, SourceLocation>, std::vector<Diagnostic>> map;
 };
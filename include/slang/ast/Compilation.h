@@ -7,6 +7,8 @@
 //------------------------------------------------------------------------------
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <memory>
 
 #include "slang/ast/ASTDiagMap.h"
@@ -49,6 +51,7 @@ struct AssertionInstanceDetails;
 struct ConfigRule;
 struct ResolvedConfig;
 
+enum class ExpressionKind : int;
 enum class IntegralFlags : uint8_t;
 enum class SymbolIndex : uint32_t;
 enum class SymbolKind : int;
@@ -122,9 +125,18 @@ enum class SLANG_EXPORT CompilationFlags {
     DisallowRefsToUnknownInstances = 1 << 12,
 
     /// Allow unnamed generate blocks (e.g. genblk) to be referenced
-    AllowUnnamedGenerate = 1 << 13
+    AllowUnnamedGenerate = 1 << 13,
+
+    /// Disable compiling constant functions to bytecode, which normally speeds up
+    /// functions that are invoked many times during elaboration.
+    DisableConstEvalBytecode = 1 << 14,
+
+    /// Record how many statements and how much time constant function calls
+    /// take, per function and per call site. The results are available via
+    /// @a Compilation::getConstEvalProfile.
+    ProfileConstEval = 1 << 15
 };
-SLANG_BITMASK(CompilationFlags, AllowUnnamedGenerate)
+SLANG_BITMASK(CompilationFlags, ProfileConstEval)
 
 /// Contains various options that can control compilation behavior.
 struct SLANG_EXPORT CompilationOptions {
@@ -254,6 +266,138 @@ struct SLANG_EXPORT HierarchyOverrideNode {
     std::vector<std::pair<BindDirectiveInfo, const syntax::SyntaxNode*>> binds;
 };
 
+/// A breakdown of the memory used by a compilation, as returned
+/// by @a Compilation::getMemoryStats. All sizes are in bytes.
+struct SLANG_EXPORT CompilationMemoryStats {
+    /// Usage information for a single allocation arena.
+    struct Arena {
+        /// The name of the arena.
+        std::string_view name;
+
+        /// The number of bytes handed out from the arena,
+        /// including padding inserted for alignment.
+        size_t used = 0;
+
+        /// The number of bytes the arena has obtained from the system.
+        size_t reserved = 0;
+    };
+
+    /// Usage information for a particular kind of AST node.
+    template<typename TKind>
+    struct KindUsage {
+        /// The kind of node.
+        TKind kind;
+
+        /// The number of nodes of this kind that have been allocated.
+        size_t count = 0;
+
+        /// The number of bytes used by those nodes, not counting any
+        /// separately allocated trailing storage.
+        size_t bytes = 0;
+    };
+
+    /// Usage of each of the compilation's arenas.
+    std::vector<Arena> arenas;
+
+    /// Symbols allocated from the main arena, grouped by kind and
+    /// sorted by descending size. Kinds with no allocations are omitted.
+    ///
+    /// Only objects created via @a Compilation::emplace are counted here;
+    /// raw allocations (such as copied arrays and strings) and objects created
+    /// through a plain @a BumpAllocator reference to the compilation still
+    /// show up in the arena totals, but not in the per-kind breakdown.
+    std::vector<KindUsage<SymbolKind>> symbols;
+
+    /// Expressions allocated from the main arena, grouped by kind and
+    /// sorted by descending size. Kinds with no allocations are omitted.
+    /// The same exclusions as for @a symbols apply.
+    std::vector<KindUsage<ExpressionKind>> expressions;
+
+    /// Arena memory reserved by all syntax trees added to the compilation.
+    size_t syntaxTrees = 0;
+
+    /// Memory used by type symbols. This is a subset of the
+    /// memory accounted for in the @a symbols list.
+    size_t types = 0;
+
+    /// Memory used by constant values created via @a Compilation::allocConstant.
+    size_t constants = 0;
+
+    /// An estimate of the memory held by issued diagnostics.
+    size_t diagnostics = 0;
+
+    /// An estimate of the memory held by the compilation's lookup
+    /// tables and caches, which live outside of any arena.
+    size_t sideTables = 0;
+
+    /// Gets the total number of bytes reserved by the compilation's arenas,
+    /// syntax trees, diagnostics, and side tables.
+    size_t getTotalReserved() const;
+};
+
+/// Counters describing how effective the table of memoized constant function
+/// calls has been, as returned by @a Compilation::getCallMemoStats.
+struct SLANG_EXPORT CallMemoStats {
+    /// The number of calls whose result was found in the table.
+    uint64_t hits = 0;
+
+    /// The number of memoizable calls that had to be evaluated.
+    uint64_t misses = 0;
+
+    /// The number of results currently stored in the table.
+    size_t entries = 0;
+};
+
+/// The cost of one or more calls to a constant function, as measured by the
+/// constant evaluation profiler (see @a CompilationFlags::ProfileConstEval).
+struct SLANG_EXPORT ConstEvalCost {
+    /// The number of calls that were evaluated.
+    uint64_t calls = 0;
+
+    /// The number of calls whose result came from the memoized call table
+    /// instead of being evaluated.
+    uint64_t memoHits = 0;
+
+    /// The number of statements executed in the function itself.
+    uint64_t selfSteps = 0;
+
+    /// The number of statements executed in the function and everything it called.
+    /// Recursive calls are only counted once, by the outermost one.
+    uint64_t totalSteps = 0;
+
+    /// The time spent in the function itself.
+    std::chrono::nanoseconds selfTime{};
+
+    /// The time spent in the function and everything it called.
+    /// Recursive calls are only counted once, by the outermost one.
+    std::chrono::nanoseconds totalTime{};
+
+    ConstEvalCost& operator+=(const ConstEvalCost& other);
+};
+
+/// An entry in the report returned by @a Compilation::getConstEvalProfile.
+struct SLANG_EXPORT ConstEvalProfileEntry {
+    /// The function that was called.
+    const SubroutineSymbol* subroutine = nullptr;
+
+    /// The location of the call, for per-call-site entries.
+    /// This is empty for per-function entries.
+    SourceLocation callLocation;
+
+    /// The measured cost of the calls.
+    ConstEvalCost cost;
+};
+
+/// The results of profiling constant function calls, as returned by
+/// @a Compilation::getConstEvalProfile.
+struct SLANG_EXPORT ConstEvalProfile {
+    /// Costs per function, most expensive (by steps executed in the function itself) first.
+    std::vector<ConstEvalProfileEntry> functions;
+
+    /// Costs per call site, most expensive (by total steps executed under the call) first.
+    std::vector<ConstEvalProfileEntry> callSites;
+};
+
 /// A centralized location for creating and caching symbols. This includes
 /// creating symbols from syntax nodes as well as fabricating them synthetically.
 /// Common symbols such as built in types are exposed here as well.
@@ -294,6 +438,21 @@ public:
     /// Gets the set of syntax trees that have been added to the compilation.
     std::span<const std::shared_ptr<syntax::SyntaxTree>> getSyntaxTrees() const;
 
+    /// Creates a new compilation that shares all of this compilation's syntax trees
+    /// and source libraries but is elaborated independently using the given @a options,
+    /// for example to select a different set of top modules or parameter overrides.
+    ///
+    /// Only the parse results are shared: syntax trees are immutable and are
+    /// reused rather than copied or re-parsed. Nothing else carries over;
+    /// definitions, packages, and the rest of the AST are created and elaborated
+    /// from scratch by the new compilation, exactly as if the trees had been
+    /// added to a newly constructed one, since symbols resolve their contents
+    /// lazily and are owned by the compilation that created them.
+    ///
+    /// This compilation must not have syntax trees added to it while the new one is
+    /// being created. Separately forked compilations can be elaborated concurrently.
+    [[nodiscard]] std::unique_ptr<Compilation> fork(const Bag& options) const;
+
     /// Gets the root of the design. The first time you call this method all top-level
     /// instances will be elaborated and the compilation finalized. After that you can
     /// no longer make any modifications to the compilation object; any attempts to do
@@ -305,6 +464,10 @@ public:
     /// defparams will not be resolved, root instances will not have been created, etc.
     const RootSymbol& getRootNoFinalize() const { return *root; }
 
+    /// Gets the table used to intern identifier names. Name-keyed maps in the
+    /// compilation and its scopes are keyed by IDs from this table.
+    IdentifierTable& getIdentifierTable() const { return identifiers; }
+
     /// Indicates whether the design has been compiled and can no longer accept modifications.
     bool isFinalized() const { return finalized; }
 
@@ -336,6 +499,19 @@ public:
     /// because of it.
     bool hasFatalErrors() const { return sawFatalError; }
 
+    /// Gets a breakdown of the memory currently used by the compilation,
+    /// grouped by arena and by category. The per-kind counters are always
+    /// maintained so this can be called at any point, but gathering the
+    /// results walks every arena so it should not be called in a hot loop.
+    CompilationMemoryStats getMemoryStats() const;
+
+    /// Gets hit and miss counts for the table of memoized constant function calls.
+    CallMemoStats getCallMemoStats() const;
+
+    /// Gets the costs of constant function calls recorded so far. This is only
+    /// populated when the @a CompilationFlags::ProfileConstEval flag is set.
+    ConstEvalProfile getConstEvalProfile() const;
+
     /// @}
     /// @name Utility and convenience methods
     /// @{
@@ -618,6 +794,25 @@ public:
     /// Notes the existence of a virtual interface type declaration for the given instance.
     void noteVirtualIfaceInstance(const InstanceSymbol& instance);
 
+    /// Looks up the memoized result of a constant function call with the given
+    /// argument values, returning std::nullopt if there isn't one. Safe to call
+    /// from multiple threads at once.
+    std::optional<ConstantValue> findMemoizedCall(const SubroutineSymbol& subroutine,
+                                                  std::span<const ConstantValue> args) const;
+
+    /// Records the result of a constant function call with the given argument values
+    /// so that later calls can use @a findMemoizedCall to skip evaluation. The caller
+    /// is responsible for ensuring that the result depends only on the arguments.
+    /// Safe to call from multiple threads at once.
+    void memoizeCall(const SubroutineSymbol& subroutine, std::span<const ConstantValue> args,
+                     const ConstantValue& result) const;
+
+    /// Adds the given cost to the profile returned by @a getConstEvalProfile,
+    /// either for a specific call site or, if @a callLocation is empty, for the
+    /// function as a whole. Safe to call from multiple threads at once.
+    void recordConstEvalCost(const SubroutineSymbol& subroutine, SourceLocation callLocation,
+                             const ConstEvalCost& cost) const;
+
     /// Adds a set of diagnostics to the compilation's list of semantic diagnostics.
     void addDiagnostics(const Diagnostics& diagnostics);
 
@@ -660,6 +855,35 @@ public:
     /// Gets a scalar (single bit) type with the given flags.
     const Type& getScalarType(bitmask<IntegralFlags> flags) const;
 
+    /// Gets a packed array type with the given element type and range.
+    /// Structurally identical array types are interned so that they share a
+    /// single object. Interned types are not associated with any syntax node,
+    /// since they may be shared by many unrelated declarations.
+    const Type& getPackedArrayType(const Type& elementType, ConstantRange range,
+                                   bitwidth_t fullWidth);
+
+    /// Gets a fixed size unpacked array type with the given element type and range.
+    /// Structurally identical array types are interned so that they share a
+    /// single object, which is not associated with any syntax node.
+    const Type& getUnpackedArrayType(const Type& elementType, ConstantRange range,
+                                     uint64_t selectableWidth, uint64_t bitstreamWidth);
+
+    /// Gets a dynamic array type with the given element type.
+    /// Structurally identical array types are interned so that they share a
+    /// single object, which is not associated with any syntax node.
+    const Type& getDynamicArrayType(const Type& elementType);
+
+    /// Gets an associative array type with the given element and index types.
+    /// A null index type indicates a wildcard index. Structurally identical
+    /// array types are interned so that they share a single object, which is
+    /// not associated with any syntax node.
+    const Type& getAssociativeArrayType(const Type& elementType, const Type* indexType);
+
+    /// Gets a queue type with the given element type and maximum bound.
+    /// Structurally identical queue types are interned so that they share a
+    /// single object, which is not associated with any syntax node.
+    const Type& getQueueType(const Type& elementType, uint32_t maxBound);
+
     /// Gets the nettype represented by the given token kind.
     /// If the token kind does not represent a nettype this will return the
     /// error nettype.
@@ -716,6 +940,22 @@ public:
     /// @name Allocation functions
     /// @{
 
+    /// Constructs a new object in the compilation's main arena.
+    /// Symbols and expressions are tallied by kind for @a getMemoryStats.
+    template<typename T, typename... Args>
+    T* emplace(Args&&... args) {
+        T* result = BumpAllocator::emplace<T>(std::forward<Args>(args)...);
+        if constexpr (std::is_base_of_v<Symbol, T>) {
+            recordAllocation(symbolAllocs, size_t(result->kind), sizeof(T));
+            if constexpr (std::is_base_of_v<Type, T>)
+                typeBytes.fetch_add(sizeof(T), std::memory_order_relaxed);
+        }
+        else if constexpr (std::is_base_of_v<Expression, T>) {
+            recordAllocation(expressionAllocs, size_t(result->kind), sizeof(T));
+        }
+        return result;
+    }
+
     /// Allocates space for a constant value in the pool of constants.
     ConstantValue* allocConstant(ConstantValue&& value) {
         SLANG_ASSERT(!isFrozen());
@@ -813,9 +1053,47 @@ private:
     Diagnostic* errorMissingDef(std::string_view name, const Scope& scope, SourceRange sourceRange,
                                 DiagCode code) const;
 
+    template<typename T, typename... Args>
+    const Type& getOrCreateArrayType(SymbolKind kind, const Type& elementType,
+                                     uint64_t discriminator, Args&&... args);
+
+    // These are atomic because nodes may be created from more than one thread.
+    struct AllocCounter {
+        std::atomic<size_t> count = 0;
+        std::atomic<size_t> bytes = 0;
+    };
+
+    static void recordAllocation(std::vector<AllocCounter>& counters, size_t index,
+                                 size_t bytes) {
+        SLANG_ASSERT(index < counters.size());
+        counters[index].count.fetch_add(1, std::memory_order_relaxed);
+        counters[index].bytes.fetch_add(bytes, std::memory_order_relaxed);
+    }
+
     // Stored options object.
     CompilationOptions options;
 
+    // The table used to intern names for the definition and package maps.
+    // This is shared with the lexer so that identifier tokens carry their IDs.
+    IdentifierTable& identifiers;
+
+    // Counters of the objects allocated via emplace, indexed by
+    // SymbolKind and ExpressionKind respectively, for memory stats.
+    std::vector<AllocCounter> symbolAllocs;
+    std::vector<AllocCounter> expressionAllocs;
+    std::atomic<size_t> typeBytes = 0;
+
+    // Results of constant function calls, keyed by subroutine and argument values.
+    // This is shared between threads so it lives behind a pointer to keep the
+    // concurrent map out of this header.
+    struct CallMemoTable;
+    std::unique_ptr<CallMemoTable> callMemo;
+
+    // Costs recorded by the constant evaluation profiler, keyed by subroutine
+    // and call location. Also shared between threads.
+    struct ConstEvalProfileTable;
+    std::unique_ptr<ConstEvalProfileTable> constEvalProfile;
+
     // Specialized allocators for types that are not trivially destructible.
     TypedBumpAllocator<SymbolMap> symbolMapAllocator;
     TypedBumpAllocator<PointerMap> pointerMapAllocator;
@@ -849,12 +1127,17 @@ private:
     // the given name / scope (which can happen for multiple libraries at the root scope),
     // and the second element is a boolean that indicates whether there exists at least
     // one nested module with the given name (requiring a more involved lookup).
-    flat_hash_map<std::tuple<std::string_view, const Scope*>, std::pair<std::vector<Symbol*>, bool>>
+    flat_hash_map<std::tuple<IdentifierId, const Scope*>, std::pair<std::vector<Symbol*>, bool>>
         definitionMap;
 
     // A cache of vector types, keyed on various properties such as bit width.
     flat_hash_map<uint32_t, const Type*> vectorTypeCache;
 
+    // A cache of array types, keyed on the element type, the kind of array, and
+    // a kind-specific discriminator (the range, max bound, or index type).
+    // This lets structurally identical array types share a single object.
+    flat_hash_map<std::tuple<const Type*, SymbolKind, uint64_t>, const Type*> arrayTypeCache;
+
     // Map from syntax kinds to the built-in types.
     flat_hash_map<syntax::SyntaxKind, const Type*> knownTypes;
 
@@ -863,7 +1146,7 @@ private:
 
     // The name map for packages. Note that packages have their own namespace,
     // which is why they can't share the definitions name table.
-    flat_hash_map<std::string_view, const PackageSymbol*> packageMap;
+    flat_hash_map<IdentifierId, const PackageSymbol*> packageMap;
 
     // A list of known system subroutines, indexed via KnownSystemName values.
     std::vector<std::shared_ptr<SystemSubroutine>> systemSubroutines;
@@ -947,6 +1230,10 @@ private:
     // Storage for syntax trees that have been added to the compilation.
     std::vector<std::shared_ptr<syntax::SyntaxTree>> syntaxTrees;
 
+    // The number of trees at the end of the syntaxTrees list that were
+    // synthesized from parameter override options rather than added by the user.
+    size_t numOptionSyntaxTrees = 0;
+
     // A list of definitions that are unreferenced in any instantiations and
     // are also not automatically instantiated as top-level.
     std::vector<const DefinitionSymbol*> unreferencedDefs;
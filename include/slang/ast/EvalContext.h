@@ -7,6 +7,7 @@
 //------------------------------------------------------------------------------
 #pragma once
 
+#include <chrono>
 #include <map>
 
 #include "slang/ast/ASTContext.h"
@@ -47,6 +48,21 @@ public:
 
         /// The lookup location of the function call site.
         LookupLocation lookupLocation;
+
+        /// Bookkeeping for the constant evaluation profiler; only filled in
+        /// when profiling is enabled.
+        struct Profile {
+            /// The step count and time when the frame was pushed.
+            uint64_t startSteps = 0;
+            std::chrono::steady_clock::time_point startTime;
+
+            /// The steps and time taken by calls made from this frame.
+            uint64_t childSteps = 0;
+            std::chrono::nanoseconds childTime{};
+
+            /// Set if a time trace event was started for this frame.
+            bool traced = false;
+        } profile;
     };
 
     /// Constructs a new EvalContext instance.
@@ -85,6 +101,15 @@ public:
     /// Pop the active frame from the call stack.
     void popFrame();
 
+    /// Notes that a call to the given function was skipped because its
+    /// result was already memoized. The call is still charged one step and
+    /// checked against the maximum call depth, so that evaluation limits don't
+    /// depend on what earlier evaluations happened to memoize, and is recorded
+    /// for the constant evaluation profiler.
+    /// @returns false if one of those limits was exceeded.
+    [[nodiscard]] bool noteMemoizedCall(const SubroutineSymbol& subroutine,
+                                        SourceLocation callLocation);
+
     /// Pushes an lvalue onto the stack for later reference during evaluation.
     /// NOTE: the lvalue storage must remain alive for as long as it remains
     /// on the eval context's lvalue stack.
@@ -165,6 +190,9 @@ public:
     /// Gets the set of diagnostics that have been produced during constant evaluation.
     Diagnostics getAllDiagnostics() const;
 
+    /// Gets the number of diagnostics (including warnings) recorded so far.
+    size_t getDiagnosticCount() const { return diags.size() + warnings.size(); }
+
     /// Records a diagnostic under the current evaluation context.
     Diagnostic& addDiag(DiagCode code, SourceLocation location);
 
@@ -182,6 +210,8 @@ public:
 
 private:
     void reportDiags(Diagnostics& diagSet);
+    bool isProfiling() const;
+    void recordProfile(const Frame& frame);
 
     uint32_t steps = 0;
     const Symbol* disableTarget = nullptr;
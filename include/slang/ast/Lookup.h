@@ -11,6 +11,7 @@
 #include "slang/diagnostics/Diagnostics.h"
 #include "slang/syntax/SyntaxFwd.h"
 #include "slang/text/SourceLocation.h"
+#include "slang/util/IdentifierTable.h"
 #include "slang/util/Util.h"
 
 namespace slang::ast {
@@ -335,10 +336,10 @@ public:
 private:
     Lookup() = default;
 
-    static void unqualifiedImpl(const Scope& scope, std::string_view name, LookupLocation location,
-                                std::optional<SourceRange> sourceRange, bitmask<LookupFlags> flags,
-                                SymbolIndex outOfBlockIndex, LookupResult& result,
-                                const Scope& originalScope,
+    static void unqualifiedImpl(const Scope& scope, std::string_view name, IdentifierId nameId,
+                                LookupLocation location, std::optional<SourceRange> sourceRange,
+                                bitmask<LookupFlags> flags, SymbolIndex outOfBlockIndex,
+                                LookupResult& result, const Scope& originalScope,
                                 const syntax::SyntaxNode* originalSyntax);
 
     static void qualified(const syntax::ScopedNameSyntax& syntax, const ASTContext& context,
@@ -14,6 +14,7 @@
 #include "slang/ast/Symbol.h"
 #include "slang/diagnostics/Diagnostics.h"
 #include "slang/util/FlatMap.h"
+#include "slang/util/IdentifierTable.h"
 #include "slang/util/Iterator.h"
 #include "slang/util/Util.h"
 
@@ -32,7 +33,56 @@ class InstanceBodySymbol;
 class NetType;
 class WildcardImportSymbol;
 
-using SymbolMap = flat_hash_map<std::string_view, const Symbol*>;
+/// A map from names to the symbols that declare them. Names are keyed
+/// by their interned IdentifierId so that lookups hash and compare integers
+/// instead of strings; string overloads are provided for convenience and
+/// translate through the default IdentifierTable.
+class SLANG_EXPORT SymbolMap {
+    using MapType = flat_hash_map<IdentifierId, const Symbol*>;
+
+public:
+    using iterator = MapType::iterator;
+    using const_iterator = MapType::const_iterator;
+
+    iterator begin() { return map.begin(); }
+    iterator end() { return map.end(); }
+    const_iterator begin() const { return map.begin(); }
+    const_iterator end() const { return map.end(); }
+
+    size_t size() const { return map.size(); }
+    bool empty() const { return map.empty(); }
+
+    iterator find(IdentifierId id) { return map.find(id); }
+    const_iterator find(IdentifierId id) const { return map.find(id); }
+
+    iterator find(std::string_view name) { return map.find(idFor(name)); }
+    const_iterator find(std::string_view name) const { return map.find(idFor(name)); }
+
+    bool contains(IdentifierId id) const { return map.contains(id); }
+    bool contains(std::string_view name) const { return map.contains(idFor(name)); }
+
+    std::pair<iterator, bool> emplace(IdentifierId id, const Symbol* symbol) {
+        return map.emplace(id, symbol);
+    }
+
+    std::pair<iterator, bool> emplace(std::string_view name, const Symbol* symbol) {
+        return map.emplace(IdentifierTable::getDefault().intern(name), symbol);
+    }
+
+    std::pair<iterator, bool> try_emplace(std::string_view name, const Symbol* symbol) {
+        return map.try_emplace(IdentifierTable::getDefault().intern(name), symbol);
+    }
+
+private:
+    // Names that have never been interned can't be in the map; the Unknown
+    // ID they translate to is never inserted so lookups simply miss.
+    static IdentifierId idFor(std::string_view name) {
+        return IdentifierTable::getDefault().find(name);
+    }
+
+    MapType map;
+};
+
 using PointerMap = flat_hash_map<uintptr_t, uintptr_t>;
 
 /// Base class for symbols that represent a name scope; that is, they contain children and can
@@ -95,6 +145,10 @@ public:
     /// the given name, nullptr is returned.
     const Symbol* find(std::string_view name) const;
 
+    /// Finds a direct child member with the given interned name. This behaves
+    /// the same as the string overload but skips translating the name.
+    const Symbol* find(IdentifierId nameId) const;
+
     /// @brief Finds a direct child member with the given name.
     ///
     /// This won't return anything weird like forwarding typedefs or imported symbols,
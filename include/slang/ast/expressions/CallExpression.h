@@ -89,11 +89,21 @@ public:
     bool hasOutputArgs() const;
 
     ConstantValue evalImpl(EvalContext& context) const;
+
+    /// Evaluates a call of a user-defined subroutine with the given, already
+    /// evaluated, argument values. The values are consumed by the call.
+    ConstantValue evalSubroutine(EvalContext& context, std::span<ConstantValue> args) const;
+
     std::optional<bitwidth_t> getEffectiveWidthImpl() const;
     EffectiveSign getEffectiveSignImpl(bool isForConversion) const;
 
     void serializeTo(ASTSerializer& serializer) const;
 
+    /// Checks whether the given subroutine can be invoked in a constant expression,
+    /// issuing diagnostics to the eval context if not.
+    static bool checkConstant(EvalContext& context, const SubroutineSymbol& subroutine,
+                              SourceRange range);
+
     static Expression& fromSyntax(Compilation& compilation,
                                   const syntax::InvocationExpressionSyntax& syntax,
                                   const syntax::ArrayOrRandomizeMethodExpressionSyntax* withClause,
@@ -172,9 +182,6 @@ private:
         const syntax::ArrayOrRandomizeMethodExpressionSyntax* withClause, SourceRange range,
         const ASTContext& context, const Scope* randomizeScope = nullptr);
 
-    static bool checkConstant(EvalContext& context, const SubroutineSymbol& subroutine,
-                              SourceRange range);
-
     const Expression* thisClass_;
     std::span<const Expression*> arguments_;
     LookupLocation lookupLocation;
@@ -57,6 +57,10 @@ public:
         selector().visit(visitor);
     }
 
+    /// @returns true if an out of bounds index was already reported when
+    /// the expression was created, so evaluation shouldn't report it again.
+    bool hasWarnedAboutIndex() const { return warnedAboutIndex; }
+
 private:
     Expression* value_;
     const Expression* selector_;
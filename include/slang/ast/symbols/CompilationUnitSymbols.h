@@ -61,6 +61,10 @@ public:
     /// exported from the package.
     const Symbol* findForImport(std::string_view name) const;
 
+    /// Searches for a symbol by interned name, in the context of importing
+    /// from the package.
+    const Symbol* findForImport(IdentifierId nameId) const;
+
     void checkExplicitExports() const;
 
     void serializeTo(ASTSerializer&) const {}
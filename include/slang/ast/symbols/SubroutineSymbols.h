@@ -14,6 +14,7 @@
 
 namespace slang::ast {
 
+class EvalBytecode;
 class FormalArgumentSymbol;
 class Statement;
 class StatementBlockSymbol;
@@ -125,6 +126,18 @@ public:
     const Statement& getBody() const;
     const Type& getReturnType() const { return declaredReturnType.getType(); }
 
+    /// Gets the bytecode form of the body used for constant evaluation, compiling
+    /// it on first use. Returns nullptr if the body should be evaluated directly.
+    const EvalBytecode* getBytecode() const;
+
+    /// Returns true if the result of calling the subroutine during constant
+    /// evaluation is determined entirely by its argument values, which means
+    /// that results can be memoized and shared between call sites. This requires
+    /// that it be a function without output arguments, that it not reference
+    /// anything other than its own locals and constants, and that the same
+    /// hold for all other subroutines it calls.
+    bool isMemoizable() const;
+
     void setOverride(const SubroutineSymbol& parentMethod) const;
     const SubroutineSymbol* getOverride() const { return overrides; }
 
@@ -185,6 +198,8 @@ private:
     mutable const SubroutineSymbol* overrides = nullptr;
     mutable const MethodPrototypeSymbol* prototype = nullptr;
     mutable std::optional<bool> cachedHasOutputArgs;
+    mutable std::optional<const EvalBytecode*> bytecode;
+    mutable std::optional<bool> cachedIsMemoizable;
     mutable bool isConstructing = false;
 };
 
@@ -42,6 +42,9 @@ namespace slang::analysis {
 
 class AnalysisManager;
 enum class AnalysisFlags;
+enum class CaseAnalysisEngine : int;
+enum class LoopAnalysisMode : int;
+struct AnalysisOptions;
 
 } // namespace slang::analysis
 
@@ -270,9 +273,15 @@ public:
         /// The maximum number of steps to take when analyzing a case statement.
         std::optional<uint32_t> maxCaseAnalysisSteps;
 
+        /// The engine to use when analyzing wildcard case statements.
+        std::optional<analysis::CaseAnalysisEngine> caseAnalysisEngine;
+
         /// The maximum number of steps to take when analyzing a loop statement.
         std::optional<uint32_t> maxLoopAnalysisSteps;
 
+        /// The way in which for loops are analyzed.
+        std::optional<analysis::LoopAnalysisMode> loopAnalysisMode;
+
         /// @}
 
         /// Returns true if the lintMode option is provided.
@@ -397,11 +406,27 @@ public:
     /// @returns true if compilation succeeded and false if errors were encountered.
     [[nodiscard]] bool runFullCompilation(bool quiet = false);
 
+    /// @brief Elaborates the loaded design once for each of the given parameter sweeps
+    /// and reports the results.
+    ///
+    /// Each entry in @a sweeps is a string of additional `--top` and `-G` options that
+    /// select the top modules and parameter overrides for that run. Overrides are added
+    /// to those given on the main command line, and top modules replace them if present.
+    /// All sweeps share the already parsed syntax trees via @a ast::Compilation::fork
+    /// and run concurrently on a thread pool sized by the `--threads` option.
+    ///
+    /// If @a analyze is true, post-elaboration analysis is run for each sweep as well.
+    /// If @a quiet is set to true, non-essential output will be suppressed.
+    /// @returns true if all sweeps succeeded and false if errors were encountered.
+    [[nodiscard]] bool runSweeps(std::span<const std::string> sweeps, bool analyze,
+                                 bool quiet = false);
+
 private:
     bool parseUnitListing(std::string_view text);
     void addLibraryFiles(std::string_view pattern);
     void addParseOptions(Bag& bag) const;
     void addCompilationOptions(Bag& bag) const;
+    analysis::AnalysisOptions createAnalysisOptions() const;
     bool reportLoadErrors();
     void printError(const std::string& message);
     void printWarning(const std::string& message);
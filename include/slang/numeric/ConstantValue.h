@@ -7,6 +7,7 @@
 //------------------------------------------------------------------------------
 #pragma once
 
+#include <atomic>
 #include <deque>
 #include <map>
 #include <string>
@@ -15,12 +16,16 @@
 
 #include "slang/numeric/SVInt.h"
 #include "slang/util/CopyPtr.h"
+#include "slang/util/FlatMap.h"
+#include "slang/util/Function.h"
 #include "slang/util/Iterator.h"
 
 namespace slang {
 
 struct AssociativeArray;
+struct SVDenseArray;
 struct SVQueue;
+struct SVRunArray;
 struct SVUnion;
 
 /// Represents an IEEE754 double precision floating point number.
@@ -61,9 +66,12 @@ public:
     using Map = CopyPtr<AssociativeArray>;
     using Queue = CopyPtr<SVQueue>;
     using Union = CopyPtr<SVUnion>;
+    using DenseArray = CopyPtr<SVDenseArray>;
+    using RunArray = CopyPtr<SVRunArray>;
 
     using Variant = std::variant<std::monostate, SVInt, real_t, shortreal_t, NullPlaceholder,
-                                 Elements, std::string, Map, Queue, Union, UnboundedPlaceholder>;
+                                 Elements, std::string, Map, Queue, Union, UnboundedPlaceholder,
+                                 DenseArray, RunArray>;
 
     ConstantValue() = default;
     ConstantValue(nullptr_t) {}
@@ -95,6 +103,16 @@ public:
     ConstantValue(const SVUnion& unionVal) : value(Union(unionVal)) {}
     ConstantValue(SVUnion&& unionVal) : value(Union(std::move(unionVal))) {}
 
+    ConstantValue(const DenseArray& dense) : value(dense) {}
+    ConstantValue(DenseArray&& dense) : value(std::move(dense)) {}
+    ConstantValue(const SVDenseArray& dense) : value(DenseArray(dense)) {}
+    ConstantValue(SVDenseArray&& dense) : value(DenseArray(std::move(dense))) {}
+
+    ConstantValue(const RunArray& runs) : value(runs) {}
+    ConstantValue(RunArray&& runs) : value(std::move(runs)) {}
+    ConstantValue(const SVRunArray& runs) : value(RunArray(runs)) {}
+    ConstantValue(SVRunArray&& runs) : value(RunArray(std::move(runs))) {}
+
     bool bad() const { return std::holds_alternative<std::monostate>(value); }
     explicit operator bool() const { return !bad(); }
 
@@ -103,11 +121,15 @@ public:
     bool isShortReal() const { return std::holds_alternative<shortreal_t>(value); }
     bool isNullHandle() const { return std::holds_alternative<NullPlaceholder>(value); }
     bool isUnbounded() const { return std::holds_alternative<UnboundedPlaceholder>(value); }
-    bool isUnpacked() const { return std::holds_alternative<Elements>(value); }
+    bool isUnpacked() const {
+        return std::holds_alternative<Elements>(value) || isDenseArray() || isRunArray();
+    }
     bool isString() const { return std::holds_alternative<std::string>(value); }
     bool isMap() const { return std::holds_alternative<Map>(value); }
     bool isQueue() const { return std::holds_alternative<Queue>(value); }
     bool isUnion() const { return std::holds_alternative<Union>(value); }
+    bool isDenseArray() const { return std::holds_alternative<DenseArray>(value); }
+    bool isRunArray() const { return std::holds_alternative<RunArray>(value); }
 
     bool isContainer() const { return isUnpacked() || isQueue() || isMap(); }
 
@@ -119,8 +141,23 @@ public:
     real_t real() const { return std::get<real_t>(value); }
     shortreal_t shortReal() const { return std::get<shortreal_t>(value); }
 
-    std::span<ConstantValue> elements() { return std::get<Elements>(value); }
-    std::span<ConstantValue const> elements() const { return std::get<Elements>(value); }
+    /// Gets the elements of an unpacked array or struct. If the value is a dense
+    /// or run-length array it is first converted in place to hold a separate
+    /// value per element.
+    std::span<ConstantValue> elements();
+
+    /// Gets the elements of an unpacked array or struct. Dense and run-length
+    /// arrays hand out a lazily built copy of all of their elements, leaving
+    /// their compact storage intact; prefer @a elementAt or @a forEachElement,
+    /// which only ever build one element at a time.
+    std::span<ConstantValue const> elements() const;
+
+    /// Gets a copy of the element at the given index of an unpacked array,
+    /// struct, or queue, which must be in bounds.
+    ConstantValue elementAt(size_t index) const;
+
+    /// Calls @a func with each element of an unpacked array, struct, or queue, in order.
+    void forEachElement(function_ref<void(const ConstantValue&)> func) const;
 
     std::string& str() & { return std::get<std::string>(value); }
     const std::string& str() const& { return std::get<std::string>(value); }
@@ -142,6 +179,16 @@ public:
     Union unionVal() && { return std::get<Union>(std::move(value)); }
     Union unionVal() const&& { return std::get<Union>(std::move(value)); }
 
+    DenseArray& denseArray() & { return std::get<DenseArray>(value); }
+    const DenseArray& denseArray() const& { return std::get<DenseArray>(value); }
+    DenseArray denseArray() && { return std::get<DenseArray>(std::move(value)); }
+    DenseArray denseArray() const&& { return std::get<DenseArray>(std::move(value)); }
+
+    RunArray& runArray() & { return std::get<RunArray>(value); }
+    const RunArray& runArray() const& { return std::get<RunArray>(value); }
+    RunArray runArray() && { return std::get<RunArray>(std::move(value)); }
+    RunArray runArray() const&& { return std::get<RunArray>(std::move(value)); }
+
     ConstantValue getSlice(int32_t upper, int32_t lower, const ConstantValue& defaultValue) const;
 
     Variant& getVariant() { return value; }
@@ -186,10 +233,170 @@ private:
     Variant value;
 };
 
+/// Holds a lazily built value derived from the contents of some constant, such as
+/// a copy of the individual elements of one of the compact array representations
+/// below. Constant values can be shared between threads, so building the value is
+/// safe to race; copies of the owning object start out with an empty cache.
+template<typename T>
+class LazyCache {
+public:
+    LazyCache() = default;
+    LazyCache(const LazyCache&) {}
+    LazyCache(LazyCache&& other) noexcept : ptr(other.ptr.exchange(nullptr)) {}
+    ~LazyCache() { clear(); }
+
+    LazyCache& operator=(const LazyCache& other) {
+        if (this != &other)
+            clear();
+        return *this;
+    }
+
+    LazyCache& operator=(LazyCache&& other) noexcept {
+        if (this != &other) {
+            clear();
+            ptr = other.ptr.exchange(nullptr);
+        }
+        return *this;
+    }
+
+    /// Gets the cached value, calling @a build to create it if needed.
+    const T& get(function_ref<T()> build) const {
+        if (auto val = ptr.load(std::memory_order_acquire))
+            return *val;
+
+        // If we race with someone else to build the value the loser throws theirs away.
+        auto val = new T(build());
+        T* expected = nullptr;
+        if (!ptr.compare_exchange_strong(expected, val, std::memory_order_acq_rel)) {
+            delete val;
+            return *expected;
+        }
+        return *val;
+    }
+
+    /// Throws away the cached value, if there is one.
+    void clear() { delete ptr.exchange(nullptr, std::memory_order_acq_rel); }
+
+private:
+    mutable std::atomic<T*> ptr = nullptr;
+};
+
+using ElementCache = LazyCache<ConstantValue::Elements>;
+
 /// Represents a SystemVerilog associative array, for use during constant evaluation.
-struct SLANG_EXPORT AssociativeArray : public std::map<ConstantValue, ConstantValue> {
-    using std::map<ConstantValue, ConstantValue>::map;
+/// Entries live in a hash table keyed on the index value, so building up and looking
+/// things up in large tables doesn't walk a tree of value comparisons. Iterating visits
+/// the entries in index order, as the language requires; that order is worked out
+/// lazily the first time it's needed after the set of indices changes.
+struct SLANG_EXPORT AssociativeArray {
+    using value_type = std::pair<const ConstantValue, ConstantValue>;
+
+    /// Hashes index values. Integer indices hash just their value, so that indices
+    /// of different widths (which can be mixed in wildcard-indexed arrays) that
+    /// compare equal also hash the same.
+    struct SLANG_EXPORT KeyHash {
+        size_t operator()(const ConstantValue& key) const;
+    };
+
+    /// Compares index values for equality, consistent with KeyHash. Integer indices
+    /// are compared as unsigned values of their own widths, which is how indices of
+    /// wildcard-indexed arrays are treated; all other arrays convert their indices
+    /// to a single index type first.
+    struct SLANG_EXPORT KeyEqual {
+        bool operator()(const ConstantValue& lhs, const ConstantValue& rhs) const;
+    };
+
+    using Table = flat_hash_map<ConstantValue, ConstantValue, KeyHash, KeyEqual>;
+
+private:
+    using Order = std::vector<value_type*>;
+
+    template<bool IsConst>
+    class Iterator : public iterator_facade<Iterator<IsConst>> {
+    public:
+        using Ref = std::conditional_t<IsConst, const value_type&, value_type&>;
+
+        Iterator() = default;
+        Iterator(Order::const_iterator it) : it(it) {}
+
+        template<bool C = IsConst>
+            requires C
+        Iterator(const Iterator<false>& other) : it(other.it) {}
+
+        Ref dereference() const { return **it; }
+        void increment() { ++it; }
+        void decrement() { --it; }
+        bool equals(const Iterator& other) const { return it == other.it; }
+
+    private:
+        template<bool>
+        friend class Iterator;
+
+        Order::const_iterator it;
+    };
+
+public:
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    /// The value returned for lookups of indices that aren't in the array,
+    /// if the array has one specified.
     ConstantValue defaultValue;
+
+    AssociativeArray() = default;
+
+    size_t size() const { return table.size(); }
+    bool empty() const { return table.empty(); }
+
+    /// Looks up the value stored for the given index, or returns nullptr
+    /// if there is no such entry.
+    ConstantValue* find(const ConstantValue& key);
+
+    /// Looks up the value stored for the given index, or returns nullptr
+    /// if there is no such entry.
+    const ConstantValue* find(const ConstantValue& key) const;
+
+    /// Determines whether there is an entry for the given index.
+    bool contains(const ConstantValue& key) const { return table.contains(key); }
+
+    /// Inserts an entry for the given index if there isn't one already.
+    /// @returns the value stored for the index and whether it was inserted.
+    std::pair<ConstantValue*, bool> try_emplace(ConstantValue key, ConstantValue value);
+
+    /// Removes the entry for the given index, if there is one.
+    void erase(const ConstantValue& key);
+
+    /// Removes all entries.
+    void clear();
+
+    iterator begin() { return getOrder().begin(); }
+    iterator end() { return getOrder().end(); }
+    const_iterator begin() const { return getOrder().begin(); }
+    const_iterator end() const { return getOrder().end(); }
+
+    reverse_iterator rbegin() { return reverse_iterator(end()); }
+    reverse_iterator rend() { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+    /// Gets the first entry (in index order) whose index is not less than @a key.
+    const_iterator lower_bound(const ConstantValue& key) const;
+
+    /// Gets the first entry (in index order) whose index is greater than @a key.
+    const_iterator upper_bound(const ConstantValue& key) const;
+
+    SLANG_EXPORT friend bool operator==(const AssociativeArray& lhs, const AssociativeArray& rhs);
+    SLANG_EXPORT friend std::partial_ordering operator<=>(const AssociativeArray& lhs,
+                                                          const AssociativeArray& rhs);
+
+private:
+    const Order& getOrder() const;
+    void changed() { order.clear(); }
+
+    Table table;
+    LazyCache<Order> order;
 };
 
 /// Represents a SystemVerilog queue, for use during constant evaluation.
@@ -209,6 +416,152 @@ struct SLANG_EXPORT SVUnion {
     std::optional<uint32_t> activeMember;
 };
 
+/// Represents a SystemVerilog unpacked array of fixed width integral elements, for
+/// use during constant evaluation. Instead of holding a separate ConstantValue per
+/// element, the bits of all elements are laid end to end in a single SVInt, with
+/// element zero in the most significant bits (the order they take in a bit-stream).
+/// As with any other SVInt, the unknown plane is only present while some of the
+/// bits are actually unknown.
+struct SLANG_EXPORT SVDenseArray {
+    /// The bits of all of the elements.
+    SVInt bits;
+
+    /// The width of each element.
+    bitwidth_t elementWidth;
+
+    /// Whether the elements are signed.
+    bool elementSigned;
+
+    /// The minimum number of elements an array needs before it gets
+    /// stored densely; smaller arrays aren't worth the trouble.
+    static constexpr size_t MinElements = 64;
+
+    SVDenseArray(SVInt bits, bitwidth_t elementWidth, bool elementSigned);
+
+    /// Gets the number of elements in the array.
+    size_t size() const { return bits.getBitWidth() / elementWidth; }
+
+    /// Gets the index of the least significant bit of the given element in @a bits.
+    int32_t getElementLsb(size_t index) const {
+        return int32_t((size() - index - 1) * elementWidth);
+    }
+
+    /// Gets the value of the element at the given index.
+    SVInt get(size_t index) const;
+
+    /// Sets the value of the element at the given index. The value must
+    /// already be of the element's width.
+    void set(size_t index, const SVInt& value);
+
+    /// Assigns to a range of bits in @a bits, which can cover part of one
+    /// element or any number of consecutive whole elements.
+    void setBits(int32_t msb, int32_t lsb, const SVInt& value);
+
+    /// Gets a copy of the array with one ConstantValue per element.
+    ConstantValue::Elements toElements() const;
+
+    /// Gets the elements as individual values. The result is built on first
+    /// use and is kept around until the array is next modified.
+    const ConstantValue::Elements& elements() const;
+
+    /// Creates a dense array of the given number of elements, all of which are
+    /// either X (for 4-state elements) or zero.
+    static SVDenseArray createFilled(size_t count, bitwidth_t elementWidth, bool elementSigned,
+                                     bool fourState);
+
+    /// Determines whether an array with the given shape can be stored densely.
+    static bool canStore(size_t count, bitwidth_t elementWidth);
+
+    /// Packs the given elements into a dense array if they are all integers of
+    /// the same width and signedness and there are enough of them to be worth
+    /// it. Otherwise the elements are returned as they are.
+    static ConstantValue pack(ConstantValue::Elements&& elements);
+
+private:
+    ElementCache cache;
+};
+
+/// Represents a SystemVerilog unpacked or dynamic array, for use during constant
+/// evaluation, whose elements mostly come in long runs of the same value, such as
+/// arrays created from a default value or a replication. Each run holds its value
+/// once, so a million element memory filled with zeros costs a single element.
+/// Writing to an element splits its run; once enough writes have broken the runs
+/// up the array should be converted back with expand().
+struct SLANG_EXPORT SVRunArray {
+    /// A run of consecutive elements that all have the same value.
+    struct Run {
+        /// The value of each element in the run.
+        ConstantValue value;
+
+        /// The index one past the last element of the run.
+        size_t end;
+    };
+
+    /// The runs, in element order.
+    std::vector<Run> runs;
+
+    /// The minimum number of elements an array needs before it gets
+    /// stored as runs; smaller arrays aren't worth the trouble.
+    static constexpr size_t MinElements = 64;
+
+    /// The average run length below which the array is considered fragmented.
+    static constexpr size_t MinAverageRun = 8;
+
+    /// The number of runs above which the array is considered fragmented no
+    /// matter how long they are, since splitting a run costs time linear in
+    /// the number of runs that follow it.
+    static constexpr size_t MaxRuns = 1024;
+
+    SVRunArray() = default;
+    SVRunArray(size_t count, ConstantValue value);
+
+    /// Gets the number of elements in the array.
+    size_t size() const { return runs.empty() ? 0 : runs.back().end; }
+
+    /// Gets the value of the element at the given index.
+    const ConstantValue& get(size_t index) const;
+
+    /// Gets the element at the given index for writing, splitting
+    /// it off into its own run first if necessary.
+    ConstantValue& getForWrite(size_t index);
+
+    /// Adds @a count copies of the given value to the end of the array,
+    /// extending the last run if it already has the same value.
+    void append(ConstantValue value, size_t count);
+
+    /// Gets a copy of the given range of elements, which must be in bounds.
+    ConstantValue slice(size_t lower, size_t upper) const;
+
+    /// Determines whether writes have broken the array up into so many
+    /// small runs that a plain representation would be better.
+    bool isFragmented() const {
+        return runs.size() > MaxRuns || runs.size() * MinAverageRun > size();
+    }
+
+    /// Gets a copy of the array with one ConstantValue per element.
+    ConstantValue::Elements toElements() const;
+
+    /// Converts the array to the best representation that isn't run-length
+    /// encoded, which is a dense array if the elements are integers.
+    ConstantValue expand() const;
+
+    /// Gets the elements as individual values. The result is built on first
+    /// use and is kept around until the array is next modified.
+    const ConstantValue::Elements& elements() const;
+
+    /// Creates an array of @a count copies of the given value, which is stored
+    /// as runs if there are enough elements to make it worth doing.
+    static ConstantValue createFilled(size_t count, const ConstantValue& value);
+
+    /// Converts the array into whichever representation suits it best: itself, if
+    /// it is large enough and its runs are long enough, or otherwise the result
+    /// of expand().
+    ConstantValue finish() &&;
+
+private:
+    ElementCache cache;
+};
+
 /// An iterator for child elements in a ConstantValue, if it represents an
 /// array, map, or queue.
 template<bool IsConst>
@@ -266,6 +619,17 @@ private:
 template<typename TValue, bool IsConst = std::is_const_v<TValue>>
     requires std::is_same_v<std::remove_cvref_t<TValue>, ConstantValue>
 CVIterator<IsConst> begin(TValue& cv) {
+    if (cv.isDenseArray() || cv.isRunArray()) {
+        if constexpr (IsConst) {
+            auto& elems = cv.isDenseArray() ? cv.denseArray()->elements()
+                                            : cv.runArray()->elements();
+            return elems.begin();
+        }
+        else {
+            cv.elements();
+        }
+    }
+
     return std::visit(
         [](auto&& arg) -> CVIterator<IsConst> {
             using T = std::decay_t<decltype(arg)>;
@@ -286,6 +650,17 @@ CVIterator<IsConst> begin(TValue& cv) {
 template<typename TValue, bool IsConst = std::is_const_v<TValue>>
     requires std::is_same_v<std::remove_cvref_t<TValue>, ConstantValue>
 CVIterator<IsConst> end(TValue& cv) {
+    if (cv.isDenseArray() || cv.isRunArray()) {
+        if constexpr (IsConst) {
+            auto& elems = cv.isDenseArray() ? cv.denseArray()->elements()
+                                            : cv.runArray()->elements();
+            return elems.end();
+        }
+        else {
+            cv.elements();
+        }
+    }
+
     return std::visit(
         [](auto&& arg) -> CVIterator<IsConst> {
             using T = std::decay_t<decltype(arg)>;
@@ -116,18 +116,31 @@ struct SLANG_EXPORT logic_t {
 /// large bit widths.
 class SLANG_EXPORT SVIntStorage {
 public:
-    SVIntStorage() : val(0), bitWidth(1), signFlag(false), unknownFlag(false) {}
+    /// The number of 64-bit words that are stored inline, without
+    /// needing a separate allocation.
+    static constexpr uint32_t INLINE_WORDS = 2;
+
+    SVIntStorage() : inlineWords{}, bitWidth(1), signFlag(false), unknownFlag(false) {}
     SVIntStorage(bitwidth_t bits, bool signFlag, bool unknownFlag) :
-        val(0), bitWidth(bits), signFlag(signFlag), unknownFlag(unknownFlag) {}
+        inlineWords{}, bitWidth(bits), signFlag(signFlag), unknownFlag(unknownFlag) {}
     SVIntStorage(uint64_t* data, bitwidth_t bits, bool signFlag, bool unknownFlag) :
         pVal(data), bitWidth(bits), signFlag(signFlag), unknownFlag(unknownFlag) {}
 
-    // 64 bits of value data; if bits > 64, we allocate words on the heap to hold
-    // the values. If we have unknown values (X or Z) we allocate double the number
-    // of data words, with the extra set indicating X or Z for each particular bit.
+    /// Indicates whether the value's words are stored in @a inlineWords
+    /// rather than being pointed to by @a pVal. This is the case for
+    /// 2-state values up to 128 bits and 4-state values up to 64 bits.
+    bool isInline() const {
+        return bitWidth <= 64 || (bitWidth <= 64 * INLINE_WORDS && !unknownFlag);
+    }
+
+    // Values that need more than two 64-bit words of storage (including the
+    // unknown words) are kept elsewhere and pointed to by pVal. If we have unknown
+    // values (X or Z) there are double the number of data words, with the extra
+    // set indicating X or Z for each particular bit.
     union {
-        uint64_t val;   // value used when bits <= 64
-        uint64_t* pVal; // value used when bits > 64
+        uint64_t val;                       // value used when bits <= 64 and no unknowns
+        uint64_t inlineWords[INLINE_WORDS]; // words used when isInline() is true
+        uint64_t* pVal;                     // words used when isInline() is false
     };
 
     bitwidth_t bitWidth; // number of bits in the integer
@@ -144,10 +157,12 @@ public:
 /// Additionally, SVInt can represent a 4-state value, where each bit can take on additional
 /// states of X and Z.
 ///
-/// Small integer values that fit within 64 bits are kept in a simple native integer. Otherwise,
-/// space is allocated on the heap. If there are any unknown bits in the number, an extra set of
-/// words are allocated adjacent in memory. The bits in these extra words indicate whether the
-/// corresponding bits in the low words are unknown or normal.
+/// Small integer values that fit within 64 bits are kept in a simple native integer. If there
+/// are any unknown bits in the number, an extra set of words are stored adjacent in memory.
+/// The bits in these extra words indicate whether the corresponding bits in the low words
+/// are unknown or normal. Values that need no more than two words in total (2-state values
+/// up to 128 bits and 4-state values up to 64 bits) are stored inline in the object;
+/// otherwise, space is allocated on the heap.
 ///
 class SLANG_EXPORT SVInt : SVIntStorage {
 public:
@@ -209,7 +224,7 @@ public:
     }
 
     ~SVInt() {
-        if (!isSingleWord())
+        if (!isInline())
             delete[] pVal;
     }
 
@@ -217,8 +232,8 @@ public:
     SVInt(const SVInt& other) : SVInt(static_cast<const SVIntStorage&>(other)) {}
     SVInt(const SVIntStorage& other) :
         SVIntStorage(other.bitWidth, other.signFlag, other.unknownFlag) {
-        if (isSingleWord())
-            val = other.val;
+        if (isInline())
+            copyInline(other);
         else
             initSlowCase(other);
     }
@@ -226,8 +241,8 @@ public:
     /// Move construct.
     SVInt(SVInt&& other) noexcept :
         SVIntStorage(other.bitWidth, other.signFlag, other.unknownFlag) {
-        if (isSingleWord())
-            val = other.val;
+        if (isInline())
+            copyInline(other);
         else
             pVal = std::exchange(other.pVal, nullptr);
     }
@@ -243,7 +258,7 @@ public:
     uint32_t getNumWords() const { return getNumWords(bitWidth, unknownFlag); }
 
     /// Gets a pointer to the underlying numeric data.
-    const uint64_t* getRawPtr() const { return isSingleWord() ? &val : pVal; }
+    const uint64_t* getRawPtr() const { return isInline() ? inlineWords : pVal; }
 
     /// Checks whether it's possible to convert the value to a simple built-in
     /// integer type and if so returns it.
@@ -423,9 +438,15 @@ public:
     /// Reverses the bit ordering of the number.
     [[nodiscard]] SVInt reverse() const;
 
+    /// Reverses the order of the slices of the given width that make up the number,
+    /// keeping the bits within each slice in their original order. Slices are formed
+    /// starting from the least significant bit; the first slice is @a lsbSliceWidth
+    /// bits wide, and the most significant slice may be narrower than @a sliceWidth.
+    [[nodiscard]] SVInt reverseSlices(bitwidth_t sliceWidth, bitwidth_t lsbSliceWidth) const;
+
     SVInt& operator=(const SVInt& rhs) {
-        if (isSingleWord() && rhs.isSingleWord()) {
-            val = rhs.val;
+        if (isInline() && rhs.isInline()) {
+            copyInline(rhs);
             bitWidth = rhs.bitWidth;
             signFlag = rhs.signFlag;
             unknownFlag = rhs.unknownFlag;
@@ -438,16 +459,20 @@ public:
         if (this == &rhs)
             return *this;
 
-        if (!isSingleWord())
+        if (!isInline())
             delete[] pVal;
 
-        val = rhs.val;
+        if (rhs.isInline()) {
+            copyInline(rhs);
+        }
+        else {
+            // prevent the other object from releasing memory
+            pVal = std::exchange(rhs.pVal, nullptr);
+        }
+
         bitWidth = rhs.bitWidth;
         signFlag = rhs.signFlag;
         unknownFlag = rhs.unknownFlag;
-
-        // prevent the other object from releasing memory
-        rhs.pVal = nullptr;
         return *this;
     }
 
@@ -538,6 +563,14 @@ public:
     /// Concatenates one or more integers into one output integer.
     static SVInt concat(std::span<SVInt const> operands);
 
+    /// Controls whether operations on wide values use the vectorized word kernels
+    /// supported by the host CPU (the default) or the portable scalar ones.
+    /// This is mostly useful for testing and benchmarking.
+    static void setVectorizedKernels(bool enabled);
+
+    /// Gets the name of the word kernel implementation currently in use.
+    static std::string_view getKernelName();
+
     /// Stream formatting operator. Guesses a nice base to use and writes the string representation
     /// into the stream.
     SLANG_EXPORT friend std::ostream& operator<<(std::ostream& os, const SVInt& rhs);
@@ -586,8 +619,22 @@ private:
     void initSlowCase(std::span<const byte> bytes);
     void initSlowCase(const SVIntStorage& other);
 
-    uint64_t* getRawData() { return isSingleWord() ? &val : pVal; }
-    const uint64_t* getRawData() const { return isSingleWord() ? &val : pVal; }
+    uint64_t* getRawData() { return isInline() ? inlineWords : pVal; }
+    const uint64_t* getRawData() const { return isInline() ? inlineWords : pVal; }
+
+    void copyInline(const SVIntStorage& other) {
+        inlineWords[0] = other.inlineWords[0];
+        inlineWords[1] = other.inlineWords[1];
+    }
+
+    // Allocates heap storage if the current bit width and unknown flag need it,
+    // and returns a pointer to the (uninitialized) words. Any previous heap
+    // storage must have already been released.
+    uint64_t* allocData();
+
+    // Switches the value between 2-state and 4-state storage, keeping the value
+    // words intact and clearing any newly added unknown words.
+    void changeUnknownStorage(bool unknown);
 
     // Slow cases for assignment, equality checking, and counting leading zeros.
     SVInt& assignSlowCase(const SVInt& other);
@@ -607,6 +654,10 @@ private:
     void checkUnknown();
     void makeUnknown();
 
+    // Same as checkUnknown, but starts looking for remaining unknown bits at the
+    // given word and works outward from there.
+    void checkUnknownNear(uint32_t word);
+
     // $unsigned(*this) value saturated at bitwidth_t::max()
     bitwidth_t unsignedAmount() const;
 
@@ -631,6 +682,14 @@ private:
     static void divide(const SVInt& lhs, uint32_t lhsWords, const SVInt& rhs, uint32_t rhsWords,
                        SVInt* quotient, SVInt* remainder);
 
+    // Division by multiplying with a Newton-Raphson reciprocal, for very wide values.
+    static void newtonDivide(const SVInt& lhs, const SVInt& rhs, SVInt* quotient,
+                             SVInt* remainder);
+
+    // Approximates 2^(n - 1 + precision) / divisor, where n is the number of active bits
+    // in the divisor, to within a few units in the last place.
+    static SVInt newtonReciprocal(const SVInt& divisor, bitwidth_t precision);
+
     // Unsigned division algorithm.
     static SVInt udiv(const SVInt& lhs, const SVInt& rhs, bool bothSigned);
 
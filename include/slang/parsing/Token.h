@@ -12,6 +12,7 @@
 #include "slang/parsing/KnownSystemName.h"
 #include "slang/parsing/TokenKind.h"
 #include "slang/text/SourceLocation.h"
+#include "slang/util/IdentifierTable.h"
 #include "slang/util/SmallVector.h"
 #include "slang/util/Util.h"
 
@@ -178,6 +179,10 @@ public:
     syntax::SyntaxKind directiveKind() const;
     KnownSystemName systemName() const;
 
+    /// Gets the interned ID of the identifier's value text.
+    /// Only valid for identifier tokens.
+    IdentifierId identifierId() const;
+
     /// Returns true if this token is on the same line as the token before it.
     /// This is detected by examining the leading trivia of this token for newlines.
     bool isOnSameLine() const;
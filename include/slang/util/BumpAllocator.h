@@ -88,6 +88,15 @@ public:
 #endif
     }
 
+    /// Gets the number of bytes that have been handed out by the allocator,
+    /// including any padding inserted to satisfy alignment requirements.
+    /// This walks the list of segments so it is not intended for hot paths.
+    size_t getBytesUsed() const;
+
+    /// Gets the number of bytes of memory the allocator has obtained from
+    /// the system, which includes space that has not yet been handed out.
+    size_t getBytesReserved() const { return bytesReserved; }
+
 protected:
     // Allocations are tracked as a linked list of segments.
     struct Segment {
@@ -97,6 +106,7 @@ protected:
 
     Segment* head;
     byte* endPtr;
+    size_t bytesReserved = 0;
 #if SLANG_ASSERT_ENABLED
     bool frozen = false;
 #endif
@@ -7,6 +7,8 @@
 //------------------------------------------------------------------------------
 #pragma once
 
+#include <atomic>
+
 #include "slang/util/Hash.h"
 
 #define BOOST_UNORDERED_DISABLE_PARALLEL_ALGORITHMS
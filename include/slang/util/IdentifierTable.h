@@ -0,0 +1,75 @@
+//------------------------------------------------------------------------------
+//! @file IdentifierTable.h
+//! @brief Thread-safe interning of identifier names
+//
+// SPDX-FileCopyrightText: Michael Popoloski
+// SPDX-License-Identifier: MIT
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <memory>
+#include <string_view>
+
+#include "slang/util/Util.h"
+
+namespace slang {
+
+/// A stable integer handle for an interned identifier name.
+/// Two identifiers with the same text always map to the same ID.
+enum class IdentifierId : uint32_t {
+    /// The ID of the empty name.
+    Empty = 0,
+
+    /// A sentinel ID indicating that a name has never been interned,
+    /// and therefore cannot be the name of any symbol.
+    Unknown = UINT32_MAX
+};
+
+/// A thread-safe table that interns identifier names and assigns each
+/// distinct name a stable integer ID. Identifier tokens are interned
+/// as they are created by the lexer, which allows name-keyed tables in
+/// the AST to hash and compare integers instead of strings.
+///
+/// IDs are stable for the lifetime of the table and are shared by all
+/// syntax trees and compilations that use it.
+class SLANG_EXPORT IdentifierTable {
+public:
+    IdentifierTable();
+    ~IdentifierTable();
+    IdentifierTable(const IdentifierTable&) = delete;
+    IdentifierTable& operator=(const IdentifierTable&) = delete;
+
+    /// Interns the given name, returning its ID. If the name has been
+    /// seen before the existing ID is returned.
+    IdentifierId intern(std::string_view name);
+
+    /// Looks up the ID for the given name without interning it.
+    /// Returns IdentifierId::Unknown if the name has never been interned.
+    IdentifierId find(std::string_view name) const;
+
+    /// Gets the text of the given interned identifier.
+    std::string_view getText(IdentifierId id) const;
+
+    /// Gets the number of distinct names that have been interned.
+    size_t size() const;
+
+    /// @brief Removes all interned names and frees the memory used to store them.
+    ///
+    /// The table otherwise only ever grows, so long-running tools that parse
+    /// many unrelated designs can call this between them to reclaim memory.
+    ///
+    /// @warning Every ID handed out before the reset becomes meaningless, so this
+    /// must only be called when no syntax trees or compilations that used the
+    /// table are still alive, and never concurrently with any other use of it.
+    void reset();
+
+    /// Gets the process-wide default table, which is populated
+    /// during lexing and used by all compilations.
+    static IdentifierTable& getDefault();
+
+private:
+    struct Storage;
+    std::unique_ptr<Storage> storage;
+};
+
+} // namespace slang
@@ -204,9 +204,12 @@ struct NodeImpl {
     uint32_t find(uint32_t size, const interval<TKey>& key) const {
         SLANG_ASSERT(size <= TDerived::Capacity);
         auto& self = *static_cast<const TDerived*>(this);
+
+        // Nodes are small, so counting every smaller key without branching
+        // is faster than stopping early at the first larger one.
         uint32_t i = 0;
-        while (i != size && self.keyAt(i).left < key.left)
-            i++;
+        for (uint32_t j = 0; j < size; j++)
+            i += uint32_t(self.keyAt(j).left < key.left);
         return i;
     }
 
@@ -544,6 +547,14 @@ public:
     /// Default constructor.
     IntervalMap() {}
 
+    /// @brief Constructs a map from a list of intervals and their values.
+    ///
+    /// The items must be sorted by the left side of their intervals. The tree
+    /// is built bottom-up with fully packed nodes, which is O(n) and much
+    /// faster than inserting each item individually.
+    IntervalMap(std::span<const std::pair<std::pair<TKey, TKey>, TValue>> items,
+                allocator_type& alloc);
+
     /// Destructor.
     ~IntervalMap() = default;
 
@@ -691,6 +702,37 @@ public:
         return find(key.first, key.second);
     }
 
+    /// @brief Finds all intervals that overlap each of the given query intervals.
+    ///
+    /// @a callback is invoked as callback(queryIndex, bounds, value) for each
+    /// overlapping interval. The callbacks for any one query happen in the
+    /// same order as they would be visited by find(), but results for
+    /// different queries are interleaved.
+    ///
+    /// This is faster than calling find() for each query, since the queries
+    /// share a single walk over the tree and each node is visited only once.
+    template<typename TCallback>
+    void findAll(std::span<const std::pair<TKey, TKey>> queries, TCallback&& callback) const {
+        if (empty() || queries.empty())
+            return;
+
+        // Sort the queries by their left bound so that each node only
+        // needs to look at a window of them.
+        SmallVector<std::pair<TKey, uint32_t>> order;
+        for (uint32_t i = 0; i < queries.size(); i++)
+            order.push_back({queries[i].first, i});
+        std::ranges::sort(order);
+
+        SmallVector<uint32_t> active;
+        for (auto& [left, i] : order)
+            active.push_back(i);
+
+        if (isFlat())
+            findAll(rootLeaf, rootSize, queries, active, callback);
+        else
+            findAll(rootBranch, rootSize, 0, queries, active, callback);
+    }
+
     /// @brief Erases the interval pointed to by the given iterator.
     ///
     /// The iterator will be invalidated by this operation.
@@ -731,6 +773,16 @@ private:
     template<typename TBranch>
     void verify(const TBranch& branch, uint32_t size, uint32_t depth, TKey& lastKey) const;
 
+    template<typename TLeaf, typename TCallback>
+    static void findAll(const TLeaf& leaf, uint32_t size,
+                        std::span<const std::pair<TKey, TKey>> queries,
+                        std::span<const uint32_t> active, TCallback& callback);
+
+    template<typename TBranch, typename TCallback>
+    void findAll(const TBranch& branch, uint32_t size, uint32_t depth,
+                 std::span<const std::pair<TKey, TKey>> queries,
+                 std::span<const uint32_t> active, TCallback& callback) const;
+
     template<typename TRootNode, typename TNewNode, bool SwitchToBranch>
     IntervalMapDetails::IndexPair modifyRoot(TRootNode& rootNode, uint32_t position,
                                              allocator_type& alloc);
@@ -1044,6 +1096,72 @@ void IntervalMap<TKey, TValue, N>::clear(allocator_type& alloc) {
     rootSize = 0;
 }
 
+template<typename TKey, typename TValue, uint32_t N>
+IntervalMap<TKey, TValue, N>::IntervalMap(
+    std::span<const std::pair<std::pair<TKey, TKey>, TValue>> items, allocator_type& alloc) {
+    using namespace IntervalMapDetails;
+    SLANG_ASSERT(std::ranges::is_sorted(items, {}, [](auto& item) { return item.first.first; }));
+
+    if (items.size() <= RootLeaf::Capacity) {
+        for (auto& [key, value] : items) {
+            rootLeaf.keyAt(rootSize) = {key.first, key.second};
+            rootLeaf.valueAt(rootSize) = value;
+            rootSize++;
+        }
+        return;
+    }
+
+    // Spreads @a count items as evenly as possible across the fewest nodes
+    // with the given capacity, with at least two nodes so that the level
+    // above always has something to branch between.
+    auto distribute = [](size_t count, size_t capacity, auto&& makeNode) {
+        const size_t numNodes = std::max(size_t(2), (count + capacity - 1) / capacity);
+        size_t offset = 0;
+        for (size_t i = 0; i < numNodes; i++) {
+            const size_t size = count / numNodes + (i < count % numNodes ? 1 : 0);
+            makeNode(offset, uint32_t(size));
+            offset += size;
+        }
+    };
+
+    // Build the leaves, and then successive levels of branches on top of
+    // them until the remaining nodes fit in the root.
+    SmallVector<std::pair<NodeRef, interval<TKey>>> refs, nextRefs;
+    distribute(items.size(), Leaf::Capacity, [&](size_t offset, uint32_t size) {
+        auto& leaf = *alloc.template emplace<Leaf>();
+        for (uint32_t i = 0; i < size; i++) {
+            auto& [key, value] = items[offset + i];
+            leaf.keyAt(i) = {key.first, key.second};
+            leaf.valueAt(i) = value;
+        }
+        refs.push_back({NodeRef(&leaf, size), leaf.getBounds(size)});
+    });
+
+    height = 1;
+    while (refs.size() > RootBranch::Capacity) {
+        distribute(refs.size(), Branch::Capacity, [&](size_t offset, uint32_t size) {
+            auto& branch = *alloc.template emplace<Branch>();
+            for (uint32_t i = 0; i < size; i++) {
+                branch.childAt(i) = refs[offset + i].first;
+                branch.keyAt(i) = refs[offset + i].second;
+            }
+            nextRefs.push_back({NodeRef(&branch, size), branch.getBounds(size)});
+        });
+
+        refs.clear();
+        refs.swap(nextRefs);
+        height++;
+    }
+
+    rootLeaf.~RootLeaf();
+    new (&rootBranch) RootBranch();
+    for (auto& [ref, key] : refs) {
+        rootBranch.childAt(rootSize) = ref;
+        rootBranch.keyAt(rootSize) = key;
+        rootSize++;
+    }
+}
+
 template<typename TKey, typename TValue, uint32_t N>
 IntervalMap<TKey, TValue, N> IntervalMap<TKey, TValue, N>::clone(allocator_type& alloc) const {
     using namespace IntervalMapDetails;
@@ -1187,6 +1305,73 @@ void IntervalMap<TKey, TValue, N>::verify(const TBranch& branch, uint32_t size,
     }
 }
 
+template<typename TKey, typename TValue, uint32_t N>
+template<typename TLeaf, typename TCallback>
+void IntervalMap<TKey, TValue, N>::findAll(const TLeaf& leaf, uint32_t size,
+                                           std::span<const std::pair<TKey, TKey>> queries,
+                                           std::span<const uint32_t> active,
+                                           TCallback& callback) {
+    // The active queries are sorted by their left bound, and so are the keys,
+    // so any query that ends before the current key can't overlap later keys.
+    size_t start = 0;
+    for (uint32_t i = 0; i < size && start < active.size(); i++) {
+        auto& key = leaf.keyAt(i);
+        while (start < active.size() && queries[active[start]].second < key.left)
+            start++;
+
+        for (size_t j = start; j < active.size(); j++) {
+            auto q = active[j];
+            auto& query = queries[q];
+            if (query.first > key.right)
+                break;
+
+            if (query.second >= key.left)
+                callback(size_t(q), std::pair<TKey, TKey>{key.left, key.right}, leaf.valueAt(i));
+        }
+    }
+}
+
+template<typename TKey, typename TValue, uint32_t N>
+template<typename TBranch, typename TCallback>
+void IntervalMap<TKey, TValue, N>::findAll(const TBranch& branch, uint32_t size, uint32_t depth,
+                                           std::span<const std::pair<TKey, TKey>> queries,
+                                           std::span<const uint32_t> active,
+                                           TCallback& callback) const {
+    // Narrow the set of queries down to the ones that can overlap each child
+    // before descending into it. See the leaf version above for how the
+    // sorted order lets us skip over most of them.
+    SmallVector<uint32_t> childActive;
+    size_t start = 0;
+    for (uint32_t i = 0; i < size && start < active.size(); i++) {
+        auto& key = branch.keyAt(i);
+        while (start < active.size() && queries[active[start]].second < key.left)
+            start++;
+
+        childActive.clear();
+        for (size_t j = start; j < active.size(); j++) {
+            auto q = active[j];
+            auto& query = queries[q];
+            if (query.first > key.right)
+                break;
+
+            if (query.second >= key.left)
+                childActive.push_back(q);
+        }
+
+        if (childActive.empty())
+            continue;
+
+        auto child = branch.childAt(i);
+        if (depth == height - 1) {
+            findAll(child.template get<Leaf>(), child.size(), queries, childActive, callback);
+        }
+        else {
+            findAll(child.template get<Branch>(), child.size(), depth + 1, queries, childActive,
+                    callback);
+        }
+    }
+}
+
 template<typename TKey, typename TValue, uint32_t N>
 IntervalMap<TKey, TValue, N> IntervalMap<TKey, TValue, N>::intersection(
     const IntervalMap& other, allocator_type& alloc) const {
@@ -9,6 +9,7 @@
 
 #include <iosfwd>
 #include <memory>
+#include <span>
 #include <string>
 
 #include "slang/util/Function.h"
@@ -45,6 +46,13 @@ public:
     /// Ends tracing a section previously started by @a beginTrace
     static void endTrace();
 
+    /// Records the current values of a set of named counters, which the
+    /// Chrome Profiler displays as a graph over time.
+    /// @param name the name of the counter group
+    /// @param values the name and current value of each counter in the group
+    static void counter(std::string_view name,
+                        std::span<const std::pair<std::string_view, uint64_t>> values);
+
 private:
     TimeTrace() = delete;
 
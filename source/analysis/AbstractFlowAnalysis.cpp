@@ -9,6 +9,7 @@
 
 #include <fmt/core.h>
 
+#include "slang/analysis/AnalysisManager.h"
 #include "slang/analysis/CaseDecisionDag.h"
 #include "slang/diagnostics/AnalysisDiags.h"
 
@@ -75,6 +76,7 @@ FlowAnalysisBase::WillExecute FlowAnalysisBase::tryGetLoopIterValues(
                 return WillExecute::Yes;
 
             forLoopSteps += increment;
+            totalLoopSteps++;
             if (forLoopSteps > options.maxLoopAnalysisSteps)
                 return WillExecute::Yes;
         }
@@ -86,6 +88,198 @@ FlowAnalysisBase::WillExecute FlowAnalysisBase::tryGetLoopIterValues(
     return willExec;
 }
 
+bool FlowAnalysisBase::fitsLoopStepLimit(uint64_t iterations) const {
+    // This mirrors the accounting in tryGetLoopIterValues, which charges
+    // each iteration of a nested loop as many steps as the loops around it.
+    const uint32_t increment = std::max(forLoopSteps, 1u);
+    if (forLoopSteps > options.maxLoopAnalysisSteps)
+        return false;
+    return iterations <= (options.maxLoopAnalysisSteps - forLoopSteps) / increment;
+}
+
+std::optional<FlowAnalysisBase::LoopBounds> FlowAnalysisBase::tryGetLoopBounds(
+    const ForLoopStatement& stmt) {
+
+    // This recognizes loops with a single integral loop variable that gets
+    // stepped by a constant amount and compared against a loop invariant
+    // bound, which lets us find the number of iterations without stepping
+    // through each of them.
+    if (stmt.loopVars.size() != 1 || stmt.steps.size() != 1 || !stmt.stopExpr)
+        return {};
+
+    auto& var = *stmt.loopVars[0];
+    auto& type = var.getType();
+    auto init = var.getInitializer();
+    if (!init || !type.isIntegral() || type.getBitWidth() > 63)
+        return {};
+
+    auto isVar = [&](const Expression& expr) {
+        auto& e = expr.unwrapImplicitConversions();
+        return e.kind == ExpressionKind::NamedValue &&
+               &e.as<NamedValueExpression>().symbol == &var;
+    };
+
+    // The loop variable doesn't have a value in the eval context here,
+    // so anything that evaluates successfully doesn't depend on it.
+    auto isInvariant = [&](const Expression& expr) { return bool(expr.eval(evalContext)); };
+
+    bool isLinear = false;
+    auto& step = *stmt.steps[0];
+    if (step.kind == ExpressionKind::UnaryOp) {
+        auto& unary = step.as<UnaryExpression>();
+        isLinear = OpInfo::isLValue(unary.op) && isVar(unary.operand());
+    }
+    else if (step.kind == ExpressionKind::Assignment) {
+        auto& assign = step.as<AssignmentExpression>();
+        auto& rhs = assign.right().unwrapImplicitConversions();
+        if (isVar(assign.left()) && rhs.kind == ExpressionKind::BinaryOp) {
+            // Compound assignments refer back to the left hand side
+            // via an lvalue reference.
+            auto& binary = rhs.as<BinaryExpression>();
+            auto isStepVar = [&](const Expression& expr) {
+                return isVar(expr) || expr.unwrapImplicitConversions().kind ==
+                                          ExpressionKind::LValueReference;
+            };
+
+            if (binary.op == BinaryOperator::Add) {
+                isLinear = (isStepVar(binary.left()) && isInvariant(binary.right())) ||
+                           (isStepVar(binary.right()) && isInvariant(binary.left()));
+            }
+            else if (binary.op == BinaryOperator::Subtract) {
+                isLinear = isStepVar(binary.left()) && isInvariant(binary.right());
+            }
+        }
+    }
+
+    if (!isLinear || stmt.stopExpr->kind != ExpressionKind::BinaryOp)
+        return {};
+
+    auto& stop = stmt.stopExpr->as<BinaryExpression>();
+    if (!OpInfo::isRelational(stop.op) ||
+        !((isVar(stop.left()) && isInvariant(stop.right())) ||
+          (isVar(stop.right()) && isInvariant(stop.left())))) {
+        return {};
+    }
+
+    auto initCv = init->eval(evalContext);
+    if (!initCv.isInteger())
+        return {};
+
+    auto firstVal = initCv.integer().as<int64_t>();
+    if (!firstVal)
+        return {};
+
+    auto local = evalContext.createLocal(&var, initCv);
+    auto cleanupLocal = ScopeGuard([&] { evalContext.deleteLocal(&var); });
+
+    if (!step.eval(evalContext) || !local->isInteger())
+        return {};
+
+    auto nextVal = local->integer().as<int64_t>();
+    if (!nextVal || *nextVal == *firstVal)
+        return {};
+
+    // Only consider values on the same side of zero as the initial value,
+    // so that the loop variable never wraps and any sign conversions in
+    // the stop expression keep it monotonic.
+    const auto width = type.getBitWidth();
+    const bool isSigned = type.isSigned();
+    int64_t minVal = 0;
+    int64_t maxVal = isSigned ? (int64_t(1) << (width - 1)) - 1
+                              : int64_t((uint64_t(1) << width) - 1);
+    if (*firstVal < 0) {
+        minVal = -(int64_t(1) << (width - 1));
+        maxVal = -1;
+    }
+
+    const int64_t stride = *nextVal - *firstVal;
+    const uint64_t maxIter = stride > 0 ? uint64_t(maxVal - *firstVal) / uint64_t(stride)
+                                        : uint64_t(*firstVal - minVal) / uint64_t(-stride);
+
+    auto valueAt = [&](uint64_t iter) {
+        auto val = *firstVal + int64_t(iter) * stride;
+        return SVInt(width, uint64_t(val), isSigned);
+    };
+
+    auto condAt = [&](uint64_t iter) -> std::optional<bool> {
+        *local = valueAt(iter);
+        auto cv = stmt.stopExpr->eval(evalContext);
+        if (!cv)
+            return {};
+        return cv.isTrue();
+    };
+
+    // Binary search for the first value that fails the stop condition.
+    auto firstCond = condAt(0);
+    auto lastCond = condAt(maxIter);
+    if (!firstCond || !lastCond || *lastCond)
+        return {};
+
+    LoopBounds result;
+    result.stride = stride;
+    if (*firstCond) {
+        uint64_t lo = 0, hi = maxIter;
+        while (hi - lo > 1) {
+            auto mid = lo + (hi - lo) / 2;
+            auto cond = condAt(mid);
+            if (!cond)
+                return {};
+
+            if (*cond)
+                lo = mid;
+            else
+                hi = mid;
+        }
+
+        result.iterations = hi;
+        result.first = valueAt(0);
+        result.last = valueAt(hi - 1);
+    }
+
+    return result;
+}
+
+const FlowAnalysisBase::WidenedLoopVar* FlowAnalysisBase::findWidenedLoopVar(
+    const Expression& selector) const {
+
+    // Looks for a selector that is a widened loop variable, optionally offset
+    // by a constant. Since widened loops have a unit stride, such a selector
+    // visits every element in between its first and last values.
+    auto findVar = [&](const Expression& expr) -> const WidenedLoopVar* {
+        auto& e = expr.unwrapImplicitConversions();
+        if (e.kind == ExpressionKind::NamedValue) {
+            auto sym = &e.as<NamedValueExpression>().symbol;
+            for (auto& wv : widenedLoopVars) {
+                if (wv.symbol == sym)
+                    return &wv;
+            }
+        }
+        return nullptr;
+    };
+
+    auto& e = selector.unwrapImplicitConversions();
+    if (auto wv = findVar(e))
+        return wv;
+
+    if (e.kind == ExpressionKind::BinaryOp) {
+        auto& binary = e.as<BinaryExpression>();
+        if (binary.op == BinaryOperator::Add || binary.op == BinaryOperator::Subtract) {
+            if (auto wv = findVar(binary.left()); wv && binary.right().eval(evalContext))
+                return wv;
+            if (auto wv = findVar(binary.right()); wv && binary.left().eval(evalContext))
+                return wv;
+        }
+    }
+
+    return nullptr;
+}
+
+void FlowAnalysisBase::noteLoopCost(const ForLoopStatement& stmt, uint64_t steps,
+                                    std::chrono::steady_clock::time_point start) const {
+    profile->loops.push_back({&rootSymbol, &stmt, 1, steps, CaseAnalysisEngine::Auto,
+                              std::chrono::steady_clock::now() - start});
+}
+
 bool FlowAnalysisBase::isFullyCovered(const CaseStatement& stmt, const Statement* knownBranch,
                                       bool isKnown) const {
     // This method determines whether a case statement's items fully cover
@@ -164,8 +358,18 @@ bool FlowAnalysisBase::isFullyCovered(const CaseStatement& stmt, const Statement
 
     std::optional<CaseDecisionDag> decisionDag;
     auto makeDecisionDag = [&]() {
+        std::chrono::steady_clock::time_point start;
+        if (profile)
+            start = std::chrono::steady_clock::now();
+
         decisionDag.emplace(intVals, bitWidth, cond == CaseStatementCondition::WildcardXOrZ,
-                            options.maxCaseAnalysisSteps);
+                            options.maxCaseAnalysisSteps, options.caseAnalysisEngine);
+
+        if (profile) {
+            profile->caseStatements.push_back({&rootSymbol, &stmt, 1, decisionDag->getSteps(),
+                                               decisionDag->engine,
+                                               std::chrono::steady_clock::now() - start});
+        }
     };
 
     // If diagnostics are enabled do various lint checks now.
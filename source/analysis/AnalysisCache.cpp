@@ -0,0 +1,465 @@
+//------------------------------------------------------------------------------
+// AnalysisCache.cpp
+// Retains analysis results across compilations
+//
+// SPDX-FileCopyrightText: Michael Popoloski
+// SPDX-License-Identifier: MIT
+//------------------------------------------------------------------------------
+#include "slang/analysis/AnalysisCache.h"
+
+#include <fmt/format.h>
+
+#include "slang/analysis/AnalysisManager.h"
+#include "slang/analysis/AnalyzedProcedure.h"
+#include "slang/ast/ASTVisitor.h"
+#include "slang/ast/Compilation.h"
+#include "slang/syntax/SyntaxTree.h"
+
+namespace slang::analysis {
+
+using namespace ast;
+
+static constexpr uint32_t InvalidId = UINT32_MAX;
+
+// Marks an inferred clock that comes from the scope's default clocking block.
+static constexpr uint32_t DefaultClockingId = UINT32_MAX - 1;
+
+static const TimingControl* getDefaultClock(const Symbol& procedure) {
+    auto scope = procedure.getParentScope();
+    SLANG_ASSERT(scope);
+
+    if (auto defaultClocking = scope->getCompilation().getDefaultClocking(*scope))
+        return &defaultClocking->as<ClockingBlockSymbol>().getEvent();
+    return nullptr;
+}
+
+// Nodes are identified by a pointer to their base class so that
+// lookups work no matter which derived type they're seen through.
+template<typename T>
+static const void* getNodeKey(const T& node) {
+    if constexpr (std::is_base_of_v<Symbol, T>)
+        return static_cast<const Symbol*>(&node);
+    else if constexpr (std::is_base_of_v<Expression, T>)
+        return static_cast<const Expression*>(&node);
+    else if constexpr (std::is_base_of_v<Statement, T>)
+        return static_cast<const Statement*>(&node);
+    else if constexpr (std::is_base_of_v<TimingControl, T>)
+        return static_cast<const TimingControl*>(&node);
+    else
+        return &node;
+}
+
+// Assigns an ID to every symbol and AST node in a scope, in visitation order,
+// and hashes their kinds so that we can tell when two scopes differ in shape.
+// Child instance bodies and classes are analyzed as their own scopes
+// so they aren't included.
+struct NodeIndexer : public ASTVisitor<NodeIndexer, true, true> {
+    flat_hash_map<const void*, uint32_t>& ids;
+    std::vector<const void*>& nodes;
+    size_t& shapeHash;
+
+    // Symbols referenced from within each procedure, to check once
+    // the whole scope has been indexed.
+    const Symbol* currentProcedure = nullptr;
+    std::vector<std::pair<const Symbol*, const Symbol*>> references;
+
+    // Procedures that call subroutines from timing controls or assertions.
+    // The drivers of those calls go straight to the analysis manager instead
+    // of being part of the procedure's results, so they can't be replayed.
+    std::vector<const Symbol*> indirectProcedures;
+    uint32_t indirectDepth = 0;
+
+    NodeIndexer(flat_hash_map<const void*, uint32_t>& ids, std::vector<const void*>& nodes,
+                size_t& shapeHash) : ids(ids), nodes(nodes), shapeHash(shapeHash) {}
+
+    template<typename T>
+    void handle(const T& node) {
+        auto key = getNodeKey(node);
+        if (!ids.emplace(key, uint32_t(nodes.size())).second)
+            return;
+
+        nodes.push_back(key);
+        if constexpr (std::is_base_of_v<Symbol, T>)
+            hash_combine(shapeHash, int(node.kind), node.name);
+        else if constexpr (requires { node.kind; })
+            hash_combine(shapeHash, int(node.kind));
+
+        if constexpr (std::is_base_of_v<ValueExpressionBase, T>) {
+            if (currentProcedure)
+                references.emplace_back(currentProcedure, &node.symbol);
+        }
+        else if constexpr (IsAnyOf<T, ArbitrarySymbolExpression>) {
+            if (currentProcedure)
+                references.emplace_back(currentProcedure, node.symbol.get());
+        }
+        else if constexpr (IsAnyOf<T, AssertionInstanceExpression>) {
+            if (currentProcedure)
+                references.emplace_back(currentProcedure, &node.symbol);
+        }
+        else if constexpr (IsAnyOf<T, CallExpression>) {
+            if (currentProcedure && !node.isSystemCall()) {
+                references.emplace_back(currentProcedure,
+                                        std::get<const SubroutineSymbol*>(node.subroutine));
+                if (indirectDepth)
+                    indirectProcedures.push_back(currentProcedure);
+            }
+        }
+
+        if constexpr (IsAnyOf<T, ProceduralBlockSymbol, ContinuousAssignSymbol>) {
+            currentProcedure = &node;
+            visitDefault(node);
+            currentProcedure = nullptr;
+        }
+        else if constexpr (std::is_same_v<T, InstanceSymbol>) {
+            node.visitExprs(*this);
+        }
+        else if constexpr (std::is_base_of_v<TimingControl, T> ||
+                           std::is_base_of_v<AssertionExpr, T> ||
+                           IsAnyOf<T, AssertionInstanceExpression>) {
+            indirectDepth++;
+            visitDefault(node);
+            indirectDepth--;
+        }
+        else if constexpr (!IsAnyOf<T, CheckerInstanceSymbol, ClassType, GenericClassDefSymbol,
+                                    CovergroupType>) {
+            visitDefault(node);
+        }
+    }
+};
+
+AnalysisCache::AnalysisCache() = default;
+AnalysisCache::~AnalysisCache() = default;
+
+void AnalysisCache::clear() {
+    std::unique_lock<std::mutex> lock(mutex);
+    scopes.clear();
+    seenKeys.clear();
+    syntaxTrees.clear();
+    fingerprint = 0;
+}
+
+size_t AnalysisCache::size() const {
+    std::unique_lock<std::mutex> lock(mutex);
+    return scopes.size();
+}
+
+void AnalysisCache::beginAnalysis(const Compilation& compilation, const AnalysisOptions& options,
+                                  bool repeatsOnly) {
+    // Anything outside of instance bodies that can affect their analysis
+    // goes into a fingerprint; if it changes none of our results can be trusted.
+    size_t fp = 0;
+    hash_combine(fp, options.flags.bits(), options.maxCaseAnalysisSteps,
+                 int(options.caseAnalysisEngine), options.maxLoopAnalysisSteps,
+                 int(options.loopAnalysisMode), uintptr_t(compilation.getSourceManager()));
+
+    for (auto unit : compilation.getRootNoFinalize().compilationUnits) {
+        for (auto& member : unit->members())
+            hash_combine(fp, int(member.kind), uintptr_t(member.getSyntax()));
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    if (fp != fingerprint) {
+        scopes.clear();
+        fingerprint = fp;
+    }
+
+    generation++;
+    this->repeatsOnly = repeatsOnly;
+    seenKeys.clear();
+    reusedProcedures = 0;
+    analyzedProcedures = 0;
+    uncacheableProcedures = 0;
+}
+
+void AnalysisCache::endAnalysis(const Compilation& compilation) {
+    std::unique_lock<std::mutex> lock(mutex);
+
+    // Drop anything that wasn't used by this analysis.
+    auto evicted = boost::unordered::erase_if(scopes, [this](auto& item) {
+        return item.second->generation != generation;
+    });
+
+    // Keep the syntax trees alive for as long as we have results keyed
+    // by their nodes, so that the addresses can't be reused.
+    auto trees = compilation.getSyntaxTrees();
+    syntaxTrees.assign(trees.begin(), trees.end());
+
+    stats.reusedProcedures = reusedProcedures;
+    stats.analyzedProcedures = analyzedProcedures;
+    stats.uncacheableProcedures = uncacheableProcedures;
+    stats.evictedScopes = evicted;
+}
+
+// Builds a key for an instance body out of its definition's syntax and its
+// parameter values, along with the same for any interfaces connected to its ports.
+static bool appendBodyKey(const InstanceBodySymbol& body, std::string& key) {
+    auto syntax = body.getDefinition().getSyntax();
+    if (!syntax)
+        return false;
+
+    key += fmt::format("{}(", static_cast<const void*>(syntax));
+    for (auto param : body.getParameters()) {
+        if (param->symbol.kind == SymbolKind::Parameter) {
+            // Values are printed in full, since the default abbreviation of wide
+            // values would let bodies with different parameters share a key.
+            key += param->symbol.as<ParameterSymbol>().getValue().toString(
+                SVInt::MAX_BITS, /* exactUnknowns */ true);
+        }
+        else {
+            key += param->symbol.as<TypeParameterSymbol>().targetType.getType().toString();
+        }
+        key.push_back(';');
+    }
+
+    for (auto port : body.getPortList()) {
+        if (port->kind != SymbolKind::InterfacePort)
+            continue;
+
+        auto [conn, modport] = port->as<InterfacePortSymbol>().getConnection();
+        if (!conn || conn->kind != SymbolKind::Instance)
+            return false;
+
+        if (modport)
+            key += modport->name;
+        if (!appendBodyKey(conn->as<InstanceSymbol>().body, key))
+            return false;
+    }
+
+    key.push_back(')');
+    return true;
+}
+
+std::unique_ptr<AnalysisCache::ScopeSession> AnalysisCache::beginScope(const Scope& scope) {
+    auto& symbol = scope.asSymbol();
+    if (symbol.kind != SymbolKind::InstanceBody)
+        return nullptr;
+
+    std::string key;
+    if (!appendBodyKey(symbol.as<InstanceBodySymbol>(), key))
+        return nullptr;
+
+    if (repeatsOnly) {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (seenKeys.insert(key).second)
+            return nullptr;
+    }
+
+    return std::make_unique<ScopeSession>(*this, std::move(key), scope);
+}
+
+AnalysisCache::ScopeSession::ScopeSession(AnalysisCache& cache, std::string key,
+                                          const Scope& scope) : cache(cache), key(std::move(key)) {
+    NodeIndexer indexer(nodeIds, nodes, shapeHash);
+    for (auto& member : scope.members())
+        member.visit(indexer);
+
+    // Procedures that refer to symbols in other instances can behave differently
+    // even if nothing in this scope has changed. Packages and compilation units
+    // are covered by the cache's fingerprint.
+    for (auto [procedure, symbol] : indexer.references) {
+        if (nodeIds.contains(static_cast<const void*>(symbol)))
+            continue;
+
+        auto parent = symbol->getParentScope();
+        while (parent && parent->asSymbol().kind != SymbolKind::Package &&
+               parent->asSymbol().kind != SymbolKind::CompilationUnit &&
+               parent->asSymbol().kind != SymbolKind::InstanceBody) {
+            parent = parent->asSymbol().getParentScope();
+        }
+
+        if (!parent || parent->asSymbol().kind == SymbolKind::InstanceBody)
+            uncachedProcedures.insert(procedure);
+    }
+
+    uncachedProcedures.insert(indexer.indirectProcedures.begin(),
+                              indexer.indirectProcedures.end());
+
+    std::unique_lock<std::mutex> lock(cache.mutex);
+    if (auto it = cache.scopes.find(this->key); it != cache.scopes.end()) {
+        if (it->second->shapeHash == shapeHash && it->second->numNodes == nodes.size())
+            previous = it->second;
+    }
+}
+
+void AnalysisCache::ScopeSession::prepare(size_t numProcedures) {
+    procedures.resize(numProcedures);
+}
+
+void AnalysisCache::ScopeSession::analyze(AnalysisContext& context, size_t index,
+                                          const Symbol& symbol,
+                                          std::vector<AnalyzedProcedure>& results) {
+    if (index >= procedures.size())
+        procedures.resize(index + 1);
+
+    if (uncachedProcedures.contains(&symbol)) {
+        results.emplace_back(context, symbol);
+        cache.analyzedProcedures++;
+        cache.uncacheableProcedures++;
+        return;
+    }
+
+    if (tryReuse(context, index, symbol, results)) {
+        procedures[index] = previous->procedures[index];
+        cache.reusedProcedures++;
+        return;
+    }
+
+    auto firstDiag = context.diagnostics.size();
+    results.emplace_back(context, symbol);
+
+    procedures[index] = capture(context, firstDiag, results.back());
+    cache.analyzedProcedures++;
+    if (!procedures[index])
+        cache.uncacheableProcedures++;
+}
+
+void AnalysisCache::ScopeSession::finish() {
+    auto entry = std::make_shared<CachedScope>();
+    entry->shapeHash = shapeHash;
+    entry->numNodes = nodes.size();
+    entry->generation = cache.generation;
+    entry->procedures = std::move(procedures);
+
+    std::unique_lock<std::mutex> lock(cache.mutex);
+    cache.scopes[key] = std::move(entry);
+}
+
+bool AnalysisCache::ScopeSession::tryReuse(AnalysisContext& context, size_t index,
+                                           const Symbol& symbol,
+                                           std::vector<AnalyzedProcedure>& results) {
+    if (!previous || index >= previous->procedures.size())
+        return false;
+
+    auto cached = previous->procedures[index].get();
+    if (!cached || nodes[cached->symbol] != &symbol)
+        return false;
+
+    auto getSymbol = [&](uint32_t id) { return static_cast<const Symbol*>(nodes[id]); };
+    auto getExpr = [&](uint32_t id) { return static_cast<const Expression*>(nodes[id]); };
+
+    AnalyzedProcedure proc(symbol);
+    if (cached->inferredClock == DefaultClockingId)
+        proc.inferredClock = getDefaultClock(symbol);
+    else if (cached->inferredClock != InvalidId)
+        proc.inferredClock = static_cast<const TimingControl*>(nodes[cached->inferredClock]);
+
+    // Assertions only produce diagnostics, which are replayed below. The only
+    // other state an assertion has is its checker scope, and procedures with
+    // procedural checkers aren't cached, so a default constructed assertion
+    // is equivalent to the one that was analyzed.
+    proc.assertions.reserve(cached->numAssertions);
+    for (uint32_t i = 0; i < cached->numAssertions; i++)
+        proc.assertions.push_back(AnalyzedAssertion());
+
+    proc.drivers.reserve(cached->drivers.size());
+    for (auto& [symbolId, cachedDrivers] : cached->drivers) {
+        DriverList drivers;
+        drivers.reserve(cachedDrivers.size());
+        for (auto& cd : cachedDrivers) {
+            auto driver = context.alloc.emplace<ValueDriver>(cd.kind,
+                                                             *getExpr(cd.prefixExpression),
+                                                             *getSymbol(cd.containingSymbol),
+                                                             cd.flags);
+            if (cd.procCallExpression != InvalidId)
+                driver->procCallExpression = getExpr(cd.procCallExpression);
+            driver->isFromSideEffect = cd.isFromSideEffect;
+            drivers.emplace_back(driver, cd.bounds);
+        }
+        proc.drivers.emplace_back(&getSymbol(symbolId)->as<ValueSymbol>(), std::move(drivers));
+    }
+
+    for (auto id : cached->callExpressions)
+        proc.callExpressions.push_back(&getExpr(id)->as<CallExpression>());
+
+    for (auto id : cached->timingControls)
+        proc.timingControls.push_back(static_cast<const Statement*>(nodes[id]));
+
+    for (auto& diag : cached->diagnostics)
+        context.diagnostics.emplace_back(diag).symbol = &symbol;
+
+    results.emplace_back(std::move(proc));
+    return true;
+}
+
+std::shared_ptr<const AnalysisCache::CachedProcedure> AnalysisCache::ScopeSession::capture(
+    const AnalysisContext& context, size_t firstDiag, const AnalyzedProcedure& procedure) {
+
+    // Procedural checkers are expanded into their own analyzed scopes,
+    // which we don't try to track.
+    auto assertions = procedure.getAssertions();
+    if (std::ranges::any_of(assertions, [](auto& a) { return a.checkerScope != nullptr; }))
+        return nullptr;
+
+    auto result = std::make_shared<CachedProcedure>();
+    result->symbol = getId(procedure.analyzedSymbol.get());
+    result->inferredClock = InvalidId;
+    result->numAssertions = uint32_t(assertions.size());
+
+    bool valid = result->symbol != InvalidId;
+    if (auto clock = procedure.getInferredClock()) {
+        result->inferredClock = getId(clock);
+        if (result->inferredClock == InvalidId &&
+            clock == getDefaultClock(*procedure.analyzedSymbol)) {
+            result->inferredClock = DefaultClockingId;
+        }
+        valid &= result->inferredClock != InvalidId;
+    }
+    for (auto& [valueSym, drivers] : procedure.getDrivers()) {
+        auto& [symbolId, cachedDrivers] = result->drivers.emplace_back();
+        symbolId = getId(static_cast<const Symbol*>(valueSym));
+        valid &= symbolId != InvalidId;
+
+        for (auto& [driver, bounds] : drivers) {
+            auto& cd = cachedDrivers.emplace_back();
+            cd.prefixExpression = getId(driver->prefixExpression.get());
+            cd.containingSymbol = getId(driver->containingSymbol.get());
+            cd.procCallExpression = driver->procCallExpression
+                                        ? getId(driver->procCallExpression)
+                                        : InvalidId;
+            cd.kind = driver->kind;
+            cd.flags = driver->flags;
+            cd.isFromSideEffect = driver->isFromSideEffect;
+            cd.bounds = bounds;
+
+            valid &= cd.prefixExpression != InvalidId && cd.containingSymbol != InvalidId &&
+                     (cd.procCallExpression != InvalidId || !driver->procCallExpression);
+        }
+    }
+
+    for (auto call : procedure.getCallExpressions()) {
+        auto id = result->callExpressions.emplace_back(getId(static_cast<const Expression*>(call)));
+        valid &= id != InvalidId;
+    }
+
+    for (auto stmt : procedure.getTimingControls()) {
+        auto id = result->timingControls.emplace_back(getId(stmt));
+        valid &= id != InvalidId;
+    }
+
+    // Diagnostics issued for anything other than the procedure itself
+    // (i.e. for a subroutine it called) belong to someone else.
+    for (size_t i = firstDiag; i < context.diagnostics.size(); i++) {
+        auto& diag = result->diagnostics.emplace_back(context.diagnostics[i]);
+        valid &= diag.symbol == procedure.analyzedSymbol.get();
+        diag.symbol = nullptr;
+
+        for (auto& arg : diag.args)
+            valid &= !std::holds_alternative<Diagnostic::CustomArgType>(arg);
+
+        for (auto& note : diag.notes)
+            valid &= note.symbol == nullptr;
+    }
+
+    if (!valid)
+        return nullptr;
+
+    return result;
+}
+
+uint32_t AnalysisCache::ScopeSession::getId(const void* node) const {
+    if (auto it = nodeIds.find(node); it != nodeIds.end())
+        return it->second;
+    return InvalidId;
+}
+
+} // namespace slang::analysis
@@ -8,13 +8,19 @@
 #include "slang/analysis/AnalysisManager.h"
 
 #include "AnalysisScopeVisitor.h"
+#include <atomic>
+#include <bit>
+#include <fmt/format.h>
 
 #include "slang/ast/ASTDiagMap.h"
 #include "slang/ast/Compilation.h"
+#include "slang/text/SourceManager.h"
+#include "slang/util/TimeTrace.h"
 
 namespace slang::analysis {
 
 using namespace ast;
+using namespace std::chrono;
 
 static const Scope& getAsScope(const Symbol& symbol) {
     switch (symbol.kind) {
@@ -31,6 +37,82 @@ static const Scope& getAsScope(const Symbol& symbol) {
     }
 }
 
+// Counts the nodes in an assertion's property expression, including
+// the expanded bodies of any named properties and sequences it instantiates.
+struct AssertionCounter : public ASTVisitor<AssertionCounter, false, true> {
+    uint64_t count = 0;
+
+    template<typename T>
+        requires(std::is_base_of_v<AssertionExpr, T>)
+    void handle(const T& expr) {
+        count++;
+        visitDefault(expr);
+    }
+};
+
+// Counts the statements in a procedure, as a rough estimate
+// of how much work it will take to analyze. Checking clock flow
+// through a concurrent assertion scales with the size of its property,
+// so those count for more.
+struct StatementCounter {
+    uint64_t count = 0;
+
+    template<typename T>
+    void visit(const T& stmt) {
+        count++;
+        if constexpr (std::is_same_v<T, ConcurrentAssertionStatement>) {
+            AssertionCounter counter;
+            stmt.propertySpec.visit(counter);
+            count += counter.count;
+        }
+
+        if constexpr (requires { stmt.visitStmts(*this); })
+            stmt.visitStmts(*this);
+    }
+};
+
+static uint64_t estimateCost(const Scope& scope);
+
+static uint64_t estimateCost(const Symbol& symbol) {
+    switch (symbol.kind) {
+        case SymbolKind::ProceduralBlock: {
+            StatementCounter counter;
+            symbol.as<ProceduralBlockSymbol>().getBody().visit(counter);
+            return 1 + counter.count;
+        }
+        case SymbolKind::ContinuousAssign:
+            return 1;
+        case SymbolKind::GenerateBlock: {
+            auto& block = symbol.as<GenerateBlockSymbol>();
+            return block.isUninstantiated ? 0 : estimateCost(static_cast<const Scope&>(block));
+        }
+        case SymbolKind::GenerateBlockArray: {
+            auto& array = symbol.as<GenerateBlockArraySymbol>();
+            return array.valid ? estimateCost(static_cast<const Scope&>(array)) : 0;
+        }
+        default:
+            // Child instances and classes are analyzed as their own scopes.
+            return 0;
+    }
+}
+
+static uint64_t estimateCost(const Scope& scope) {
+    uint64_t cost = 1;
+    for (auto& member : scope.members())
+        cost += estimateCost(member);
+    return cost;
+}
+
+// Describes a procedure for time trace events, along with its location.
+static std::string describeForTimeTrace(const Symbol& symbol) {
+    auto result = AnalysisManager::describeProcedure(symbol);
+    if (auto sm = symbol.getParentScope()->getCompilation().getSourceManager()) {
+        auto loc = sm->getFullyOriginalLoc(symbol.location);
+        result += fmt::format(" ({}:{})", sm->getFileName(loc), sm->getLineNumber(loc));
+    }
+    return result;
+}
+
 const AnalyzedScope* PendingAnalysis::tryGet() const {
     return analysisManager->getAnalyzedScope(getAsScope(*symbol));
 }
@@ -57,9 +139,14 @@ AnalysisManager::AnalysisManager(AnalysisOptions options) :
 #else
     workerStates.emplace_back(*this);
 #endif
+
+    if (hasFlag(AnalysisFlags::Profile)) {
+        for (auto& state : workerStates)
+            state.context.profile = &state.profile;
+    }
 }
 
-AnalyzedDesign AnalysisManager::analyze(const Compilation& compilation) {
+AnalyzedDesign AnalysisManager::analyze(const Compilation& compilation, AnalysisCache* cache) {
     if (!compilation.isElaborated())
         SLANG_THROW(std::runtime_error("Compilation must be elaborated before analysis"));
 
@@ -67,6 +154,11 @@ AnalyzedDesign AnalysisManager::analyze(const Compilation& compilation) {
     if (compilation.hasFatalErrors())
         return {};
 
+    auto startTime = steady_clock::now();
+
+    this->cache = cache ? cache : &instanceCache;
+    this->cache->beginAnalysis(compilation, options, /* repeatsOnly */ !cache);
+
     // Analyze all compilation units first.
     auto& root = compilation.getRootNoFinalize();
     for (auto unit : root.compilationUnits)
@@ -98,7 +190,28 @@ AnalyzedDesign AnalysisManager::analyze(const Compilation& compilation) {
 
     // Finalize all drivers that are applied through modport ports.
     auto& state = getState();
-    driverTracker.propagateModportDrivers(state.context, state.driverAlloc);
+    driverTracker.propagateModportDrivers(state.context, state.driverBuffer);
+    mergeDrivers();
+
+    this->cache->endAnalysis(compilation);
+    cacheStats = this->cache->getStats();
+    this->cache = nullptr;
+    instanceCache.clear();
+
+    if (TimeTrace::isEnabled()) {
+        // Report how busy each worker was over the course of the analysis.
+        auto stats = getWorkerStats();
+        auto elapsed = duration_cast<microseconds>(steady_clock::now() - startTime).count();
+        std::vector<std::string> names;
+        std::vector<std::pair<std::string_view, uint64_t>> values;
+        names.reserve(stats.size());
+        for (size_t i = 0; i < stats.size(); i++) {
+            auto busy = duration_cast<microseconds>(stats[i].busyTime).count();
+            names.emplace_back(fmt::format("worker {} utilization %", i));
+            values.emplace_back(names.back(), elapsed ? uint64_t(busy * 100 / elapsed) : 0);
+        }
+        TimeTrace::counter("analysisWorkers"sv, values);
+    }
 
     // Report on unused definitions.
     if (hasFlag(AnalysisFlags::CheckUnused)) {
@@ -115,11 +228,17 @@ AnalyzedDesign AnalysisManager::analyze(const Compilation& compilation) {
 
 const AnalyzedScope& AnalysisManager::analyzeScopeBlocking(
     const Scope& scope, const AnalyzedProcedure* parentProcedure) {
+    return analyzeScopeImpl(scope, parentProcedure, nullptr);
+}
 
+const AnalyzedScope& AnalysisManager::analyzeScopeImpl(const Scope& scope,
+                                                       const AnalyzedProcedure* parentProcedure,
+                                                       AnalysisCache::ScopeSession* cacheSession) {
     auto& state = getState();
     auto& result = *state.scopeAlloc.emplace(scope);
 
     AnalysisScopeVisitor visitor(state, result, parentProcedure);
+    visitor.cacheSession = cacheSession;
     for (auto& member : scope.members())
         member.visit(visitor);
 
@@ -157,7 +276,7 @@ const AnalyzedProcedure* AnalysisManager::addAnalyzedSubroutine(
         SLANG_ASSERT(result);
 
         auto& state = getState();
-        driverTracker.add(state.context, state.driverAlloc, *result);
+        driverTracker.add(state.context, state.driverBuffer, *result);
     }
 
     return result;
@@ -165,12 +284,12 @@ const AnalyzedProcedure* AnalysisManager::addAnalyzedSubroutine(
 
 void AnalysisManager::noteDriver(const Expression& expr, const Symbol& containingSymbol) {
     auto& state = getState();
-    driverTracker.add(state.context, state.driverAlloc, expr, containingSymbol);
+    driverTracker.add(state.context, state.driverBuffer, expr, containingSymbol);
 }
 
 void AnalysisManager::noteDrivers(std::span<const SymbolDriverListPair> drivers) {
     auto& state = getState();
-    driverTracker.add(state.context, state.driverAlloc, drivers);
+    driverTracker.add(state.driverBuffer, drivers);
 }
 
 void AnalysisManager::getFunctionDrivers(const CallExpression& expr, const Symbol& containingSymbol,
@@ -206,8 +325,8 @@ void AnalysisManager::getFunctionDrivers(const CallExpression& expr, const Symbo
     auto& context = getState().context;
     auto analysis = getAnalyzedSubroutine(subroutine);
     if (!analysis) {
-        auto proc = std::make_unique<AnalyzedProcedure>(context, subroutine);
-        analysis = addAnalyzedSubroutine(subroutine, std::move(proc));
+        analysis = addAnalyzedSubroutine(subroutine,
+                                         analyzeSubroutine(context, subroutine, nullptr));
     }
 
     // For each driver in the function, create a new driver that points to the
@@ -266,8 +385,8 @@ void AnalysisManager::getTaskTimingControls(const CallExpression& expr,
     // Get analysis for the task.
     auto analysis = getAnalyzedSubroutine(subroutine);
     if (!analysis) {
-        auto proc = std::make_unique<AnalyzedProcedure>(getState().context, subroutine);
-        analysis = addAnalyzedSubroutine(subroutine, std::move(proc));
+        analysis = addAnalyzedSubroutine(
+            subroutine, analyzeSubroutine(getState().context, subroutine, nullptr));
     }
 
     // Add timing controls from the task to our list.
@@ -307,32 +426,296 @@ PendingAnalysis AnalysisManager::analyzeSymbol(const Symbol& symbol) {
         auto& inst = symbol.as<InstanceSymbol>();
         if (inst.getCanonicalBody()) {
             auto& state = getState();
-            driverTracker.noteNonCanonicalInstance(state.context, state.driverAlloc, inst);
+            driverTracker.noteNonCanonicalInstance(state.context, state.driverBuffer, inst);
         }
     }
 
     return PendingAnalysis(*this, symbol);
 }
 
-void AnalysisManager::analyzeScopeAsync(const Scope& scope) {
-    // Kick off a new analysis task if we haven't already seen
-    // this scope before.
-    if (analyzedScopes.try_emplace(&scope, std::nullopt)) {
+template<typename TFunc>
+void AnalysisManager::runTask(uint64_t cost, TFunc&& func) {
+    auto task = [this, cost, func = std::forward<TFunc>(func)]() mutable {
+        auto start = steady_clock::now();
+        func();
+
+        auto& stats = getState().stats;
+        stats.tasks++;
+        stats.estimatedCost += cost;
+        stats.busyTime += steady_clock::now() - start;
+    };
+
 #if defined(SLANG_USE_THREADS)
-        threadPool.detach_task([this, &scope] {
+    // Tasks are prioritized by the magnitude of their cost.
+    auto priority = BS::priority_t(std::bit_width(cost));
+    threadPool.detach_task(
+        [this, task = std::move(task)]() mutable {
             SLANG_TRY {
-                auto& result = analyzeScopeBlocking(scope);
-                analyzedScopes.visit(&scope, [&result](auto& item) { item.second = &result; });
+                task();
             }
             SLANG_CATCH(...) {
                 std::unique_lock<std::mutex> lock(mutex);
                 pendingException = std::current_exception();
             }
+        },
+        priority);
+#else
+    task();
+#endif
+}
+
+void AnalysisManager::analyzeScopeAsync(const Scope& scope) {
+    // Kick off a new analysis task if we haven't already seen
+    // this scope before.
+    if (analyzedScopes.try_emplace(&scope, std::nullopt)) {
+        auto cost = estimateCost(scope);
+        runTask(cost, [this, &scope, cost] {
+            TimeTraceScope timeScope("analyzeScope"sv,
+                                     [&] { return scope.asSymbol().getHierarchicalPath(); });
+
+            auto start = steady_clock::now();
+
+            std::unique_ptr<AnalysisCache::ScopeSession> cacheSession;
+            if (cache)
+                cacheSession = cache->beginScope(scope);
+
+            if (options.scopeSplitCost && cost >= options.scopeSplitCost && getThreadCount() > 1) {
+                analyzeScopeSplit(scope, std::move(cacheSession));
+            }
+            else {
+                publishScope(scope, analyzeScopeImpl(scope, nullptr, cacheSession.get()));
+                if (cacheSession)
+                    cacheSession->finish();
+            }
+            noteScopeTime(getState(), scope, start);
+        });
+    }
+}
+
+struct AnalysisManager::SplitScope {
+    AnalyzedScope& result;
+    std::unique_ptr<AnalysisCache::ScopeSession> cacheSession;
+    std::vector<const Symbol*> procedures;
+    std::vector<std::vector<AnalyzedProcedure>> batches;
+    std::atomic<size_t> remaining = 0;
+
+    SplitScope(AnalyzedScope& result, std::unique_ptr<AnalysisCache::ScopeSession> cacheSession) :
+        result(result), cacheSession(std::move(cacheSession)) {}
+};
+
+void AnalysisManager::analyzeScopeSplit(const Scope& scope,
+                                        std::unique_ptr<AnalysisCache::ScopeSession> cacheSession) {
+    // Visit the scope as usual, except that procedures are collected
+    // instead of being analyzed inline.
+    auto& state = getState();
+    auto split = std::make_shared<SplitScope>(*state.scopeAlloc.emplace(scope),
+                                              std::move(cacheSession));
+
+    AnalysisScopeVisitor visitor(state, split->result, nullptr);
+    visitor.deferredProcedures = &split->procedures;
+    for (auto& member : scope.members())
+        member.visit(visitor);
+
+    auto& procedures = split->procedures;
+    if (procedures.empty()) {
+        publishScope(scope, split->result);
+        if (split->cacheSession)
+            split->cacheSession->finish();
+        return;
+    }
+
+    if (split->cacheSession)
+        split->cacheSession->prepare(procedures.size());
+
+    // Divide the procedures into contiguous batches of roughly equal cost.
+    // Make a few batches per worker so that they can even out.
+    SmallVector<uint64_t> costs;
+    uint64_t totalCost = 0;
+    for (auto proc : procedures)
+        totalCost += costs.emplace_back(estimateCost(*proc));
+
+    auto numBatches = std::min(procedures.size(), getThreadCount() * 4);
+    auto batchCost = (totalCost + numBatches - 1) / numBatches;
+
+    SmallVector<std::pair<size_t, uint64_t>> batchEnds;
+    uint64_t currCost = 0;
+    for (size_t i = 0; i < procedures.size(); i++) {
+        currCost += costs[i];
+        if (currCost >= batchCost || i == procedures.size() - 1) {
+            batchEnds.emplace_back(i + 1, currCost);
+            currCost = 0;
+        }
+    }
+
+    split->batches.resize(batchEnds.size());
+    split->remaining = batchEnds.size();
+
+    size_t begin = 0;
+    for (size_t i = 0; i < batchEnds.size(); i++) {
+        auto [end, cost] = batchEnds[i];
+        runTask(cost, [this, &scope, split, i, begin, end] {
+            TimeTraceScope timeScope("analyzeProcedures"sv,
+                                     [&] { return scope.asSymbol().getHierarchicalPath(); });
+
+            auto start = steady_clock::now();
+            auto& batchState = getState();
+            auto& batch = split->batches[i];
+            batch.reserve(end - begin);
+            for (size_t j = begin; j < end; j++) {
+                analyzeProcedure(batchState, split->cacheSession.get(), j, *split->procedures[j],
+                                 nullptr, batch);
+            }
+            noteScopeTime(batchState, scope, start);
+
+            // The last batch to finish puts the results back together in order.
+            if (split->remaining.fetch_sub(1) == 1) {
+                auto& result = split->result;
+                result.procedures.reserve(split->procedures.size());
+                for (auto& b : split->batches) {
+                    for (auto& proc : b)
+                        result.procedures.emplace_back(std::move(proc));
+                }
+                publishScope(scope, result);
+                if (split->cacheSession)
+                    split->cacheSession->finish();
+            }
+        });
+        begin = end;
+    }
+}
+
+void AnalysisManager::analyzeProcedure(WorkerState& state,
+                                       AnalysisCache::ScopeSession* cacheSession, size_t index,
+                                       const Symbol& symbol,
+                                       const AnalyzedProcedure* parentProcedure,
+                                       std::vector<AnalyzedProcedure>& results) {
+    TimeTraceScope timeScope("analyzeProcedure"sv, [&] { return describeForTimeTrace(symbol); });
+    auto start = steady_clock::now();
+
+    if (cacheSession)
+        cacheSession->analyze(state.context, index, symbol, results);
+    else
+        results.emplace_back(state.context, symbol, parentProcedure);
+    driverTracker.add(state.context, state.driverBuffer, results.back());
+
+    if (auto profile = state.context.profile) {
+        profile->procedures.push_back(
+            {&symbol, nullptr, 1, 0, CaseAnalysisEngine::Auto, steady_clock::now() - start});
+    }
+}
+
+std::unique_ptr<AnalyzedProcedure> AnalysisManager::analyzeSubroutine(
+    AnalysisContext& context, const SubroutineSymbol& symbol,
+    const AnalyzedProcedure* parentProcedure) {
+
+    TimeTraceScope timeScope("analyzeProcedure"sv, [&] { return describeForTimeTrace(symbol); });
+    auto start = steady_clock::now();
+
+    auto result = std::make_unique<AnalyzedProcedure>(context, symbol, parentProcedure);
+    if (context.profile) {
+        context.profile->procedures.push_back(
+            {&symbol, nullptr, 1, 0, CaseAnalysisEngine::Auto, steady_clock::now() - start});
+    }
+    return result;
+}
+
+void AnalysisManager::noteScopeTime(WorkerState& state, const Scope& scope,
+                                    steady_clock::time_point start) {
+    if (auto profile = state.context.profile) {
+        profile->scopes.push_back({&scope.asSymbol(), nullptr, 1, 0, CaseAnalysisEngine::Auto,
+                                   steady_clock::now() - start});
+    }
+}
+
+void AnalysisManager::publishScope(const Scope& scope, const AnalyzedScope& result) {
+    analyzedScopes.visit(&scope, [&result](auto& item) { item.second = &result; });
+}
+
+void AnalysisManager::mergeDrivers() {
+    TimeTraceScope timeScope("mergeDrivers"sv, ""sv);
+
+    // Each worker has buffered the drivers it found; merge them into the
+    // tracker and check them for conflicts, one shard of symbols per task.
+    std::vector<DriverTracker::DriverBuffer*> buffers;
+    for (auto& state : workerStates)
+        buffers.push_back(&state.driverBuffer);
+
+    for (size_t shard = 0; shard < DriverTracker::NumShards; shard++) {
+        runTask(1, [this, &buffers, shard] {
+            auto& state = getState();
+            driverTracker.mergeShard(state.context, state.driverBuffer.alloc, buffers, shard);
         });
+    }
+    wait();
+}
+
+size_t AnalysisManager::getThreadCount() const {
+#if defined(SLANG_USE_THREADS)
+    return threadPool.get_thread_count();
 #else
-        auto& result = analyzeScopeBlocking(scope);
-        analyzedScopes.visit(&scope, [&result](auto& item) { item.second = &result; });
+    return 1;
 #endif
+}
+
+std::vector<AnalysisWorkerStats> AnalysisManager::getWorkerStats() const {
+    std::vector<AnalysisWorkerStats> result;
+    for (auto& state : workerStates)
+        result.push_back(state.stats);
+
+#if defined(SLANG_USE_THREADS)
+    // The last state is for threads outside of the pool,
+    // which don't run any analysis tasks.
+    result.pop_back();
+#endif
+    return result;
+}
+
+AnalysisProfile AnalysisManager::getProfile() const {
+    // Each worker records its own entries; merge the ones that refer to the same
+    // symbol or statement, since scopes can be split across workers and statements
+    // in unrolled loops are analyzed many times.
+    AnalysisProfile result;
+    auto merge = [&](std::vector<AnalysisProfileEntry> AnalysisProfile::* list) {
+        auto& entries = result.*list;
+        flat_hash_map<std::pair<const Symbol*, const Statement*>, size_t> indices;
+        for (auto& state : workerStates) {
+            for (auto& entry : state.profile.*list) {
+                auto [it, inserted] = indices.try_emplace({entry.symbol, entry.statement},
+                                                          entries.size());
+                if (inserted) {
+                    entries.push_back(entry);
+                }
+                else {
+                    auto& existing = entries[it->second];
+                    existing.count += entry.count;
+                    existing.steps += entry.steps;
+                    existing.time += entry.time;
+                }
+            }
+        }
+
+        std::ranges::stable_sort(entries,
+                                 [](auto& a, auto& b) { return a.time > b.time; });
+    };
+
+    merge(&AnalysisProfile::scopes);
+    merge(&AnalysisProfile::procedures);
+    merge(&AnalysisProfile::caseStatements);
+    merge(&AnalysisProfile::loops);
+    return result;
+}
+
+std::string AnalysisManager::describeProcedure(const Symbol& symbol) {
+    switch (symbol.kind) {
+        case SymbolKind::ProceduralBlock:
+            return fmt::format("{} in {}",
+                               SemanticFacts::getProcedureKindStr(
+                                   symbol.as<ProceduralBlockSymbol>().procedureKind),
+                               symbol.getHierarchicalPath());
+        case SymbolKind::ContinuousAssign:
+            return fmt::format("assign in {}", symbol.getHierarchicalPath());
+        default:
+            return symbol.getHierarchicalPath();
     }
 }
 
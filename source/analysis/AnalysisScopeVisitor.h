@@ -33,6 +33,13 @@ struct AnalysisScopeVisitor {
     AnalyzedScope& result;
     const AnalyzedProcedure* parentProcedure;
 
+    // If set, procedures are collected here to be analyzed
+    // separately instead of being analyzed inline.
+    std::vector<const Symbol*>* deferredProcedures = nullptr;
+
+    // If set, procedure results are reused from and recorded into an analysis cache.
+    AnalysisCache::ScopeSession* cacheSession = nullptr;
+
     AnalysisScopeVisitor(AnalysisManager::WorkerState& state, AnalyzedScope& scope,
                          const AnalyzedProcedure* parentProcedure) :
         state(state), context(state.context), manager(*context.manager), result(scope),
@@ -46,7 +53,7 @@ struct AnalysisScopeVisitor {
         visitExprs(symbol);
 
         for (auto conn : symbol.getPortConnections())
-            manager.driverTracker.add(state.context, state.driverAlloc, *conn, symbol);
+            manager.driverTracker.add(state.context, state.driverBuffer, *conn, symbol);
     }
 
     void visit(const CheckerInstanceSymbol& symbol) {
@@ -59,7 +66,7 @@ struct AnalysisScopeVisitor {
 
         for (auto& conn : symbol.getPortConnections()) {
             if (conn.formal.kind == SymbolKind::FormalArgument && conn.actual.index() == 0) {
-                manager.driverTracker.add(state.context, state.driverAlloc,
+                manager.driverTracker.add(state.context, state.driverBuffer,
                                           *std::get<0>(conn.actual), symbol);
             }
         }
@@ -71,7 +78,7 @@ struct AnalysisScopeVisitor {
         for (auto expr : symbol.getPortConnections()) {
             if (expr->kind == ExpressionKind::Assignment) {
                 auto& assign = expr->as<AssignmentExpression>();
-                manager.driverTracker.add(state.context, state.driverAlloc, assign.left(), symbol);
+                manager.driverTracker.add(state.context, state.driverBuffer, assign.left(), symbol);
             }
         }
     }
@@ -105,8 +112,13 @@ struct AnalysisScopeVisitor {
     template<typename T>
         requires(IsAnyOf<T, ProceduralBlockSymbol, ContinuousAssignSymbol>)
     void visit(const T& symbol) {
-        result.procedures.emplace_back(context, symbol, parentProcedure);
-        manager.driverTracker.add(state.context, state.driverAlloc, result.procedures.back());
+        if (deferredProcedures) {
+            deferredProcedures->push_back(&symbol);
+            return;
+        }
+
+        manager.analyzeProcedure(state, cacheSession, result.procedures.size(), symbol,
+                                 parentProcedure, result.procedures);
     }
 
     void visit(const SubroutineSymbol& symbol) {
@@ -118,7 +130,7 @@ struct AnalysisScopeVisitor {
 
         if (!manager.getAnalyzedSubroutine(symbol)) {
             manager.addAnalyzedSubroutine(
-                symbol, std::make_unique<AnalyzedProcedure>(context, symbol, parentProcedure));
+                symbol, manager.analyzeSubroutine(context, symbol, parentProcedure));
         }
 
         visitMembers(symbol);
@@ -151,18 +163,22 @@ struct AnalysisScopeVisitor {
         if (auto func = symbol.getResolutionFunction()) {
             auto proc = manager.getAnalyzedSubroutine(*func);
             if (!proc) {
-                auto newProc = std::make_unique<AnalyzedProcedure>(context, *func);
-                proc = manager.addAnalyzedSubroutine(*func, std::move(newProc));
+                proc = manager.addAnalyzedSubroutine(
+                    *func, manager.analyzeSubroutine(context, *func, nullptr));
             }
 
+            // Drivers aren't merged into the manager until analysis is done,
+            // so look at the ones recorded by the function itself.
             auto args = func->getArguments();
             if (args.size() == 1) {
-                auto drivers = manager.getDrivers(*args[0]);
-                if (!drivers.empty()) {
-                    auto& diag = context.addDiag(symbol, diag::NTResolveArgModify,
-                                                 drivers[0].first->getSourceRange());
-                    diag << symbol.name << args[0]->name;
-                    diag.addNote(diag::NoteReferencedHere, symbol.location);
+                for (auto& [valueSym, drivers] : proc->getDrivers()) {
+                    if (valueSym == args[0] && !drivers.empty()) {
+                        auto& diag = context.addDiag(symbol, diag::NTResolveArgModify,
+                                                     drivers[0].first->getSourceRange());
+                        diag << symbol.name << args[0]->name;
+                        diag.addNote(diag::NoteReferencedHere, symbol.location);
+                        break;
+                    }
                 }
             }
         }
@@ -212,7 +228,7 @@ struct AnalysisScopeVisitor {
             }
         }
         else if (symbol.kind == SymbolKind::ClockVar) {
-            manager.driverTracker.add(state.context, state.driverAlloc,
+            manager.driverTracker.add(state.context, state.driverBuffer,
                                       symbol.as<ClockVarSymbol>());
         }
     }
@@ -283,7 +299,7 @@ struct AnalysisScopeVisitor {
 
     void visit(const PortSymbol& symbol) {
         visitExprs(symbol);
-        manager.driverTracker.add(state.context, state.driverAlloc, symbol);
+        manager.driverTracker.add(state.context, state.driverBuffer, symbol);
     }
 
     void visit(const MultiPortSymbol& symbol) {
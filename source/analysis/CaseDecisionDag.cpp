@@ -7,22 +7,208 @@
 //------------------------------------------------------------------------------
 #include "slang/analysis/CaseDecisionDag.h"
 
+#include <bit>
 #include <numeric>
 
 namespace slang::analysis {
 
+namespace {
+
+// A list of cubes over a fixed number of bits. Each cube is stored as a
+// mask of the bits it cares about followed by the values of those bits,
+// each taking up `words` words. An input matches a cube when all of the
+// cared about bits are equal to the cube's value bits.
+class CubeList {
+public:
+    explicit CubeList(uint32_t words) : words(words) {}
+
+    size_t size() const { return data.size() / (2 * words); }
+    bool empty() const { return data.empty(); }
+
+    const uint64_t* care(size_t index) const { return &data[index * 2 * words]; }
+    const uint64_t* value(size_t index) const { return care(index) + words; }
+
+    void add(const uint64_t* care, const uint64_t* value) {
+        data.insert(data.end(), care, care + words);
+        data.insert(data.end(), value, value + words);
+    }
+
+    // Restricts every cube to the half of the input space where the given
+    // bit has the given value; cubes that don't intersect it are dropped.
+    CubeList cofactor(uint32_t bit, bool bitValue) const {
+        const uint32_t word = bit / 64;
+        const uint64_t mask = 1ull << (bit % 64);
+
+        CubeList result(words);
+        for (size_t i = 0; i < size(); i++) {
+            auto c = care(i);
+            auto v = value(i);
+            if (c[word] & mask) {
+                if (bool(v[word] & mask) != bitValue)
+                    continue;
+
+                result.add(c, v);
+                result.data[result.data.size() - 2 * words + word] &= ~mask;
+            }
+            else {
+                result.add(c, v);
+            }
+        }
+        return result;
+    }
+
+    // Restricts every cube to the space covered by the given cube;
+    // cubes that don't intersect it are dropped.
+    CubeList cofactor(const uint64_t* c, const uint64_t* v) const {
+        CubeList result(words);
+        for (size_t i = 0; i < size(); i++) {
+            if (!intersects(care(i), value(i), c, v))
+                continue;
+
+            result.add(care(i), value(i));
+            auto newCare = &result.data[result.data.size() - 2 * words];
+            for (uint32_t w = 0; w < words; w++)
+                newCare[w] &= ~c[w];
+        }
+        return result;
+    }
+
+    bool intersects(const uint64_t* c1, const uint64_t* v1, const uint64_t* c2,
+                    const uint64_t* v2) const {
+        for (uint32_t w = 0; w < words; w++) {
+            if ((v1[w] ^ v2[w]) & c1[w] & c2[w])
+                return false;
+        }
+        return true;
+    }
+
+    uint32_t words;
+    std::vector<uint64_t> data;
+};
+
+// Answers coverage questions about lists of cubes, counting the number
+// of steps taken so that callers can bail out of pathological inputs.
+class CubeEngine {
+public:
+    uint32_t steps = 0;
+
+    CubeEngine(uint32_t words, uint32_t maxSteps) : words(words), maxSteps(maxSteps) {}
+
+    bool gaveUp() const { return steps >= maxSteps; }
+
+    // Returns true if the cubes in the given list cover the entire input space.
+    // If the step limit is exceeded this returns true; callers must check gaveUp().
+    bool isTautology(CubeList list) {
+        if (++steps >= maxSteps)
+            return true;
+
+        std::vector<uint64_t> pos(words), neg(words);
+        while (true) {
+            if (list.empty())
+                return false;
+
+            // Gather the set of bits used in each polarity. Along the way, look
+            // for a cube that doesn't care about any bits, which covers everything,
+            // and sum up the fraction of the input space covered by each cube.
+            // If that sum is less than one there must be a gap somewhere.
+            std::ranges::fill(pos, 0);
+            std::ranges::fill(neg, 0);
+            double coverage = 0;
+            for (size_t i = 0; i < list.size(); i++) {
+                auto c = list.care(i);
+                auto v = list.value(i);
+                int caredBits = 0;
+                for (uint32_t w = 0; w < words; w++) {
+                    pos[w] |= c[w] & v[w];
+                    neg[w] |= c[w] & ~v[w];
+                    caredBits += std::popcount(c[w]);
+                }
+
+                if (caredBits == 0)
+                    return true;
+                coverage += std::ldexp(1.0, -caredBits);
+            }
+
+            if (coverage < 1.0)
+                return false;
+
+            // A bit that only appears in one polarity is unate; the cubes that
+            // use it are covered by the tautology if and only if the rest of the
+            // cubes are, so they can be dropped. Repeat until every remaining
+            // bit is binate.
+            bool anyUnate = false;
+            for (uint32_t w = 0; w < words; w++) {
+                pos[w] ^= neg[w];
+                anyUnate |= pos[w] != 0;
+            }
+
+            if (!anyUnate)
+                break;
+
+            CubeList binate(words);
+            for (size_t i = 0; i < list.size(); i++) {
+                auto c = list.care(i);
+                bool usesUnate = false;
+                for (uint32_t w = 0; w < words && !usesUnate; w++)
+                    usesUnate = (c[w] & pos[w]) != 0;
+
+                if (!usesUnate)
+                    binate.add(c, list.value(i));
+            }
+            list = std::move(binate);
+        }
+
+        // Split on the binate bit that is used by the most cubes.
+        uint32_t splitBit = 0;
+        uint32_t bestCount = 0;
+        std::vector<uint32_t> counts(words * 64);
+        for (size_t i = 0; i < list.size(); i++) {
+            auto c = list.care(i);
+            for (uint32_t w = 0; w < words; w++) {
+                for (uint64_t bits = c[w]; bits; bits &= bits - 1) {
+                    auto bit = w * 64 + (uint32_t)std::countr_zero(bits);
+                    if (++counts[bit] > bestCount) {
+                        bestCount = counts[bit];
+                        splitBit = bit;
+                    }
+                }
+            }
+        }
+
+        return isTautology(list.cofactor(splitBit, false)) &&
+               isTautology(list.cofactor(splitBit, true));
+    }
+
+private:
+    const uint32_t words;
+    const uint32_t maxSteps;
+};
+
+} // namespace
+
 CaseDecisionDag::CaseDecisionDag(std::span<const SVInt> clauses, uint32_t bitWidth, bool wildcardX,
-                                 uint32_t maxSteps) {
+                                 uint32_t maxSteps, CaseAnalysisEngine engine) :
+    engine(engine) {
     SLANG_ASSERT(bitWidth > 0);
 
-    std::vector<ClauseIndex> activeIndices(clauses.size());
-    std::iota(activeIndices.begin(), activeIndices.end(), 0);
-
 #if defined(SLANG_DEBUG)
     for (auto& clause : clauses)
         SLANG_ASSERT(clause.getBitWidth() == bitWidth);
 #endif
 
+    // The DAG is cheap for narrow case expressions, where it can
+    // never take more than a few hundred steps.
+    if (engine == CaseAnalysisEngine::Auto)
+        this->engine = bitWidth <= 8 ? CaseAnalysisEngine::Dag : CaseAnalysisEngine::Cube;
+
+    if (this->engine == CaseAnalysisEngine::Cube) {
+        buildCubes(clauses, bitWidth, wildcardX, maxSteps);
+        return;
+    }
+
+    std::vector<ClauseIndex> activeIndices(clauses.size());
+    std::iota(activeIndices.begin(), activeIndices.end(), 0);
+
     SVInt start(bitWidth, 0, false);
     build(0, clauses, bitWidth, wildcardX, maxSteps, start, std::move(activeIndices));
 
@@ -44,6 +230,112 @@ CaseDecisionDag::CaseDecisionDag(std::span<const SVInt> clauses, uint32_t bitWid
     });
 }
 
+void CaseDecisionDag::buildCubes(std::span<const SVInt> clauses, uint32_t bitWidth,
+                                 bool wildcardX, uint32_t maxSteps) {
+    const uint32_t words = (bitWidth + 63) / 64;
+
+    // Convert each clause to a cube. Clauses with bits that can't match any
+    // two-state input (X bits when X isn't a wildcard) never match anything.
+    CubeList cubes(words);
+    SmallVector<bool> valid;
+    std::vector<uint64_t> care(words), value(words);
+    for (auto& clause : clauses) {
+        std::ranges::fill(care, 0);
+        std::ranges::fill(value, 0);
+
+        bool isValid = true;
+        for (uint32_t bit = 0; bit < bitWidth; bit++) {
+            const auto p = clause[int32_t(bit)];
+            const uint64_t mask = 1ull << (bit % 64);
+            if (exactlyEqual(p, logic_t(1))) {
+                care[bit / 64] |= mask;
+                value[bit / 64] |= mask;
+            }
+            else if (exactlyEqual(p, logic_t(0))) {
+                care[bit / 64] |= mask;
+            }
+            else if (!exactlyEqual(p, logic_t::z) && !(wildcardX && exactlyEqual(p, logic_t::x))) {
+                isValid = false;
+            }
+        }
+
+        cubes.add(care.data(), value.data());
+        valid.push_back(isValid);
+    }
+
+    CubeEngine cubeEngine(words, maxSteps);
+    auto finish = [&] {
+        steps = cubeEngine.steps;
+        if (cubeEngine.gaveUp()) {
+            gaveUp = true;
+            unreachableClauses.clear();
+            overlappingClauses.clear();
+            counterexample.reset();
+            return true;
+        }
+        return false;
+    };
+
+    // A clause is unreachable if the clauses before it cover everything it matches.
+    CubeList allCubes(words);
+    for (size_t i = 0; i < clauses.size(); i++) {
+        auto index = (ClauseIndex)i;
+        if (!valid[i]) {
+            unreachableClauses.insert(index);
+            continue;
+        }
+
+        auto c = cubes.care(i);
+        auto v = cubes.value(i);
+        if (cubeEngine.isTautology(allCubes.cofactor(c, v)))
+            unreachableClauses.insert(index);
+        if (finish())
+            return;
+
+        allCubes.add(c, v);
+    }
+
+    // Pairs of reachable clauses overlap if their cubes intersect.
+    for (size_t i = 0; i < clauses.size(); i++) {
+        if (unreachableClauses.contains((ClauseIndex)i))
+            continue;
+
+        for (size_t j = i + 1; j < clauses.size(); j++) {
+            if (!unreachableClauses.contains((ClauseIndex)j) &&
+                cubes.intersects(cubes.care(i), cubes.value(i), cubes.care(j), cubes.value(j))) {
+                overlappingClauses.insert({(ClauseIndex)i, (ClauseIndex)j});
+            }
+        }
+    }
+
+    // If the clauses don't cover the entire input space, find the smallest
+    // input that isn't covered by choosing each bit in turn from the MSB,
+    // preferring zero whenever that half of the space still has a gap.
+    // This matches the counterexample that the DAG would find.
+    if (!cubeEngine.isTautology(allCubes)) {
+        std::vector<uint64_t> path(words);
+        for (uint32_t bit = bitWidth; bit > 0; bit--) {
+            auto zeroHalf = allCubes.cofactor(bit - 1, false);
+            if (!cubeEngine.isTautology(zeroHalf)) {
+                allCubes = std::move(zeroHalf);
+            }
+            else {
+                allCubes = allCubes.cofactor(bit - 1, true);
+                path[(bit - 1) / 64] |= 1ull << ((bit - 1) % 64);
+            }
+
+            if (finish())
+                return;
+        }
+
+        counterexample = SVInt(bitWidth,
+                               std::span(reinterpret_cast<const byte*>(path.data()),
+                                         path.size() * sizeof(uint64_t)),
+                               false);
+    }
+    finish();
+}
+
 void CaseDecisionDag::build(uint32_t level, std::span<const SVInt> clauses, uint32_t bitWidth,
                             bool wildcardX, uint32_t maxSteps, SVInt curPath,
                             std::vector<ClauseIndex>&& activeIndicesInput) {
@@ -13,12 +13,97 @@
 
 namespace slang::analysis {
 
+static uint64_t wordMask(uint64_t first, uint64_t last) {
+    // Mask covering bits [first, last] of a single word, with both
+    // indices taken modulo the word size.
+    uint64_t hi = ~0ull >> (63 - (last % 64));
+    return hi & (~0ull << (first % 64));
+}
+
+void DataFlowState::setDense(uint64_t first, uint64_t last) {
+    SLANG_ASSERT(first <= last);
+    auto firstWord = first / 64;
+    auto lastWord = last / 64;
+    if (lastWord >= dense.size())
+        dense.resize(lastWord + 1);
+
+    if (firstWord == lastWord) {
+        dense[firstWord] |= wordMask(first, last);
+        return;
+    }
+
+    dense[firstWord] |= wordMask(first, 63);
+    for (auto i = firstWord + 1; i < lastWord; i++)
+        dense[i] = ~0ull;
+    dense[lastWord] |= wordMask(0, last);
+}
+
+bool DataFlowState::allDense(uint64_t first, uint64_t last) const {
+    SLANG_ASSERT(first <= last);
+    auto firstWord = first / 64;
+    auto lastWord = last / 64;
+    if (lastWord >= dense.size())
+        return false;
+
+    if (firstWord == lastWord) {
+        auto mask = wordMask(first, last);
+        return (dense[firstWord] & mask) == mask;
+    }
+
+    auto mask = wordMask(first, 63);
+    if ((dense[firstWord] & mask) != mask)
+        return false;
+
+    for (auto i = firstWord + 1; i < lastWord; i++) {
+        if (dense[i] != ~0ull)
+            return false;
+    }
+
+    mask = wordMask(0, last);
+    return (dense[lastWord] & mask) == mask;
+}
+
+std::optional<std::pair<uint64_t, uint64_t>> DataFlowState::findDenseRun(uint64_t first,
+                                                                          uint64_t last) const {
+    if (dense.empty())
+        return std::nullopt;
+
+    last = std::min(last, dense.size() * 64 - 1);
+    if (first > last)
+        return std::nullopt;
+
+    // Find the first set bit at or after `first`.
+    auto word = first / 64;
+    uint64_t bits = dense[word] & (~0ull << (first % 64));
+    while (!bits) {
+        if (++word >= dense.size())
+            return std::nullopt;
+        bits = dense[word];
+    }
+
+    uint64_t start = word * 64 + (uint64_t)std::countr_zero(bits);
+    if (start > last)
+        return std::nullopt;
+
+    // Now find the first clear bit after the start of the run.
+    bits = ~dense[word] & (~0ull << (start % 64));
+    while (!bits) {
+        if (++word >= dense.size())
+            return std::pair{start, last};
+        bits = ~dense[word];
+    }
+
+    uint64_t end = word * 64 + (uint64_t)std::countr_zero(bits) - 1;
+    return std::pair{start, std::min(end, last)};
+}
+
 DataFlowAnalysis::DataFlowAnalysis(AnalysisContext& context, const Symbol& symbol,
                                    bool reportDiags) :
     AbstractFlowAnalysis(symbol, context.manager->getOptions(),
                          reportDiags ? &context.diagnostics : nullptr),
     context(context), bitMapAllocator(context.alloc), lspMapAllocator(context.alloc),
     lspVisitor(*this) {
+    profile = context.profile;
 }
 
 bool DataFlowAnalysis::isReferenced(const ValueSymbol& symbol, const Expression& lsp) const {
@@ -48,8 +133,16 @@ bool DataFlowAnalysis::isDefinitelyAssigned(const ValueSymbol& symbol) const {
     if (it == symbolToSlot.end())
         return false;
 
-    auto& assigned = getState().assigned;
-    return it->second < assigned.size() && !assigned[it->second].empty();
+    auto& symbolState = lvalues[it->second];
+    auto& currState = getState();
+    if (symbolState.denseWidth) {
+        auto offset = symbolState.stateIndex;
+        return currState.findDenseRun(offset, offset + symbolState.denseWidth - 1).has_value();
+    }
+
+    auto& assigned = currState.assigned;
+    return symbolState.stateIndex < assigned.size() &&
+           !assigned[symbolState.stateIndex].empty();
 }
 
 void DataFlowAnalysis::noteReference(const ValueSymbol& symbol, const Expression& lsp) {
@@ -62,7 +155,12 @@ void DataFlowAnalysis::noteReference(const ValueSymbol& symbol, const Expression
     if (!currState.reachable)
         return;
 
-    auto bounds = LSPUtilities::getBounds(lsp, getEvalContext(), symbol.getType());
+    std::optional<DriverBitRange> bounds;
+    if (&lsp == widenedLSP)
+        bounds = getWidenedBounds(lsp, symbol.getType());
+    else
+        bounds = LSPUtilities::getBounds(lsp, getEvalContext(), symbol.getType());
+
     if (!bounds) {
         // This probably cannot be hit given that we early out elsewhere for
         // invalid expressions.
@@ -72,17 +170,38 @@ void DataFlowAnalysis::noteReference(const ValueSymbol& symbol, const Expression
     if (isLValue) {
         auto [it, inserted] = symbolToSlot.try_emplace(&symbol, (uint32_t)lvalues.size());
         if (inserted) {
-            lvalues.emplace_back(symbol);
+            // Decide up front how this symbol's assigned bits will be tracked.
+            // Most symbols get a fixed range of bits in the dense state so that
+            // joins and meets can be done a word at a time; anything too large
+            // falls back to an interval map.
+            auto& lvalue = lvalues.emplace_back(symbol);
+            auto width = symbol.getType().getSelectableWidth();
+            if (width <= MaxDenseSymbolWidth && denseStateWidth + width <= MaxDenseStateWidth) {
+                lvalue.stateIndex = denseStateWidth;
+                lvalue.denseWidth = width;
+                denseStateWidth += width;
+            }
+            else {
+                lvalue.stateIndex = sparseStateCount++;
+            }
             SLANG_ASSERT(lvalues.size() == symbolToSlot.size());
         }
 
-        auto index = it->second;
-        if (index >= currState.assigned.size())
-            currState.assigned.resize(index + 1);
+        auto& lvalue = lvalues[it->second];
+        if (lvalue.denseWidth) {
+            SLANG_ASSERT(bounds->second < lvalue.denseWidth);
+            currState.setDense(lvalue.stateIndex + bounds->first,
+                               lvalue.stateIndex + bounds->second);
+        }
+        else {
+            auto index = lvalue.stateIndex;
+            if (index >= currState.assigned.size())
+                currState.assigned.resize(index + 1);
 
-        currState.assigned[index].unionWith(*bounds, {}, bitMapAllocator);
+            currState.assigned[index].unionWith(*bounds, {}, bitMapAllocator);
+        }
 
-        auto& lspMap = lvalues[index].assigned;
+        auto& lspMap = lvalue.assigned;
         for (auto lspIt = lspMap.find(*bounds); lspIt != lspMap.end();) {
             // If we find an existing entry that completely contains
             // the new bounds we can just keep that one and ignore the
@@ -107,6 +226,50 @@ void DataFlowAnalysis::noteReference(const ValueSymbol& symbol, const Expression
     }
 }
 
+std::optional<DriverBitRange> DataFlowAnalysis::getWidenedBounds(const Expression& lsp,
+                                                                 const Type& rootType) {
+    // The select covers everything in between the elements it
+    // selects in the first and last iterations of the loop.
+    auto& evalCtx = getEvalContext();
+    auto& loopVar = *widenedLSPVar;
+    auto local = evalCtx.createLocal(loopVar.symbol, loopVar.first);
+    auto first = LSPUtilities::getBounds(lsp, evalCtx, rootType);
+
+    *local = loopVar.last;
+    auto last = LSPUtilities::getBounds(lsp, evalCtx, rootType);
+    evalCtx.deleteLocal(loopVar.symbol);
+
+    // If the loop runs off the end of the selected range, fall back
+    // to treating the whole symbol as referenced.
+    if (!first || !last)
+        return DriverBitRange{0, rootType.getSelectableWidth() - 1};
+
+    return DriverBitRange{std::min(first->first, last->first),
+                          std::max(first->second, last->second)};
+}
+
+void DataFlowAnalysis::handle(const ElementSelectExpression& expr) {
+    // Inside a widened loop, an outermost select by the loop variable stands in
+    // for every element the loop visits, so it can still serve as the LSP even
+    // though its selector isn't constant.
+    if (!lspVisitor.currentLSP && !widenedLoopVars.empty()) {
+        if (auto loopVar = findWidenedLoopVar(expr.selector())) {
+            auto prevLSP = std::exchange(widenedLSP, &expr);
+            auto prevVar = std::exchange(widenedLSPVar, loopVar);
+            lspVisitor.currentLSP = &expr;
+            visit(expr.value());
+            widenedLSP = prevLSP;
+            widenedLSPVar = prevVar;
+
+            auto guard = saveLValueFlag();
+            visit(expr.selector());
+            return;
+        }
+    }
+
+    lspVisitor.handle(expr);
+}
+
 void DataFlowAnalysis::handle(const AssignmentExpression& expr) {
     // Note that this method mirrors the logic in the base class
     // handler but we need to track the LValue status of the lhs.
@@ -223,6 +386,13 @@ void DataFlowAnalysis::handleTiming(const TimingControl& timing) {
 
 void DataFlowAnalysis::joinState(DataFlowState& result, const DataFlowState& other) {
     if (result.reachable == other.reachable) {
+        // Intersect the assigned state across each variable.
+        if (result.dense.size() > other.dense.size())
+            result.dense.resize(other.dense.size());
+
+        for (size_t i = 0; i < result.dense.size(); i++)
+            result.dense[i] &= other.dense[i];
+
         if (result.assigned.size() > other.assigned.size())
             result.assigned.resize(other.assigned.size());
 
@@ -243,6 +413,12 @@ void DataFlowAnalysis::meetState(DataFlowState& result, const DataFlowState& oth
     }
 
     // Union the assigned state across each variable.
+    if (result.dense.size() < other.dense.size())
+        result.dense.resize(other.dense.size());
+
+    for (size_t i = 0; i < other.dense.size(); i++)
+        result.dense[i] |= other.dense[i];
+
     if (result.assigned.size() < other.assigned.size())
         result.assigned.resize(other.assigned.size());
 
@@ -255,6 +431,7 @@ void DataFlowAnalysis::meetState(DataFlowState& result, const DataFlowState& oth
 DataFlowState DataFlowAnalysis::copyState(const DataFlowState& source) {
     DataFlowState result;
     result.reachable = source.reachable;
+    result.dense.append(source.dense.begin(), source.dense.end());
     result.assigned.reserve(source.assigned.size());
     for (size_t i = 0; i < source.assigned.size(); i++)
         result.assigned.emplace_back(source.assigned[i].clone(bitMapAllocator));
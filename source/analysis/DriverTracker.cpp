@@ -18,30 +18,20 @@ namespace slang::analysis {
 
 using namespace ast;
 
-void DriverTracker::add(AnalysisContext& context, DriverAlloc& driverAlloc,
+void DriverTracker::add(AnalysisContext& context, DriverBuffer& buffer,
                         const AnalyzedProcedure& procedure) {
-    SmallVector<std::pair<const HierarchicalReference*, const ValueDriver*>> ifacePortRefs;
     for (auto& [valueSym, drivers] : procedure.getDrivers()) {
-        auto updateFunc = [&](auto& elem) {
-            for (auto& [driver, bounds] : drivers) {
-                auto ref = addDriver(context, driverAlloc, *elem.first, elem.second, *driver,
-                                     bounds);
-                if (ref) {
-                    // This driver is via an interface port so we need to
-                    // store and then apply it after we're done touching the
-                    // symbolDrivers map.
-                    ifacePortRefs.emplace_back(ref, driver);
-                }
+        for (auto& [driver, bounds] : drivers) {
+            if (auto ref = addDriver(buffer, *valueSym, *driver, bounds)) {
+                // This driver is via an interface port so we need
+                // to apply it to other instances as well.
+                noteInterfacePortDriver(context, buffer, *ref, *driver);
             }
-        };
-        symbolDrivers.try_emplace_and_visit(valueSym, updateFunc, updateFunc);
+        }
     }
-
-    for (auto& [ref, driver] : ifacePortRefs)
-        noteInterfacePortDriver(context, driverAlloc, *ref, *driver);
 }
 
-void DriverTracker::add(AnalysisContext& context, DriverAlloc& driverAlloc,
+void DriverTracker::add(AnalysisContext& context, DriverBuffer& buffer,
                         const PortConnection& connection, const Symbol& containingSymbol) {
     auto& port = connection.port;
     auto expr = connection.getExpression();
@@ -65,11 +55,10 @@ void DriverTracker::add(AnalysisContext& context, DriverAlloc& driverAlloc,
     if (expr->kind == ExpressionKind::Assignment)
         expr = &expr->as<AssignmentExpression>().left();
 
-    addDrivers(context, driverAlloc, *expr, DriverKind::Continuous, flags, containingSymbol);
+    addDrivers(context, buffer, *expr, DriverKind::Continuous, flags, containingSymbol);
 }
 
-void DriverTracker::add(AnalysisContext& context, DriverAlloc& driverAlloc,
-                        const PortSymbol& symbol) {
+void DriverTracker::add(AnalysisContext& context, DriverBuffer& buffer, const PortSymbol& symbol) {
     // This method adds driver *from* the port to the *internal*
     // symbol (or expression) that it connects to.
     auto dir = symbol.direction;
@@ -81,16 +70,16 @@ void DriverTracker::add(AnalysisContext& context, DriverAlloc& driverAlloc,
     SLANG_ASSERT(scope);
 
     if (auto expr = symbol.getInternalExpr()) {
-        addDrivers(context, driverAlloc, *expr, DriverKind::Continuous, flags, scope->asSymbol());
+        addDrivers(context, buffer, *expr, DriverKind::Continuous, flags, scope->asSymbol());
     }
     else if (auto is = symbol.internalSymbol) {
         auto nve = context.alloc.emplace<NamedValueExpression>(
             is->as<ValueSymbol>(), SourceRange{is->location, is->location + is->name.length()});
-        addDrivers(context, driverAlloc, *nve, DriverKind::Continuous, flags, scope->asSymbol());
+        addDrivers(context, buffer, *nve, DriverKind::Continuous, flags, scope->asSymbol());
     }
 }
 
-void DriverTracker::add(AnalysisContext& context, DriverAlloc& driverAlloc,
+void DriverTracker::add(AnalysisContext& context, DriverBuffer& buffer,
                         const ClockVarSymbol& symbol) {
     // Input clock vars don't have drivers.
     if (symbol.direction == ArgumentDirection::In)
@@ -100,36 +89,42 @@ void DriverTracker::add(AnalysisContext& context, DriverAlloc& driverAlloc,
     SLANG_ASSERT(scope);
 
     if (auto expr = symbol.getInitializer()) {
-        addDrivers(context, driverAlloc, *expr, DriverKind::Continuous, DriverFlags::ClockVar,
+        addDrivers(context, buffer, *expr, DriverKind::Continuous, DriverFlags::ClockVar,
                    scope->asSymbol());
     }
 }
 
-void DriverTracker::add(AnalysisContext& context, DriverAlloc& driverAlloc, const Expression& expr,
+void DriverTracker::add(AnalysisContext& context, DriverBuffer& buffer, const Expression& expr,
                         const Symbol& containingSymbol) {
-    addDrivers(context, driverAlloc, expr, DriverKind::Continuous, DriverFlags::None,
+    addDrivers(context, buffer, expr, DriverKind::Continuous, DriverFlags::None,
                containingSymbol);
 }
 
-void DriverTracker::add(AnalysisContext& context, DriverAlloc& driverAlloc,
+void DriverTracker::add(DriverBuffer& buffer,
                         std::span<const SymbolDriverListPair> symbolDriverList) {
     for (auto& [valueSym, drivers] : symbolDriverList) {
-        auto updateFunc = [&](auto& elem) {
-            for (auto& [driver, bounds] : drivers) {
-                auto ref = addDriver(context, driverAlloc, *elem.first, elem.second, *driver,
-                                     bounds);
-                SLANG_ASSERT(!ref);
-            }
-        };
-        symbolDrivers.try_emplace_and_visit(valueSym, updateFunc, updateFunc);
+        for (auto& [driver, bounds] : drivers) {
+            auto ref = addDriver(buffer, *valueSym, *driver, bounds);
+            SLANG_ASSERT(!ref);
+        }
     }
 }
 
-void DriverTracker::noteNonCanonicalInstance(AnalysisContext& context, DriverAlloc& driverAlloc,
+void DriverTracker::noteNonCanonicalInstance(AnalysisContext& context, DriverBuffer& buffer,
                                              const InstanceSymbol& instance) {
     auto canonical = instance.getCanonicalBody();
     SLANG_ASSERT(canonical);
 
+    // Side effects only come from drivers applied through interface ports,
+    // so there's no need to track instances of bodies that don't have any.
+    // This avoids contending on the same entry for every instance in large
+    // arrays of identical modules.
+    if (std::ranges::none_of(canonical->getPortList(), [](const Symbol* port) {
+            return port->kind == SymbolKind::InterfacePort;
+        })) {
+        return;
+    }
+
     std::vector<InstanceState::IfacePortDriver> ifacePortDrivers;
     auto updater = [&](auto& item) {
         auto& state = item.second;
@@ -141,10 +136,10 @@ void DriverTracker::noteNonCanonicalInstance(AnalysisContext& context, DriverAll
     instanceMap.try_emplace_and_visit(canonical, updater, updater);
 
     for (auto& ifacePortDriver : ifacePortDrivers)
-        applyInstanceSideEffect(context, driverAlloc, ifacePortDriver, instance);
+        applyInstanceSideEffect(context, buffer, ifacePortDriver, instance);
 }
 
-void DriverTracker::propagateModportDrivers(AnalysisContext& context, DriverAlloc& driverAlloc) {
+void DriverTracker::propagateModportDrivers(AnalysisContext& context, DriverBuffer& buffer) {
     while (true) {
         concurrent_map<const ast::ValueSymbol*, DriverList> localCopy;
         std::swap(modportPortDrivers, localCopy);
@@ -154,13 +149,13 @@ void DriverTracker::propagateModportDrivers(AnalysisContext& context, DriverAllo
         localCopy.cvisit_all([&](auto& item) {
             if (auto expr = item.first->template as<ModportPortSymbol>().getConnectionExpr()) {
                 for (auto& [originalDriver, _] : item.second)
-                    propagateModportDriver(context, driverAlloc, *expr, *originalDriver);
+                    propagateModportDriver(context, buffer, *expr, *originalDriver);
             }
         });
     }
 }
 
-void DriverTracker::propagateModportDriver(AnalysisContext& context, DriverAlloc& driverAlloc,
+void DriverTracker::propagateModportDriver(AnalysisContext& context, DriverBuffer& buffer,
                                            const Expression& connectionExpr,
                                            const ValueDriver& originalDriver) {
     // TODO: this is clunky, but we need to be able to glue the outer select
@@ -194,11 +189,11 @@ void DriverTracker::propagateModportDriver(AnalysisContext& context, DriverAlloc
             break;
     }
 
-    addDrivers(context, driverAlloc, connectionExpr, originalDriver.kind, originalDriver.flags,
+    addDrivers(context, buffer, connectionExpr, originalDriver.kind, originalDriver.flags,
                *originalDriver.containingSymbol, initialLSP);
 }
 
-void DriverTracker::addDrivers(AnalysisContext& context, DriverAlloc& driverAlloc,
+void DriverTracker::addDrivers(AnalysisContext& context, DriverBuffer& buffer,
                                const Expression& expr, DriverKind driverKind,
                                bitmask<DriverFlags> driverFlags, const Symbol& containingSymbol,
                                const Expression* initialLSP) {
@@ -218,29 +213,62 @@ void DriverTracker::addDrivers(AnalysisContext& context, DriverAlloc& driverAllo
             auto driver = context.alloc.emplace<ValueDriver>(driverKind, lsp, containingSymbol,
                                                              driverFlags);
 
-            auto updateFunc = [&](auto& elem) {
-                if (auto ref = addDriver(context, driverAlloc, *elem.first, elem.second, *driver,
-                                         *bounds)) {
-                    ifacePortRefs.emplace_back(ref, driver);
-                }
-            };
-            symbolDrivers.try_emplace_and_visit(&symbol, updateFunc, updateFunc);
+            if (auto ref = addDriver(buffer, symbol, *driver, *bounds))
+                ifacePortRefs.emplace_back(ref, driver);
         },
         initialLSP);
 
     for (auto& [ref, driver] : ifacePortRefs)
-        noteInterfacePortDriver(context, driverAlloc, *ref, *driver);
+        noteInterfacePortDriver(context, buffer, *ref, *driver);
+}
+
+void DriverTracker::mergeShard(AnalysisContext& context, DriverAlloc& driverAlloc,
+                               std::span<DriverBuffer* const> buffers, size_t shard) {
+    SLANG_ASSERT(shard < NumShards);
+
+    std::vector<DriverBuffer::PendingDriver> pending;
+    for (auto buffer : buffers) {
+        auto& entries = buffer->shards[shard];
+        pending.insert(pending.end(), entries.begin(), entries.end());
+        entries.clear();
+    }
+
+    // Merge drivers in source order so that the same driver is reported as
+    // the conflicting one no matter which worker happened to find it first.
+    // Drivers at the same location (i.e. from different generate blocks)
+    // are ordered by the bits they drive, and otherwise kept in the order
+    // in which they were added.
+    std::ranges::sort(pending, [](auto& a, auto& b) {
+        auto aLoc = a.driver->getSourceRange().start();
+        auto bLoc = b.driver->getSourceRange().start();
+        if (aLoc != bLoc)
+            return aLoc < bLoc;
+        if (a.bounds != b.bounds)
+            return a.bounds < b.bounds;
+        return a.order < b.order;
+    });
+
+    auto& driverMaps = symbolDrivers[shard];
+    for (auto& entry : pending) {
+        mergeDriver(context, driverAlloc, *entry.symbol, driverMaps[entry.symbol], *entry.driver,
+                    entry.bounds);
+    }
 }
 
 DriverList DriverTracker::getDrivers(const ValueSymbol& symbol) const {
     DriverList drivers;
-    symbolDrivers.cvisit(&symbol, [&drivers](auto& item) {
-        for (auto it = item.second.begin(); it != item.second.end(); ++it)
-            drivers.emplace_back(*it, it.bounds());
-    });
+    auto& driverMaps = symbolDrivers[getShard(symbol)];
+    if (auto it = driverMaps.find(&symbol); it != driverMaps.end()) {
+        for (auto mapIt = it->second.begin(); mapIt != it->second.end(); ++mapIt)
+            drivers.emplace_back(*mapIt, mapIt.bounds());
+    }
     return drivers;
 }
 
+size_t DriverTracker::getShard(const ValueSymbol& symbol) {
+    return hash<const ValueSymbol*>()(&symbol) % NumShards;
+}
+
 static std::string getLSPName(const ValueSymbol& symbol, const ValueDriver& driver) {
     FormatBuffer buf;
     EvalContext evalContext(symbol);
@@ -374,13 +402,10 @@ static bool handleOverlap(AnalysisContext& context, const ValueSymbol& symbol,
     return false;
 }
 
-const HierarchicalReference* DriverTracker::addDriver(
-    AnalysisContext& context, DriverAlloc& driverAlloc, const ValueSymbol& symbol,
-    SymbolDriverMap& driverMap, const ValueDriver& driver, DriverBitRange bounds) {
-
-    auto scope = symbol.getParentScope();
-    SLANG_ASSERT(scope);
-
+const HierarchicalReference* DriverTracker::addDriver(DriverBuffer& buffer,
+                                                      const ValueSymbol& symbol,
+                                                      const ValueDriver& driver,
+                                                      DriverBitRange bounds) {
     // If this driver is made via an interface port connection we want to
     // note that fact as it represents a side effect for the instance that
     // is not captured in the port connections.
@@ -403,6 +428,19 @@ const HierarchicalReference* DriverTracker::addDriver(
         return result;
     }
 
+    // The driver gets checked against all others once analysis is done
+    // and the buffers are merged.
+    auto order = nextDriverOrder.fetch_add(1, std::memory_order_relaxed);
+    buffer.shards[getShard(symbol)].push_back({&symbol, &driver, bounds, order});
+    return result;
+}
+
+void DriverTracker::mergeDriver(AnalysisContext& context, DriverAlloc& driverAlloc,
+                                const ValueSymbol& symbol, SymbolDriverMap& driverMap,
+                                const ValueDriver& driver, DriverBitRange bounds) {
+    auto scope = symbol.getParentScope();
+    SLANG_ASSERT(scope);
+
     if (driverMap.empty()) {
         // The first time we add a driver, check whether there is also an
         // initializer expression that should count as a driver as well.
@@ -435,7 +473,7 @@ const HierarchicalReference* DriverTracker::addDriver(
 
         if (driverMap.empty()) {
             driverMap.insert(bounds, &driver, driverAlloc);
-            return result;
+            return;
         }
     }
 
@@ -515,10 +553,9 @@ const HierarchicalReference* DriverTracker::addDriver(
     }
 
     driverMap.insert(bounds, &driver, driverAlloc);
-    return result;
 }
 
-void DriverTracker::noteInterfacePortDriver(AnalysisContext& context, DriverAlloc& driverAlloc,
+void DriverTracker::noteInterfacePortDriver(AnalysisContext& context, DriverBuffer& buffer,
                                             const HierarchicalReference& ref,
                                             const ValueDriver& driver) {
     SLANG_ASSERT(ref.isViaIfacePort());
@@ -544,7 +581,7 @@ void DriverTracker::noteInterfacePortDriver(AnalysisContext& context, DriverAllo
     instanceMap.try_emplace_and_visit(&symbol.as<InstanceBodySymbol>(), updater, updater);
 
     for (auto inst : nonCanonicalInstances)
-        applyInstanceSideEffect(context, driverAlloc, ifacePortDriver, *inst);
+        applyInstanceSideEffect(context, buffer, ifacePortDriver, *inst);
 
     // If this driver's target is through another interface port we should
     // recursively follow it to the parent connection.
@@ -552,7 +589,7 @@ void DriverTracker::noteInterfacePortDriver(AnalysisContext& context, DriverAllo
     if (expr && expr->kind == ExpressionKind::ArbitrarySymbol) {
         auto& connRef = expr->as<ArbitrarySymbolExpression>().hierRef;
         if (connRef.isViaIfacePort())
-            noteInterfacePortDriver(context, driverAlloc, connRef.join(context.alloc, ref), driver);
+            noteInterfacePortDriver(context, buffer, connRef.join(context.alloc, ref), driver);
     }
 }
 
@@ -671,7 +708,7 @@ static const Symbol* retargetIfacePort(const HierarchicalReference& ref,
     return symbol;
 }
 
-void DriverTracker::applyInstanceSideEffect(AnalysisContext& context, DriverAlloc& driverAlloc,
+void DriverTracker::applyInstanceSideEffect(AnalysisContext& context, DriverBuffer& buffer,
                                             const InstanceState::IfacePortDriver& ifacePortDriver,
                                             const InstanceSymbol& instance) {
     auto& ref = *ifacePortDriver.ref;
@@ -687,11 +724,8 @@ void DriverTracker::applyInstanceSideEffect(AnalysisContext& context, DriverAllo
         if (!bounds)
             return;
 
-        auto updateFunc = [&](auto& elem) {
-            auto ref = addDriver(context, driverAlloc, *elem.first, elem.second, *driver, *bounds);
-            SLANG_ASSERT(!ref);
-        };
-        symbolDrivers.try_emplace_and_visit(&valueSym, updateFunc, updateFunc);
+        auto ref = addDriver(buffer, valueSym, *driver, *bounds);
+        SLANG_ASSERT(!ref);
     }
 }
 
@@ -21,6 +21,25 @@ Diagnostic& ASTDiagMap::add(Diagnostic diag, bool& isNew) {
     return it->second.back();
 }
 
+static size_t getDiagMemoryUsage(const Diagnostic& diag) {
+    size_t result = diag.args.capacity() * sizeof(Diagnostic::Arg) +
+                    diag.ranges.capacity() * sizeof(SourceRange) +
+                    diag.notes.capacity() * sizeof(Diagnostic);
+    for (auto& note : diag.notes)
+        result += getDiagMemoryUsage(note);
+    return result;
+}
+
+size_t ASTDiagMap::getMemoryUsage() const {
+    size_t result = map.bucket_count() * sizeof(decltype(map)::value_type);
+    for (auto& [key, diagList] : map) {
+        result += diagList.capacity() * sizeof(Diagnostic);
+        for (auto& diag : diagList)
+            result += getDiagMemoryUsage(diag);
+    }
+    return result;
+}
+
 Diagnostics ASTDiagMap::coalesce(const SourceManager* sourceManager) {
     Diagnostics results;
     for (auto& [key, diagList] : map) {
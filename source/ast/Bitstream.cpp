@@ -313,6 +313,18 @@ static void packBitstream(ConstantValue& value, SmallVectorBase<ConstantValue*>&
         if (!value.str().empty())
             packed.push_back(&value);
     }
+    else if (value.isRunArray()) {
+        // Expanding integral elements gives a dense array, which can then
+        // be packed in one piece.
+        value = value.runArray()->expand();
+        packBitstream(value, packed);
+    }
+    else if (value.isDenseArray()) {
+        // The elements are already laid out in bit-stream order.
+        SVInt bits = std::move(value.denseArray()->bits);
+        value = std::move(bits);
+        packed.push_back(&value);
+    }
     else if (value.isUnpacked()) {
         for (auto& cv : value.elements())
             packBitstream(cv, packed);
@@ -333,6 +345,23 @@ static void packBitstream(ConstantValue& value, SmallVectorBase<ConstantValue*>&
 
 using PackIterator = ConstantValue* const*;
 
+/// Concatenates all of the pieces of a packed bit-stream into a single integer.
+static SVInt flattenPacked(std::span<ConstantValue* const> packed) {
+    SmallVector<SVInt> buffer;
+    buffer.reserve(packed.size());
+    for (auto cv : packed) {
+        if (cv->isString())
+            buffer.emplace_back(cv->convertToInt().integer());
+        else
+            buffer.emplace_back(std::move(cv->integer()));
+    }
+
+    if (buffer.size() == 1)
+        return std::move(buffer.front());
+
+    return SVInt::concat(buffer);
+}
+
 static SVInt slicePacked(PackIterator& iter, const PackIterator iterEnd, uint64_t& bit,
                          uint64_t width) {
     if (iter == iterEnd) {
@@ -341,11 +370,13 @@ static SVInt slicePacked(PackIterator& iter, const PackIterator iterEnd, uint64_
         return SVInt(bitwidth_t(width), 0, false); // filling with zero bits on the right
     }
 
-    ConstantValue cp = **iter;
-    if (cp.isString())
-        cp = cp.convertToInt();
+    // Avoid copying the whole value just to slice a few bits out of it;
+    // packed dense arrays in particular can be very wide.
+    ConstantValue strInt;
+    if ((*iter)->isString())
+        strInt = (*iter)->convertToInt();
 
-    auto& ci = cp.integer();
+    const SVInt& ci = strInt ? strInt.integer() : (*iter)->integer();
     SLANG_ASSERT(bit < ci.getBitWidth());
     uint64_t msb = ci.getBitWidth() - bit - 1;
     uint64_t lsb = std::min<uint64_t>(bit + width, ci.getBitWidth());
@@ -359,7 +390,7 @@ static SVInt slicePacked(PackIterator& iter, const PackIterator iterEnd, uint64_
     }
 
     if (lsb == 0 && msb == ci.getBitWidth() - 1)
-        return std::move(ci);
+        return ci;
 
     return ci.slice(static_cast<int32_t>(msb), static_cast<int32_t>(lsb));
 }
@@ -439,7 +470,15 @@ static ConstantValue unpackBitstream(const Type& type, PackIterator& iter,
         else {
             auto& fsua = ct.as<FixedSizeUnpackedArrayType>();
             auto& elem = fsua.elementType;
-            for (auto width = fsua.range.width(); width > 0; width--)
+            auto count = fsua.range.width();
+            if (elem.isIntegral() && SVDenseArray::canStore(count, elem.getBitWidth())) {
+                // Integral elements can be sliced out of the stream all at once.
+                auto bits = concatPacked(count * elem.getBitWidth(), elem.isFourState());
+                bits.setSigned(false);
+                return SVDenseArray(std::move(bits), elem.getBitWidth(), elem.isSigned());
+            }
+
+            for (auto width = count; width > 0; width--)
                 buffer.emplace_back(unpackBitstream(elem, iter, iterEnd, bit, dynamicSize));
         }
 
@@ -643,6 +682,21 @@ ConstantValue Bitstream::reOrder(ConstantValue&& value, uint64_t sliceSize, uint
     if (packed.empty())
         return std::move(value);
 
+    if (totalWidth <= SVInt::MAX_BITS) {
+        // Gather the whole stream into one contiguous integer so that blocks can be
+        // moved around a word at a time instead of being sliced out one by one.
+        SVInt bits = flattenPacked(packed);
+        bits.setSigned(false);
+        if (unpackWidth && unpackWidth < totalWidth) // left-aligned so trim rightmost
+            bits = bits.slice(int32_t(totalWidth - 1), int32_t(totalWidth - unpackWidth));
+
+        // For unpack, the first (rightmost) block may be smaller than the slice size.
+        // For pack, it's the last block instead.
+        uint64_t firstBlock = unpackWidth && (unpackWidth % sliceSize) ? unpackWidth % sliceSize
+                                                                         : sliceSize;
+        return bits.reverseSlices(bitwidth_t(sliceSize), bitwidth_t(firstBlock));
+    }
+
     size_t rightIndex = packed.size() - 1; // Right-to-left
     uint64_t rightWidth = packed.back()->getBitstreamWidth();
     uint64_t extraBits = 0;
@@ -692,12 +746,16 @@ ConstantValue Bitstream::reOrder(ConstantValue&& value, uint64_t sliceSize, uint
         // "rightWidth" bits of packed[rightIndex].
         auto iter = std::cbegin(packed) + index;
         if (slice) {
+            // The slice always runs to the end of packed[index], so this
+            // also advances the iterator past it.
             auto bit = width - slice;
             result.emplace_back(slicePacked(iter, std::cend(packed), bit, slice));
             width -= slice;
         }
+        else {
+            iter++;
+        }
 
-        iter++;
         auto nextIndex = index;
         while (++index < rightIndex)
             result.emplace_back(std::move(**iter++));
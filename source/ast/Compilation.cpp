@@ -22,6 +22,7 @@
 #include "slang/syntax/SyntaxTree.h"
 #include "slang/text/CharInfo.h"
 #include "slang/text/SourceManager.h"
+#include "slang/util/ConcurrentMap.h"
 #include "slang/util/TimeTrace.h"
 
 using namespace slang::parsing;
@@ -37,9 +38,71 @@ const PackageSymbol& createStdPackage(Compilation&);
 
 namespace slang::ast {
 
+struct Compilation::CallMemoTable {
+    struct Key {
+        const SubroutineSymbol* subroutine;
+        std::vector<ConstantValue> args;
+    };
+
+    // Used to look up entries without copying the argument values.
+    struct KeyRef {
+        const SubroutineSymbol* subroutine;
+        std::span<const ConstantValue> args;
+    };
+
+    struct Hash {
+        using is_transparent = void;
+
+        size_t operator()(const Key& key) const {
+            return (*this)(KeyRef{key.subroutine, key.args});
+        }
+
+        size_t operator()(const KeyRef& key) const {
+            size_t h = 0;
+            hash_combine(h, key.subroutine);
+            for (auto& arg : key.args)
+                hash_combine(h, arg.hash());
+            return h;
+        }
+    };
+
+    struct Equal {
+        using is_transparent = void;
+
+        template<typename TLeft, typename TRight>
+        bool operator()(const TLeft& left, const TRight& right) const {
+            return left.subroutine == right.subroutine && std::ranges::equal(left.args, right.args);
+        }
+    };
+
+    concurrent_map<Key, ConstantValue, Hash, Equal> results;
+    std::atomic<uint64_t> hits = 0;
+    std::atomic<uint64_t> misses = 0;
+};
+
+ConstEvalCost& ConstEvalCost::operator+=(const ConstEvalCost& other) {
+    calls += other.calls;
+    memoHits += other.memoHits;
+    selfSteps += other.selfSteps;
+    totalSteps += other.totalSteps;
+    selfTime += other.selfTime;
+    totalTime += other.totalTime;
+    return *this;
+}
+
+struct Compilation::ConstEvalProfileTable {
+    using Key = std::pair<const SubroutineSymbol*, SourceLocation>;
+    concurrent_map<Key, ConstEvalCost> costs;
+};
+
 Compilation::Compilation(const Bag& options, const SourceLibrary* defaultLib) :
-    options(options.getOrDefault<CompilationOptions>()), tempDiag({}, {}), netAliasAllocator(*this),
-    defaultLibPtr(defaultLib) {
+    options(options.getOrDefault<CompilationOptions>()), identifiers(IdentifierTable::getDefault()),
+    symbolAllocs(SymbolKind_traits::values.size()),
+    expressionAllocs(ExpressionKind_traits::values.size()), tempDiag({}, {}),
+    netAliasAllocator(*this), defaultLibPtr(defaultLib) {
+
+    callMemo = std::make_unique<CallMemoTable>();
+    constEvalProfile = std::make_unique<ConstEvalProfileTable>();
 
     // Construct all built-in types.
     auto& bi = slang::ast::builtins::Builtins::Instance;
@@ -142,7 +205,7 @@ Compilation::Compilation(const Bag& options, const SourceLibrary* defaultLib) :
 
     // Register the built-in std package.
     stdPkg = &builtins::createStdPackage(*this);
-    packageMap.emplace(stdPkg->name, stdPkg);
+    packageMap.emplace(identifiers.intern(stdPkg->name), stdPkg);
 
     // Register the built-in gate types.
     builtins::registerGateTypes(*this);
@@ -259,6 +322,22 @@ std::span<const std::shared_ptr<SyntaxTree>> Compilation::getSyntaxTrees() const
     return syntaxTrees;
 }
 
+std::unique_ptr<Compilation> Compilation::fork(const Bag& newOptions) const {
+    // If we own our default library then the fork needs its own,
+    // since it can outlive this compilation.
+    auto result = std::make_unique<Compilation>(newOptions,
+                                                defaultLibMem ? nullptr : defaultLibPtr);
+
+    // Trees synthesized from our parameter override options are always added
+    // last, and are skipped since the fork will create its own as needed.
+    SLANG_ASSERT(numOptionSyntaxTrees <= syntaxTrees.size());
+    auto numTrees = syntaxTrees.size() - numOptionSyntaxTrees;
+    for (size_t i = 0; i < numTrees; i++)
+        result->addSyntaxTree(syntaxTrees[i]);
+
+    return result;
+}
+
 std::span<const CompilationUnitSymbol* const> Compilation::getCompilationUnits() const {
     return compilationUnits;
 }
@@ -278,9 +357,10 @@ std::vector<const Symbol*> Compilation::getDefinitions() const {
 
 std::vector<const PackageSymbol*> Compilation::getPackages() const {
     std::vector<const PackageSymbol*> result;
-    for (auto& [name, pkg] : packageMap) {
+    for (auto& [_, pkg] : packageMap) {
         result.insert(
-            std::ranges::upper_bound(result, name, {}, [](auto item) { return item->name; }), pkg);
+            std::ranges::upper_bound(result, pkg->name, {}, [](auto item) { return item->name; }),
+            pkg);
     }
     return result;
 }
@@ -432,7 +512,8 @@ const RootSymbol& Compilation::getRoot(bool skipDefParamsAndBinds) {
             }
 
             if (!onlyConfig) {
-                if (auto defIt = definitionMap.find(std::tuple{searchName, root.get()});
+                if (auto defIt = definitionMap.find(
+                        std::tuple{identifiers.find(searchName), root.get()});
                     defIt != definitionMap.end()) {
 
                     const DefinitionSymbol* foundDef = nullptr;
@@ -585,7 +666,8 @@ Compilation::DefinitionLookupResult Compilation::tryGetDefinition(std::string_vi
         resolvedConfig = inst->parentInstance->resolvedConfig;
 
     // Always search in the root scope to start. Most definitions are global.
-    auto it = definitionMap.find({lookupName, root.get()});
+    auto nameId = identifiers.find(lookupName);
+    auto it = definitionMap.find({nameId, root.get()});
     if (it == definitionMap.end()) {
         // If there's a config it might be able to provide an
         // override for this cell name.
@@ -599,7 +681,7 @@ Compilation::DefinitionLookupResult Compilation::tryGetDefinition(std::string_vi
     if (it->second.second) {
         auto searchScope = &scope;
         do {
-            auto scopeIt = definitionMap.find({lookupName, searchScope});
+            auto scopeIt = definitionMap.find({nameId, searchScope});
             if (scopeIt != definitionMap.end()) {
                 it = scopeIt;
                 break;
@@ -648,10 +730,13 @@ Compilation::DefinitionLookupResult Compilation::getDefinition(std::string_view
                                                                SourceRange sourceRange,
                                                                DiagCode code) const {
     std::pair<DefinitionLookupResult, bool> result;
-    if (auto it = definitionMap.find({lookupName, root.get()}); it != definitionMap.end())
+    if (auto it = definitionMap.find({identifiers.find(lookupName), root.get()});
+        it != definitionMap.end()) {
         result = resolveConfigRules(lookupName, scope, nullptr, &configRule, it->second.first);
-    else
+    }
+    else {
         result = resolveConfigRules(lookupName, scope, nullptr, &configRule, {});
+    }
 
     if (!result.first.definition && !result.second) {
         // No definition found and no error issued, so issue one ourselves.
@@ -728,7 +813,7 @@ const DefinitionSymbol* Compilation::getDefinition(const ConfigBlockSymbol& conf
                                                    std::string_view cellName,
                                                    std::string_view libName,
                                                    SourceRange sourceRange) const {
-    if (auto defIt = definitionMap.find(std::tuple{cellName, root.get()});
+    if (auto defIt = definitionMap.find(std::tuple{identifiers.find(cellName), root.get()});
         defIt != definitionMap.end()) {
 
         const DefinitionSymbol* foundDef = nullptr;
@@ -847,10 +932,12 @@ void Compilation::insertDefinition(Symbol& symbol, const Scope& scope) {
     // it to the root scope instead so that lookups from other compilation units will find it.
     auto targetScope = scope.asSymbol().kind == SymbolKind::CompilationUnit ? root.get() : &scope;
     const bool isRoot = targetScope == root.get();
-    auto key = std::tuple(symbol.name, targetScope);
     if (symbol.name.empty())
         return;
 
+    auto nameId = identifiers.intern(symbol.name);
+    auto key = std::tuple(nameId, targetScope);
+
     if (auto it = definitionMap.find(key); it != definitionMap.end()) {
         // There is already a definition with this name in this scope.
         // If we're not at the root scope, it's a straightforward error.
@@ -934,12 +1021,12 @@ void Compilation::insertDefinition(Symbol& symbol, const Scope& scope) {
     }
     else {
         // Record the fact that we have nested modules with this name.
-        definitionMap[std::tuple(symbol.name, root.get())].second = true;
+        definitionMap[std::tuple(nameId, root.get())].second = true;
     }
 }
 
 const PackageSymbol* Compilation::getPackage(std::string_view lookupName) const {
-    auto it = packageMap.find(lookupName);
+    auto it = packageMap.find(identifiers.find(lookupName));
     if (it == packageMap.end())
         return nullptr;
     return it->second;
@@ -956,7 +1043,7 @@ const PackageSymbol& Compilation::createPackage(const Scope& scope,
     auto& package = PackageSymbol::fromSyntax(scope, syntax, *metadata.defaultNetType,
                                               metadata.timeScale);
 
-    auto [it, inserted] = packageMap.emplace(package.name, &package);
+    auto [it, inserted] = packageMap.emplace(identifiers.intern(package.name), &package);
     if (!inserted && !package.name.empty() &&
         scope.asSymbol().kind == SymbolKind::CompilationUnit) {
         auto& diag = scope.addDiag(diag::Redefinition, package.location);
@@ -1657,6 +1744,130 @@ const Diagnostics& Compilation::getAllDiagnostics() {
     return *cachedAllDiagnostics;
 }
 
+size_t CompilationMemoryStats::getTotalReserved() const {
+    size_t result = syntaxTrees + diagnostics + sideTables;
+    for (auto& arena : arenas)
+        result += arena.reserved;
+    return result;
+}
+
+template<typename TKind, typename TCounter>
+static void collectKindUsage(const std::vector<TCounter>& counters,
+                             std::vector<CompilationMemoryStats::KindUsage<TKind>>& results) {
+    for (size_t i = 0; i < counters.size(); i++) {
+        if (auto count = counters[i].count.load(std::memory_order_relaxed))
+            results.push_back({TKind(i), count, counters[i].bytes.load(std::memory_order_relaxed)});
+    }
+
+    std::ranges::sort(results, [](auto& a, auto& b) { return a.bytes > b.bytes; });
+}
+
+template<typename TMap>
+static size_t getTableMemoryUsage(const TMap& map) {
+    return map.bucket_count() * sizeof(typename TMap::value_type);
+}
+
+CompilationMemoryStats Compilation::getMemoryStats() const {
+    CompilationMemoryStats stats;
+    auto addArena = [&](std::string_view name, const BumpAllocator& alloc) {
+        stats.arenas.push_back({name, alloc.getBytesUsed(), alloc.getBytesReserved()});
+    };
+
+    addArena("main"sv, *this);
+    addArena("symbolMaps"sv, symbolMapAllocator);
+    addArena("pointerMaps"sv, pointerMapAllocator);
+    addArena("constants"sv, constantAllocator);
+    addArena("genericClasses"sv, genericClassAllocator);
+    addArena("assertionDetails"sv, assertionDetailsAllocator);
+    addArena("configBlocks"sv, configBlockAllocator);
+    addArena("wildcardImports"sv, wildcardImportAllocator);
+
+    collectKindUsage<SymbolKind>(symbolAllocs, stats.symbols);
+    collectKindUsage<ExpressionKind>(expressionAllocs, stats.expressions);
+
+    for (auto& tree : syntaxTrees)
+        stats.syntaxTrees += tree->allocator().getBytesReserved();
+
+    stats.types = typeBytes.load(std::memory_order_relaxed);
+    stats.constants = constantAllocator.getBytesUsed();
+
+    stats.diagnostics = diagMap.getMemoryUsage();
+    for (auto& diags : {&cachedParseDiagnostics, &cachedSemanticDiagnostics,
+                        &cachedAllDiagnostics}) {
+        if (*diags)
+            stats.diagnostics += (*diags)->capacity() * sizeof(Diagnostic);
+    }
+
+    auto addTables = [&](auto&... maps) {
+        ((stats.sideTables += getTableMemoryUsage(maps)), ...);
+    };
+    addTables(referenceStatusMap, definitionMap, vectorTypeCache, arrayTypeCache, knownTypes,
+              knownNetTypes, packageMap, methodMap, instanceSideEffectMap, attributeMap,
+              syntaxMetadata, outOfBlockDecls, gateMap, definitionFromSyntax,
+              globalInstantiations, defaultClockingMap, globalClockingMap, defaultDisableMap,
+              configBlocks, configBySyntax, libraryNameMap, instancesWithDefBinds, externDefMap,
+              netAliases, subroutineNameMap);
+    stats.sideTables += callMemo->results.size() *
+                        sizeof(std::pair<const CallMemoTable::Key, ConstantValue>);
+    stats.sideTables += constEvalProfile->costs.size() *
+                        sizeof(std::pair<const ConstEvalProfileTable::Key, ConstEvalCost>);
+
+    return stats;
+}
+
+CallMemoStats Compilation::getCallMemoStats() const {
+    CallMemoStats stats;
+    stats.hits = callMemo->hits;
+    stats.misses = callMemo->misses;
+    stats.entries = callMemo->results.size();
+    return stats;
+}
+
+ConstEvalProfile Compilation::getConstEvalProfile() const {
+    ConstEvalProfile profile;
+    constEvalProfile->costs.cvisit_all([&](auto& item) {
+        auto& [subroutine, location] = item.first;
+        auto& list = location ? profile.callSites : profile.functions;
+        list.push_back({subroutine, location, item.second});
+    });
+
+    auto sortBy = [](auto& list, auto steps, auto time) {
+        std::ranges::sort(list, [&](auto& a, auto& b) {
+            return std::tie(a.cost.*steps, a.cost.*time) > std::tie(b.cost.*steps, b.cost.*time);
+        });
+    };
+    sortBy(profile.functions, &ConstEvalCost::selfSteps, &ConstEvalCost::selfTime);
+    sortBy(profile.callSites, &ConstEvalCost::totalSteps, &ConstEvalCost::totalTime);
+    return profile;
+}
+
+void Compilation::recordConstEvalCost(const SubroutineSymbol& subroutine,
+                                      SourceLocation callLocation,
+                                      const ConstEvalCost& cost) const {
+    constEvalProfile->costs.emplace_or_visit(std::pair{&subroutine, callLocation}, cost,
+                                             [&](auto& item) { item.second += cost; });
+}
+
+std::optional<ConstantValue> Compilation::findMemoizedCall(
+    const SubroutineSymbol& subroutine, std::span<const ConstantValue> args) const {
+    std::optional<ConstantValue> result;
+    callMemo->results.cvisit(CallMemoTable::KeyRef{&subroutine, args},
+                             [&](auto& item) { result = item.second; });
+
+    if (result)
+        callMemo->hits++;
+    else
+        callMemo->misses++;
+    return result;
+}
+
+void Compilation::memoizeCall(const SubroutineSymbol& subroutine,
+                              std::span<const ConstantValue> args,
+                              const ConstantValue& result) const {
+    callMemo->results.emplace(CallMemoTable::Key{&subroutine, {args.begin(), args.end()}},
+                              result);
+}
+
 void Compilation::addDiagnostics(const Diagnostics& diagnostics) {
     SLANG_ASSERT(!isFrozen());
     for (auto& diag : diagnostics)
@@ -1755,12 +1966,12 @@ const Type& Compilation::getType(bitwidth_t width, bitmask<IntegralFlags> flags)
     if (it != vectorTypeCache.end())
         return *it->second;
 
-    SLANG_ASSERT(!isFrozen());
-
-    auto type = emplace<PackedArrayType>(getScalarType(flags), ConstantRange{int32_t(width - 1), 0},
-                                         width);
-    vectorTypeCache.emplace_hint(it, key, type);
-    return *type;
+    // Go through the array type cache so that vectors declared via syntax
+    // with the same range end up sharing this type object.
+    auto& type = getPackedArrayType(getScalarType(flags), ConstantRange{int32_t(width - 1), 0},
+                                    width);
+    vectorTypeCache.emplace(key, &type);
+    return type;
 }
 
 const Type& Compilation::getScalarType(bitmask<IntegralFlags> flags) const {
@@ -1769,6 +1980,51 @@ const Type& Compilation::getScalarType(bitmask<IntegralFlags> flags) const {
     return *ptr;
 }
 
+template<typename T, typename... Args>
+const Type& Compilation::getOrCreateArrayType(SymbolKind kind, const Type& elementType,
+                                              uint64_t discriminator, Args&&... args) {
+    auto key = std::tuple(&elementType, kind, discriminator);
+    if (auto it = arrayTypeCache.find(key); it != arrayTypeCache.end())
+        return *it->second;
+
+    SLANG_ASSERT(!isFrozen());
+
+    auto type = emplace<T>(elementType, std::forward<Args>(args)...);
+    arrayTypeCache.emplace(key, type);
+    return *type;
+}
+
+static uint64_t getRangeKey(ConstantRange range) {
+    return (uint64_t(uint32_t(range.left)) << 32) | uint32_t(range.right);
+}
+
+const Type& Compilation::getPackedArrayType(const Type& elementType, ConstantRange range,
+                                            bitwidth_t fullWidth) {
+    return getOrCreateArrayType<PackedArrayType>(SymbolKind::PackedArrayType, elementType,
+                                                 getRangeKey(range), range, fullWidth);
+}
+
+const Type& Compilation::getUnpackedArrayType(const Type& elementType, ConstantRange range,
+                                              uint64_t selectableWidth, uint64_t bitstreamWidth) {
+    return getOrCreateArrayType<FixedSizeUnpackedArrayType>(
+        SymbolKind::FixedSizeUnpackedArrayType, elementType, getRangeKey(range), range,
+        selectableWidth, bitstreamWidth);
+}
+
+const Type& Compilation::getDynamicArrayType(const Type& elementType) {
+    return getOrCreateArrayType<DynamicArrayType>(SymbolKind::DynamicArrayType, elementType, 0);
+}
+
+const Type& Compilation::getAssociativeArrayType(const Type& elementType, const Type* indexType) {
+    return getOrCreateArrayType<AssociativeArrayType>(SymbolKind::AssociativeArrayType, elementType,
+                                                      reinterpret_cast<uintptr_t>(indexType),
+                                                      indexType);
+}
+
+const Type& Compilation::getQueueType(const Type& elementType, uint32_t maxBound) {
+    return getOrCreateArrayType<QueueType>(SymbolKind::QueueType, elementType, maxBound, maxBound);
+}
+
 const NetType& Compilation::getNetType(TokenKind kind) const {
     auto it = knownNetTypes.find(kind);
     return it == knownNetTypes.end() ? *knownNetTypes.find(TokenKind::Unknown)->second
@@ -1835,6 +2091,7 @@ void Compilation::parseParamOverrides(
 
                     if (tree->diagnostics().empty() && tree->root().kind == SyntaxKind::DefParam) {
                         addSyntaxTree(std::move(tree));
+                        numOptionSyntaxTrees++;
                         continue;
                     }
                 }
@@ -2066,7 +2323,7 @@ void Compilation::checkElemTimeScale(std::optional<TimeScale> timeScale, SourceR
             checkElemTimeScale(def->timeScale, syntax.header->name.range());
         }
 
-        for (auto [name, package] : packageMap) {
+        for (auto [_, package] : packageMap) {
             if (auto syntax = package->getSyntax()) {
                 checkElemTimeScale(package->timeScale,
                                    syntax->as<ModuleDeclarationSyntax>().header->name.range());
@@ -2426,6 +2683,19 @@ void Compilation::resolveDefParamsAndBinds() {
         return false;
     };
 
+    // Each iteration below builds a throwaway elaboration of the design. Only the
+    // parts of the hierarchy that can contain defparams or bind directives need to
+    // be elaborated, so figure out which definitions those are up front. Configs
+    // can remap instance names arbitrarily so in that case everything is visited.
+    std::optional<flat_hash_set<const SyntaxNode*>> relevantDefs;
+    if (configBySyntax.empty()) {
+        DefParamSourceVisitor sourceVisitor;
+        for (auto& tree : syntaxTrees)
+            tree->root().visit(sourceVisitor);
+        relevantDefs = sourceVisitor.getRelevantDefs();
+    }
+    auto relevantDefsPtr = relevantDefs ? &*relevantDefs : nullptr;
+
     // [23.10.4.1] gives an algorithm for elaboration in the face of defparams.
     // Specifically, we need to resolve all possible defparams at one "level" of
     // hierarchy before moving on to a deeper level, where a "level" in this case
@@ -2457,7 +2727,10 @@ void Compilation::resolveDefParamsAndBinds() {
         };
 
         while (true) {
-            DefParamVisitor v(options.maxInstanceDepth, generateLevel);
+            TimeTraceScope iterScope("defParamDiscovery"sv,
+                                     [&] { return fmt::format("level {}", generateLevel); });
+
+            DefParamVisitor v(options.maxInstanceDepth, generateLevel, relevantDefsPtr);
             initialClone.getRoot(/* skipDefParamsAndBinds */ true).visit(v);
             if (checkProblem(v))
                 return;
@@ -2494,10 +2767,14 @@ void Compilation::resolveDefParamsAndBinds() {
         // give up due to the potential of cyclical references.
         bool allSame = true;
         for (uint32_t i = 0; i < options.maxDefParamSteps; i++) {
+            TimeTraceScope iterScope("defParamIteration"sv, [&] {
+                return fmt::format("level {} step {}", generateLevel, i);
+            });
+
             Compilation c({}, defaultLibPtr);
             cloneInto(c);
 
-            DefParamVisitor v(options.maxInstanceDepth, generateLevel);
+            DefParamVisitor v(options.maxInstanceDepth, generateLevel, relevantDefsPtr);
             c.getRoot(/* skipDefParamsAndBinds */ true).visit(v);
             if (checkProblem(v))
                 return;
@@ -2586,7 +2863,7 @@ std::pair<Compilation::DefinitionLookupResult, bool> Compilation::resolveConfigR
     }
 
     if (!id.targetConfig) {
-        if (auto overrideDefIt = definitionMap.find({id.name, root.get()});
+        if (auto overrideDefIt = definitionMap.find({identifiers.find(id.name), root.get()});
             overrideDefIt != definitionMap.end()) {
             // There are definitions with this name; find the one that
             // matches our target library.
@@ -11,6 +11,7 @@
 #include "slang/ast/EvalContext.h"
 #include "slang/diagnostics/CompilationDiags.h"
 #include "slang/diagnostics/DeclarationsDiags.h"
+#include "slang/syntax/SyntaxVisitor.h"
 #include "slang/util/TimeTrace.h"
 
 namespace slang::ast {
@@ -674,8 +675,10 @@ struct DiagnosticVisitor : public ASTVisitor<DiagnosticVisitor, false, false> {
 // with the compilation by Scope::addMembers and then get processed after we finish
 // visiting the tree.
 struct DefParamVisitor : public ASTVisitor<DefParamVisitor, false, false> {
-    DefParamVisitor(size_t maxInstanceDepth, size_t generateLevel) :
-        maxInstanceDepth(maxInstanceDepth), generateLevel(generateLevel) {}
+    DefParamVisitor(size_t maxInstanceDepth, size_t generateLevel,
+                    const flat_hash_set<const syntax::SyntaxNode*>* relevantDefs = nullptr) :
+        maxInstanceDepth(maxInstanceDepth), generateLevel(generateLevel),
+        relevantDefs(relevantDefs) {}
 
     void handle(const RootSymbol& symbol) { visitDefault(symbol); }
     void handle(const CompilationUnitSymbol& symbol) { visitDefault(symbol); }
@@ -699,13 +702,24 @@ struct DefParamVisitor : public ASTVisitor<DefParamVisitor, false, false> {
             return;
         }
 
+        // If nothing underneath this instance can declare a defparam or bind directive
+        // then there's no need to elaborate it. Instances with override nodes are always
+        // visited since binds can inject new instances into them.
+        auto& definition = symbol.getDefinition();
+        if (relevantDefs && !symbol.body.hierarchyOverrideNode &&
+            definition.bindDirectives.empty() && !relevantDefs->contains(definition.getSyntax())) {
+            if (generateDepth <= generateLevel)
+                numBlocksSeen++;
+            return;
+        }
+
         bool inserted = false;
         const bool wasInRecursive = inRecursiveInstance;
         if (!inRecursiveInstance) {
             // If the instance's definition is already in the active set,
             // we potentially have an infinitely recursive instantiation and
             // need to go all the way to the maximum depth to find out.
-            inserted = activeInstances.emplace(&symbol.getDefinition()).second;
+            inserted = activeInstances.emplace(&definition).second;
             if (!inserted)
                 inRecursiveInstance = true;
         }
@@ -721,7 +735,7 @@ struct DefParamVisitor : public ASTVisitor<DefParamVisitor, false, false> {
 
         inRecursiveInstance = wasInRecursive;
         if (inserted)
-            activeInstances.erase(&symbol.getDefinition());
+            activeInstances.erase(&definition);
     }
 
     void handle(const GenerateBlockSymbol& symbol) {
@@ -762,6 +776,115 @@ struct DefParamVisitor : public ASTVisitor<DefParamVisitor, false, false> {
     size_t generateDepth = 0;
     bool inRecursiveInstance = false;
     const InstanceSymbol* hierarchyProblem = nullptr;
+    const flat_hash_set<const syntax::SyntaxNode*>* relevantDefs;
+};
+
+// Finds the set of module, interface, and program declarations that can contribute
+// defparams or bind directives to the design, either directly or by (transitively)
+// instantiating some other declaration that does. This is purely syntactic and
+// conservative: all declarations with a given name are treated alike.
+class DefParamSourceVisitor : public syntax::SyntaxVisitor<DefParamSourceVisitor> {
+public:
+    void handle(const syntax::ModuleDeclarationSyntax& syntax) {
+        auto name = syntax.header->name.valueText();
+        auto [it, inserted] = nameMap.try_emplace(name, infos.size());
+        if (inserted)
+            infos.emplace_back();
+
+        // Nested declarations can be implicitly instantiated by their parent.
+        if (!stack.empty())
+            infos[stack.back()].instantiated.push_back(name);
+
+        decls.emplace_back(&syntax, it->second);
+        stack.push_back(it->second);
+        visitDefault(syntax);
+        stack.pop_back();
+    }
+
+    void handle(const syntax::DefParamSyntax&) { markCurrent(); }
+    void handle(const syntax::BindDirectiveSyntax&) { markCurrent(); }
+
+    void handle(const syntax::HierarchyInstantiationSyntax& syntax) {
+        if (!stack.empty() && syntax.type.kind == parsing::TokenKind::Identifier)
+            infos[stack.back()].instantiated.push_back(syntax.type.valueText());
+        visitDefault(syntax);
+    }
+
+    flat_hash_set<const syntax::SyntaxNode*> getRelevantDefs() {
+        // The visitor is also responsible for diagnosing runaway recursive
+        // instantiations, so anything that can reach a cycle is relevant too.
+        // Repeatedly peel off declarations that only instantiate already peeled
+        // (or unknown) ones; whatever is left over can reach a cycle.
+        std::vector<bool> acyclic(infos.size());
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            for (size_t i = 0; i < infos.size(); i++) {
+                if (acyclic[i])
+                    continue;
+
+                bool leaf = std::ranges::all_of(infos[i].instantiated, [&](auto name) {
+                    auto it = nameMap.find(name);
+                    return it == nameMap.end() || acyclic[it->second];
+                });
+
+                if (leaf) {
+                    acyclic[i] = true;
+                    changed = true;
+                }
+            }
+        }
+
+        for (size_t i = 0; i < infos.size(); i++) {
+            if (!acyclic[i])
+                infos[i].relevant = true;
+        }
+
+        // Propagate relevance from instantiated declarations up to their
+        // instantiators until nothing changes.
+        changed = true;
+        while (changed) {
+            changed = false;
+            for (auto& info : infos) {
+                if (info.relevant)
+                    continue;
+
+                for (auto name : info.instantiated) {
+                    auto it = nameMap.find(name);
+                    if (it != nameMap.end() && infos[it->second].relevant) {
+                        info.relevant = true;
+                        changed = true;
+                        break;
+                    }
+                }
+            }
+        }
+
+        flat_hash_set<const syntax::SyntaxNode*> results;
+        for (auto [syntax, index] : decls) {
+            if (infos[index].relevant)
+                results.emplace(syntax);
+        }
+        return results;
+    }
+
+private:
+    struct Info {
+        SmallVector<std::string_view> instantiated;
+        bool relevant = false;
+    };
+
+    void markCurrent() {
+        // Mark every enclosing declaration, since nested declarations
+        // can be implicitly instantiated without appearing by name.
+        for (auto index : stack)
+            infos[index].relevant = true;
+    }
+
+    flat_hash_map<std::string_view, size_t> nameMap;
+    std::vector<Info> infos;
+    std::vector<std::pair<const syntax::ModuleDeclarationSyntax*, size_t>> decls;
+    SmallVector<size_t> stack;
 };
 
 InstanceCacheKey::InstanceCacheKey(const InstanceSymbol& symbol, bool& valid,
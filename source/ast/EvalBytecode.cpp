@@ -0,0 +1,1112 @@
+//------------------------------------------------------------------------------
+// EvalBytecode.cpp
+// Bytecode compiler and interpreter for constant functions
+//
+// SPDX-FileCopyrightText: Michael Popoloski
+// SPDX-License-Identifier: MIT
+//------------------------------------------------------------------------------
+#include "EvalBytecode.h"
+
+#include "slang/ast/ASTVisitor.h"
+#include "slang/ast/Compilation.h"
+#include "slang/ast/EvalContext.h"
+#include "slang/diagnostics/ExpressionsDiags.h"
+#include "slang/diagnostics/NumericDiags.h"
+
+namespace {
+
+using namespace slang;
+using namespace slang::ast;
+
+using ER = Statement::EvalResult;
+using Op = EvalBytecode::Op;
+using Instr = EvalBytecode::Instr;
+
+constexpr uint32_t NoReg = EvalBytecode::NoReg;
+constexpr uint32_t NoTarget = EvalBytecode::NoTarget;
+
+// While compiling, registers are tagged with their kind in the top bits;
+// they get flattened into a single index space once we know the final counts.
+enum class RegKind : uint32_t { Local, Temp, Const };
+constexpr uint32_t RegKindShift = 30;
+constexpr uint32_t RegIndexMask = (1u << RegKindShift) - 1;
+
+uint32_t makeReg(RegKind kind, uint32_t index) {
+    SLANG_ASSERT(index <= RegIndexMask);
+    return (uint32_t(kind) << RegKindShift) | index;
+}
+
+RegKind regKind(uint32_t reg) {
+    return RegKind(reg >> RegKindShift);
+}
+
+bool hasSideEffects(const Expression& expr) {
+    bool result = false;
+    auto visitor = makeVisitor([&](auto&, const AssignmentExpression&) { result = true; },
+                               [&](auto& v, const UnaryExpression& unary) {
+                                   if (OpInfo::isLValue(unary.op))
+                                       result = true;
+                                   else
+                                       v.visitDefault(unary);
+                               });
+    expr.visit(visitor);
+    return result;
+}
+
+bool hasLValueReference(const Expression& expr) {
+    bool result = false;
+    auto visitor = makeVisitor([&](auto&, const LValueReferenceExpression&) { result = true; });
+    expr.visit(visitor);
+    return result;
+}
+
+bool isFallible(Op op) {
+    switch (op) {
+        case Op::CheckCall:
+        case Op::Call:
+        case Op::EvalExpr:
+        case Op::ExecStmt:
+            return true;
+        default:
+            return false;
+    }
+}
+
+class BytecodeCompiler {
+public:
+    BytecodeCompiler(Compilation& compilation, const SubroutineSymbol& subroutine) :
+        compilation(compilation), subroutine(subroutine) {}
+
+    const EvalBytecode* compile() {
+        // Disabling a named block requires unwinding through the enclosing
+        // blocks, which is left to the tree-walking evaluator.
+        auto& body = subroutine.getBody();
+        bool hasDisable = false;
+        body.visit(makeVisitor([&](auto&, const DisableStatement&) { hasDisable = true; }));
+        if (hasDisable)
+            return nullptr;
+
+        for (auto formal : subroutine.getArguments())
+            addSlot(*formal);
+
+        SLANG_ASSERT(subroutine.returnValVar);
+        retSlot = addSlot(*subroutine.returnValVar);
+
+        compileStmt(body);
+        emit({.op = Op::Exit, .sub = uint8_t(ER::Success)});
+        return finish();
+    }
+
+private:
+    struct LoopTargets {
+        // Instructions to patch with the loop's exit / continue
+        // locations, along with whether to patch the second target.
+        SmallVector<std::pair<uint32_t, bool>> breaks;
+        SmallVector<std::pair<uint32_t, bool>> continues;
+    };
+
+    struct Checkpoint {
+        size_t codeSize;
+        uint32_t tempTop;
+        uint32_t lastLabel;
+        uint32_t numFallible;
+    };
+
+    uint32_t addSlot(const ValueSymbol& symbol) {
+        auto reg = makeReg(RegKind::Local, numLocals++);
+        slots[&symbol] = reg;
+        return reg;
+    }
+
+    std::optional<uint32_t> findSlot(const Expression& expr) const {
+        if (expr.kind != ExpressionKind::NamedValue)
+            return std::nullopt;
+
+        auto it = slots.find(&expr.as<NamedValueExpression>().symbol);
+        if (it == slots.end())
+            return std::nullopt;
+        return it->second;
+    }
+
+    uint32_t allocTemp() {
+        auto reg = makeReg(RegKind::Temp, tempTop++);
+        maxTemps = std::max(maxTemps, tempTop);
+        return reg;
+    }
+
+    uint32_t addConstant(const ConstantValue& value) {
+        constants.push_back(&value);
+        return makeReg(RegKind::Const, uint32_t(constants.size() - 1));
+    }
+
+    uint32_t addConstant(ConstantValue&& value) {
+        return addConstant(*compilation.allocConstant(std::move(value)));
+    }
+
+    uint32_t emit(Instr instr) {
+        if (isFallible(instr.op))
+            numFallible++;
+
+        code.push_back(instr);
+        return uint32_t(code.size() - 1);
+    }
+
+    uint32_t emitJump(Op op, uint32_t cond = NoReg) { return emit({.op = op, .a = cond}); }
+
+    void emitStep(const Statement& stmt) {
+        Instr instr{.op = Op::Step};
+        instr.location = stmt.sourceRange.start();
+        emit(instr);
+    }
+
+    uint32_t bindLabel() {
+        lastLabel = uint32_t(code.size());
+        return lastLabel;
+    }
+
+    void patch(uint32_t index, uint32_t target) { code[index].target = target; }
+
+    Checkpoint checkpoint() const { return {code.size(), tempTop, lastLabel, numFallible}; }
+
+    void rollback(const Checkpoint& cp) {
+        code.resize(cp.codeSize);
+        tempTop = cp.tempTop;
+        lastLabel = cp.lastLabel;
+        numFallible = cp.numFallible;
+    }
+
+    // Copies a local into a temporary so that a later side effect in
+    // a sibling expression can't change the value out from under us.
+    uint32_t stabilize(uint32_t reg) {
+        if (regKind(reg) != RegKind::Local)
+            return reg;
+
+        auto temp = allocTemp();
+        emit({.op = Op::Move, .dst = temp, .a = reg});
+        return temp;
+    }
+
+    uint32_t fallback(const Expression& expr, bool discard) {
+        if (compoundTarget != NoReg && hasLValueReference(expr))
+            lvalueRefInFallback = true;
+
+        Instr instr{.op = Op::EvalExpr, .dst = discard ? NoReg : allocTemp()};
+        instr.node = &expr;
+        emit(instr);
+        return instr.dst;
+    }
+
+    uint32_t compileExpr(const Expression& expr, bool discard = false) {
+        if (auto cv = expr.getConstant(); cv && !cv->bad())
+            return addConstant(*cv);
+
+        if (!expr.bad()) {
+            std::optional<uint32_t> result;
+            if (expr.kind == ExpressionKind::Call)
+                result = compileCall(expr.as<CallExpression>());
+            else if (expr.type->isIntegral())
+                result = compileIntegral(expr, discard);
+
+            if (result)
+                return *result;
+        }
+
+        return fallback(expr, discard);
+    }
+
+    void compileExprInto(const Expression& expr, uint32_t dst) {
+        auto reg = compileExpr(expr);
+        if (reg == dst)
+            return;
+
+        // If the value was just computed into a temporary, have the
+        // instruction that produced it write to the destination directly.
+        if (regKind(reg) == RegKind::Temp && !code.empty() && lastLabel != code.size() &&
+            code.back().dst == reg) {
+            switch (code.back().op) {
+                case Op::Move:
+                case Op::Unary:
+                case Op::Binary:
+                case Op::Convert:
+                case Op::Select:
+                case Op::Concat:
+                case Op::Merge:
+                case Op::Call:
+                case Op::EvalExpr:
+                    code.back().dst = dst;
+                    return;
+                default:
+                    break;
+            }
+        }
+
+        emit({.op = Op::Move, .dst = dst, .a = reg});
+    }
+
+    std::optional<uint32_t> compileIntegral(const Expression& expr, bool discard) {
+        switch (expr.kind) {
+            case ExpressionKind::IntegerLiteral:
+                return addConstant(expr.as<IntegerLiteral>().getValue());
+            case ExpressionKind::UnbasedUnsizedIntegerLiteral:
+                return addConstant(expr.as<UnbasedUnsizedIntegerLiteral>().getValue());
+            case ExpressionKind::NamedValue:
+                return findSlot(expr);
+            case ExpressionKind::LValueReference:
+                if (compoundTarget != NoReg)
+                    return compoundTarget;
+                return std::nullopt;
+            case ExpressionKind::UnaryOp:
+                return compileUnary(expr.as<UnaryExpression>(), discard);
+            case ExpressionKind::BinaryOp:
+                return compileBinary(expr.as<BinaryExpression>());
+            case ExpressionKind::ConditionalOp:
+                return compileConditional(expr.as<ConditionalExpression>());
+            case ExpressionKind::Conversion:
+                return compileConversion(expr.as<ConversionExpression>());
+            case ExpressionKind::ElementSelect:
+                return compileElementSelect(expr.as<ElementSelectExpression>());
+            case ExpressionKind::Concatenation:
+                return compileConcat(expr.as<ConcatenationExpression>());
+            case ExpressionKind::Assignment:
+                return compileAssignment(expr.as<AssignmentExpression>());
+            default:
+                return std::nullopt;
+        }
+    }
+
+    std::optional<uint32_t> compileUnary(const UnaryExpression& expr, bool discard) {
+        if (!expr.operand().type->isIntegral())
+            return std::nullopt;
+
+        if (OpInfo::isLValue(expr.op)) {
+            auto slot = findSlot(expr.operand());
+            if (!slot)
+                return std::nullopt;
+
+            auto dst = discard ? NoReg : allocTemp();
+            emit({.op = Op::IncDec, .sub = uint8_t(expr.op), .dst = dst, .a = *slot});
+            return dst;
+        }
+
+        auto operand = compileExpr(expr.operand());
+        auto dst = allocTemp();
+        emit({.op = Op::Unary, .sub = uint8_t(expr.op), .dst = dst, .a = operand});
+        return dst;
+    }
+
+    std::optional<uint32_t> compileBinary(const BinaryExpression& expr) {
+        if (!expr.left().type->isIntegral() || !expr.right().type->isIntegral())
+            return std::nullopt;
+
+        auto lhs = compileExpr(expr.left());
+        if (hasSideEffects(expr.right()))
+            lhs = stabilize(lhs);
+
+        auto dst = allocTemp();
+        if (!OpInfo::isShortCircuit(expr.op)) {
+            auto rhs = compileExpr(expr.right());
+            emit({.op = Op::Binary, .sub = uint8_t(expr.op), .dst = dst, .a = lhs, .b = rhs});
+            return dst;
+        }
+
+        auto skip = emitJump(expr.op == BinaryOperator::LogicalOr ? Op::JumpIfTrue
+                                                                  : Op::JumpIfFalse,
+                             lhs);
+
+        auto rhs = compileExpr(expr.right());
+        emit({.op = Op::Binary, .sub = uint8_t(expr.op), .dst = dst, .a = lhs, .b = rhs});
+        auto end = emitJump(Op::Jump);
+
+        patch(skip, bindLabel());
+        bool shortValue = expr.op != BinaryOperator::LogicalAnd;
+        emit({.op = Op::Move, .dst = dst, .a = shortValue ? getTrue() : getFalse()});
+
+        patch(end, bindLabel());
+        return dst;
+    }
+
+    std::optional<uint32_t> compileConditional(const ConditionalExpression& expr) {
+        if (expr.conditions.size() != 1 || expr.conditions[0].pattern)
+            return std::nullopt;
+
+        auto& pred = *expr.conditions[0].expr;
+        auto& left = expr.left();
+        auto& right = expr.right();
+        if (!pred.type->isIntegral() || !left.type->isIntegral() || !right.type->isIntegral())
+            return std::nullopt;
+
+        // When the predicate is unknown both arms get evaluated, and a failure in
+        // the first one must not prevent the second from running and reporting
+        // its own diagnostics, so arms that can fail are left to the tree walker.
+        auto cp = checkpoint();
+        auto cond = compileExpr(pred);
+        if (hasSideEffects(left) || hasSideEffects(right))
+            cond = stabilize(cond);
+
+        auto fallibleBefore = numFallible;
+        auto dst = allocTemp();
+        auto unknown = emitJump(Op::JumpIfUnknown, cond);
+        auto isFalse = emitJump(Op::JumpIfNotTrue, cond);
+        compileExprInto(left, dst);
+        auto end1 = emitJump(Op::Jump);
+
+        patch(isFalse, bindLabel());
+        compileExprInto(right, dst);
+        auto end2 = emitJump(Op::Jump);
+
+        if (numFallible != fallibleBefore) {
+            rollback(cp);
+            return std::nullopt;
+        }
+
+        patch(unknown, bindLabel());
+        auto lhs = compileExpr(left);
+        if (hasSideEffects(right))
+            lhs = stabilize(lhs);
+
+        auto rhs = compileExpr(right);
+        emit({.op = Op::Merge, .dst = dst, .a = cond, .b = lhs, .c = rhs});
+
+        auto end = bindLabel();
+        patch(end1, end);
+        patch(end2, end);
+        return dst;
+    }
+
+    std::optional<uint32_t> compileConversion(const ConversionExpression& expr) {
+        if (expr.conversionKind == ConversionKind::BitstreamCast ||
+            expr.conversionKind == ConversionKind::StreamingConcat ||
+            !expr.operand().type->isIntegral()) {
+            return std::nullopt;
+        }
+
+        auto operand = compileExpr(expr.operand());
+        if (expr.operand().type->isMatching(*expr.type))
+            return operand;
+
+        auto dst = allocTemp();
+        Instr instr{.op = Op::Convert, .dst = dst, .a = operand};
+        instr.node = &expr;
+        emit(instr);
+        return dst;
+    }
+
+    std::optional<uint32_t> compileElementSelect(const ElementSelectExpression& expr) {
+        auto& valType = *expr.value().type;
+        if (!valType.isIntegral() || !valType.hasFixedRange() ||
+            !expr.selector().type->isIntegral()) {
+            return std::nullopt;
+        }
+
+        auto value = compileExpr(expr.value());
+        if (hasSideEffects(expr.selector()))
+            value = stabilize(value);
+
+        auto selector = compileExpr(expr.selector());
+        auto dst = allocTemp();
+        Instr instr{.op = Op::Select, .dst = dst, .a = value, .b = selector};
+        instr.node = &expr;
+        emit(instr);
+        return dst;
+    }
+
+    uint32_t addOperandList(std::span<const Expression* const> exprs) {
+        SmallVector<bool> laterSideEffects;
+        laterSideEffects.resize(exprs.size());
+        for (size_t i = exprs.size(); i > 1; i--)
+            laterSideEffects[i - 2] = laterSideEffects[i - 1] || hasSideEffects(*exprs[i - 1]);
+
+        SmallVector<uint32_t> regs;
+        for (size_t i = 0; i < exprs.size(); i++) {
+            auto reg = compileExpr(*exprs[i]);
+            if (laterSideEffects[i])
+                reg = stabilize(reg);
+            regs.push_back(reg);
+        }
+
+        auto start = uint32_t(operandLists.size());
+        operandLists.append_range(regs);
+        return start;
+    }
+
+    std::optional<uint32_t> compileConcat(const ConcatenationExpression& expr) {
+        for (auto op : expr.operands()) {
+            if (!op->type->isIntegral())
+                return std::nullopt;
+        }
+
+        auto start = addOperandList(expr.operands());
+        auto dst = allocTemp();
+        emit({.op = Op::Concat,
+              .dst = dst,
+              .a = start,
+              .b = uint32_t(expr.operands().size())});
+        return dst;
+    }
+
+    std::optional<uint32_t> compileAssignment(const AssignmentExpression& expr) {
+        if (expr.timingControl || expr.isLValueArg())
+            return std::nullopt;
+
+        auto slot = findSlot(expr.left());
+        if (!slot)
+            return std::nullopt;
+
+        if (!expr.isCompound()) {
+            compileExprInto(expr.right(), *slot);
+            return *slot;
+        }
+
+        // Compound assignments read the target through an LValueReference; if any
+        // part of the right hand side falls back to the tree walker it will expect
+        // the lvalue to be pushed on the context, so evaluate the whole thing there.
+        auto cp = checkpoint();
+        auto savedTarget = std::exchange(compoundTarget, *slot);
+        auto savedFlag = std::exchange(lvalueRefInFallback, false);
+
+        compileExprInto(expr.right(), *slot);
+
+        bool needsLValue = lvalueRefInFallback;
+        compoundTarget = savedTarget;
+        lvalueRefInFallback = savedFlag;
+
+        if (needsLValue) {
+            rollback(cp);
+            return std::nullopt;
+        }
+        return *slot;
+    }
+
+    std::optional<uint32_t> compileCall(const CallExpression& expr) {
+        if (expr.isSystemCall() || expr.thisClass())
+            return std::nullopt;
+
+        auto& sub = *std::get<0>(expr.subroutine);
+        if (sub.subroutineKind != SubroutineKind::Function || sub.hasOutputArgs())
+            return std::nullopt;
+
+        Instr check{.op = Op::CheckCall};
+        check.node = &expr;
+        emit(check);
+
+        auto start = addOperandList(expr.arguments());
+        Instr call{.op = Op::Call,
+                   .dst = allocTemp(),
+                   .a = start,
+                   .b = uint32_t(expr.arguments().size())};
+        call.node = &expr;
+        emit(call);
+        return call.dst;
+    }
+
+    uint32_t getTrue() {
+        if (trueConst == NoReg)
+            trueConst = addConstant(SVInt(true));
+        return trueConst;
+    }
+
+    uint32_t getFalse() {
+        if (falseConst == NoReg)
+            falseConst = addConstant(SVInt(false));
+        return falseConst;
+    }
+
+    void compileStmt(const Statement& stmt) {
+        // Temporaries never live past the statement that created them.
+        auto mark = tempTop;
+        if (!compileStmtImpl(stmt))
+            execStmt(stmt);
+        tempTop = mark;
+    }
+
+    void execStmt(const Statement& stmt) {
+        Instr instr{.op = Op::ExecStmt};
+        instr.node = &stmt;
+        auto index = emit(instr);
+        if (loop) {
+            loop->breaks.push_back({index, false});
+            loop->continues.push_back({index, true});
+        }
+    }
+
+    void compileLoopBody(const Statement& body, LoopTargets& targets) {
+        auto savedLoop = std::exchange(loop, &targets);
+        compileStmt(body);
+        loop = savedLoop;
+    }
+
+    void patchLoop(const LoopTargets& targets, uint32_t exit, uint32_t cont) {
+        for (auto [index, second] : targets.breaks) {
+            if (second)
+                code[index].target2 = exit;
+            else
+                code[index].target = exit;
+        }
+
+        // Continue targets are stored in the second slot of ExecStmt
+        // instructions, which are the only ones marked as such.
+        for (auto [index, second] : targets.continues) {
+            if (second)
+                code[index].target2 = cont;
+            else
+                code[index].target = cont;
+        }
+    }
+
+    bool compileStmtImpl(const Statement& stmt) {
+        if (stmt.bad())
+            return false;
+
+        switch (stmt.kind) {
+            case StatementKind::Empty:
+                emitStep(stmt);
+                return true;
+            case StatementKind::List:
+                emitStep(stmt);
+                for (auto item : stmt.as<StatementList>().list)
+                    compileStmt(*item);
+                return true;
+            case StatementKind::Block: {
+                auto& block = stmt.as<BlockStatement>();
+                if (block.blockKind != StatementBlockKind::Sequential)
+                    return false;
+
+                emitStep(stmt);
+                compileStmt(block.body);
+                return true;
+            }
+            case StatementKind::VariableDeclaration: {
+                // Static initializers are skipped with a warning, which
+                // the tree walker takes care of reporting.
+                auto& symbol = stmt.as<VariableDeclStatement>().symbol;
+                auto init = symbol.getInitializer();
+                if (init && symbol.lifetime == VariableLifetime::Static)
+                    return false;
+
+                emitStep(stmt);
+                auto value = init ? compileExpr(*init) : NoReg;
+
+                Instr instr{.op = Op::Decl, .dst = addSlot(symbol), .a = value};
+                instr.node = &symbol;
+                emit(instr);
+                return true;
+            }
+            case StatementKind::ExpressionStatement: {
+                auto& expr = stmt.as<ExpressionStatement>().expr;
+                if (expr.kind == ExpressionKind::Call && expr.as<CallExpression>().isSystemCall() &&
+                    expr.as<CallExpression>().getSubroutineKind() == SubroutineKind::Task) {
+                    return false;
+                }
+
+                emitStep(stmt);
+                compileExpr(expr, /* discard */ true);
+                return true;
+            }
+            case StatementKind::Return: {
+                emitStep(stmt);
+                if (auto expr = stmt.as<ReturnStatement>().expr)
+                    compileExprInto(*expr, retSlot);
+
+                emit({.op = Op::Exit, .sub = uint8_t(ER::Return)});
+                return true;
+            }
+            case StatementKind::Break:
+            case StatementKind::Continue: {
+                if (!loop)
+                    return false;
+
+                emitStep(stmt);
+                auto index = emitJump(Op::Jump);
+                if (stmt.kind == StatementKind::Break)
+                    loop->breaks.push_back({index, false});
+                else
+                    loop->continues.push_back({index, false});
+                return true;
+            }
+            case StatementKind::Conditional:
+                return compileConditional(stmt.as<ConditionalStatement>());
+            case StatementKind::ForLoop:
+                compileForLoop(stmt.as<ForLoopStatement>());
+                return true;
+            case StatementKind::RepeatLoop:
+                return compileRepeatLoop(stmt.as<RepeatLoopStatement>());
+            case StatementKind::WhileLoop: {
+                auto& whileLoop = stmt.as<WhileLoopStatement>();
+                emitStep(stmt);
+
+                LoopTargets targets;
+                auto head = bindLabel();
+                auto exitJump = emitJump(Op::JumpIfNotTrue, compileExpr(whileLoop.cond));
+                compileLoopBody(whileLoop.body, targets);
+                emit({.op = Op::Jump, .target = head});
+
+                auto exit = bindLabel();
+                patch(exitJump, exit);
+                patchLoop(targets, exit, head);
+                return true;
+            }
+            case StatementKind::DoWhileLoop: {
+                auto& doWhile = stmt.as<DoWhileLoopStatement>();
+                emitStep(stmt);
+
+                LoopTargets targets;
+                auto head = bindLabel();
+                compileLoopBody(doWhile.body, targets);
+
+                auto cont = bindLabel();
+                emit({.op = Op::JumpIfTrue, .a = compileExpr(doWhile.cond), .target = head});
+
+                patchLoop(targets, bindLabel(), cont);
+                return true;
+            }
+            case StatementKind::ForeverLoop: {
+                emitStep(stmt);
+
+                LoopTargets targets;
+                auto head = bindLabel();
+                compileLoopBody(stmt.as<ForeverLoopStatement>().body, targets);
+                emit({.op = Op::Jump, .target = head});
+
+                patchLoop(targets, bindLabel(), head);
+                return true;
+            }
+            default:
+                return false;
+        }
+    }
+
+    void compileForLoop(const ForLoopStatement& stmt) {
+        emitStep(stmt);
+        for (auto init : stmt.initializers)
+            compileExpr(*init, /* discard */ true);
+
+        LoopTargets targets;
+        auto head = bindLabel();
+        auto exitJump = NoTarget;
+        if (stmt.stopExpr)
+            exitJump = emitJump(Op::JumpIfNotTrue, compileExpr(*stmt.stopExpr));
+
+        compileLoopBody(stmt.body, targets);
+
+        auto cont = bindLabel();
+        for (auto step : stmt.steps)
+            compileExpr(*step, /* discard */ true);
+        emit({.op = Op::Jump, .target = head});
+
+        auto exit = bindLabel();
+        if (exitJump != NoTarget)
+            patch(exitJump, exit);
+        patchLoop(targets, exit, cont);
+    }
+
+    bool compileRepeatLoop(const RepeatLoopStatement& stmt) {
+        if (!stmt.count.type->isIntegral())
+            return false;
+
+        emitStep(stmt);
+        auto counter = numCounters++;
+
+        Instr init{.op = Op::RepeatInit, .a = compileExpr(stmt.count), .target2 = counter};
+        init.node = &stmt.count;
+        emit(init);
+
+        LoopTargets targets;
+        auto head = bindLabel();
+        auto next = emit({.op = Op::RepeatNext, .target2 = counter});
+        compileLoopBody(stmt.body, targets);
+        emit({.op = Op::Jump, .target = head});
+
+        auto exit = bindLabel();
+        patch(next, exit);
+        patchLoop(targets, exit, head);
+        return true;
+    }
+
+    bool compileConditional(const ConditionalStatement& stmt) {
+        // Unique and priority checks need to know about every matching
+        // branch, so those are left to the tree walker.
+        if (stmt.check != UniquePriorityCheck::None)
+            return false;
+
+        // Gather the else-if chain. All of its conditions get evaluated up front,
+        // even after one of them has matched, to mirror the tree walker.
+        SmallVector<const ConditionalStatement*> chain;
+        for (auto curr = &stmt;;) {
+            if (curr->conditions.size() != 1 || curr->conditions[0].pattern ||
+                ConditionalStatement::isKind(curr->ifTrue.kind)) {
+                return false;
+            }
+
+            chain.push_back(curr);
+            if (!curr->ifFalse || !ConditionalStatement::isKind(curr->ifFalse->kind))
+                break;
+
+            curr = &curr->ifFalse->as<ConditionalStatement>();
+        }
+
+        auto cp = checkpoint();
+        emitStep(stmt);
+
+        SmallVector<const Expression*> condExprs;
+        for (auto elem : chain)
+            condExprs.push_back(elem->conditions[0].expr);
+
+        auto start = addOperandList(condExprs);
+        SmallVector<uint32_t> conds(operandLists.begin() + start, operandLists.end());
+        operandLists.resize(start);
+
+        // If evaluating one condition can fail, the tree walker still goes
+        // on to evaluate the rest, so let it handle the whole statement.
+        if (chain.size() > 1 && numFallible != cp.numFallible) {
+            rollback(cp);
+            return false;
+        }
+
+        SmallVector<uint32_t> leafJumps;
+        for (auto cond : conds)
+            leafJumps.push_back(emitJump(Op::JumpIfTrue, cond));
+
+        SmallVector<uint32_t> endJumps;
+        if (auto elseStmt = chain.back()->ifFalse)
+            compileStmt(*elseStmt);
+        endJumps.push_back(emitJump(Op::Jump));
+
+        for (size_t i = 0; i < chain.size(); i++) {
+            patch(leafJumps[i], bindLabel());
+            compileStmt(chain[i]->ifTrue);
+            endJumps.push_back(emitJump(Op::Jump));
+        }
+
+        auto end = bindLabel();
+        for (auto index : endJumps)
+            patch(index, end);
+        return true;
+    }
+
+    const EvalBytecode* finish() {
+        auto numTemps = maxTemps;
+        auto remap = [&](uint32_t& reg) {
+            if (reg == NoReg)
+                return;
+
+            auto index = reg & RegIndexMask;
+            switch (regKind(reg)) {
+                case RegKind::Local:
+                    reg = index;
+                    break;
+                case RegKind::Temp:
+                    reg = numLocals + index;
+                    break;
+                case RegKind::Const:
+                    reg = numLocals + numTemps + index;
+                    break;
+            }
+        };
+
+        for (auto& instr : code) {
+            switch (instr.op) {
+                case Op::Concat:
+                case Op::Call:
+                    // Operand lists are remapped separately below.
+                    remap(instr.dst);
+                    break;
+                default:
+                    remap(instr.dst);
+                    remap(instr.a);
+                    remap(instr.b);
+                    remap(instr.c);
+                    break;
+            }
+        }
+
+        for (auto& reg : operandLists)
+            remap(reg);
+
+        auto result = compilation.emplace<EvalBytecode>();
+        result->code = compilation.copyFrom(std::span<const Instr>(code));
+        result->operandLists = compilation.copyFrom(std::span<const uint32_t>(operandLists));
+        result->constants = compilation.copyFrom(std::span<const ConstantValue* const>(constants));
+        result->numLocals = numLocals;
+        result->numTemps = numTemps;
+        result->numCounters = numCounters;
+        return result;
+    }
+
+    Compilation& compilation;
+    const SubroutineSymbol& subroutine;
+    SmallVector<Instr> code;
+    SmallVector<uint32_t> operandLists;
+    SmallVector<const ConstantValue*> constants;
+    SmallMap<const ValueSymbol*, uint32_t, 8> slots;
+    LoopTargets* loop = nullptr;
+    uint32_t numLocals = 0;
+    uint32_t tempTop = 0;
+    uint32_t maxTemps = 0;
+    uint32_t numCounters = 0;
+    uint32_t numFallible = 0;
+    uint32_t lastLabel = NoTarget;
+    uint32_t retSlot = NoReg;
+    uint32_t trueConst = NoReg;
+    uint32_t falseConst = NoReg;
+    uint32_t compoundTarget = NoReg;
+    bool lvalueRefInFallback = false;
+};
+
+ConstantValue evalUnary(UnaryOperator op, SVInt v) {
+    switch (op) {
+        case UnaryOperator::Plus:
+            return v;
+        case UnaryOperator::Minus:
+            return -v;
+        case UnaryOperator::BitwiseNot:
+            return ~v;
+        case UnaryOperator::BitwiseAnd:
+            return SVInt(v.reductionAnd());
+        case UnaryOperator::BitwiseOr:
+            return SVInt(v.reductionOr());
+        case UnaryOperator::BitwiseXor:
+            return SVInt(v.reductionXor());
+        case UnaryOperator::BitwiseNand:
+            return SVInt(!v.reductionAnd());
+        case UnaryOperator::BitwiseNor:
+            return SVInt(!v.reductionOr());
+        case UnaryOperator::BitwiseXnor:
+            return SVInt(!v.reductionXor());
+        case UnaryOperator::LogicalNot:
+            return SVInt(!v);
+        default:
+            SLANG_UNREACHABLE;
+    }
+}
+
+} // namespace
+
+namespace slang::ast {
+
+const EvalBytecode* EvalBytecode::compile(Compilation& compilation,
+                                          const SubroutineSymbol& subroutine) {
+    BytecodeCompiler compiler(compilation, subroutine);
+    return compiler.compile();
+}
+
+Statement::EvalResult EvalBytecode::run(EvalContext& context,
+                                        std::span<ConstantValue* const> locals) const {
+    SLANG_ASSERT(locals.size() <= numLocals);
+
+    const uint32_t tempBase = numLocals;
+    const uint32_t constBase = numLocals + numTemps;
+    auto isTemp = [&](uint32_t reg) { return reg >= tempBase && reg < constBase; };
+
+    // Locals for variables declared in the body get filled in
+    // as their declarations execute.
+    SmallVector<ConstantValue*, 32> regs;
+    regs.resize(constBase + constants.size());
+    std::ranges::copy(locals, regs.begin());
+
+    SmallVector<ConstantValue, 16> temps;
+    temps.resize(numTemps);
+    for (uint32_t i = 0; i < numTemps; i++)
+        regs[tempBase + i] = &temps[i];
+
+    for (size_t i = 0; i < constants.size(); i++)
+        regs[constBase + i] = const_cast<ConstantValue*>(constants[i]);
+
+    SmallVector<int64_t, 4> counters;
+    counters.resize(numCounters);
+
+    auto take = [&](uint32_t reg) -> ConstantValue {
+        if (isTemp(reg))
+            return std::move(*regs[reg]);
+        return *regs[reg];
+    };
+
+    size_t pc = 0;
+    while (true) {
+        SLANG_ASSERT(pc < code.size());
+        const Instr& instr = code[pc++];
+        switch (instr.op) {
+            case Op::Step:
+                if (!context.step(instr.location))
+                    return ER::Fail;
+                break;
+            case Op::Jump:
+                pc = instr.target;
+                break;
+            case Op::JumpIfTrue:
+                if (regs[instr.a]->isTrue())
+                    pc = instr.target;
+                break;
+            case Op::JumpIfNotTrue:
+                if (!regs[instr.a]->isTrue())
+                    pc = instr.target;
+                break;
+            case Op::JumpIfFalse:
+                if (regs[instr.a]->isFalse())
+                    pc = instr.target;
+                break;
+            case Op::JumpIfUnknown: {
+                auto& cv = *regs[instr.a];
+                if (cv.isInteger() && cv.integer().hasUnknown())
+                    pc = instr.target;
+                break;
+            }
+            case Op::Move:
+                if (instr.dst != instr.a)
+                    *regs[instr.dst] = take(instr.a);
+                break;
+            case Op::Unary:
+                *regs[instr.dst] = evalUnary(UnaryOperator(instr.sub), regs[instr.a]->integer());
+                break;
+            case Op::Binary: {
+                auto cv = OpInfo::eval(BinaryOperator(instr.sub), *regs[instr.a],
+                                       *regs[instr.b]);
+                if (!cv)
+                    return ER::Fail;
+
+                *regs[instr.dst] = std::move(cv);
+                break;
+            }
+            case Op::IncDec: {
+                auto& target = *regs[instr.a];
+                SVInt v = target.integer();
+                switch (UnaryOperator(instr.sub)) {
+                    case UnaryOperator::Preincrement:
+                        target = ++v;
+                        break;
+                    case UnaryOperator::Predecrement:
+                        target = --v;
+                        break;
+                    case UnaryOperator::Postincrement:
+                        target = v + 1;
+                        break;
+                    case UnaryOperator::Postdecrement:
+                        target = v - 1;
+                        break;
+                    default:
+                        SLANG_UNREACHABLE;
+                }
+
+                if (instr.dst != NoReg)
+                    *regs[instr.dst] = std::move(v);
+                break;
+            }
+            case Op::Convert: {
+                auto& conv = instr.as<ConversionExpression>();
+                auto cv = conv.applyTo(context, take(instr.a));
+                if (!cv)
+                    return ER::Fail;
+
+                *regs[instr.dst] = std::move(cv);
+                break;
+            }
+            case Op::Select: {
+                auto& expr = instr.as<ElementSelectExpression>();
+                auto& valType = *expr.value().type;
+                auto& cs = *regs[instr.b];
+
+                auto range = valType.getFixedRange();
+                auto index = cs.integer().as<int32_t>();
+                if (!index || !range.containsPoint(*index)) {
+                    if (!expr.hasWarnedAboutIndex())
+                        context.addDiag(diag::IndexOOB, expr.sourceRange) << cs << valType;
+                    *regs[instr.dst] = expr.type->getDefaultValue();
+                    break;
+                }
+
+                auto width = (int32_t)expr.type->getBitWidth();
+                auto i = range.translateIndex(*index) * width;
+                *regs[instr.dst] = regs[instr.a]->integer().slice(i + width - 1, i);
+                break;
+            }
+            case Op::Concat: {
+                SmallVector<SVInt, 4> values;
+                for (auto reg : operandLists.subspan(instr.a, instr.b))
+                    values.push_back(regs[reg]->integer());
+
+                *regs[instr.dst] = SVInt::concat(values);
+                break;
+            }
+            case Op::Merge:
+                *regs[instr.dst] = SVInt::conditional(regs[instr.a]->integer(),
+                                                      regs[instr.b]->integer(),
+                                                      regs[instr.c]->integer());
+                break;
+            case Op::RepeatInit: {
+                auto& cv = *regs[instr.a];
+                std::optional<int64_t> oc = cv.integer().as<int64_t>();
+                if (!oc || oc < 0) {
+                    if (cv.integer().hasUnknown())
+                        oc = 0;
+                    else {
+                        auto& diag = context.addDiag(diag::ValueOutOfRange,
+                                                     instr.as<Expression>().sourceRange);
+                        diag << cv << 0 << INT64_MAX;
+                        return ER::Fail;
+                    }
+                }
+
+                counters[instr.target2] = *oc;
+                break;
+            }
+            case Op::RepeatNext:
+                if (counters[instr.target2] <= 0)
+                    pc = instr.target;
+                else
+                    counters[instr.target2]--;
+                break;
+            case Op::CheckCall: {
+                auto& call = instr.as<CallExpression>();
+                if (!CallExpression::checkConstant(context, *std::get<0>(call.subroutine),
+                                                   call.sourceRange)) {
+                    return ER::Fail;
+                }
+                break;
+            }
+            case Op::Call: {
+                SmallVector<ConstantValue, 4> args;
+                for (auto reg : operandLists.subspan(instr.a, instr.b))
+                    args.emplace_back(take(reg));
+
+                auto cv = instr.as<CallExpression>().evalSubroutine(context, args);
+                if (!cv)
+                    return ER::Fail;
+
+                *regs[instr.dst] = std::move(cv);
+                break;
+            }
+            case Op::Decl: {
+                ConstantValue initial;
+                if (instr.a != NoReg)
+                    initial = take(instr.a);
+                regs[instr.dst] = context.createLocal(&instr.as<ValueSymbol>(), std::move(initial));
+                break;
+            }
+            case Op::EvalExpr: {
+                auto cv = instr.as<Expression>().eval(context);
+                if (!cv)
+                    return ER::Fail;
+
+                if (instr.dst != NoReg)
+                    *regs[instr.dst] = std::move(cv);
+                break;
+            }
+            case Op::ExecStmt: {
+                auto result = instr.as<Statement>().eval(context);
+                if (result == ER::Success)
+                    break;
+
+                if (result == ER::Break && instr.target != NoTarget)
+                    pc = instr.target;
+                else if (result == ER::Continue && instr.target2 != NoTarget)
+                    pc = instr.target2;
+                else
+                    return result;
+                break;
+            }
+            case Op::Exit:
+                return ER(instr.sub);
+        }
+    }
+}
+
+} // namespace slang::ast
@@ -0,0 +1,101 @@
+//------------------------------------------------------------------------------
+// EvalBytecode.h
+// Internal bytecode form of constant functions
+//
+// SPDX-FileCopyrightText: Michael Popoloski
+// SPDX-License-Identifier: MIT
+//------------------------------------------------------------------------------
+#pragma once
+
+#include "slang/ast/Statement.h"
+#include "slang/numeric/ConstantValue.h"
+
+namespace slang::ast {
+
+class Compilation;
+class EvalContext;
+class Expression;
+class SubroutineSymbol;
+class ValueSymbol;
+
+/// A flattened, register-based form of a constant function body that can be
+/// executed without walking the AST. Integral expressions and the common
+/// control flow statements are lowered to instructions; everything else is
+/// embedded as an instruction that defers to the regular tree-walking
+/// evaluator, so any body can be compiled and the results (including step
+/// counts and diagnostics) match the tree walker exactly.
+///
+/// Registers are laid out as [locals][temporaries][constants]. The first locals
+/// are the subroutine's formal arguments followed by its return value variable;
+/// the rest belong to variables declared in the body.
+class EvalBytecode {
+public:
+    enum class Op : uint8_t {
+        Step,
+        Jump,
+        JumpIfTrue,
+        JumpIfNotTrue,
+        JumpIfFalse,
+        JumpIfUnknown,
+        Move,
+        Unary,
+        Binary,
+        IncDec,
+        Convert,
+        Select,
+        Concat,
+        Merge,
+        RepeatInit,
+        RepeatNext,
+        CheckCall,
+        Call,
+        Decl,
+        EvalExpr,
+        ExecStmt,
+        Exit
+    };
+
+    struct Instr {
+        Op op;
+        uint8_t sub = 0;
+        uint32_t dst = NoReg;
+        uint32_t a = NoReg;
+        uint32_t b = NoReg;
+        uint32_t c = NoReg;
+        uint32_t target = NoTarget;
+        uint32_t target2 = NoTarget;
+        SourceLocation location = SourceLocation::NoLocation;
+
+        /// The AST node that the instruction operates on, if any.
+        const void* node = nullptr;
+
+        template<typename T>
+        const T& as() const {
+            return *static_cast<const T*>(node);
+        }
+    };
+
+    static constexpr uint32_t NoReg = UINT32_MAX;
+    static constexpr uint32_t NoTarget = UINT32_MAX;
+
+    std::span<const Instr> code;
+    std::span<const uint32_t> operandLists;
+    std::span<const ConstantValue* const> constants;
+    uint32_t numLocals = 0;
+    uint32_t numTemps = 0;
+    uint32_t numCounters = 0;
+
+    /// Lowers the body of the given subroutine. Returns nullptr if the body uses
+    /// constructs that can't be represented, in which case the caller should fall
+    /// back to evaluating the AST directly.
+    static const EvalBytecode* compile(Compilation& compilation,
+                                       const SubroutineSymbol& subroutine);
+
+    /// Runs the bytecode in the current (already pushed) stack frame. The @a locals
+    /// span must contain storage for each formal argument followed by the return
+    /// value variable.
+    Statement::EvalResult run(EvalContext& context,
+                              std::span<ConstantValue* const> locals) const;
+};
+
+} // namespace slang::ast
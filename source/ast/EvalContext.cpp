@@ -14,10 +14,16 @@
 #include "slang/ast/types/Type.h"
 #include "slang/diagnostics/ConstEvalDiags.h"
 #include "slang/text/FormatBuffer.h"
+#include "slang/util/TimeTrace.h"
 
 namespace slang::ast {
 
 void EvalContext::reset() {
+    for (auto& frame : stack) {
+        if (frame.profile.traced)
+            TimeTrace::endTrace();
+    }
+
     steps = 0;
     disableTarget = nullptr;
     queueTarget = nullptr;
@@ -75,6 +81,20 @@ bool EvalContext::pushFrame(const SubroutineSymbol& subroutine, SourceLocation c
     frame.subroutine = &subroutine;
     frame.callLocation = callLocation;
     frame.lookupLocation = lookupLocation;
+
+    if (isProfiling()) {
+        // Only the outermost call gets a time trace event; nested calls
+        // can number in the millions and are covered by the profile itself.
+        if (TimeTrace::isEnabled() &&
+            std::ranges::none_of(stack, [](const Frame& f) { return f.subroutine; })) {
+            TimeTrace::beginTrace("constEvalCall"sv, subroutine.name);
+            frame.profile.traced = true;
+        }
+
+        frame.profile.startSteps = steps;
+        frame.profile.startTime = std::chrono::steady_clock::now();
+    }
+
     stack.emplace_back(std::move(frame));
     return true;
 }
@@ -84,9 +104,81 @@ void EvalContext::pushEmptyFrame() {
 }
 
 void EvalContext::popFrame() {
+    if (stack.back().subroutine && isProfiling())
+        recordProfile(stack.back());
     stack.pop_back();
 }
 
+bool EvalContext::noteMemoizedCall(const SubroutineSymbol& subroutine,
+                                   SourceLocation callLocation) {
+    const uint32_t maxDepth = getCompilation().getOptions().maxConstexprDepth;
+    if (stack.size() >= maxDepth) {
+        addDiag(diag::ConstEvalExceededMaxCallDepth, subroutine.location) << maxDepth;
+        return false;
+    }
+
+    if (!step(callLocation))
+        return false;
+
+    if (!isProfiling())
+        return true;
+
+    ConstEvalCost cost;
+    cost.memoHits = 1;
+
+    auto& comp = getCompilation();
+    comp.recordConstEvalCost(subroutine, {}, cost);
+    if (callLocation)
+        comp.recordConstEvalCost(subroutine, callLocation, cost);
+    return true;
+}
+
+bool EvalContext::isProfiling() const {
+    return getCompilation().getOptions().flags.has(CompilationFlags::ProfileConstEval);
+}
+
+void EvalContext::recordProfile(const Frame& frame) {
+    auto& profile = frame.profile;
+    if (profile.traced)
+        TimeTrace::endTrace();
+
+    ConstEvalCost cost;
+    cost.calls = 1;
+    cost.totalSteps = steps - profile.startSteps;
+    cost.totalTime = std::chrono::steady_clock::now() - profile.startTime;
+    cost.selfSteps = cost.totalSteps - profile.childSteps;
+    cost.selfTime = cost.totalTime - profile.childTime;
+
+    // The caller's own cost excludes what was spent in this call.
+    auto outer = std::span(stack).first(stack.size() - 1);
+    if (!outer.empty()) {
+        outer.back().profile.childSteps += cost.totalSteps;
+        outer.back().profile.childTime += cost.totalTime;
+    }
+
+    // Recursive calls are already included in the totals of the outermost
+    // call of the same function (or from the same call site), so count them
+    // only once.
+    auto record = [&](SourceLocation location, bool nested) {
+        auto entry = cost;
+        if (nested) {
+            entry.totalSteps = 0;
+            entry.totalTime = {};
+        }
+        getCompilation().recordConstEvalCost(*frame.subroutine, location, entry);
+    };
+
+    record({}, std::ranges::any_of(outer, [&](const Frame& f) {
+               return f.subroutine == frame.subroutine;
+           }));
+
+    if (frame.callLocation) {
+        record(frame.callLocation, std::ranges::any_of(outer, [&](const Frame& f) {
+                   return f.subroutine && f.callLocation == frame.callLocation;
+               }));
+    }
+}
+
 void EvalContext::pushLValue(LValue& lval) {
     lvalStack.push_back(&lval);
 }
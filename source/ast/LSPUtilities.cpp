@@ -9,9 +9,22 @@
 
 #include "slang/ast/expressions/ConversionExpression.h"
 #include "slang/ast/expressions/OperatorExpressions.h"
+#include "slang/syntax/AllSyntax.h"
 
 namespace slang::ast {
 
+// Selectors indexed by a loop variable (for drivers in unrolled or widened loops)
+// no longer have a value once the loop has been analyzed, so those get printed
+// as they were written instead.
+static std::string stringifySelector(const Expression& expr, EvalContext& evalContext) {
+    if (auto cv = expr.eval(evalContext); cv || !expr.syntax)
+        return cv.toString();
+
+    auto text = expr.syntax->toString();
+    text.erase(0, text.find_first_not_of(" \t\r\n"));
+    return text;
+}
+
 void LSPUtilities::stringifyLSP(const Expression& expr, EvalContext& evalContext,
                                 FormatBuffer& buffer) {
     switch (expr.kind) {
@@ -25,14 +38,14 @@ void LSPUtilities::stringifyLSP(const Expression& expr, EvalContext& evalContext
         case ExpressionKind::ElementSelect: {
             auto& select = expr.as<ElementSelectExpression>();
             stringifyLSP(select.value(), evalContext, buffer);
-            buffer.format("[{}]", select.selector().eval(evalContext).toString());
+            buffer.format("[{}]", stringifySelector(select.selector(), evalContext));
             break;
         }
         case ExpressionKind::RangeSelect: {
             auto& select = expr.as<RangeSelectExpression>();
             stringifyLSP(select.value(), evalContext, buffer);
-            buffer.format("[{}:{}]", select.left().eval(evalContext).toString(),
-                          select.right().eval(evalContext).toString());
+            buffer.format("[{}:{}]", stringifySelector(select.left(), evalContext),
+                          stringifySelector(select.right(), evalContext));
             break;
         }
         case ExpressionKind::MemberAccess: {
@@ -80,6 +80,14 @@ ConstantValue LValue::load() const {
                     else if (result.isString()) {
                         result = SVInt(8, (uint64_t)result.str()[size_t(arg.index)], false);
                     }
+                    else if (result.isDenseArray()) {
+                        SVInt temp = result.denseArray()->get(size_t(arg.index));
+                        result = std::move(temp);
+                    }
+                    else if (result.isRunArray()) {
+                        ConstantValue temp = result.runArray()->get(size_t(arg.index));
+                        result = std::move(temp);
+                    }
                     else {
                         // Be careful not to assign to the result while
                         // still referencing its elements.
@@ -93,9 +101,9 @@ ConstantValue LValue::load() const {
                 }
                 else if constexpr (std::is_same_v<T, ArrayLookup>) {
                     auto& map = *result.map();
-                    if (auto it = map.find(arg.index); it != map.end()) {
+                    if (auto val = map.find(arg.index)) {
                         // If we find the index in the target map, return the value.
-                        ConstantValue temp(std::move(it->second));
+                        ConstantValue temp(std::move(*val));
                         result = std::move(temp);
                     }
                     else if (map.defaultValue) {
@@ -135,11 +143,10 @@ void LValue::store(const ConstantValue& newValue) {
             }
         }
         else {
-            auto newElems = newValue.elements();
             auto& lvalElems = concat->elems;
-            SLANG_ASSERT(newElems.size() == lvalElems.size());
+            SLANG_ASSERT(newValue.size() == lvalElems.size());
             for (size_t i = 0; i < lvalElems.size(); i++)
-                lvalElems[i].store(newElems[i]);
+                lvalElems[i].store(newValue.elementAt(i));
         }
         return;
     }
@@ -169,6 +176,11 @@ void LValue::store(const ConstantValue& newValue) {
         return;
     }
 
+    // Slices of run-length arrays get written one element at a time,
+    // which would just break the runs up, so expand the array first.
+    if (target->isRunArray())
+        *target = target->runArray()->expand();
+
     // Otherwise, assign to the slice.
     if (target->isInteger()) {
         target->integer().set(range->upper(), range->lower(), newValue.integer());
@@ -192,16 +204,37 @@ void LValue::store(const ConstantValue& newValue) {
         for (int32_t i = std::max(l, 0); i <= u; i++)
             dest[size_t(i)] = src[size_t(i - l)];
     }
+    else if (target->isDenseArray()) {
+        auto& dest = *target->denseArray();
+        if (newValue.isInteger()) {
+            // An element (or some bits of one); the range is in terms
+            // of the dense array's bits.
+            dest.setBits(range->upper(), range->lower(), newValue.integer());
+            return;
+        }
+
+        int32_t l = range->lower();
+        int32_t u = std::min(range->upper(), int32_t(dest.size()) - 1);
+        if (l >= 0 && u == range->upper() && newValue.isDenseArray() &&
+            newValue.denseArray()->elementWidth == dest.elementWidth) {
+            // Copy a slice from one dense array to another all at once.
+            dest.setBits(dest.getElementLsb(size_t(l)) + int32_t(dest.elementWidth) - 1,
+                         dest.getElementLsb(size_t(u)), newValue.denseArray()->bits);
+            return;
+        }
+
+        for (int32_t i = std::max(l, 0); i <= u; i++)
+            dest.set(size_t(i), newValue.elementAt(size_t(i - l)).integer());
+    }
     else {
         int32_t l = range->lower();
         int32_t u = range->upper();
 
-        auto src = newValue.elements();
         auto dest = target->elements();
 
         u = std::min(u, int32_t(dest.size()));
         for (int32_t i = std::max(l, 0); i <= u; i++)
-            dest[size_t(i)] = src[size_t(i - l)];
+            dest[size_t(i)] = newValue.elementAt(size_t(i - l));
     }
 }
 
@@ -223,6 +256,12 @@ ConstantValue* LValue::resolveInternal(std::optional<ConstantRange>& range) {
                         range = range->subrange(arg.range);
                 }
                 else if constexpr (std::is_same_v<T, ElementIndex>) {
+                    if (target->isRunArray() && target->runArray()->isFragmented()) {
+                        // Enough elements have been written individually that
+                        // the runs aren't buying us anything anymore.
+                        *target = target->runArray()->expand();
+                    }
+
                     if (arg.forceOutOfBounds) {
                         target = nullptr;
                     }
@@ -259,6 +298,25 @@ ConstantValue* LValue::resolveInternal(std::optional<ConstantRange>& range) {
                         else
                             range = ConstantRange{arg.index, arg.index};
                     }
+                    else if (target->isRunArray()) {
+                        auto& runs = *target->runArray();
+                        if (arg.index < 0 || size_t(arg.index) >= runs.size())
+                            target = nullptr;
+                        else
+                            target = &runs.getForWrite(size_t(arg.index));
+                    }
+                    else if (target->isDenseArray()) {
+                        // Elements of a dense array don't have their own ConstantValue
+                        // to point at, so select the bits that make up the element.
+                        auto& dense = *target->denseArray();
+                        if (arg.index < 0 || size_t(arg.index) >= dense.size()) {
+                            target = nullptr;
+                        }
+                        else {
+                            int32_t lsb = dense.getElementLsb(size_t(arg.index));
+                            range = ConstantRange{lsb + int32_t(dense.elementWidth) - 1, lsb};
+                        }
+                    }
                     else {
                         auto elems = target->elements();
                         if (arg.index < 0 || size_t(arg.index) >= elems.size())
@@ -272,10 +330,10 @@ ConstantValue* LValue::resolveInternal(std::optional<ConstantRange>& range) {
                 }
                 else if constexpr (std::is_same_v<T, ArrayLookup>) {
                     auto& map = *target->map();
-                    auto [it, inserted] = map.try_emplace(std::move(arg.index),
-                                                          std::move(arg.defaultValue));
+                    auto [val, inserted] = map.try_emplace(std::move(arg.index),
+                                                           std::move(arg.defaultValue));
 
-                    target = &it->second;
+                    target = val;
                 }
                 else {
                     static_assert(always_false<T>::value, "Missing case");
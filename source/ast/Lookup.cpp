@@ -100,6 +100,7 @@ namespace {
 
 struct NameComponents {
     std::string_view text;
+    IdentifierId id = IdentifierId::Empty;
     SourceRange range;
     std::span<const ElementSelectSyntax* const> selectors;
     const ParameterValueAssignmentSyntax* paramAssignments = nullptr;
@@ -142,9 +143,16 @@ struct NameComponents {
         }
     }
 
-    void set(Token id) {
-        text = id.valueText();
-        range = id.range();
+    void set(Token token) {
+        text = token.valueText();
+        range = token.range();
+
+        // Identifiers are interned by the lexer; other tokens used as
+        // names (keywords, system names) are translated on demand.
+        if (token.kind == TokenKind::Identifier)
+            id = token.identifierId();
+        else
+            id = IdentifierTable::getDefault().find(text);
     }
 };
 
@@ -486,18 +494,18 @@ bool lookupDownward(std::span<const NamePlusLoc> nameParts, NameComponents name,
             return false;
 
         auto& scope = symbol->as<Scope>();
-        symbol = scope.find(name.text);
+        symbol = scope.find(name.id);
         if (!symbol) {
             // If we did the lookup in a modport, check to see if the symbol actually
             // exists in the parent interface.
             auto& prevSym = scope.asSymbol();
             if (prevSym.kind != SymbolKind::Modport ||
-                (symbol = prevSym.getParentScope()->find(name.text)) == nullptr) {
+                (symbol = prevSym.getParentScope()->find(name.id)) == nullptr) {
 
                 // Check if we actually had a method prototype found here but it failed
                 // to resolve due to some other error, in which case we should keep quiet.
                 auto& nameMap = scope.getNameMap();
-                if (auto scopeIt = nameMap.find(name.text);
+                if (auto scopeIt = nameMap.find(name.id);
                     scopeIt != nameMap.end() &&
                     scopeIt->second->kind == SymbolKind::MethodPrototype) {
                     return false;
@@ -603,7 +611,7 @@ bool lookupUpward(std::span<const NamePlusLoc> nameParts, const NameComponents&
     const Scope* scope = context.scope;
     do {
         // Search for a scope or instance target within our current scope.
-        auto symbol = scope->find(name.text);
+        auto symbol = scope->find(name.id);
         if (symbol && !symbol->isValue() && !symbol->isType() &&
             (symbol->isScope() || symbol->kind == SymbolKind::Instance)) {
             if (!tryMatch(*symbol))
@@ -849,14 +857,14 @@ bool resolveColonNames(SmallVectorBase<NamePlusLoc>& nameParts, int colonParts,
 
         const Symbol* savedSymbol = symbol;
         if (symbol->kind == SymbolKind::Package) {
-            symbol = symbol->as<PackageSymbol>().findForImport(name.text);
+            symbol = symbol->as<PackageSymbol>().findForImport(name.id);
             result.flags |= LookupResultFlags::WasImported;
         }
         else if (symbol->kind == SymbolKind::CovergroupType) {
-            symbol = symbol->as<CovergroupType>().getBody().find(name.text);
+            symbol = symbol->as<CovergroupType>().getBody().find(name.id);
         }
         else {
-            symbol = symbol->as<Scope>().find(name.text);
+            symbol = symbol->as<Scope>().find(name.id);
         }
 
         if (!symbol) {
@@ -1154,8 +1162,8 @@ void Lookup::name(const NameSyntax& syntax, const ASTContext& context, bitmask<L
         return;
 
     // Perform the lookup.
-    unqualifiedImpl(scope, name.text, context.getLocation(), name.range, flags, {}, result, scope,
-                    &syntax);
+    unqualifiedImpl(scope, name.text, name.id, context.getLocation(), name.range, flags, {}, result,
+                    scope, &syntax);
 
     if (!result.found) {
         if (flags.has(LookupFlags::AlwaysAllowUpward)) {
@@ -1202,8 +1210,8 @@ const Symbol* Lookup::unqualified(const Scope& scope, std::string_view name,
         return nullptr;
 
     LookupResult result;
-    unqualifiedImpl(scope, name, LookupLocation::max, std::nullopt, flags, {}, result, scope,
-                    nullptr);
+    unqualifiedImpl(scope, name, IdentifierTable::getDefault().find(name), LookupLocation::max,
+                    std::nullopt, flags, {}, result, scope, nullptr);
 
     SLANG_ASSERT(result.selectors.empty());
     unwrapResult(scope, std::nullopt, result, /* unwrapGenericClasses */ false);
@@ -1218,7 +1226,8 @@ const Symbol* Lookup::unqualifiedAt(const Scope& scope, std::string_view name,
         return nullptr;
 
     LookupResult result;
-    unqualifiedImpl(scope, name, location, sourceRange, flags, {}, result, scope, nullptr);
+    unqualifiedImpl(scope, name, IdentifierTable::getDefault().find(name), location, sourceRange,
+                    flags, {}, result, scope, nullptr);
 
     SLANG_ASSERT(result.selectors.empty());
     unwrapResult(scope, sourceRange, result, /* unwrapGenericClasses */ false);
@@ -1418,6 +1427,7 @@ void Lookup::selectChild(const Type& virtualInterface, SourceRange range,
             NamePlusLoc npl;
             npl.dotLocation = memberSel->dotLocation;
             npl.name.text = memberSel->name;
+            npl.name.id = IdentifierTable::getDefault().find(memberSel->name);
             npl.name.range = memberSel->nameRange;
             std::ranges::reverse(elementSelects); // reverse the element selects since we initially
                                                   // saw them in reverse order
@@ -1658,7 +1668,7 @@ bool Lookup::withinClassRandomize(const ASTContext& context, const NameSyntax& s
                 }
             }
 
-            result.found = classScope.find(name.text);
+            result.found = classScope.find(name.id);
             break;
         case SyntaxKind::ThisHandle:
             result.found = details.thisVar;
@@ -1743,10 +1753,11 @@ bool Lookup::findAssertionLocalVar(const ASTContext& context, const NameSyntax&
     return lookupDownward(nameParts, name, context, LookupFlags::None, result);
 }
 
-void Lookup::unqualifiedImpl(const Scope& scope, std::string_view name, LookupLocation location,
-                             std::optional<SourceRange> sourceRange, bitmask<LookupFlags> flags,
-                             SymbolIndex outOfBlockIndex, LookupResult& result,
-                             const Scope& originalScope, const SyntaxNode* originalSyntax) {
+void Lookup::unqualifiedImpl(const Scope& scope, std::string_view name, IdentifierId nameId,
+                             LookupLocation location, std::optional<SourceRange> sourceRange,
+                             bitmask<LookupFlags> flags, SymbolIndex outOfBlockIndex,
+                             LookupResult& result, const Scope& originalScope,
+                             const SyntaxNode* originalSyntax) {
     auto reportRecursiveError = [&](const Symbol& symbol) {
         if (sourceRange) {
             auto& diag = result.addDiag(scope, diag::RecursiveDefinition, *sourceRange);
@@ -1759,7 +1770,7 @@ void Lookup::unqualifiedImpl(const Scope& scope, std::string_view name, LookupLo
     // Try a simple name lookup to see if we find anything.
     auto& nameMap = scope.getNameMap();
     const Symbol* symbol = nullptr;
-    if (auto it = nameMap.find(name); it != nameMap.end()) {
+    if (auto it = nameMap.find(nameId); it != nameMap.end()) {
         // If the lookup is for a local name, check that we can access the symbol (it must be
         // declared before use). Callables and block names can be referenced anywhere in the
         // scope, so the location doesn't matter for them.
@@ -1955,7 +1966,7 @@ void Lookup::unqualifiedImpl(const Scope& scope, std::string_view name, LookupLo
                 scope.getCompilation().forceElaborate(scope.asSymbol());
             }
 
-            if (auto it = wildcardImportData->importedSymbols.find(name);
+            if (auto it = wildcardImportData->importedSymbols.find(nameId);
                 it != wildcardImportData->importedSymbols.end()) {
                 result.flags |= LookupResultFlags::WasImported;
                 result.found = it->second;
@@ -1980,7 +1991,7 @@ void Lookup::unqualifiedImpl(const Scope& scope, std::string_view name, LookupLo
                     continue;
                 }
 
-                const Symbol* imported = package->findForImport(name);
+                const Symbol* imported = package->findForImport(nameId);
                 if (imported && importDedup.emplace(imported).second)
                     imports.emplace_back(Import{imported, import});
             }
@@ -2066,7 +2077,7 @@ void Lookup::unqualifiedImpl(const Scope& scope, std::string_view name, LookupLo
         return;
     }
 
-    return unqualifiedImpl(*location.getScope(), name, location, sourceRange, flags,
+    return unqualifiedImpl(*location.getScope(), name, nameId, location, sourceRange, flags,
                            outOfBlockIndex, result, originalScope, originalSyntax);
 }
 
@@ -2115,8 +2126,8 @@ void Lookup::qualified(const ScopedNameSyntax& syntax, const ASTContext& context
         case SyntaxKind::IdentifierSelectName:
         case SyntaxKind::ClassName:
             // Start by trying to find the first name segment using normal unqualified lookup
-            unqualifiedImpl(scope, name, context.getLocation(), first.range, flags, {}, result,
-                            scope, nullptr);
+            unqualifiedImpl(scope, name, IdentifierTable::getDefault().find(name),
+                            context.getLocation(), first.range, flags, {}, result, scope, nullptr);
             break;
         case SyntaxKind::UnitScope: {
             // Walk upward to find the compilation unit scope.
@@ -2129,8 +2140,8 @@ void Lookup::qualified(const ScopedNameSyntax& syntax, const ASTContext& context
             do {
                 auto& symbol = current->asSymbol();
                 if (symbol.kind == SymbolKind::CompilationUnit) {
-                    unqualifiedImpl(*current, name, location, first.range, flags, {}, result, scope,
-                                    nullptr);
+                    unqualifiedImpl(*current, name, IdentifierTable::getDefault().find(name),
+                                    location, first.range, flags, {}, result, scope, nullptr);
                     break;
                 }
 
@@ -2258,6 +2269,7 @@ void Lookup::reportUndeclared(const Scope& initialScope, std::string_view name,
     const Symbol* closestSym = nullptr;
     int bestDistance = INT_MAX;
     bool usedBeforeDeclared = false;
+    flat_hash_set<IdentifierId> checkedNames;
     auto scope = &initialScope;
     while (true) {
         // This lambda returns true if the given symbol is a viable candidate
@@ -2321,15 +2333,23 @@ void Lookup::reportUndeclared(const Scope& initialScope, std::string_view name,
         // Only check for typos if that functionality is enabled -- it can be
         // disabled by config or if we've tried too many times to correct typos.
         if (comp.doTypoCorrection()) {
+            // Candidates come from the scope's name map, so each distinct name is
+            // only compared once; a viable name found in an inner scope hides the
+            // same name in outer scopes, which could never be a closer match.
+            // Ties go to the earliest declaration in the scope.
             auto checkMembers = [&](const Scope& toCheck) {
-                for (auto& member : toCheck.members()) {
-                    if (member.name.empty() || !isViable(member))
+                for (auto& [id, member] : toCheck.getNameMap()) {
+                    if (checkedNames.contains(id) || !isViable(*member))
                         continue;
 
-                    int dist = editDistance(member.name, name, /* allowReplacements */ true,
+                    checkedNames.insert(id);
+                    int dist = editDistance(member->name, name, /* allowReplacements */ true,
                                             bestDistance);
-                    if (dist < bestDistance) {
-                        closestSym = &member;
+                    if (dist < bestDistance ||
+                        (dist == bestDistance && closestSym &&
+                         closestSym->getParentScope() == &toCheck &&
+                         member->getIndex() < closestSym->getIndex())) {
+                        closestSym = member;
                         bestDistance = dist;
                     }
                 }
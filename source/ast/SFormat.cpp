@@ -265,8 +265,7 @@ static void formatString(std::string& result, const std::string& value,
 
 static void formatRaw2(std::string& result, const ConstantValue& value) {
     if (value.isUnpacked()) {
-        for (auto& elem : value.elements())
-            formatRaw2(result, elem);
+        value.forEachElement([&](const ConstantValue& elem) { formatRaw2(result, elem); });
         return;
     }
 
@@ -288,8 +287,7 @@ static void formatRaw2(std::string& result, const ConstantValue& value) {
 
 static void formatRaw4(std::string& result, const ConstantValue& value) {
     if (value.isUnpacked()) {
-        for (auto& elem : value.elements())
-            formatRaw4(result, elem);
+        value.forEachElement([&](const ConstantValue& elem) { formatRaw4(result, elem); });
         return;
     }
 
@@ -455,17 +453,17 @@ struct TypeVisitor {
 
     void visit(const FixedSizeUnpackedArrayType& type, const ConstantValue& arg) {
         if (arg)
-            formatArray(type, arg.elements());
+            formatArray(type, arg);
     }
 
     void visit(const DynamicArrayType& type, const ConstantValue& arg) {
         if (arg)
-            formatArray(type, arg.elements());
+            formatArray(type, arg);
     }
 
     void visit(const QueueType& type, const ConstantValue& arg) {
         if (arg)
-            formatArray(type, *arg.queue());
+            formatArray(type, arg);
     }
 
     void visit(const AssociativeArrayType& type, const ConstantValue& arg) {
@@ -504,20 +502,21 @@ struct TypeVisitor {
             buffer.append(arg.toString());
     }
 
-    template<typename T>
-    void formatArray(const Type& type, const T& arr) {
+    void formatArray(const Type& type, const ConstantValue& arr) {
         auto elemType = type.getArrayElementType();
         SLANG_ASSERT(elemType);
 
         buffer.append("'{");
-        for (size_t i = 0; i < arr.size(); i++) {
-            if (i != 0) {
+        bool first = true;
+        arr.forEachElement([&](const ConstantValue& elem) {
+            if (!first) {
                 buffer.append(",");
                 if (!abbreviated)
                     buffer.append(" ");
             }
-            elemType->visit(*this, arr[i]);
-        }
+            first = false;
+            elemType->visit(*this, elem);
+        });
         buffer.append("}");
     }
 
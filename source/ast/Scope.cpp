@@ -563,9 +563,13 @@ void Scope::addMembers(const SyntaxNode& syntax) {
 }
 
 const Symbol* Scope::find(std::string_view name) const {
+    return find(IdentifierTable::getDefault().find(name));
+}
+
+const Symbol* Scope::find(IdentifierId nameId) const {
     // Just do a simple lookup and return the result if we have one.
     ensureElaborated();
-    auto it = nameMap->find(name);
+    auto it = nameMap->find(nameId);
     if (it == nameMap->end())
         return nullptr;
 
@@ -25,6 +25,20 @@ static bool isComparable(const Type& type) {
     return type.isNumeric() || type.isString();
 }
 
+// Evaluates the array a query method is called on. Local variables are looked
+// at in place instead of being copied out, since the array can be large and
+// these methods tend to be called in a loop.
+static const ConstantValue* evalArrayArg(EvalContext& context, const Expression& arg,
+                                         ConstantValue& storage) {
+    if (arg.kind == ExpressionKind::NamedValue) {
+        if (auto local = context.findLocal(&arg.as<NamedValueExpression>().symbol))
+            return local;
+    }
+
+    storage = arg.eval(context);
+    return &storage;
+}
+
 class ArrayReductionMethod : public SystemSubroutine {
 public:
     using Operator = function_ref<void(SVInt&, const SVInt&)>;
@@ -182,8 +196,8 @@ public:
                 sortTarget(*target->queue());
             }
             else {
-                auto& vec = std::get<ConstantValue::Elements>(target->getVariant());
-                sortTarget(vec);
+                auto elems = target->elements();
+                sortTarget(elems);
             }
         }
         else {
@@ -198,8 +212,8 @@ public:
                 sortTarget(*target->queue());
             }
             else {
-                auto& vec = std::get<ConstantValue::Elements>(target->getVariant());
-                sortTarget(vec);
+                auto elems = target->elements();
+                sortTarget(elems);
             }
         }
 
@@ -236,7 +250,7 @@ public:
         if (target->isQueue())
             std::ranges::reverse(*target->queue());
         else
-            std::ranges::reverse(std::get<ConstantValue::Elements>(target->getVariant()));
+            std::ranges::reverse(target->elements());
 
         return nullptr;
     }
@@ -274,12 +288,12 @@ public:
                     context.addDiag(diag::AssociativeWildcardNotAllowed, range) << name;
                     return comp.getErrorType();
                 }
-                return *comp.emplace<QueueType>(*indexType, 0u);
+                return comp.getQueueType(*indexType, 0u);
             }
-            return *comp.emplace<QueueType>(comp.getIntType(), 0u);
+            return comp.getQueueType(comp.getIntType(), 0u);
         }
 
-        return *comp.emplace<QueueType>(*arrayType->getArrayElementType(), 0u);
+        return comp.getQueueType(*arrayType->getArrayElementType(), 0u);
     }
 
     ConstantValue eval(EvalContext& context, const Args& args, SourceRange,
@@ -346,10 +360,13 @@ public:
                     doFind(std::begin(cont), std::end(cont));
             };
 
-            if (arr.isQueue())
+            if (arr.isQueue()) {
                 find(*arr.queue());
-            else
-                find(std::get<ConstantValue::Elements>(arr.getVariant()));
+            }
+            else {
+                auto elems = arr.elements();
+                find(elems);
+            }
         }
 
         return results;
@@ -383,7 +400,7 @@ public:
             return comp.getErrorType();
         }
 
-        return *comp.emplace<QueueType>(*elemType, 0u);
+        return comp.getQueueType(*elemType, 0u);
     }
 
     ConstantValue eval(EvalContext& context, const Args& args, SourceRange,
@@ -469,12 +486,12 @@ public:
                     context.addDiag(diag::AssociativeWildcardNotAllowed, range) << name;
                     return comp.getErrorType();
                 }
-                return *comp.emplace<QueueType>(*indexType, 0u);
+                return comp.getQueueType(*indexType, 0u);
             }
-            return *comp.emplace<QueueType>(comp.getIntType(), 0u);
+            return comp.getQueueType(comp.getIntType(), 0u);
         }
 
-        return *comp.emplace<QueueType>(*arrayType->getArrayElementType(), 0u);
+        return comp.getQueueType(*arrayType->getArrayElementType(), 0u);
     }
 
     ConstantValue eval(EvalContext& context, const Args& args, SourceRange,
@@ -536,11 +553,12 @@ public:
 
     ConstantValue eval(EvalContext& context, const Args& args, SourceRange,
                        const CallExpression::SystemCallInfo&) const final {
-        auto val = args[0]->eval(context);
-        if (!val)
+        ConstantValue storage;
+        auto val = evalArrayArg(context, *args[0], storage);
+        if (!*val)
             return nullptr;
 
-        return SVInt(32, val.size(), true);
+        return SVInt(32, val->size(), true);
     }
 };
 
@@ -659,12 +677,13 @@ public:
 
     ConstantValue eval(EvalContext& context, const Args& args, SourceRange,
                        const CallExpression::SystemCallInfo&) const final {
-        auto array = args[0]->eval(context);
+        ConstantValue storage;
+        auto array = evalArrayArg(context, *args[0], storage);
         auto index = args[1]->eval(context);
-        if (!array || !index)
+        if (!*array || !index)
             return nullptr;
 
-        bool exists = array.map()->count(index);
+        bool exists = array->map()->contains(index);
         return SVInt(32, exists ? 1 : 0, true);
     }
 };
@@ -714,10 +733,49 @@ public:
         return comp.getIntType();
     }
 
-    ConstantValue eval(EvalContext& context, const Args&, SourceRange range,
+    ConstantValue eval(EvalContext& context, const Args& args, SourceRange,
                        const CallExpression::SystemCallInfo&) const final {
-        notConst(context, range);
-        return nullptr;
+        // All of these are answered from the index ordering that the array keeps
+        // alongside its hash table, which stays valid while stepping through a
+        // local array with next() or prev() since nothing is copied.
+        ConstantValue storage;
+        auto array = evalArrayArg(context, *args[0], storage);
+        auto lval = args[1]->evalLValue(context);
+        if (!*array || !lval)
+            return nullptr;
+
+        auto& map = *array->map();
+        const ConstantValue* result = nullptr;
+        switch (knownNameId) {
+            case KnownSystemName::First:
+                if (!map.empty())
+                    result = &map.begin()->first;
+                break;
+            case KnownSystemName::Last:
+                if (!map.empty())
+                    result = &map.rbegin()->first;
+                break;
+            case KnownSystemName::Next: {
+                auto it = map.upper_bound(lval.load());
+                if (it != map.end())
+                    result = &it->first;
+                break;
+            }
+            case KnownSystemName::Prev: {
+                auto it = map.lower_bound(lval.load());
+                if (it != map.begin())
+                    result = &(--it)->first;
+                break;
+            }
+            default:
+                SLANG_UNREACHABLE;
+        }
+
+        if (!result)
+            return SVInt(32, 0, true);
+
+        lval.store(*result);
+        return SVInt(32, 1, true);
     }
 };
 
@@ -984,14 +1042,14 @@ public:
                                                            iterExpr->sourceRange);
             }
             case SymbolKind::DynamicArrayType:
-                return *comp.emplace<DynamicArrayType>(elemType);
+                return comp.getDynamicArrayType(elemType);
             case SymbolKind::AssociativeArrayType: {
                 auto& aat = arrayType.as<AssociativeArrayType>();
-                return *comp.emplace<AssociativeArrayType>(elemType, aat.indexType);
+                return comp.getAssociativeArrayType(elemType, aat.indexType);
             }
             case SymbolKind::QueueType: {
                 auto& qt = arrayType.as<QueueType>();
-                return *comp.emplace<QueueType>(elemType, qt.maxBound);
+                return comp.getQueueType(elemType, qt.maxBound);
             }
             default:
                 SLANG_UNREACHABLE;
@@ -1016,7 +1074,7 @@ public:
                 if (!cv)
                     return nullptr;
 
-                results.emplace(key, std::move(cv));
+                results.try_emplace(key, std::move(cv));
             }
             return results;
         }
@@ -1041,7 +1099,8 @@ public:
             }
             else {
                 ConstantValue::Elements results;
-                if (!doMap(std::get<ConstantValue::Elements>(arr.getVariant()), results))
+                auto elems = arr.elements();
+                if (!doMap(elems, results))
                     return nullptr;
                 return results;
             }
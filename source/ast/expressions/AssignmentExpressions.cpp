@@ -8,6 +8,7 @@
 #include "slang/ast/expressions/AssignmentExpressions.h"
 
 #include "slang/ast/ASTSerializer.h"
+#include "slang/ast/ASTVisitor.h"
 #include "slang/ast/Bitstream.h"
 #include "slang/ast/Compilation.h"
 #include "slang/ast/EvalContext.h"
@@ -538,26 +539,36 @@ ConstantValue NewArrayExpression::evalImpl(EvalContext& context) const {
     }
 
     size_t count = size_t(*size);
-    size_t index = 0;
-    std::vector<ConstantValue> result(count);
+    ConstantValue def = type->getArrayElementType()->getDefaultValue();
+    if (!initExpr())
+        return SVRunArray::createFilled(count, def);
 
-    ConstantValue iv;
-    if (initExpr()) {
-        iv = initExpr()->eval(context);
-        if (!iv)
-            return nullptr;
+    ConstantValue iv = initExpr()->eval(context);
+    if (!iv)
+        return nullptr;
 
+    // Keep as many of the initializer's elements as fit; any remaining
+    // elements are default initialized.
+    SVRunArray result;
+    size_t index = std::min(count, iv.size());
+    if (iv.isRunArray()) {
+        size_t start = 0;
+        for (auto& run : iv.runArray()->runs) {
+            if (start >= index)
+                break;
+
+            result.append(run.value, std::min(run.end, index) - start);
+            start = run.end;
+        }
+    }
+    else {
         auto elems = iv.elements();
-        for (; index < count && index < elems.size(); index++)
-            result[index] = elems[index];
+        for (size_t i = 0; i < index; i++)
+            result.append(std::move(elems[i]), 1);
     }
 
-    // Any remaining elements are default initialized.
-    ConstantValue def = type->getArrayElementType()->getDefaultValue();
-    for (; index < count; index++)
-        result[index] = def;
-
-    return result;
+    result.append(std::move(def), count - index);
+    return std::move(result).finish();
 }
 
 void NewArrayExpression::serializeTo(ASTSerializer& serializer) const {
@@ -860,6 +871,23 @@ Expression& Expression::bindAssignmentPattern(Compilation& comp,
     }
 }
 
+// Determines whether an assignment pattern element can be evaluated once and its
+// value reused everywhere the element appears. Calls and assignments rule that out,
+// since every evaluation has to happen for its side effects (and evaluation steps).
+static bool canReuseElementValue(const Expression& expr) {
+    bool result = true;
+    auto visitor = makeVisitor([&](auto&, const AssignmentExpression&) { result = false; },
+                               [&](auto&, const CallExpression&) { result = false; },
+                               [&](auto& v, const UnaryExpression& unary) {
+                                   if (OpInfo::isLValue(unary.op))
+                                       result = false;
+                                   else
+                                       v.visitDefault(unary);
+                               });
+    expr.visit(visitor);
+    return result;
+}
+
 ConstantValue AssignmentPatternExpressionBase::evalImpl(EvalContext& context) const {
     size_t replCount = 1;
     if (kind == ExpressionKind::ReplicatedAssignmentPattern) {
@@ -924,6 +952,58 @@ ConstantValue AssignmentPatternExpressionBase::evalImpl(EvalContext& context) co
         result.resizeToBound();
         return result;
     }
+    else if (auto& ct = type->getCanonicalType();
+             ct.kind == SymbolKind::FixedSizeUnpackedArrayType ||
+             ct.kind == SymbolKind::DynamicArrayType) {
+        // Arrays are built up as runs of the same value, so that patterns
+        // like '{default: 0} or '{N{x}} on a huge array only evaluate and
+        // store each value once. Default and type setters show up as the
+        // same expression repeated for every element they cover. Elements
+        // with side effects are still evaluated once per element they cover.
+        auto elems = elements();
+        SVRunArray runs;
+        bool allReused = true;
+        auto evalElements = [&] {
+            for (size_t i = 0; i < elems.size();) {
+                size_t j = i + 1;
+                while (j < elems.size() && elems[j] == elems[i])
+                    j++;
+
+                const bool reuse = canReuseElementValue(*elems[i]);
+                allReused &= reuse;
+                for (; i < j; i += reuse ? j - i : 1) {
+                    ConstantValue v = elems[i]->eval(context);
+                    if (!v)
+                        return false;
+
+                    runs.append(std::move(v), reuse ? j - i : 1);
+                }
+            }
+            return true;
+        };
+
+        for (size_t i = 0; i < replCount; i++) {
+            if (!evalElements())
+                return nullptr;
+
+            if (allReused && replCount > 1) {
+                // Nothing needs to be evaluated again, so the remaining
+                // copies can reuse the runs from the first one.
+                SVRunArray replicated;
+                for (size_t k = 0; k < replCount; k++) {
+                    size_t start = 0;
+                    for (auto& run : runs.runs) {
+                        replicated.append(run.value, run.end - start);
+                        start = run.end;
+                    }
+                }
+                runs = std::move(replicated);
+                break;
+            }
+        }
+
+        return std::move(runs).finish();
+    }
     else {
         std::vector<ConstantValue> values;
         for (size_t i = 0; i < replCount; i++) {
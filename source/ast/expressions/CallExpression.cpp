@@ -7,6 +7,8 @@
 //------------------------------------------------------------------------------
 #include "slang/ast/expressions/CallExpression.h"
 
+#include "../EvalBytecode.h"
+
 #include "slang/ast/Compilation.h"
 #include "slang/ast/Constraints.h"
 #include "slang/ast/EvalContext.h"
@@ -666,6 +668,23 @@ Expression& CallExpression::createSystemCall(
     return *expr;
 }
 
+// Reals are excluded because values that compare equal (such as positive
+// and negative zero) can still produce different results.
+static bool isMemoizableValue(const ConstantValue& value) {
+    if (value.isInteger() || value.isString() || value.isDenseArray())
+        return true;
+
+    if (value.isRunArray()) {
+        return std::ranges::all_of(value.runArray()->runs,
+                                   [](auto& run) { return isMemoizableValue(run.value); });
+    }
+
+    if (value.isUnpacked())
+        return std::ranges::all_of(value.elements(), isMemoizableValue);
+
+    return false;
+}
+
 ConstantValue CallExpression::evalImpl(EvalContext& context) const {
     // If thisClass() is set call eval on it to be sure an error is issued.
     if (thisClass()) {
@@ -693,19 +712,49 @@ ConstantValue CallExpression::evalImpl(EvalContext& context) const {
         args.emplace_back(std::move(v));
     }
 
+    return evalSubroutine(context, args);
+}
+
+ConstantValue CallExpression::evalSubroutine(EvalContext& context,
+                                             std::span<ConstantValue> args) const {
+    const SubroutineSymbol& symbol = *std::get<0>(subroutine);
+
+    // Results of functions that depend only on their arguments are shared across
+    // the whole compilation. The arguments are moved into locals below so we need
+    // to hold on to a copy of them to use as the key.
+    auto& comp = context.getCompilation();
+    SmallVector<ConstantValue, 4> memoArgs;
+    const bool memoize = symbol.isMemoizable() && std::ranges::all_of(args, isMemoizableValue);
+    if (memoize) {
+        if (auto memoized = comp.findMemoizedCall(symbol, args)) {
+            if (!context.noteMemoizedCall(symbol, sourceRange.start()))
+                return nullptr;
+            return std::move(*memoized);
+        }
+
+        memoArgs.append(args.begin(), args.end());
+    }
+    const size_t diagCount = context.getDiagnosticCount();
+
     // Push a new stack frame, push argument values as locals.
     if (!context.pushFrame(symbol, sourceRange.start(), lookupLocation))
         return nullptr;
 
+    SmallVector<ConstantValue*, 8> locals;
     std::span<const FormalArgumentSymbol* const> formals = symbol.getArguments();
+    SLANG_ASSERT(formals.size() == args.size());
     for (size_t i = 0; i < formals.size(); i++)
-        context.createLocal(formals[i], args[i]);
+        locals.push_back(context.createLocal(formals[i], std::move(args[i])));
 
     SLANG_ASSERT(symbol.returnValVar);
-    context.createLocal(symbol.returnValVar);
+    locals.push_back(context.createLocal(symbol.returnValVar));
 
     using ER = Statement::EvalResult;
-    ER er = symbol.getBody().eval(context);
+    ER er;
+    if (auto bytecode = symbol.getBytecode())
+        er = bytecode->run(context, locals);
+    else
+        er = symbol.getBody().eval(context);
 
     // If we got a disable result, it means a disable statement was evaluated that
     // targeted a block that wasn't executing. This isn't allowed in a constant expression.
@@ -720,6 +769,12 @@ ConstantValue CallExpression::evalImpl(EvalContext& context) const {
         return nullptr;
 
     SLANG_ASSERT(er == ER::Success || er == ER::Return);
+
+    // Calls that issue diagnostics aren't memoized so that every
+    // call site continues to report them.
+    if (memoize && context.getDiagnosticCount() == diagCount)
+        comp.memoizeCall(symbol, memoArgs, result);
+
     return result;
 }
 
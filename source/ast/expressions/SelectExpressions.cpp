@@ -210,7 +210,18 @@ bool ElementSelectExpression::isConstantSelect(EvalContext& context) const {
 }
 
 ConstantValue ElementSelectExpression::evalImpl(EvalContext& context) const {
-    ConstantValue cv = value().eval(context);
+    // Associative arrays held in local variables are looked up in place;
+    // copying out the whole table for every lookup would make loops that
+    // read from a table quadratic.
+    const ConstantValue* local = nullptr;
+    if (value().type->isAssociativeArray() && value().kind == ExpressionKind::NamedValue)
+        local = context.findLocal(&value().as<NamedValueExpression>().symbol);
+
+    ConstantValue storage;
+    if (!local)
+        storage = value().eval(context);
+
+    const ConstantValue& cv = local ? *local : storage;
     if (!cv)
         return nullptr;
 
@@ -228,8 +239,13 @@ ConstantValue ElementSelectExpression::evalImpl(EvalContext& context) const {
     const Type& valType = *value().type;
     if (valType.hasFixedRange()) {
         // For fixed types, we know we will always be in range, so just do the selection.
-        if (valType.isUnpackedArray())
+        if (valType.isUnpackedArray()) {
+            if (cv.isDenseArray())
+                return cv.denseArray()->get(size_t(range->left));
+            if (cv.isRunArray())
+                return cv.runArray()->get(size_t(range->left));
             return cv.elements()[size_t(range->left)];
+        }
         else
             return cv.integer().slice(range->left, range->right);
     }
@@ -237,8 +253,8 @@ ConstantValue ElementSelectExpression::evalImpl(EvalContext& context) const {
     // Handling for associative arrays.
     if (valType.isAssociativeArray()) {
         auto& map = *cv.map();
-        if (auto it = map.find(associativeIndex); it != map.end())
-            return it->second;
+        if (auto val = map.find(associativeIndex))
+            return *val;
 
         // If there is a user specified default, return that without warning.
         if (map.defaultValue)
@@ -255,7 +271,14 @@ ConstantValue ElementSelectExpression::evalImpl(EvalContext& context) const {
     if (valType.isString())
         return cv.getSlice(range->left, range->right, nullptr);
 
-    return std::move(cv).at(size_t(range->left));
+    // Dynamic arrays can be stored compactly too; pull out just the one
+    // element instead of letting at() expand the whole thing.
+    if (cv.isDenseArray())
+        return cv.denseArray()->get(size_t(range->left));
+    if (cv.isRunArray())
+        return cv.runArray()->get(size_t(range->left));
+
+    return std::move(storage).at(size_t(range->left));
 }
 
 LValue ElementSelectExpression::evalLValueImpl(EvalContext& context) const {
@@ -263,8 +286,10 @@ LValue ElementSelectExpression::evalLValueImpl(EvalContext& context) const {
     if (!lval)
         return nullptr;
 
+    // Associative array lookups don't need the current value, and loading
+    // it would copy the entire table.
     ConstantValue loadedVal;
-    if (!value().type->hasFixedRange())
+    if (!value().type->hasFixedRange() && !value().type->isAssociativeArray())
         loadedVal = lval.load();
 
     bool softFail = false;
@@ -468,7 +493,7 @@ Expression& RangeSelectExpression::fromSyntax(Compilation& compilation, Expressi
 
     // If this is selecting from a queue, the result is always a queue.
     if (isQueue) {
-        result->type = compilation.emplace<QueueType>(elementType, 0u);
+        result->type = &compilation.getQueueType(elementType, 0u);
         return *result;
     }
 
@@ -478,7 +503,7 @@ Expression& RangeSelectExpression::fromSyntax(Compilation& compilation, Expressi
     if (context.flags.has(ASTFlags::StreamingWithRange)) {
         if (context.inUnevaluatedBranch() || !context.tryEval(right) ||
             (selectionKind == RangeSelectionKind::Simple && !context.tryEval(left))) {
-            result->type = compilation.emplace<QueueType>(elementType, 0u);
+            result->type = &compilation.getQueueType(elementType, 0u);
             return *result;
         }
     }
@@ -504,10 +504,8 @@ ER ForeachLoopStatement::evalRecursive(EvalContext& context, const ConstantValue
         }
     }
     else {
-        std::span<const ConstantValue> elements;
-        if (cv.isUnpacked())
-            elements = cv.elements();
-
+        // Elements are fetched one at a time, and only to recurse into, so that
+        // dense arrays don't have to build all of them just to be iterated over.
         ConstantRange range;
         bool isLittleEndian;
         if (dim.range) {
@@ -515,7 +513,7 @@ ER ForeachLoopStatement::evalRecursive(EvalContext& context, const ConstantValue
             isLittleEndian = range.isLittleEndian();
         }
         else {
-            range = {0, int32_t(elements.size()) - 1};
+            range = {0, cv.isUnpacked() ? int32_t(cv.size()) - 1 : -1};
             isLittleEndian = false;
         }
 
@@ -530,7 +528,8 @@ ER ForeachLoopStatement::evalRecursive(EvalContext& context, const ConstantValue
                 if (dim.range)
                     index = (size_t)range.reverse().translateIndex(i);
 
-                result = evalRecursive(context, elements.empty() ? nullptr : elements[index],
+                result = evalRecursive(context,
+                                       cv.isUnpacked() ? cv.elementAt(index) : nullptr,
                                        currDims.subspan(1));
             }
             else {
@@ -116,6 +116,10 @@ PackageSymbol& PackageSymbol::fromSyntax(const Scope& scope, const ModuleDeclara
 }
 
 const Symbol* PackageSymbol::findForImport(std::string_view lookupName) const {
+    return findForImport(IdentifierTable::getDefault().find(lookupName));
+}
+
+const Symbol* PackageSymbol::findForImport(IdentifierId lookupName) const {
     auto& scopeNameMap = getNameMap();
     if (auto it = scopeNameMap.find(lookupName); it != scopeNameMap.end()) {
         auto symbol = it->second;
@@ -7,6 +7,8 @@
 //------------------------------------------------------------------------------
 #include "slang/ast/symbols/SubroutineSymbols.h"
 
+#include "../EvalBytecode.h"
+
 #include "slang/ast/ASTSerializer.h"
 #include "slang/ast/ASTVisitor.h"
 #include "slang/ast/Compilation.h"
@@ -59,6 +61,105 @@ const Statement& SubroutineSymbol::getBody() const {
     return *stmt;
 }
 
+const EvalBytecode* SubroutineSymbol::getBytecode() const {
+    if (!bytecode) {
+        // Bytecode is allocated in the compilation, so once it has been frozen
+        // we can no longer create it and the tree walker gets used instead.
+        auto& comp = getCompilation();
+        if (comp.isFrozen() || comp.hasFlag(CompilationFlags::DisableConstEvalBytecode))
+            return nullptr;
+
+        // Recursive calls made while the body is still being bound can't
+        // be compiled yet.
+        auto& body = getBody();
+        if (isConstructing)
+            return nullptr;
+
+        bytecode = body.bad() ? nullptr : EvalBytecode::compile(comp, *this);
+    }
+    return *bytecode;
+}
+
+bool SubroutineSymbol::isMemoizable() const {
+    if (cachedIsMemoizable)
+        return *cachedIsMemoizable;
+
+    // The answer can't be cached once the compilation is frozen and other threads
+    // might be reading it, so just skip memoization in that case.
+    if (getCompilation().isFrozen())
+        return false;
+
+    // Walk the whole call graph from this function. Functions that have already
+    // been visited are assumed to be fine since the walk will check them anyway;
+    // only the result for this root is cached because the results for the
+    // functions along the way depend on those assumptions.
+    SmallSet<const SubroutineSymbol*, 4> visited;
+    bool incomplete = false;
+    auto check = [&](auto& self, const SubroutineSymbol& sub) -> bool {
+        if (!visited.emplace(&sub).second)
+            return true;
+
+        if (sub.subroutineKind != SubroutineKind::Function || sub.thisVar ||
+            sub.flags.has(MethodFlags::DPIImport | MethodFlags::Virtual | MethodFlags::Pure) ||
+            sub.hasOutputArgs()) {
+            return false;
+        }
+
+        // Recursive calls made while a body is still being bound can't be checked yet.
+        if (sub.isConstructing) {
+            incomplete = true;
+            return false;
+        }
+
+        auto& body = sub.getBody();
+        if (body.bad())
+            return false;
+
+        auto isLocal = [&](const Symbol& symbol) {
+            for (auto scope = symbol.getParentScope(); scope;
+                 scope = scope->asSymbol().getParentScope()) {
+                if (scope == &sub)
+                    return true;
+            }
+            return false;
+        };
+
+        bool result = true;
+        body.visit(makeVisitor(
+            [&](auto&, const HierarchicalValueExpression&) { result = false; },
+            [&](auto&, const NamedValueExpression& expr) {
+                switch (expr.symbol.kind) {
+                    case SymbolKind::Parameter:
+                    case SymbolKind::EnumValue:
+                    case SymbolKind::Specparam:
+                        break;
+                    default:
+                        if (!isLocal(expr.symbol))
+                            result = false;
+                        break;
+                }
+            },
+            [&](auto& v, const CallExpression& call) {
+                if (call.isSystemCall()) {
+                    if (call.getSubroutineKind() == SubroutineKind::Task)
+                        result = false;
+                }
+                else if (!self(self, *std::get<0>(call.subroutine))) {
+                    result = false;
+                }
+
+                if (result)
+                    v.visitDefault(call);
+            }));
+        return result;
+    };
+
+    bool result = check(check, *this);
+    if (!incomplete)
+        cachedIsMemoizable = result;
+    return result;
+}
+
 std::pair<SubroutineSymbol*, bool> SubroutineSymbol::fromSyntax(
     Compilation& compilation, const FunctionDeclarationSyntax& syntax, const Scope& parent,
     bool outOfBlock) {
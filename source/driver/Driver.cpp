@@ -8,6 +8,7 @@
 //------------------------------------------------------------------------------
 #include "slang/driver/Driver.h"
 
+#include <BS_thread_pool.hpp>
 #include <fmt/color.h>
 
 #include "slang/analysis/AnalysisManager.h"
@@ -30,6 +31,7 @@
 #include "slang/text/Json.h"
 #include "slang/util/Random.h"
 #include "slang/util/String.h"
+#include "slang/util/TimeTrace.h"
 
 namespace fs = std::filesystem;
 
@@ -208,6 +210,9 @@ void Driver::addStandardArgs() {
     addCompFlag(CompilationFlags::AllowUnnamedGenerate, "--allow-genblk-reference",
                 "Allow references to unnamed generate blocks via their external names "
                 "(e.g. genblk1)");
+    addCompFlag(CompilationFlags::DisableConstEvalBytecode, "--disable-constexpr-bytecode",
+                "Evaluate constant functions by walking their syntax trees instead of compiling "
+                "them to bytecode");
 
     cmdLine.add("--top", options.topModules,
                 "One or more top-level modules to instantiate "
@@ -383,9 +388,17 @@ void Driver::addStandardArgs() {
     cmdLine.add("--max-case-analysis-steps", options.maxCaseAnalysisSteps,
                 "Maximum number of steps that can occur during case analysis before giving up",
                 "<steps>");
+    cmdLine.addEnum<CaseAnalysisEngine, CaseAnalysisEngine_traits>(
+        "--case-analysis-engine", options.caseAnalysisEngine,
+        "Engine to use for analyzing coverage and overlaps of wildcard case statements",
+        "<engine>");
     cmdLine.add("--max-loop-analysis-steps", options.maxLoopAnalysisSteps,
                 "Maximum number of steps that can occur during loop analysis before giving up",
                 "<steps>");
+    cmdLine.addEnum<LoopAnalysisMode, LoopAnalysisMode_traits>(
+        "--loop-analysis-mode", options.loopAnalysisMode,
+        "Method to use for analyzing for loops: unrolling or widening of the loop variable",
+        "<mode>");
 }
 
 [[nodiscard]] bool Driver::parseCommandLine(std::string_view argList,
@@ -947,6 +960,27 @@ std::unique_ptr<Compilation> Driver::createCompilation() {
     return compilation;
 }
 
+AnalysisOptions Driver::createAnalysisOptions() const {
+    AnalysisOptions ao;
+    ao.numThreads = options.numThreads.value_or(0);
+    if (!options.lintMode())
+        ao.flags |= AnalysisFlags::CheckUnused;
+    if (options.maxCaseAnalysisSteps)
+        ao.maxCaseAnalysisSteps = *options.maxCaseAnalysisSteps;
+    if (options.caseAnalysisEngine)
+        ao.caseAnalysisEngine = *options.caseAnalysisEngine;
+    if (options.maxLoopAnalysisSteps)
+        ao.maxLoopAnalysisSteps = *options.maxLoopAnalysisSteps;
+    if (options.loopAnalysisMode)
+        ao.loopAnalysisMode = *options.loopAnalysisMode;
+
+    for (auto& [flag, value] : options.analysisFlags) {
+        if (value == true)
+            ao.flags |= flag;
+    }
+    return ao;
+}
+
 bool Driver::reportParseDiags() {
     Diagnostics diags;
     for (auto& tree : sourceLoader.getLibraryMaps())
@@ -983,21 +1017,7 @@ std::unique_ptr<AnalysisManager> Driver::runAnalysis(ast::Compilation& compilati
     compilation.getAllDiagnostics();
     compilation.freeze();
 
-    AnalysisOptions ao;
-    ao.numThreads = options.numThreads.value_or(0);
-    if (!options.lintMode())
-        ao.flags |= AnalysisFlags::CheckUnused;
-    if (options.maxCaseAnalysisSteps)
-        ao.maxCaseAnalysisSteps = *options.maxCaseAnalysisSteps;
-    if (options.maxLoopAnalysisSteps)
-        ao.maxLoopAnalysisSteps = *options.maxLoopAnalysisSteps;
-
-    for (auto& [flag, value] : options.analysisFlags) {
-        if (value == true)
-            ao.flags |= flag;
-    }
-
-    auto analysisManager = std::make_unique<AnalysisManager>(ao);
+    auto analysisManager = std::make_unique<AnalysisManager>(createAnalysisOptions());
     analysisManager->analyze(compilation);
 
     for (auto& diag : analysisManager->getDiagnostics(compilation.getSourceManager()))
@@ -1053,6 +1073,117 @@ bool Driver::runFullCompilation(bool quiet) {
     return reportDiagnostics(quiet);
 }
 
+bool Driver::runSweeps(std::span<const std::string> sweeps, bool analyze, bool quiet) {
+    // The base compilation is never elaborated; it just holds the set of
+    // syntax trees and libraries that each sweep forks from.
+    auto base = createCompilation();
+    const auto baseBag = createOptionBag();
+    auto baseOptions = baseBag.getOrDefault<CompilationOptions>();
+
+    struct SweepResult {
+        Diagnostics diags;
+        std::vector<std::string> errors;
+    };
+    std::vector<SweepResult> results(sweeps.size());
+
+    auto runSweep = [&](size_t index) {
+        TimeTraceScope timeScope("sweep"sv, sweeps[index]);
+
+        std::vector<std::string> topModules;
+        std::vector<std::string> paramOverrides;
+        CommandLine sweepCmdLine;
+        sweepCmdLine.add("--top", topModules, "", "", CommandLineFlags::CommaList);
+        sweepCmdLine.add("-G", paramOverrides, "");
+        sweepCmdLine.setProgramName(fmt::format("sweep {}", index + 1));
+
+        CommandLine::ParseOptions parseOpts;
+        parseOpts.ignoreProgramName = true;
+        parseOpts.supportComments = true;
+
+        auto& result = results[index];
+        if (!sweepCmdLine.parse(sweeps[index], parseOpts)) {
+            result.errors.assign(sweepCmdLine.getErrors().begin(),
+                                 sweepCmdLine.getErrors().end());
+            return;
+        }
+
+        auto coptions = baseOptions;
+        if (!topModules.empty()) {
+            coptions.topModules.clear();
+            for (auto& name : topModules)
+                coptions.topModules.emplace(name);
+        }
+        for (auto& opt : paramOverrides)
+            coptions.paramOverrides.emplace_back(opt);
+
+        Bag bag = baseBag;
+        bag.set(coptions);
+
+        auto compilation = base->fork(bag);
+        result.diags = compilation->getAllDiagnostics();
+
+        if (analyze) {
+            compilation->freeze();
+
+            // Sweeps are already running in parallel so each
+            // analysis pass runs on the sweep's own thread.
+            auto ao = createAnalysisOptions();
+            ao.numThreads = 1;
+
+            AnalysisManager analysisManager(ao);
+            analysisManager.analyze(*compilation);
+            result.diags.append_range(analysisManager.getDiagnostics(&sourceManager));
+        }
+    };
+
+    if (sweeps.size() > 1 && options.numThreads != 1u) {
+        BS::thread_pool<> threadPool(options.numThreads.value_or(0u));
+        threadPool.detach_loop(size_t(0), sweeps.size(), runSweep);
+        threadPool.wait();
+    }
+    else {
+        for (size_t i = 0; i < sweeps.size(); i++)
+            runSweep(i);
+    }
+
+    // Report results in order so that output is deterministic.
+    bool succeeded = true;
+    for (size_t i = 0; i < sweeps.size(); i++) {
+        auto& result = results[i];
+        if (!result.errors.empty()) {
+            for (auto& err : result.errors)
+                printError(err);
+            succeeded = false;
+            continue;
+        }
+
+        auto prevErrors = diagEngine.getNumErrors();
+        auto prevWarnings = diagEngine.getNumWarnings();
+        for (auto& diag : result.diags)
+            diagEngine.issue(diag);
+
+        auto numErrors = diagEngine.getNumErrors() - prevErrors;
+        auto numWarnings = diagEngine.getNumWarnings() - prevWarnings;
+        succeeded &= numErrors == 0;
+
+        if (!quiet) {
+            OS::print(fg(textDiagClient->warningColor), fmt::format("Sweep {}: ", i + 1));
+            OS::print(fmt::format("{} ({} error{}, {} warning{})\n", sweeps[i], numErrors,
+                                  numErrors == 1 ? "" : "s", numWarnings,
+                                  numWarnings == 1 ? "" : "s"));
+        }
+
+        // Print each sweep's diagnostics as we go so that they
+        // can be attributed to the sweep that produced them.
+        if (options.diagJson != "-") {
+            OS::printE(textDiagClient->getString());
+            textDiagClient->clear();
+        }
+    }
+
+    return succeeded;
+}
+
 bool Driver::parseUnitListing(std::string_view text) {
     CommandLine unitCmdLine;
     std::vector<std::string> includes;
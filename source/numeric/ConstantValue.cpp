@@ -87,6 +87,36 @@ std::string ConstantValue::toString(bitwidth_t abbreviateThresholdBits, bool exa
                 buffer.append(useAssignmentPatterns ? "}"sv : "]"sv);
                 return buffer.str();
             }
+            else if constexpr (std::is_same_v<T, DenseArray>) {
+                FormatBuffer buffer;
+                buffer.append(useAssignmentPatterns ? "'{"sv : "["sv);
+                for (size_t i = 0; i < arg->size(); i++) {
+                    buffer.append(arg->get(i).toString(abbreviateThresholdBits, exactUnknowns));
+                    buffer.append(",");
+                }
+
+                buffer.pop_back();
+                buffer.append(useAssignmentPatterns ? "}"sv : "]"sv);
+                return buffer.str();
+            }
+            else if constexpr (std::is_same_v<T, RunArray>) {
+                FormatBuffer buffer;
+                buffer.append(useAssignmentPatterns ? "'{"sv : "["sv);
+                size_t start = 0;
+                for (auto& run : arg->runs) {
+                    auto str = run.value.toString(abbreviateThresholdBits, exactUnknowns,
+                                                  useAssignmentPatterns);
+                    for (; start < run.end; start++) {
+                        buffer.append(str);
+                        buffer.append(",");
+                    }
+                }
+
+                if (!arg->runs.empty())
+                    buffer.pop_back();
+                buffer.append(useAssignmentPatterns ? "}"sv : "]"sv);
+                return buffer.str();
+            }
             else if constexpr (std::is_same_v<T, Union>) {
                 if (!arg->activeMember)
                     return "(unset)"s;
@@ -103,7 +133,11 @@ std::string ConstantValue::toString(bitwidth_t abbreviateThresholdBits, bool exa
 }
 
 size_t ConstantValue::hash() const {
-    size_t h = value.index();
+    // Dense and run-length arrays compare equal to the equivalent array
+    // of elements, so they need to hash the same way too.
+    static const size_t elementsIndex = Variant(Elements{}).index();
+
+    size_t h = isDenseArray() || isRunArray() ? elementsIndex : value.index();
     std::visit(
         [&h](auto&& arg) noexcept {
             using T = std::decay_t<decltype(arg)>;
@@ -127,7 +161,7 @@ size_t ConstantValue::hash() const {
                 hash_combine(h, slang::hash<std::string>()(arg));
             else if constexpr (std::is_same_v<T, Map>) {
                 for (auto& [key, val] : *arg) {
-                    hash_combine(h, key.hash());
+                    hash_combine(h, AssociativeArray::KeyHash()(key));
                     hash_combine(h, val.hash());
                 }
             }
@@ -143,6 +177,18 @@ size_t ConstantValue::hash() const {
                     hash_combine(h, arg->value.hash());
                 }
             }
+            else if constexpr (std::is_same_v<T, DenseArray>) {
+                for (size_t i = 0; i < arg->size(); i++)
+                    hash_combine(h, ConstantValue(arg->get(i)).hash());
+            }
+            else if constexpr (std::is_same_v<T, RunArray>) {
+                size_t start = 0;
+                for (auto& run : arg->runs) {
+                    size_t valueHash = run.value.hash();
+                    for (; start < run.end; start++)
+                        hash_combine(h, valueHash);
+                }
+            }
             else {
                 static_assert(always_false<T>::value, "Missing case");
             }
@@ -165,6 +211,8 @@ size_t ConstantValue::size() const {
                 return arg->size();
             else if constexpr (std::is_same_v<T, Queue>)
                 return arg->size();
+            else if constexpr (std::is_same_v<T, DenseArray> || std::is_same_v<T, RunArray>)
+                return arg->size();
             else if constexpr (std::is_same_v<T, std::string>)
                 return arg.size();
             else
@@ -173,7 +221,65 @@ size_t ConstantValue::size() const {
         value);
 }
 
+std::span<ConstantValue> ConstantValue::elements() {
+    if (auto dense = std::get_if<DenseArray>(&value))
+        value = (*dense)->toElements();
+    else if (auto runs = std::get_if<RunArray>(&value))
+        value = (*runs)->toElements();
+
+    return std::get<Elements>(value);
+}
+
+std::span<ConstantValue const> ConstantValue::elements() const {
+    if (auto dense = std::get_if<DenseArray>(&value))
+        return (*dense)->elements();
+    if (auto runs = std::get_if<RunArray>(&value))
+        return (*runs)->elements();
+
+    return std::get<Elements>(value);
+}
+
+ConstantValue ConstantValue::elementAt(size_t index) const {
+    if (auto dense = std::get_if<DenseArray>(&value)) {
+        SLANG_ASSERT(index < (*dense)->size());
+        return (*dense)->get(index);
+    }
+    if (auto runs = std::get_if<RunArray>(&value)) {
+        SLANG_ASSERT(index < (*runs)->size());
+        return (*runs)->get(index);
+    }
+    if (auto queue = std::get_if<Queue>(&value))
+        return (*queue)->at(index);
+
+    return std::get<Elements>(value).at(index);
+}
+
+void ConstantValue::forEachElement(function_ref<void(const ConstantValue&)> func) const {
+    if (auto dense = std::get_if<DenseArray>(&value)) {
+        for (size_t i = 0; i < (*dense)->size(); i++)
+            func((*dense)->get(i));
+    }
+    else if (auto runs = std::get_if<RunArray>(&value)) {
+        size_t i = 0;
+        for (auto& run : (*runs)->runs) {
+            for (; i < run.end; i++)
+                func(run.value);
+        }
+    }
+    else if (auto queue = std::get_if<Queue>(&value)) {
+        for (auto& elem : **queue)
+            func(elem);
+    }
+    else {
+        for (auto& elem : std::get<Elements>(value))
+            func(elem);
+    }
+}
+
 ConstantValue& ConstantValue::at(size_t index) {
+    if (isDenseArray() || isRunArray())
+        elements();
+
     return std::visit(
         [index](auto&& arg) -> ConstantValue& {
             using T = std::decay_t<decltype(arg)>;
@@ -195,6 +301,12 @@ const ConstantValue& ConstantValue::at(size_t index) const {
                 return arg.at(index);
             else if constexpr (std::is_same_v<T, Queue>)
                 return arg->at(index);
+            else if constexpr (std::is_same_v<T, DenseArray>)
+                return arg->elements().at(index);
+            else if constexpr (std::is_same_v<T, RunArray>) {
+                SLANG_ASSERT(index < arg->size());
+                return arg->get(index);
+            }
             else
                 SLANG_UNREACHABLE;
         },
@@ -206,16 +318,37 @@ ConstantValue ConstantValue::getSlice(int32_t upper, int32_t lower,
     if (isInteger())
         return integer().slice(upper, lower);
 
+    if (isDenseArray()) {
+        // Slices that are entirely in bounds can stay dense.
+        auto& dense = *denseArray();
+        if (lower >= 0 && size_t(upper) < dense.size()) {
+            size_t count = size_t(upper - lower + 1);
+            int32_t msb = dense.getElementLsb(size_t(lower)) + int32_t(dense.elementWidth) - 1;
+            SVDenseArray result(dense.bits.slice(msb, dense.getElementLsb(size_t(upper))),
+                                dense.elementWidth, dense.elementSigned);
+
+            if (SVDenseArray::canStore(count, dense.elementWidth))
+                return result;
+            return result.toElements();
+        }
+    }
+
+    if (isRunArray()) {
+        auto& runs = *runArray();
+        if (lower >= 0 && size_t(upper) < runs.size())
+            return runs.slice(size_t(lower), size_t(upper));
+    }
+
     if (isUnpacked()) {
-        std::span<const ConstantValue> elems = elements();
+        const size_t count = size();
         std::vector<ConstantValue> result{size_t(upper - lower + 1)};
         ConstantValue* dest = result.data();
 
         for (int32_t i = lower; i <= upper; i++) {
-            if (i < 0 || size_t(i) >= elems.size())
+            if (i < 0 || size_t(i) >= count)
                 *dest++ = defaultValue;
             else
-                *dest++ = elems[size_t(i)];
+                *dest++ = elementAt(size_t(i));
         }
 
         return result;
@@ -290,6 +423,16 @@ bool ConstantValue::hasUnknown() const {
             if constexpr (std::is_same_v<T, SVInt>) {
                 return arg.hasUnknown();
             }
+            else if constexpr (std::is_same_v<T, DenseArray>) {
+                return arg->bits.hasUnknown();
+            }
+            else if constexpr (std::is_same_v<T, RunArray>) {
+                for (auto& run : arg->runs) {
+                    if (run.value.hasUnknown())
+                        return true;
+                }
+                return false;
+            }
             else if constexpr (std::is_same_v<T, Elements>) {
                 for (auto& element : arg) {
                     if (element.hasUnknown())
@@ -493,10 +636,22 @@ uint64_t ConstantValue::getBitstreamWidth() const {
     if (isString())
         return str().length() * CHAR_BIT;
 
+    if (isDenseArray())
+        return denseArray()->bits.getBitWidth();
+
+    if (isRunArray()) {
+        uint64_t width = 0;
+        size_t start = 0;
+        for (auto& run : runArray()->runs) {
+            width += run.value.getBitstreamWidth() * (run.end - start);
+            start = run.end;
+        }
+        return width;
+    }
+
     uint64_t width = 0;
     if (isUnpacked()) {
-        for (const auto& cv : elements())
-            width += cv.getBitstreamWidth();
+        forEachElement([&](const ConstantValue& cv) { width += cv.getBitstreamWidth(); });
     }
     else if (isMap()) {
         for (const auto& kv : *map())
@@ -531,6 +686,20 @@ std::ostream& operator<<(std::ostream& os, const ConstantValue& cv) {
     return os << cv.toString();
 }
 
+// Compares the elements of two unpacked values one at a time, for when at least
+// one of them is a dense or run-length array.
+static bool elementsEqual(const ConstantValue& lhs, const ConstantValue& rhs) {
+    const size_t count = lhs.size();
+    if (count != rhs.size())
+        return false;
+
+    for (size_t i = 0; i < count; i++) {
+        if (lhs.elementAt(i) != rhs.elementAt(i))
+            return false;
+    }
+    return true;
+}
+
 bool operator==(const ConstantValue& lhs, const ConstantValue& rhs) {
     return std::visit(
         [&](auto&& arg) {
@@ -551,6 +720,9 @@ bool operator==(const ConstantValue& lhs, const ConstantValue& rhs) {
                 if (!rhs.isUnpacked())
                     return false;
 
+                if (rhs.isDenseArray() || rhs.isRunArray())
+                    return elementsEqual(lhs, rhs);
+
                 return arg == std::get<ConstantValue::Elements>(rhs.value);
             }
             else if constexpr (std::is_same_v<T, std::string>)
@@ -574,6 +746,34 @@ bool operator==(const ConstantValue& lhs, const ConstantValue& rhs) {
                 auto& ru = rhs.unionVal();
                 return arg->activeMember == ru->activeMember && arg->value == ru->value;
             }
+            else if constexpr (std::is_same_v<T, ConstantValue::DenseArray>) {
+                if (!rhs.isUnpacked())
+                    return false;
+
+                // Arrays with the same shape can compare all of their bits at once.
+                if (rhs.isDenseArray() && arg->elementWidth == rhs.denseArray()->elementWidth) {
+                    auto& ra = *rhs.denseArray();
+                    return arg->size() == ra.size() && exactlyEqual(arg->bits, ra.bits);
+                }
+
+                return elementsEqual(lhs, rhs);
+            }
+            else if constexpr (std::is_same_v<T, ConstantValue::RunArray>) {
+                if (!rhs.isUnpacked())
+                    return false;
+
+                if (rhs.isRunArray() && arg->runs.size() == rhs.runArray()->runs.size()) {
+                    // Arrays made up of the same runs are certainly equal; otherwise
+                    // the runs may just have been split up differently by writes.
+                    auto sameRun = [](auto& a, auto& b) {
+                        return a.end == b.end && a.value == b.value;
+                    };
+                    if (std::ranges::equal(arg->runs, rhs.runArray()->runs, sameRun))
+                        return true;
+                }
+
+                return elementsEqual(lhs, rhs);
+            }
             else {
                 static_assert(always_false<T>::value, "Missing case");
             }
@@ -582,6 +782,19 @@ bool operator==(const ConstantValue& lhs, const ConstantValue& rhs) {
 }
 
 std::partial_ordering operator<=>(const ConstantValue& lhs, const ConstantValue& rhs) {
+    // Only used when at least one side is a dense or run-length array,
+    // so the elements are compared one at a time.
+    auto compareElements = [&]() -> std::partial_ordering {
+        const size_t ls = lhs.size();
+        const size_t rs = rhs.size();
+        for (size_t i = 0; i < std::min(ls, rs); i++) {
+            auto result = lhs.elementAt(i) <=> rhs.elementAt(i);
+            if (result != 0)
+                return result;
+        }
+        return ls <=> rs;
+    };
+
     return std::visit(
         [&](auto&& arg) -> std::partial_ordering {
             constexpr auto unordered = std::partial_ordering::unordered;
@@ -612,6 +825,9 @@ std::partial_ordering operator<=>(const ConstantValue& lhs, const ConstantValue&
                 if (!rhs.isUnpacked())
                     return unordered;
 
+                if (rhs.isDenseArray() || rhs.isRunArray())
+                    return compareElements();
+
                 return arg <=> std::get<ConstantValue::Elements>(rhs.value);
             }
             else if constexpr (std::is_same_v<T, std::string>) {
@@ -638,6 +854,10 @@ std::partial_ordering operator<=>(const ConstantValue& lhs, const ConstantValue&
 
                 return *arg <=> *rhs.unionVal();
             }
+            else if constexpr (std::is_same_v<T, ConstantValue::DenseArray> ||
+                               std::is_same_v<T, ConstantValue::RunArray>) {
+                return rhs.isUnpacked() ? compareElements() : unordered;
+            }
             else {
                 static_assert(always_false<T>::value, "Missing case");
             }
@@ -645,6 +865,292 @@ std::partial_ordering operator<=>(const ConstantValue& lhs, const ConstantValue&
         lhs.value);
 }
 
+size_t AssociativeArray::KeyHash::operator()(const ConstantValue& key) const {
+    if (key.isInteger()) {
+        // Integer indices compare as unsigned values (see KeyEqual), so equal
+        // indices have the same low word no matter their widths.
+        return hash<uint64_t>()(key.integer().getRawPtr()[0]);
+    }
+
+    if (key.isReal()) {
+        // Positive and negative zero compare equal.
+        double d = key.real();
+        return hash<double>()(d == 0.0 ? 0.0 : d);
+    }
+
+    if (key.isShortReal()) {
+        float f = key.shortReal();
+        return hash<float>()(f == 0.0f ? 0.0f : f);
+    }
+
+    return key.hash();
+}
+
+bool AssociativeArray::KeyEqual::operator()(const ConstantValue& lhs,
+                                            const ConstantValue& rhs) const {
+    if (lhs.isInteger() && rhs.isInteger()) {
+        // Indices of wildcard-indexed arrays can have any integral type and are
+        // treated as unsigned, so -1 and 32'hFFFFFFFF name the same entry. Other
+        // arrays convert every index to their index type, for which comparing
+        // unsigned values is the same as comparing the indices themselves.
+        auto& l = lhs.integer();
+        auto& r = rhs.integer();
+        if ((l.isSigned() == r.isSigned() && l.getBitWidth() == r.getBitWidth()) ||
+            (!l.isSigned() && !r.isSigned())) {
+            return exactlyEqual(l, r);
+        }
+
+        SVInt ul = l;
+        SVInt ur = r;
+        ul.setSigned(false);
+        ur.setSigned(false);
+        return exactlyEqual(ul, ur);
+    }
+    return lhs == rhs;
+}
+
+ConstantValue* AssociativeArray::find(const ConstantValue& key) {
+    auto it = table.find(key);
+    return it == table.end() ? nullptr : &it->second;
+}
+
+const ConstantValue* AssociativeArray::find(const ConstantValue& key) const {
+    auto it = table.find(key);
+    return it == table.end() ? nullptr : &it->second;
+}
+
+std::pair<ConstantValue*, bool> AssociativeArray::try_emplace(ConstantValue key,
+                                                              ConstantValue value) {
+    auto [it, inserted] = table.try_emplace(std::move(key), std::move(value));
+    if (inserted)
+        changed();
+    return {&it->second, inserted};
+}
+
+void AssociativeArray::erase(const ConstantValue& key) {
+    if (table.erase(key))
+        changed();
+}
+
+void AssociativeArray::clear() {
+    table.clear();
+    changed();
+}
+
+AssociativeArray::const_iterator AssociativeArray::lower_bound(const ConstantValue& key) const {
+    auto& entries = getOrder();
+    return std::ranges::partition_point(entries,
+                                        [&](value_type* entry) { return entry->first < key; });
+}
+
+AssociativeArray::const_iterator AssociativeArray::upper_bound(const ConstantValue& key) const {
+    auto& entries = getOrder();
+    return std::ranges::partition_point(entries,
+                                        [&](value_type* entry) { return !(key < entry->first); });
+}
+
+const AssociativeArray::Order& AssociativeArray::getOrder() const {
+    return order.get([this] {
+        // The order hands out mutable entries for non-const iteration;
+        // the table itself is only ever read here.
+        auto& mutableTable = const_cast<Table&>(table);
+
+        Order result;
+        result.reserve(table.size());
+        for (auto& entry : mutableTable)
+            result.push_back(&entry);
+
+        std::ranges::sort(result, [](value_type* a, value_type* b) { return a->first < b->first; });
+        return result;
+    });
+}
+
+bool operator==(const AssociativeArray& lhs, const AssociativeArray& rhs) {
+    if (lhs.size() != rhs.size())
+        return false;
+
+    // No need to put the entries in order just to see if they're the same.
+    for (auto& [key, val] : lhs.table) {
+        auto other = rhs.find(key);
+        if (!other || !(*other == val))
+            return false;
+    }
+    return true;
+}
+
+std::partial_ordering operator<=>(const AssociativeArray& lhs, const AssociativeArray& rhs) {
+    return std::lexicographical_compare_three_way(
+        lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+        [](const AssociativeArray::value_type& a,
+           const AssociativeArray::value_type& b) -> std::partial_ordering {
+            if (auto cmp = a.first <=> b.first; cmp != 0)
+                return cmp;
+            return a.second <=> b.second;
+        });
+}
+
+SVDenseArray::SVDenseArray(SVInt bits, bitwidth_t elementWidth, bool elementSigned) :
+    bits(std::move(bits)), elementWidth(elementWidth), elementSigned(elementSigned) {
+    SLANG_ASSERT(elementWidth && this->bits.getBitWidth() % elementWidth == 0);
+}
+
+SVInt SVDenseArray::get(size_t index) const {
+    SLANG_ASSERT(index < size());
+    int32_t lsb = getElementLsb(index);
+    SVInt result = bits.slice(lsb + int32_t(elementWidth) - 1, lsb);
+    result.setSigned(elementSigned);
+    return result;
+}
+
+void SVDenseArray::set(size_t index, const SVInt& value) {
+    SLANG_ASSERT(index < size());
+    int32_t lsb = getElementLsb(index);
+    setBits(lsb + int32_t(elementWidth) - 1, lsb, value);
+}
+
+void SVDenseArray::setBits(int32_t msb, int32_t lsb, const SVInt& value) {
+    cache.clear();
+    bits.set(msb, lsb, value);
+}
+
+ConstantValue::Elements SVDenseArray::toElements() const {
+    ConstantValue::Elements result;
+    result.reserve(size());
+    for (size_t i = 0; i < size(); i++)
+        result.emplace_back(get(i));
+    return result;
+}
+
+const ConstantValue::Elements& SVDenseArray::elements() const {
+    return cache.get([this] { return toElements(); });
+}
+
+SVDenseArray SVDenseArray::createFilled(size_t count, bitwidth_t elementWidth,
+                                        bool elementSigned, bool fourState) {
+    SLANG_ASSERT(canStore(count, elementWidth));
+    auto width = bitwidth_t(count * elementWidth);
+    return SVDenseArray(fourState ? SVInt::createFillX(width, false) : SVInt(width, 0, false),
+                        elementWidth, elementSigned);
+}
+
+bool SVDenseArray::canStore(size_t count, bitwidth_t elementWidth) {
+    return count >= MinElements && elementWidth &&
+           uint64_t(count) * elementWidth <= SVInt::MAX_BITS;
+}
+
+ConstantValue SVDenseArray::pack(ConstantValue::Elements&& elements) {
+    if (elements.empty() || !elements[0].isInteger())
+        return std::move(elements);
+
+    bitwidth_t width = elements[0].integer().getBitWidth();
+    bool isSigned = elements[0].integer().isSigned();
+    if (!canStore(elements.size(), width))
+        return std::move(elements);
+
+    for (auto& elem : elements) {
+        if (!elem.isInteger() || elem.integer().getBitWidth() != width ||
+            elem.integer().isSigned() != isSigned) {
+            return std::move(elements);
+        }
+    }
+
+    SmallVector<SVInt> operands;
+    operands.reserve(elements.size());
+    for (auto& elem : elements)
+        operands.emplace_back(std::move(elem).integer());
+
+    return SVDenseArray(SVInt::concat(operands), width, isSigned);
+}
+
+SVRunArray::SVRunArray(size_t count, ConstantValue value) {
+    if (count)
+        runs.push_back({std::move(value), count});
+}
+
+const ConstantValue& SVRunArray::get(size_t index) const {
+    SLANG_ASSERT(index < size());
+    auto it = std::ranges::upper_bound(runs, index, {}, &Run::end);
+    return it->value;
+}
+
+ConstantValue& SVRunArray::getForWrite(size_t index) {
+    SLANG_ASSERT(index < size());
+    cache.clear();
+
+    auto it = std::ranges::upper_bound(runs, index, {}, &Run::end);
+    size_t start = it == runs.begin() ? 0 : std::prev(it)->end;
+    size_t end = it->end;
+    if (end - start == 1)
+        return it->value;
+
+    // Split the run into (up to) three pieces, with the
+    // element being written in a run all by itself.
+    SmallVector<Run, 3> pieces;
+    if (index > start)
+        pieces.push_back({it->value, index});
+    pieces.push_back({it->value, index + 1});
+    if (end > index + 1)
+        pieces.push_back({it->value, end});
+
+    size_t offset = size_t(it - runs.begin()) + (index > start ? 1 : 0);
+    *it = std::move(pieces.back());
+    runs.insert(it, std::make_move_iterator(pieces.begin()),
+                std::make_move_iterator(pieces.end() - 1));
+    return runs[offset].value;
+}
+
+void SVRunArray::append(ConstantValue value, size_t count) {
+    if (!count)
+        return;
+
+    cache.clear();
+    if (!runs.empty() && runs.back().value == value)
+        runs.back().end += count;
+    else
+        runs.push_back({std::move(value), size() + count});
+}
+
+ConstantValue SVRunArray::slice(size_t lower, size_t upper) const {
+    SLANG_ASSERT(lower <= upper && upper < size());
+
+    SVRunArray result;
+    auto it = std::ranges::upper_bound(runs, lower, {}, &Run::end);
+    for (size_t start = lower; start <= upper; ++it) {
+        size_t end = std::min(it->end, upper + 1);
+        result.append(it->value, end - start);
+        start = end;
+    }
+    return std::move(result).finish();
+}
+
+ConstantValue::Elements SVRunArray::toElements() const {
+    ConstantValue::Elements result;
+    result.reserve(size());
+    for (auto& run : runs)
+        result.resize(run.end, run.value);
+    return result;
+}
+
+ConstantValue SVRunArray::expand() const {
+    return SVDenseArray::pack(toElements());
+}
+
+const ConstantValue::Elements& SVRunArray::elements() const {
+    return cache.get([this] { return toElements(); });
+}
+
+ConstantValue SVRunArray::createFilled(size_t count, const ConstantValue& value) {
+    if (count < MinElements)
+        return ConstantValue::Elements(count, value);
+    return SVRunArray(count, value);
+}
+
+ConstantValue SVRunArray::finish() && {
+    if (size() < MinElements || isFragmented())
+        return expand();
+    return std::move(*this);
+}
+
 ConstantRange ConstantRange::subrange(ConstantRange select) const {
     int32_t l = lower();
     ConstantRange result;
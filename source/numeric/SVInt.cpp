@@ -276,13 +276,13 @@ SVInt SVInt::fromDecimalDigits(bitwidth_t bits, bool isSigned, std::span<logic_t
     auto writeWord = [&]() {
         if (!count) {
             if (word)
-                result.pVal[count++] = word;
+                result.getRawData()[count++] = word;
         }
         else {
-            uint64_t carry = mulOne(result.pVal, result.pVal, count, maxWord);
-            carry += addOne(result.pVal, result.pVal, count, word);
+            uint64_t carry = mulOne(result.getRawData(), result.getRawData(), count, maxWord);
+            carry += addOne(result.getRawData(), result.getRawData(), count, word);
             if (carry)
-                result.pVal[count++] = carry;
+                result.getRawData()[count++] = carry;
         }
     };
 
@@ -317,7 +317,7 @@ SVInt SVInt::fromPow2Digits(bitwidth_t bits, bool isSigned, bool anyUnknown, uin
     uint32_t ones = (1 << shift) - 1;
     uint64_t word = 0;
     uint64_t unknownWord = 0;
-    uint64_t* dest = result.pVal;
+    uint64_t* dest = result.getRawData();
     uint64_t* endPtr = dest + numWords;
     uint32_t bitPos = 0;
 
@@ -383,17 +383,17 @@ SVInt SVInt::fromPow2Digits(bitwidth_t bits, bool isSigned, bool anyUnknown, uin
         }
 
         uint32_t topWord = numWords + wordOffset;
-        if (result.pVal[topWord] >> (wordBits - 1)) {
+        if (result.getRawData()[topWord] >> (wordBits - 1)) {
             // Unknown bit was set, so now do the extension.
-            result.pVal[topWord] |= mask;
+            result.getRawData()[topWord] |= mask;
             for (topWord++; topWord < numWords * 2; topWord++)
-                result.pVal[topWord] = UINT64_MAX;
+                result.getRawData()[topWord] = UINT64_MAX;
 
-            if (result.pVal[wordOffset] >> (wordBits - 1)) {
+            if (result.getRawData()[wordOffset] >> (wordBits - 1)) {
                 // The Z bit was set as well, so handle that too.
-                result.pVal[wordOffset] |= mask;
+                result.getRawData()[wordOffset] |= mask;
                 for (wordOffset++; wordOffset < numWords; wordOffset++)
-                    result.pVal[wordOffset] = UINT64_MAX;
+                    result.getRawData()[wordOffset] = UINT64_MAX;
             }
             result.clearUnusedBits();
         }
@@ -424,23 +424,24 @@ void SVInt::setAllZeros() {
     else if (unknownFlag)
         *this = SVInt(bitWidth, 0, signFlag);
     else
-        memset(pVal, 0, getNumWords() * WORD_SIZE);
+        memset(getRawData(), 0, getNumWords() * WORD_SIZE);
 }
 
 void SVInt::setAllOnes() {
     // we don't have unknown digits anymore, so reallocate if necessary
     if (unknownFlag) {
+        if (!isInline())
+            delete[] pVal;
         unknownFlag = false;
-        delete[] pVal;
-        if (getNumWords() > 1)
-            pVal = new uint64_t[getNumWords()];
+        allocData();
     }
 
     if (isSingleWord())
         val = UINT64_MAX;
     else {
+        uint64_t* data = getRawData();
         for (uint32_t i = 0; i < getNumWords(); i++)
-            pVal[i] = UINT64_MAX;
+            data[i] = UINT64_MAX;
     }
     clearUnusedBits();
 }
@@ -448,34 +449,36 @@ void SVInt::setAllOnes() {
 void SVInt::setAllX() {
     // first set low half to zero (for X)
     uint32_t words = getNumWords(bitWidth, false);
-    if (unknownFlag)
-        memset(pVal, 0, words * WORD_SIZE);
-    else {
-        if (!isSingleWord())
+    if (!unknownFlag) {
+        if (!isInline())
             delete[] pVal;
 
         unknownFlag = true;
-        pVal = new uint64_t[words * 2]();
+        allocData();
     }
 
+    uint64_t* data = getRawData();
+    memset(data, 0, words * WORD_SIZE);
+
     // now set upper half to ones (for unknown)
     for (uint32_t i = words; i < words * 2; i++)
-        pVal[i] = UINT64_MAX;
+        data[i] = UINT64_MAX;
     clearUnusedBits();
 }
 
 void SVInt::setAllZ() {
     if (!unknownFlag) {
-        if (!isSingleWord())
+        if (!isInline())
             delete[] pVal;
 
         unknownFlag = true;
-        pVal = new uint64_t[getNumWords()];
+        allocData();
     }
 
     // everything set to 1 (for Z in the low half and for unknown in the upper half)
+    uint64_t* data = getRawData();
     for (uint32_t i = 0; i < getNumWords(); i++)
-        pVal[i] = UINT64_MAX;
+        data[i] = UINT64_MAX;
     clearUnusedBits();
 }
 
@@ -485,8 +488,8 @@ void SVInt::flattenUnknowns() {
 
     uint32_t words = getNumWords(bitWidth, false);
     for (uint32_t i = 0; i < words; i++) {
-        pVal[i] &= ~pVal[i + words];
-        pVal[i + words] = 0;
+        getRawData()[i] &= ~getRawData()[i + words];
+        getRawData()[i + words] = 0;
     }
 
     checkUnknown();
@@ -529,11 +532,8 @@ SVInt SVInt::shl(bitwidth_t amount) const {
     // handle the small shift case
     SVInt result = allocUninitialized(bitWidth, signFlag, unknownFlag);
     if (amount < BITS_PER_WORD && !unknownFlag) {
-        uint64_t carry = 0;
-        for (uint32_t i = 0; i < getNumWords(); i++) {
-            result.pVal[i] = pVal[i] << amount | carry;
-            carry = pVal[i] >> (BITS_PER_WORD - amount);
-        }
+        SVIntKernels::get().shiftLeftWords(result.getRawData(), getRawData(), getNumWords(),
+                                           amount);
     }
     else {
         // otherwise do a full shift
@@ -542,9 +542,9 @@ SVInt SVInt::shl(bitwidth_t amount) const {
         uint32_t offset = amount / BITS_PER_WORD;
 
         // also handle shifting the unknown bits if necessary
-        shlFar(result.pVal, pVal, wordShift, offset, 0, numWords);
+        shlFar(result.getRawData(), getRawData(), wordShift, offset, 0, numWords);
         if (unknownFlag)
-            shlFar(result.pVal, pVal, wordShift, offset, numWords, numWords);
+            shlFar(result.getRawData(), getRawData(), wordShift, offset, numWords, numWords);
     }
 
     result.clearUnusedBits();
@@ -571,8 +571,10 @@ SVInt SVInt::lshr(bitwidth_t amount) const {
 
     // handle the small shift case
     SVInt result = allocZeroed(bitWidth, signFlag, unknownFlag);
-    if (amount < BITS_PER_WORD && !unknownFlag)
-        lshrNear(result.pVal, pVal, getNumWords(), amount);
+    if (amount < BITS_PER_WORD && !unknownFlag) {
+        SVIntKernels::get().shiftRightWords(result.getRawData(), getRawData(), getNumWords(),
+                                            amount);
+    }
     else {
         // otherwise do a full shift
         uint32_t numWords = getNumWords(bitWidth, false);
@@ -580,9 +582,9 @@ SVInt SVInt::lshr(bitwidth_t amount) const {
         uint32_t offset = amount / BITS_PER_WORD;
 
         // also handle shifting the unknown bits if necessary
-        lshrFar(result.pVal, pVal, wordShift, offset, 0, numWords);
+        lshrFar(result.getRawData(), getRawData(), wordShift, offset, 0, numWords);
         if (unknownFlag)
-            lshrFar(result.pVal, pVal, wordShift, offset, numWords, numWords);
+            lshrFar(result.getRawData(), getRawData(), wordShift, offset, numWords, numWords);
     }
 
     result.checkUnknown();
@@ -736,20 +738,20 @@ void SVInt::writeTo(SmallVectorBase<char>& buffer, LiteralBase base, bool includ
 
             auto all = [&](uint32_t start, uint64_t v) {
                 for (uint32_t i = 0; i < words - 1; i++) {
-                    if (pVal[start + i] != v)
+                    if (getRawData()[start + i] != v)
                         return false;
                 }
 
-                return pVal[start + words - 1] == (mask & v);
+                return getRawData()[start + words - 1] == (mask & v);
             };
 
             auto anyXs = [&]() {
                 for (uint32_t i = 0; i < words - 1; i++) {
-                    if ((~pVal[i] & pVal[i + words]) != 0)
+                    if ((~getRawData()[i] & getRawData()[i + words]) != 0)
                         return true;
                 }
 
-                return (~pVal[words - 1] & mask & pVal[words * 2 - 1]) != 0;
+                return (~getRawData()[words - 1] & mask & getRawData()[words * 2 - 1]) != 0;
             };
 
             bool upperOnes = all(words, UINT64_MAX);
@@ -824,7 +826,7 @@ void SVInt::writeTo(SmallVectorBase<char>& buffer, LiteralBase base, bool includ
             if (!tmp.unknownFlag)
                 buffer.push_back(Digits[digit]);
             else {
-                uint32_t u = uint32_t(tmp.pVal[getNumWords(bitWidth, false)]) & maskAmount;
+                uint32_t u = uint32_t(tmp.getRawData()[getNumWords(bitWidth, false)]) & maskAmount;
                 if (!u)
                     buffer.push_back(Digits[digit]);
                 else if (u == maskAmount && (digit & maskAmount) == 0)
@@ -926,10 +928,10 @@ logic_t SVInt::reductionAnd() const {
     if (unknownFlag) {
         uint32_t words = getNumWords(bitWidth, false);
         for (uint32_t i = 0; i < words - 1; i++) {
-            if ((pVal[i] | pVal[i + words]) != UINT64_MAX)
+            if ((getRawData()[i] | getRawData()[i + words]) != UINT64_MAX)
                 return logic_t(false);
         }
-        if ((pVal[words - 1] | pVal[words * 2 - 1]) != mask)
+        if ((getRawData()[words - 1] | getRawData()[words * 2 - 1]) != mask)
             return logic_t(false);
         return logic_t::x;
     }
@@ -938,10 +940,10 @@ logic_t SVInt::reductionAnd() const {
         return logic_t(val == mask);
     else {
         for (uint32_t i = 0; i < getNumWords() - 1; i++) {
-            if (pVal[i] != UINT64_MAX)
+            if (getRawData()[i] != UINT64_MAX)
                 return logic_t(false);
         }
-        return logic_t(pVal[getNumWords() - 1] == mask);
+        return logic_t(getRawData()[getNumWords() - 1] == mask);
     }
 }
 
@@ -949,7 +951,7 @@ logic_t SVInt::reductionOr() const {
     if (unknownFlag) {
         uint32_t words = getNumWords(bitWidth, false);
         for (uint32_t i = 0; i < words; i++) {
-            if (pVal[i] & ~pVal[i + words])
+            if (getRawData()[i] & ~getRawData()[i + words])
                 return logic_t(true);
         }
         return logic_t::x;
@@ -959,7 +961,7 @@ logic_t SVInt::reductionOr() const {
         return logic_t(val != 0);
     else {
         for (uint32_t i = 0; i < getNumWords(); i++) {
-            if (pVal[i] != 0)
+            if (getRawData()[i] != 0)
                 return logic_t(true);
         }
     }
@@ -994,14 +996,14 @@ SVInt SVInt::operator~() const {
         result.val ^= UINT64_MAX;
     else {
         for (uint32_t i = 0; i < words; i++)
-            result.pVal[i] ^= UINT64_MAX;
+            result.getRawData()[i] ^= UINT64_MAX;
     }
 
     if (unknownFlag) {
         // any unknown bits are still unknown, but we need to make sure
         // any high impedance values become X's
         for (uint32_t i = 0; i < words; i++)
-            result.pVal[i] &= ~result.pVal[i + words];
+            result.getRawData()[i] &= ~result.getRawData()[i + words];
     }
 
     result.clearUnusedBits();
@@ -1014,7 +1016,7 @@ SVInt& SVInt::operator++() {
     else if (unknownFlag)
         setAllX();
     else
-        addOne(pVal, pVal, getNumWords(), 1);
+        addOne(getRawData(), getRawData(), getNumWords(), 1);
     clearUnusedBits();
     return *this;
 }
@@ -1025,7 +1027,7 @@ SVInt& SVInt::operator--() {
     else if (unknownFlag)
         setAllX();
     else
-        subOne(pVal, pVal, getNumWords(), 1);
+        subOne(getRawData(), getRawData(), getNumWords(), 1);
     clearUnusedBits();
     return *this;
 }
@@ -1044,7 +1046,7 @@ SVInt& SVInt::operator+=(const SVInt& rhs) {
         if (isSingleWord())
             val += rhs.val;
         else
-            addGeneral(pVal, pVal, rhs.pVal, getNumWords());
+            addGeneral(getRawData(), getRawData(), rhs.getRawData(), getNumWords());
         clearUnusedBits();
     }
     return *this;
@@ -1065,7 +1067,7 @@ SVInt& SVInt::operator-=(const SVInt& rhs) {
         if (isSingleWord())
             val -= rhs.val;
         else
-            subGeneral(pVal, pVal, rhs.pVal, getNumWords());
+            subGeneral(getRawData(), getRawData(), rhs.getRawData(), getNumWords());
         clearUnusedBits();
     }
     return *this;
@@ -1101,12 +1103,12 @@ SVInt& SVInt::operator*=(const SVInt& rhs) {
             // allocate result space and do the multiply
             uint32_t destWords = lhsWords + rhsWords;
             TempBuffer<uint64_t, 128> dst(destWords);
-            mul(dst.get(), pVal, lhsWords, rhs.pVal, rhsWords);
+            mul(dst.get(), getRawData(), lhsWords, rhs.getRawData(), rhsWords);
 
             // copy the result back into *this
             setAllZeros();
             uint32_t wordsToCopy = destWords >= getNumWords() ? getNumWords() : destWords;
-            memcpy(pVal, dst.get(), wordsToCopy * WORD_SIZE);
+            memcpy(getRawData(), dst.get(), wordsToCopy * WORD_SIZE);
         }
         clearUnusedBits();
     }
@@ -1139,31 +1141,14 @@ SVInt& SVInt::operator&=(const SVInt& rhs) {
         val &= rhs.val;
     else {
         uint32_t words = getNumWords(bitWidth, false);
+        uint64_t* data = getRawData();
+        const uint64_t* rdata = rhs.getRawData();
         if (unknownFlag) {
-            if (rhs.isSingleWord()) {
-                pVal[1] &= rhs.val;
-                pVal[0] = ~pVal[1] & pVal[0] & rhs.val;
-            }
-            else {
-                if (rhs.hasUnknown()) {
-                    for (uint32_t i = 0; i < words; i++) {
-                        pVal[i + words] = (pVal[i + words] | rhs.pVal[i + words]) &
-                                          (pVal[i + words] | pVal[i]) &
-                                          (rhs.pVal[i + words] | rhs.pVal[i]);
-                    }
-                }
-                else {
-                    for (uint32_t i = 0; i < words; i++)
-                        pVal[i + words] &= rhs.pVal[i];
-                }
-
-                for (uint32_t i = 0; i < words; i++)
-                    pVal[i] = ~pVal[i + words] & pVal[i] & rhs.pVal[i];
-            }
+            SVIntKernels::get().and4State(data, data + words, rdata,
+                                          rhs.unknownFlag ? rdata + words : nullptr, words);
         }
         else {
-            for (uint32_t i = 0; i < words; i++)
-                pVal[i] &= rhs.pVal[i];
+            SVIntKernels::get().andWords(data, rdata, words);
         }
     }
     clearUnusedBits();
@@ -1187,30 +1172,14 @@ SVInt& SVInt::operator|=(const SVInt& rhs) {
         val |= rhs.val;
     else {
         uint32_t words = getNumWords(bitWidth, false);
+        uint64_t* data = getRawData();
+        const uint64_t* rdata = rhs.getRawData();
         if (unknownFlag) {
-            if (rhs.isSingleWord()) {
-                pVal[1] &= ~rhs.val;
-                pVal[0] = ~pVal[1] & (pVal[0] | rhs.val);
-            }
-            else {
-                if (rhs.hasUnknown()) {
-                    for (uint32_t i = 0; i < words; i++) {
-                        pVal[i + words] = (pVal[i + words] & (rhs.pVal[i + words] | ~rhs.pVal[i])) |
-                                          (~pVal[i] & rhs.pVal[i + words]);
-                    }
-                }
-                else {
-                    for (uint32_t i = 0; i < words; i++)
-                        pVal[i + words] &= ~rhs.pVal[i];
-                }
-
-                for (uint32_t i = 0; i < words; i++)
-                    pVal[i] = ~pVal[i + words] & (pVal[i] | rhs.pVal[i]);
-            }
+            SVIntKernels::get().or4State(data, data + words, rdata,
+                                         rhs.unknownFlag ? rdata + words : nullptr, words);
         }
         else {
-            for (uint32_t i = 0; i < words; i++)
-                pVal[i] |= rhs.pVal[i];
+            SVIntKernels::get().orWords(data, rdata, words);
         }
     }
     clearUnusedBits();
@@ -1234,22 +1203,14 @@ SVInt& SVInt::operator^=(const SVInt& rhs) {
         val ^= rhs.val;
     else {
         uint32_t words = getNumWords(bitWidth, false);
+        uint64_t* data = getRawData();
+        const uint64_t* rdata = rhs.getRawData();
         if (unknownFlag) {
-            if (rhs.isSingleWord())
-                pVal[0] = ~pVal[1] & (pVal[0] ^ rhs.val);
-            else {
-                if (rhs.hasUnknown()) {
-                    for (uint32_t i = 0; i < words; i++)
-                        pVal[i + words] |= rhs.pVal[i + words];
-                }
-
-                for (uint32_t i = 0; i < words; i++)
-                    pVal[i] = ~pVal[i + words] & (pVal[i] ^ rhs.pVal[i]);
-            }
+            SVIntKernels::get().xor4State(data, data + words, rdata,
+                                          rhs.unknownFlag ? rdata + words : nullptr, words);
         }
         else {
-            for (uint32_t i = 0; i < words; i++)
-                pVal[i] ^= rhs.pVal[i];
+            SVIntKernels::get().xorWords(data, rdata, words);
         }
     }
     clearUnusedBits();
@@ -1273,22 +1234,14 @@ SVInt SVInt::xnor(const SVInt& rhs) const {
         result.val = ~(result.val ^ rhs.val);
     else {
         uint32_t words = getNumWords(bitWidth, false);
+        uint64_t* data = result.getRawData();
+        const uint64_t* rdata = rhs.getRawData();
         if (result.hasUnknown()) {
-            if (rhs.isSingleWord())
-                result.pVal[0] = ~result.pVal[1] & ~(result.pVal[0] ^ rhs.val);
-            else {
-                if (rhs.hasUnknown()) {
-                    for (uint32_t i = 0; i < words; i++)
-                        result.pVal[i + words] |= rhs.pVal[i + words];
-                }
-
-                for (uint32_t i = 0; i < words; i++)
-                    result.pVal[i] = ~result.pVal[i + words] & ~(result.pVal[i] ^ rhs.pVal[i]);
-            }
+            SVIntKernels::get().xnor4State(data, data + words, rdata,
+                                           rhs.unknownFlag ? rdata + words : nullptr, words);
         }
         else {
-            for (uint32_t i = 0; i < words; i++)
-                result.pVal[i] = ~(result.pVal[i] ^ rhs.pVal[i]);
+            SVIntKernels::get().xnorWords(data, rdata, words);
         }
     }
     result.clearUnusedBits();
@@ -1418,15 +1371,13 @@ logic_t SVInt::operator<(const SVInt& rhs) const {
     if (a1 == 0)
         return logic_t(false); // both values are zero
 
-    // same number of words, compare each one until there's no match
-    uint32_t top = whichWord(a1 - 1);
-    for (int i = int(top); i >= 0; i--) {
-        if (pVal[i] > rhs.pVal[i])
-            return logic_t(false);
-        if (pVal[i] < rhs.pVal[i])
-            return logic_t(true);
-    }
-    return logic_t(false);
+    // same number of words, find the highest one that doesn't match
+    const uint64_t* data = getRawData();
+    const uint64_t* rdata = rhs.getRawData();
+    int32_t i = SVIntKernels::get().findLastDifference(data, rdata, whichWord(a1 - 1) + 1);
+    if (i < 0)
+        return logic_t(false);
+    return logic_t(data[i] < rdata[i]);
 }
 
 logic_t SVInt::operator[](const SVInt& index) const {
@@ -1442,11 +1393,12 @@ logic_t SVInt::operator[](int32_t index) const {
     if (index < 0 || bi >= bitWidth)
         return logic_t::x;
 
-    bool bit = (maskBit(bi) & (isSingleWord() ? val : pVal[whichWord(bi)])) != 0;
+    bool bit = (maskBit(bi) & (isSingleWord() ? val : getRawData()[whichWord(bi)])) != 0;
     if (!unknownFlag)
         return logic_t(bit);
 
-    bool unknownBit = (maskBit(bi) & pVal[whichWord(bi) + getNumWords(bitWidth, false)]) != 0;
+    uint64_t unknownWord = getRawData()[whichWord(bi) + getNumWords(bitWidth, false)];
+    bool unknownBit = (maskBit(bi) & unknownWord) != 0;
     if (!unknownBit)
         return logic_t(bit);
 
@@ -1486,8 +1438,8 @@ SVInt SVInt::slice(int32_t msb, int32_t lsb) const {
     if (unknownFlag) {
         // copy over preexisting unknown data
         uint32_t words = getNumWords(selectWidth, false);
-        bitcpy(result.getRawData() + words, frontOOB, pVal + getNumWords() / 2, validSelectWidth,
-               frontOOB ? 0 : uint32_t(lsb));
+        bitcpy(result.getRawData() + words, frontOOB, getRawData() + getNumWords() / 2,
+               validSelectWidth, frontOOB ? 0 : uint32_t(lsb));
     }
 
     // If we had any out of bounds accesses, fill them with x's.
@@ -1514,16 +1466,8 @@ void SVInt::set(int32_t msb, int32_t lsb, const SVInt& value) {
     uint32_t backOOB = bitwidth_t(msb) >= bitWidth ? bitwidth_t(msb - int32_t(bitWidth) + 1) : 0;
     uint32_t validSelectWidth = selectWidth - frontOOB - backOOB;
 
-    if (!hasUnknown() && value.hasUnknown()) {
-        uint64_t* newData = new uint64_t[getNumWords(bitWidth, true)]();
-        memcpy(newData, getRawData(), getNumWords());
-
-        if (!isSingleWord())
-            delete[] pVal;
-
-        unknownFlag = true;
-        pVal = newData;
-    }
+    if (!hasUnknown() && value.hasUnknown())
+        makeUnknown();
 
     bitcpy(getRawData(), (uint32_t)std::max(lsb, 0), value.getRawData(), validSelectWidth,
            frontOOB);
@@ -1537,8 +1481,11 @@ void SVInt::set(int32_t msb, int32_t lsb, const SVInt& value) {
                   validSelectWidth);
     }
 
+    // Sequential writes into a wide value (such as filling in the elements of a
+    // large array) tend to leave any remaining unknown bits right next to the
+    // segment we just assigned, so start looking for them there.
     clearUnusedBits();
-    checkUnknown();
+    checkUnknownNear(whichWord(bitwidth_t(std::max(lsb, 0))));
 }
 
 SVInt SVInt::sext(bitwidth_t bits) const {
@@ -1555,10 +1502,11 @@ SVInt SVInt::sext(bitwidth_t bits) const {
     SVInt result = SVInt::allocUninitialized(bits, signFlag, unknownFlag);
     uint32_t oldWords = SVInt::getNumWords(bitWidth, false);
     uint32_t newWords = SVInt::getNumWords(bits, false);
-    signExtendCopy(result.pVal, getRawData(), bitWidth, oldWords, newWords);
+    signExtendCopy(result.getRawData(), getRawData(), bitWidth, oldWords, newWords);
 
     if (unknownFlag)
-        signExtendCopy(result.pVal + newWords, pVal + oldWords, bitWidth, oldWords, newWords);
+        signExtendCopy(result.getRawData() + newWords, getRawData() + oldWords, bitWidth, oldWords,
+                       newWords);
 
     result.clearUnusedBits();
     return result;
@@ -1581,13 +1529,13 @@ bool SVInt::isSignExtendedFrom(bitwidth_t msb) const {
     auto word = whichWord(msb);
     auto numWords = getNumWords(bitWidth, false);
 
-    if (!isSignExtended(pVal, numWords, word, bit, maskMsw))
+    if (!isSignExtended(getRawData(), numWords, word, bit, maskMsw))
         return false;
 
     if (!unknownFlag)
         return true;
 
-    return isSignExtended(pVal + numWords, numWords, word, bit, maskMsw);
+    return isSignExtended(getRawData() + numWords, numWords, word, bit, maskMsw);
 }
 
 void SVInt::signExtendFrom(bitwidth_t msb) {
@@ -1607,9 +1555,9 @@ void SVInt::signExtendFrom(bitwidth_t msb) {
     auto word = whichWord(msb);
     auto numWords = getNumWords(bitWidth, false);
 
-    signExtend(pVal, numWords, word, bit, maskMsw);
+    signExtend(getRawData(), numWords, word, bit, maskMsw);
     if (unknownFlag)
-        signExtend(pVal + numWords, numWords, word, bit, maskMsw);
+        signExtend(getRawData() + numWords, numWords, word, bit, maskMsw);
 }
 
 SVInt SVInt::zext(bitwidth_t bits) const {
@@ -1622,12 +1570,12 @@ SVInt SVInt::zext(bitwidth_t bits) const {
 
     uint32_t valueWords = SVInt::getNumWords(bitWidth, false);
     for (uint32_t i = 0; i < valueWords; i++)
-        result.pVal[i] = getRawData()[i];
+        result.getRawData()[i] = getRawData()[i];
 
     if (unknownFlag) {
         uint32_t newWords = SVInt::getNumWords(bits, false);
         for (uint32_t i = 0; i < valueWords; i++)
-            result.pVal[i + newWords] = getRawData()[i + valueWords];
+            result.getRawData()[i + newWords] = getRawData()[i + valueWords];
     }
 
     return result;
@@ -1656,7 +1604,7 @@ SVInt SVInt::trunc(bitwidth_t bits) const {
     if (unknownFlag) {
         // copy over preexisting unknown data
         uint32_t words = getNumWords(bits, false);
-        bitcpy(result.getRawData() + words, 0, pVal + getNumWords() / 2, bits, 0);
+        bitcpy(result.getRawData() + words, 0, getRawData() + getNumWords() / 2, bits, 0);
     }
 
     result.clearUnusedBits();
@@ -1703,6 +1651,55 @@ SVInt SVInt::reverse() const {
     return result;
 }
 
+SVInt SVInt::reverseSlices(bitwidth_t sliceWidth, bitwidth_t lsbSliceWidth) const {
+    SLANG_ASSERT(lsbSliceWidth > 0 && lsbSliceWidth <= sliceWidth);
+    if (sliceWidth == 1)
+        return reverse();
+
+    if (lsbSliceWidth >= bitWidth)
+        return *this;
+
+    uint32_t words = getNumWords(bitWidth, false);
+    const uint64_t* src = getRawData();
+
+    if (sliceWidth == 8 && lsbSliceWidth == 8 && bitWidth % 8 == 0 && !isSingleWord()) {
+        // Byte slices can be reversed a whole word at a time, the same way
+        // reverse() handles single bits.
+        auto result = SVInt::allocUninitialized(bitWidth, signFlag, unknownFlag);
+        uint64_t* dst = result.getRawData();
+        for (uint32_t i = 0; i < words; i++)
+            dst[i] = reverseBytes64(src[words - i - 1]);
+
+        if (unknownFlag) {
+            for (uint32_t i = 0; i < words; i++)
+                dst[i + words] = reverseBytes64(src[words * 2 - i - 1]);
+        }
+
+        bitwidth_t msw = bitWidth % BITS_PER_WORD;
+        if (msw != 0)
+            return result.lshr(BITS_PER_WORD - msw);
+
+        return result;
+    }
+
+    // Otherwise copy each slice over to its mirrored position. Every bit of
+    // the result gets written, so there's nothing else to fix up afterward.
+    SVInt result = isSingleWord() ? SVInt(bitWidth, 0, signFlag)
+                                  : SVInt::allocZeroed(bitWidth, signFlag, unknownFlag);
+    uint64_t* dst = result.getRawData();
+
+    bitwidth_t width = lsbSliceWidth;
+    for (bitwidth_t lsb = 0; lsb < bitWidth; lsb += width, width = sliceWidth) {
+        width = std::min(width, bitWidth - lsb);
+        bitwidth_t destOffset = bitWidth - lsb - width;
+        bitcpy(dst, destOffset, src, width, lsb);
+        if (unknownFlag)
+            bitcpy(dst + words, destOffset, src + words, width, lsb);
+    }
+
+    return result;
+}
+
 SVInt SVInt::conditional(const SVInt& condition, const SVInt& lhs, const SVInt& rhs) {
     bool bothSigned = lhs.signFlag && rhs.signFlag;
     if (lhs.bitWidth != rhs.bitWidth) {
@@ -1726,9 +1723,9 @@ SVInt SVInt::conditional(const SVInt& condition, const SVInt& lhs, const SVInt&
         // Unknown if either bit is unknown or bits differ.
         const uint64_t* lp = lhs.getRawData();
         const uint64_t* rp = rhs.getRawData();
-        result.pVal[i + words] = (lhs.unknownFlag ? lp[i + words] : 0) |
+        result.getRawData()[i + words] = (lhs.unknownFlag ? lp[i + words] : 0) |
                                  (rhs.unknownFlag ? rp[i + words] : 0) | (lp[i] ^ rp[i]);
-        result.pVal[i] = ~result.pVal[i + words] & lp[i] & rp[i];
+        result.getRawData()[i] = ~result.getRawData()[i + words] & lp[i] & rp[i];
     }
 
     result.clearUnusedBits();
@@ -1771,8 +1768,8 @@ SVInt SVInt::concat(std::span<SVInt const> operands) {
     for (auto it = operands.rbegin(); it != operands.rend(); it++) {
         bitcpy(result.getRawData(), offset, it->getRawData(), it->bitWidth);
         if (it->unknownFlag) {
-            bitcpy(result.getRawData() + words / 2, offset, it->pVal + it->getNumWords() / 2,
-                   it->bitWidth);
+            bitcpy(result.getRawData() + words / 2, offset,
+                   it->getRawData() + it->getNumWords() / 2, it->bitWidth);
         }
         offset += it->bitWidth;
     }
@@ -1780,45 +1777,82 @@ SVInt SVInt::concat(std::span<SVInt const> operands) {
     return result;
 }
 
+void SVInt::setVectorizedKernels(bool enabled) {
+    SVIntKernels::select(enabled);
+}
+
+std::string_view SVInt::getKernelName() {
+    return SVIntKernels::get().name;
+}
+
 SVInt SVInt::allocUninitialized(bitwidth_t bits, bool signFlag, bool unknownFlag) {
     SLANG_ASSERT(bits && (bits > 64 || unknownFlag));
-    return SVInt(new uint64_t[getNumWords(bits, unknownFlag)], bits, signFlag, unknownFlag);
+    SVInt result(nullptr, bits, signFlag, unknownFlag);
+    result.allocData();
+    return result;
 }
 
 SVInt SVInt::allocZeroed(bitwidth_t bits, bool signFlag, bool unknownFlag) {
     SLANG_ASSERT(bits && (bits > 64 || unknownFlag));
-    return SVInt(new uint64_t[getNumWords(bits, unknownFlag)](), bits, signFlag, unknownFlag);
+    SVInt result(nullptr, bits, signFlag, unknownFlag);
+    memset(result.allocData(), 0, result.getNumWords() * WORD_SIZE);
+    return result;
+}
+
+uint64_t* SVInt::allocData() {
+    if (isInline())
+        return inlineWords;
+
+    pVal = new uint64_t[getNumWords()];
+    return pVal;
+}
+
+void SVInt::changeUnknownStorage(bool unknown) {
+    SLANG_ASSERT(unknownFlag != unknown);
+
+    // Stash inline words before the storage gets reused.
+    uint64_t saved[INLINE_WORDS];
+    const bool wasInline = isInline();
+    uint64_t* oldData = pVal;
+    if (wasInline) {
+        std::ranges::copy(inlineWords, saved);
+        oldData = saved;
+    }
+
+    uint32_t words = getNumWords(bitWidth, false);
+    unknownFlag = unknown;
+
+    uint64_t* newData = allocData();
+    memcpy(newData, oldData, words * WORD_SIZE);
+    if (unknown)
+        memset(newData + words, 0, words * WORD_SIZE);
+
+    if (!wasInline)
+        delete[] oldData;
 }
 
 void SVInt::initSlowCase(logic_t bit) {
-    pVal = new uint64_t[getNumWords()](); // allocation is zero cleared
-    pVal[1] = 1;
-    if (exactlyEqual(bit, logic_t::z))
-        pVal[0] = 1;
+    // A single unknown bit always fits inline.
+    inlineWords[1] = 1;
+    inlineWords[0] = exactlyEqual(bit, logic_t::z) ? 1 : 0;
 }
 
 void SVInt::initSlowCase(uint64_t value) {
     uint32_t words = getNumWords();
-    pVal = new uint64_t[words](); // allocation is zero cleared
-    pVal[0] = value;
+    uint64_t* data = allocData();
+    data[0] = value;
 
     // sign extend if necessary
-    if (signFlag && int64_t(value) < 0) {
-        for (uint32_t i = 1; i < words; i++)
-            pVal[i] = (uint64_t)(-1);
-    }
+    uint64_t fill = signFlag && int64_t(value) < 0 ? (uint64_t)(-1) : 0;
+    for (uint32_t i = 1; i < words; i++)
+        data[i] = fill;
 }
 
 void SVInt::initSlowCase(std::span<const byte> bytes) {
-    if (isSingleWord()) {
-        val = 0;
-        memcpy(&val, bytes.data(), std::min<size_t>(WORD_SIZE, bytes.size()));
-    }
-    else {
-        uint32_t words = getNumWords();
-        pVal = new uint64_t[words](); // allocation is zero cleared
-        memcpy(pVal, bytes.data(), std::min<size_t>(words * WORD_SIZE, bytes.size()));
-    }
+    uint32_t words = getNumWords();
+    uint64_t* data = allocData();
+    memset(data, 0, words * WORD_SIZE);
+    memcpy(data, bytes.data(), std::min<size_t>(words * WORD_SIZE, bytes.size()));
     clearUnusedBits();
 }
 
@@ -1832,12 +1866,13 @@ SVInt& SVInt::assignSlowCase(const SVInt& rhs) {
     if (this == &rhs)
         return *this;
 
-    if (rhs.isSingleWord()) {
-        delete[] pVal;
-        val = rhs.val;
+    if (rhs.isInline()) {
+        if (!isInline())
+            delete[] pVal;
+        copyInline(rhs);
     }
     else {
-        if (isSingleWord()) {
+        if (isInline()) {
             pVal = new uint64_t[rhs.getNumWords()];
         }
         else if (getNumWords() != rhs.getNumWords()) {
@@ -1862,8 +1897,8 @@ logic_t SVInt::equalsSlowCase(const SVInt& rhs) const {
 
     // handle unequal bit widths; spec says that if both values are signed, then do sign
     // extension
-    const uint64_t* lval = pVal;
-    const uint64_t* rval = rhs.pVal;
+    const uint64_t* lval = getRawData();
+    const uint64_t* rval = rhs.getRawData();
 
     if (bitWidth != rhs.bitWidth) {
         if (signFlag && rhs.signFlag) {
@@ -1872,11 +1907,6 @@ logic_t SVInt::equalsSlowCase(const SVInt& rhs) const {
             else
                 return rhs.sext(bitWidth).equalsSlowCase(*this);
         }
-
-        if (isSingleWord())
-            lval = &val;
-        if (rhs.isSingleWord())
-            rval = &rhs.val;
     }
 
     bitwidth_t a1 = getActiveBits();
@@ -1888,13 +1918,7 @@ logic_t SVInt::equalsSlowCase(const SVInt& rhs) const {
         return logic_t(true);
 
     // compare each word
-    uint32_t limit = whichWord(a1 - 1);
-    for (uint32_t i = 0; i <= limit; i++) {
-        if (lval[i] != rval[i])
-            return logic_t(false);
-    }
-
-    return logic_t(true);
+    return logic_t(SVIntKernels::get().equalWords(lval, rval, whichWord(a1 - 1) + 1));
 }
 
 void SVInt::getTopWordMask(bitwidth_t& bitsInMsw, uint64_t& mask) const {
@@ -1914,16 +1938,16 @@ bitwidth_t SVInt::countLeadingZerosSlowCase() const {
     getTopWordMask(bitsInMsw, mask);
 
     uint32_t i = getNumWords();
-    uint64_t part = pVal[i - 1] & mask;
+    uint64_t part = getRawData()[i - 1] & mask;
     if (part)
         return (bitwidth_t)std::countl_zero(part) - (BITS_PER_WORD - bitsInMsw);
 
     bitwidth_t count = bitsInMsw;
     for (--i; i > 0; --i) {
-        if (pVal[i - 1] == 0)
+        if (getRawData()[i - 1] == 0)
             count += BITS_PER_WORD;
         else {
-            count += (bitwidth_t)std::countl_zero(pVal[i - 1]);
+            count += (bitwidth_t)std::countl_zero(getRawData()[i - 1]);
             break;
         }
     }
@@ -1939,13 +1963,13 @@ bitwidth_t SVInt::countLeadingOnesSlowCase() const {
         shift = BITS_PER_WORD - bitsInMsw;
 
     int i = int(getNumWords() - 1);
-    bitwidth_t count = (bitwidth_t)std::countl_one(pVal[i] << shift);
+    bitwidth_t count = (bitwidth_t)std::countl_one(getRawData()[i] << shift);
     if (count == bitsInMsw) {
         for (i--; i >= 0; i--) {
-            if (pVal[i] == UINT64_MAX)
+            if (getRawData()[i] == UINT64_MAX)
                 count += BITS_PER_WORD;
             else {
-                count += (bitwidth_t)std::countl_one(pVal[i]);
+                count += (bitwidth_t)std::countl_one(getRawData()[i]);
                 break;
             }
         }
@@ -1967,13 +1991,13 @@ bitwidth_t SVInt::countLeadingUnknowns() const {
 
     int words = (int)getNumWords(bitWidth, false);
     int i = words - 1;
-    bitwidth_t count = (bitwidth_t)std::countl_one(pVal[i + words] << shift);
+    bitwidth_t count = (bitwidth_t)std::countl_one(getRawData()[i + words] << shift);
     if (count == bitsInMsw) {
         for (i--; i >= 0; i--) {
-            if (pVal[i + words] == UINT64_MAX)
+            if (getRawData()[i + words] == UINT64_MAX)
                 count += BITS_PER_WORD;
             else {
-                count += (bitwidth_t)std::countl_one(pVal[i + words]);
+                count += (bitwidth_t)std::countl_one(getRawData()[i + words]);
                 break;
             }
         }
@@ -1993,12 +2017,13 @@ bitwidth_t SVInt::countLeadingZs() const {
     else
         shift = BITS_PER_WORD - bitsInMsw;
 
+    const uint64_t* data = getRawData();
     int words = (int)getNumWords(bitWidth, false);
     int i = words - 1;
-    bitwidth_t count = (bitwidth_t)std::countl_one((pVal[i + words] & pVal[i]) << shift);
+    bitwidth_t count = (bitwidth_t)std::countl_one((data[i + words] & data[i]) << shift);
     if (count == bitsInMsw) {
         for (i--; i >= 0; i--) {
-            auto elem = pVal[i + words] & pVal[i];
+            auto elem = data[i + words] & data[i];
             if (elem == UINT64_MAX)
                 count += BITS_PER_WORD;
             else {
@@ -2018,12 +2043,12 @@ bitwidth_t SVInt::countOnes() const {
     bitwidth_t count = 0;
     if (!unknownFlag) {
         for (uint32_t i = 0; i < getNumWords(); i++)
-            count += (bitwidth_t)std::popcount(pVal[i]);
+            count += (bitwidth_t)std::popcount(getRawData()[i]);
     }
     else {
         uint32_t words = getNumWords(bitWidth, false);
         for (uint32_t i = 0; i < words; i++)
-            count += (bitwidth_t)std::popcount(pVal[i] & ~pVal[i + words]);
+            count += (bitwidth_t)std::popcount(getRawData()[i] & ~getRawData()[i + words]);
     }
 
     return count;
@@ -2036,12 +2061,12 @@ bitwidth_t SVInt::countZeros() const {
     bitwidth_t count = 0;
     if (!unknownFlag) {
         for (uint32_t i = 0; i < getNumWords(); i++)
-            count += (bitwidth_t)std::popcount(~pVal[i]);
+            count += (bitwidth_t)std::popcount(~getRawData()[i]);
     }
     else {
         uint32_t words = getNumWords(bitWidth, false);
         for (uint32_t i = 0; i < words; i++)
-            count += (bitwidth_t)std::popcount(~pVal[i] & ~pVal[i + words]);
+            count += (bitwidth_t)std::popcount(~getRawData()[i] & ~getRawData()[i + words]);
     }
 
     uint32_t wordBits = bitWidth % BITS_PER_WORD;
@@ -2058,7 +2083,7 @@ bitwidth_t SVInt::countXs() const {
     bitwidth_t count = 0;
     uint32_t words = getNumWords(bitWidth, false);
     for (uint32_t i = 0; i < words; i++)
-        count += (bitwidth_t)std::popcount(~pVal[i] & pVal[i + words]);
+        count += (bitwidth_t)std::popcount(~getRawData()[i] & getRawData()[i + words]);
 
     return count;
 }
@@ -2070,7 +2095,7 @@ bitwidth_t SVInt::countZs() const {
     bitwidth_t count = 0;
     uint32_t words = getNumWords(bitWidth, false);
     for (uint32_t i = 0; i < words; i++)
-        count += (bitwidth_t)std::popcount(pVal[i] & pVal[i + words]);
+        count += (bitwidth_t)std::popcount(getRawData()[i] & getRawData()[i + words]);
 
     return count;
 }
@@ -2085,9 +2110,9 @@ void SVInt::clearUnusedBits() {
     if (isSingleWord())
         val &= mask;
     else {
-        pVal[getNumWords() - 1] &= mask;
+        getRawData()[getNumWords() - 1] &= mask;
         if (unknownFlag)
-            pVal[getNumWords(bitWidth, false) - 1] &= mask;
+            getRawData()[getNumWords(bitWidth, false) - 1] &= mask;
     }
 }
 
@@ -2097,39 +2122,30 @@ void SVInt::checkUnknown() {
     if (!unknownFlag || countLeadingZeros() < bitWidth)
         return;
 
-    unknownFlag = false;
-    uint32_t words = getNumWords();
-    if (words == 1) {
-        uint64_t newVal = pVal[0];
-        delete[] pVal;
-        val = newVal;
-    }
-    else {
-        uint64_t* newMem = new uint64_t[words];
-        memcpy(newMem, pVal, words * WORD_SIZE);
-        delete[] pVal;
-        pVal = newMem;
-    }
+    changeUnknownStorage(false);
 }
 
-void SVInt::makeUnknown() {
-    if (unknownFlag)
+void SVInt::checkUnknownNear(uint32_t word) {
+    if (!unknownFlag)
         return;
 
-    uint32_t words = getNumWords();
-    unknownFlag = true;
-    if (words == 1) {
-        auto value = val;
-        pVal = new uint64_t[2];
-        pVal[0] = value;
-        pVal[1] = 0;
-    }
-    else {
-        uint64_t* newMem = new uint64_t[words * 2]();
-        memcpy(newMem, pVal, words * WORD_SIZE);
-        delete[] pVal;
-        pVal = newMem;
+    uint32_t numWords = getNumWords(bitWidth, false);
+    const uint64_t* unknowns = getRawData() + numWords;
+    uint32_t lo = word + 1;
+    uint32_t hi = word + 1;
+    while (lo > 0 || hi < numWords) {
+        if (lo > 0 && unknowns[--lo])
+            return;
+        if (hi < numWords && unknowns[hi++])
+            return;
     }
+
+    changeUnknownStorage(false);
+}
+
+void SVInt::makeUnknown() {
+    if (!unknownFlag)
+        changeUnknownStorage(true);
 }
 
 SVInt SVInt::createFillX(bitwidth_t bitWidth, bool isSigned) {
@@ -2164,7 +2180,7 @@ void SVInt::buildDivideResult(SVInt* result, uint32_t* value, bitwidth_t bitWidt
     else {
         *result = SVInt(bitWidth, 0, signFlag);
         for (uint32_t i = 0; i < numWords; i++)
-            result->pVal[i] = uint64_t(value[i * 2]) |
+            result->getRawData()[i] = uint64_t(value[i * 2]) |
                               (uint64_t(value[i * 2 + 1]) << (BITS_PER_WORD / 2));
     }
 }
@@ -2250,6 +2266,119 @@ void SVInt::divide(const SVInt& lhs, uint32_t lhsWords, const SVInt& rhs, uint32
     buildDivideResult(remainder, r, rhs.bitWidth, bothSigned, rhsWords);
 }
 
+// Divisions where both the divisor and the quotient have at least this many words
+// are done by multiplying with a reciprocal instead of with Knuth's algorithm.
+static constexpr uint32_t NEWTON_THRESHOLD = 192;
+
+// Reciprocals with at most this many words of precision are computed directly.
+static constexpr uint32_t NEWTON_BASE_WORDS = 32;
+
+SVInt SVInt::newtonReciprocal(const SVInt& divisor, bitwidth_t precision) {
+    // Only the top bits of the divisor matter at this precision, so drop
+    // the rest to keep the multiplies below as small as possible.
+    constexpr bitwidth_t GuardBits = 8;
+    bitwidth_t bits = divisor.getActiveBits();
+    SVInt b = divisor;
+    b.setSigned(false);
+    if (bits > precision + GuardBits) {
+        b = b.lshr(bits - precision - GuardBits);
+        bits = precision + GuardBits;
+    }
+    b = b.resize(bits);
+
+    if (precision <= NEWTON_BASE_WORDS * BITS_PER_WORD) {
+        // Small enough to just do the long division.
+        bitwidth_t width = bits + precision;
+        SVInt dividend = SVInt(width, 1, false).shl(width - 1);
+        SVInt result;
+        divide(dividend, getNumWords(width, false), b, getNumWords(bits, false), &result,
+               nullptr);
+        return result.resize(precision + 2);
+    }
+
+    // Otherwise get a reciprocal with a bit more than half the precision and refine
+    // it with one step of Newton's method, which doubles the number of correct bits:
+    //   y = z + z * (1 - b * z)
+    // All of the terms are scaled by powers of two so that they stay integers.
+    bitwidth_t half = precision / 2 + GuardBits;
+    SVInt z = newtonReciprocal(b, half);
+
+    bitwidth_t width = bits + half + 2;
+    SVInt one = SVInt(width, 1, false).shl(bits - 1 + half);
+    SVInt bz = b.resize(width) * z.resize(width);
+    bool tooLarge = bool(bz > one);
+    SVInt error = tooLarge ? bz - one : one - bz;
+
+    width = half + 2 + std::max(error.getActiveBits(), 1u);
+    SVInt correction = z.resize(width) * error.resize(width);
+    correction = correction.lshr(bits - 1 + 2 * half - precision).resize(precision + 2);
+
+    SVInt result = z.resize(precision + 2).shl(precision - half);
+    if (!tooLarge)
+        result += correction;
+    else if (bool(correction < result))
+        result -= correction;
+    else
+        result.setAllZeros();
+
+    return result;
+}
+
+void SVInt::newtonDivide(const SVInt& lhs, const SVInt& rhs, SVInt* quotient,
+                         SVInt* remainder) {
+    // Estimate the quotient by multiplying with the reciprocal of the divisor.
+    // The estimate is only off by a few units, so correct it afterward.
+    bitwidth_t lhsBits = lhs.getActiveBits();
+    bitwidth_t rhsBits = rhs.getActiveBits();
+    SLANG_ASSERT(lhsBits >= rhsBits);
+
+    bitwidth_t precision = lhsBits - rhsBits + 1;
+    SVInt recip = newtonReciprocal(rhs, precision);
+
+    auto toUnsigned = [](const SVInt& value, bitwidth_t bits) {
+        SVInt result = value.resize(bits);
+        result.setSigned(false);
+        return result;
+    };
+
+    // As with the reciprocal, only the top bits of the dividend affect the estimate.
+    constexpr bitwidth_t GuardBits = 8;
+    bitwidth_t shift = lhsBits > precision + GuardBits ? lhsBits - precision - GuardBits : 0;
+    bitwidth_t width = lhsBits - shift + precision + 2;
+    SVInt q = toUnsigned(lhs.lshr(shift), width) * toUnsigned(recip, width);
+    q = q.lshr(lhsBits - shift);
+
+    // Leave some headroom so that products of an estimate that's too
+    // large can't wrap around.
+    width = lhsBits + GuardBits;
+    q = q.resize(width);
+    SVInt a = toUnsigned(lhs, width);
+    SVInt b = toUnsigned(rhs, width);
+    SVInt one(width, 1, false);
+
+    SVInt product = q * b;
+    while (product > a) {
+        q -= one;
+        product -= b;
+    }
+
+    SVInt r = a - product;
+    while (r >= b) {
+        q += one;
+        r -= b;
+    }
+
+    bool bothSigned = lhs.signFlag && rhs.signFlag;
+    if (quotient) {
+        *quotient = q.resize(lhs.bitWidth);
+        quotient->setSigned(bothSigned);
+    }
+    if (remainder) {
+        *remainder = r.resize(rhs.bitWidth);
+        remainder->setSigned(bothSigned);
+    }
+}
+
 SVInt SVInt::udiv(const SVInt& lhs, const SVInt& rhs, bool bothSigned) {
     // At this point we have two values with the same bit widths, both positive,
     // and X's have been dealt with. Also, we know rhs isn't zero.
@@ -2272,11 +2401,15 @@ SVInt SVInt::udiv(const SVInt& lhs, const SVInt& rhs, bool bothSigned) {
         return SVInt(lhs.bitWidth, 0, bothSigned);
     // X and Y are actually a single word
     if (lhsWords == 1 && rhsWords == 1)
-        return SVInt(lhs.bitWidth, lhs.pVal[0] / rhs.pVal[0], bothSigned);
+        return SVInt(lhs.bitWidth, lhs.getRawData()[0] / rhs.getRawData()[0], bothSigned);
 
-    // compute it the hard way with the Knuth algorithm
+    // compute it the hard way, either with the Knuth algorithm
+    // or by way of a reciprocal for really big values
     SVInt quotient;
-    divide(lhs, lhsWords, rhs, rhsWords, &quotient, nullptr);
+    if (rhsWords >= NEWTON_THRESHOLD && lhsWords - rhsWords >= NEWTON_THRESHOLD)
+        newtonDivide(lhs, rhs, &quotient, nullptr);
+    else
+        divide(lhs, lhsWords, rhs, rhsWords, &quotient, nullptr);
     return quotient;
 }
 
@@ -2302,11 +2435,15 @@ SVInt SVInt::urem(const SVInt& lhs, const SVInt& rhs, bool bothSigned) {
         return lhs;
     // X and Y are actually a single word
     if (lhsWords == 1)
-        return SVInt(lhs.bitWidth, lhs.pVal[0] % rhs.pVal[0], bothSigned);
+        return SVInt(lhs.bitWidth, lhs.getRawData()[0] % rhs.getRawData()[0], bothSigned);
 
-    // compute it the hard way with the Knuth algorithm
+    // compute it the hard way, either with the Knuth algorithm
+    // or by way of a reciprocal for really big values
     SVInt remainder;
-    divide(lhs, lhsWords, rhs, rhsWords, nullptr, &remainder);
+    if (rhsWords >= NEWTON_THRESHOLD && lhsWords - rhsWords >= NEWTON_THRESHOLD)
+        newtonDivide(lhs, rhs, nullptr, &remainder);
+    else
+        divide(lhs, lhsWords, rhs, rhsWords, nullptr, &remainder);
     return remainder;
 }
 
@@ -2388,7 +2525,7 @@ bool exactlyEqual(const SVInt& lhs, const SVInt& rhs) {
     }
 
     // ok, equal widths, and they both have unknown values, do a straight memory compare
-    return memcmp(lhs.pVal, rhs.pVal, lhs.getNumWords() * SVInt::WORD_SIZE) == 0;
+    return memcmp(lhs.getRawData(), rhs.getRawData(), lhs.getNumWords() * SVInt::WORD_SIZE) == 0;
 }
 
 logic_t condWildcardEqual(const SVInt& lhs, const SVInt& rhs) {
@@ -2408,11 +2545,11 @@ logic_t condWildcardEqual(const SVInt& lhs, const SVInt& rhs) {
     uint32_t words = SVInt::getNumWords(rhs.bitWidth, false);
     for (uint32_t i = 0; i < words; ++i) {
         // bitmask to avoid comparing the bits unknown on the rhs
-        uint64_t mask = ~rhs.pVal[i + words];
+        uint64_t mask = ~rhs.getRawData()[i + words];
         if (lhs.unknownFlag && (lhs.getRawData()[i + words] & mask) != 0)
             return logic_t::x;
 
-        if ((lhs.getRawData()[i] & mask) != (rhs.pVal[i] & mask))
+        if ((lhs.getRawData()[i] & mask) != (rhs.getRawData()[i] & mask))
             return logic_t(false);
     }
 
@@ -2438,9 +2575,9 @@ bool caseXWildcardEqual(const SVInt& lhs, const SVInt& rhs) {
         // bitmask to avoid comparing the unknown bits on either side
         uint64_t mask = UINT64_MAX;
         if (lhs.unknownFlag)
-            mask &= ~lhs.pVal[i + words];
+            mask &= ~lhs.getRawData()[i + words];
         if (rhs.unknownFlag)
-            mask &= ~rhs.pVal[i + words];
+            mask &= ~rhs.getRawData()[i + words];
 
         if ((lhs.getRawData()[i] & mask) != (rhs.getRawData()[i] & mask))
             return false;
@@ -2470,14 +2607,14 @@ bool caseZWildcardEqual(const SVInt& lhs, const SVInt& rhs) {
 
         uint64_t lunknown = 0;
         if (lhs.unknownFlag) {
-            lunknown = lhs.pVal[i + words] & ~lhs.pVal[i];
-            mask &= ~(lhs.pVal[i + words] & lhs.pVal[i]);
+            lunknown = lhs.getRawData()[i + words] & ~lhs.getRawData()[i];
+            mask &= ~(lhs.getRawData()[i + words] & lhs.getRawData()[i]);
         }
 
         uint64_t runknown = 0;
         if (rhs.unknownFlag) {
-            runknown = rhs.pVal[i + words] & ~rhs.pVal[i];
-            mask &= ~(rhs.pVal[i + words] & rhs.pVal[i]);
+            runknown = rhs.getRawData()[i + words] & ~rhs.getRawData()[i];
+            mask &= ~(rhs.getRawData()[i + words] & rhs.getRawData()[i]);
         }
 
         if ((lhs.getRawData()[i] & mask) != (rhs.getRawData()[i] & mask) ||
@@ -11,6 +11,8 @@
 #include <cstdint>
 #include <cstring>
 
+#include "SVIntKernels.h"
+
 #include "slang/numeric/SVInt.h"
 
 #if defined(__x86_64__) || defined(_M_X64)
@@ -101,17 +103,7 @@ private:
     alignas(T) char stackBase[StackCount * sizeof(T)];
 };
 
-static void lshrNear(uint64_t* dst, uint64_t* src, uint32_t words, uint32_t amount) {
-    // fast case for logical right shift of a small amount (less than 64 bits)
-    uint64_t carry = 0;
-    for (int i = int(words - 1); i >= 0; i--) {
-        uint64_t temp = src[i];
-        dst[i] = (temp >> amount) | carry;
-        carry = temp << (64 - amount);
-    }
-}
-
-static void lshrFar(uint64_t* dst, uint64_t* src, uint32_t wordShift, uint32_t offset,
+static void lshrFar(uint64_t* dst, const uint64_t* src, uint32_t wordShift, uint32_t offset,
                     uint32_t start, uint32_t numWords) {
     // this function is split out so that if we have an unknown value we can reuse the code
     // optimization: move whole words
@@ -120,19 +112,12 @@ static void lshrFar(uint64_t* dst, uint64_t* src, uint32_t wordShift, uint32_t o
             dst[i] = src[i + offset];
     }
     else {
-        // shift low order words
-        uint32_t breakWord = start + numWords - offset - 1;
-        for (uint32_t i = start; i < breakWord; i++) {
-            dst[i] = (src[i + offset] >> wordShift) |
-                     (src[i + offset + 1] << (SVInt::BITS_PER_WORD - wordShift));
-        }
-
-        // shift the "break" word
-        dst[breakWord] = src[breakWord + offset] >> wordShift;
+        SVIntKernels::get().shiftRightWords(dst + start, src + start + offset, numWords - offset,
+                                            wordShift);
     }
 }
 
-static void shlFar(uint64_t* dst, uint64_t* src, uint32_t wordShift, uint32_t offset,
+static void shlFar(uint64_t* dst, const uint64_t* src, uint32_t wordShift, uint32_t offset,
                    uint32_t start, uint32_t numWords) {
     // optimization: move whole words
     if (wordShift == 0) {
@@ -140,11 +125,8 @@ static void shlFar(uint64_t* dst, uint64_t* src, uint32_t wordShift, uint32_t of
             dst[i] = src[i - offset];
     }
     else {
-        for (uint32_t i = start + numWords - 1; i > start + offset; i--) {
-            dst[i] = src[i - offset] << wordShift |
-                     src[i - offset - 1] >> (SVInt::BITS_PER_WORD - wordShift);
-        }
-        dst[start + offset] = src[start] << wordShift;
+        SVIntKernels::get().shiftLeftWords(dst + start + offset, src + start, numWords - offset,
+                                           wordShift);
     }
 
     for (uint32_t i = start; i < start + offset; i++)
@@ -290,14 +272,29 @@ static uint64_t mulOne(uint64_t* dst, const uint64_t* x, uint32_t len, uint64_t
     return carry;
 }
 
+// Operands with more words than this (on both sides) are multiplied with
+// the Karatsuba algorithm instead of the schoolbook one.
+static constexpr uint32_t KARATSUBA_THRESHOLD = 7;
+
 static void mulKaratsuba(uint64_t* dst, const uint64_t* x, uint32_t xlen, const uint64_t* y,
                          uint32_t ylen);
 
+static void mulUnbalanced(uint64_t* dst, const uint64_t* x, uint32_t xlen, const uint64_t* y,
+                          uint32_t ylen);
+
 // Generalized multiplier
 SLANG_NO_SANITIZE("unsigned-integer-overflow")
 static void mul(uint64_t* dst, const uint64_t* x, uint32_t xlen, const uint64_t* y, uint32_t ylen) {
-    if (xlen > 7 && ylen > 7) {
-        mulKaratsuba(dst, x, xlen, y, ylen);
+    if (xlen > KARATSUBA_THRESHOLD && ylen > KARATSUBA_THRESHOLD) {
+        if (xlen > ylen) {
+            std::swap(x, y);
+            std::swap(xlen, ylen);
+        }
+
+        if (ylen >= 2 * xlen)
+            mulUnbalanced(dst, x, xlen, y, ylen);
+        else
+            mulKaratsuba(dst, x, xlen, y, ylen);
         return;
     }
 
@@ -385,6 +382,22 @@ static void mulKaratsuba(uint64_t* dst, const uint64_t* x, uint32_t xlen, const
     addGeneral(dst + shift, dst + shift, t3.get(), remaining);
 }
 
+// Multiplies a short operand by a much longer one. Karatsuba only pays off when
+// the operands are roughly the same size, so split the longer one into chunks the
+// size of the shorter one and accumulate the partial products.
+static void mulUnbalanced(uint64_t* dst, const uint64_t* x, uint32_t xlen, const uint64_t* y,
+                          uint32_t ylen) {
+    memset(dst, 0, (xlen + ylen) * sizeof(uint64_t));
+
+    TempBuffer<uint64_t, 128> partial(2 * xlen);
+    for (uint32_t offset = 0; offset < ylen; offset += xlen) {
+        // Everything above the previous chunk is still zero, so this can't carry out.
+        uint32_t chunk = std::min(xlen, ylen - offset);
+        mul(partial.get(), x, xlen, y + offset, chunk);
+        addGeneral(dst + offset, dst + offset, partial.get(), xlen + chunk);
+    }
+}
+
 // Implementation of Knuth's Algorithm D (Division of nonnegative integers)
 // from "Art of Computer Programming, Volume 2", section 4.3.1, p. 272.
 // Note that this implementation is based on the APInt implementation from
@@ -792,4 +805,11 @@ static uint64_t reverseBits64(uint64_t x) {
     return (uint64_t(reverseBits32(uint32_t(x))) << 32) | reverseBits32(uint32_t(x >> 32));
 }
 
+// Reverses the byte ordering of the number.
+static uint64_t reverseBytes64(uint64_t x) {
+    x = ((x & 0xff00ff00ff00ff00) >> 8) | ((x & 0x00ff00ff00ff00ff) << 8);
+    x = ((x & 0xffff0000ffff0000) >> 16) | ((x & 0x0000ffff0000ffff) << 16);
+    return (x >> 32) | (x << 32);
+}
+
 } // namespace slang
@@ -0,0 +1,511 @@
+//------------------------------------------------------------------------------
+// SVIntKernels.cpp
+// Bulk word operations used by SVInt for wide values
+//
+// SPDX-FileCopyrightText: Michael Popoloski
+// SPDX-License-Identifier: MIT
+//------------------------------------------------------------------------------
+#include "SVIntKernels.h"
+
+#include <atomic>
+#include <bit>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#    define SLANG_SVINT_AVX2 1
+#    include <immintrin.h>
+#    ifdef _MSC_VER
+#        include <intrin.h>
+#        define SLANG_AVX2_TARGET
+#    else
+#        define SLANG_AVX2_TARGET __attribute__((target("avx2")))
+#    endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#    define SLANG_SVINT_NEON 1
+#    include <arm_neon.h>
+#endif
+
+namespace slang {
+
+// The portable implementations are written as simple loops so that the compiler
+// is free to vectorize them for whatever baseline instruction set it targets.
+// They also handle the leftover words for the vectorized implementations.
+namespace portable {
+
+static void andWords(uint64_t* dst, const uint64_t* src, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++)
+        dst[i] &= src[i];
+}
+
+static void orWords(uint64_t* dst, const uint64_t* src, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++)
+        dst[i] |= src[i];
+}
+
+static void xorWords(uint64_t* dst, const uint64_t* src, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++)
+        dst[i] ^= src[i];
+}
+
+static void xnorWords(uint64_t* dst, const uint64_t* src, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++)
+        dst[i] = ~(dst[i] ^ src[i]);
+}
+
+static void and4State(uint64_t* lv, uint64_t* lu, const uint64_t* rv, const uint64_t* ru,
+                      uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        uint64_t rhsUnknown = ru ? ru[i] : 0;
+        uint64_t unknown = (lu[i] | rhsUnknown) & (lu[i] | lv[i]) & (rhsUnknown | rv[i]);
+        lu[i] = unknown;
+        lv[i] = ~unknown & lv[i] & rv[i];
+    }
+}
+
+static void or4State(uint64_t* lv, uint64_t* lu, const uint64_t* rv, const uint64_t* ru,
+                     uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        uint64_t rhsUnknown = ru ? ru[i] : 0;
+        uint64_t unknown = (lu[i] & (rhsUnknown | ~rv[i])) | (~lv[i] & rhsUnknown);
+        lu[i] = unknown;
+        lv[i] = ~unknown & (lv[i] | rv[i]);
+    }
+}
+
+static void xor4State(uint64_t* lv, uint64_t* lu, const uint64_t* rv, const uint64_t* ru,
+                      uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        uint64_t unknown = lu[i] | (ru ? ru[i] : 0);
+        lu[i] = unknown;
+        lv[i] = ~unknown & (lv[i] ^ rv[i]);
+    }
+}
+
+static void xnor4State(uint64_t* lv, uint64_t* lu, const uint64_t* rv, const uint64_t* ru,
+                       uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        uint64_t unknown = lu[i] | (ru ? ru[i] : 0);
+        lu[i] = unknown;
+        lv[i] = ~unknown & ~(lv[i] ^ rv[i]);
+    }
+}
+
+static void shiftRightWords(uint64_t* dst, const uint64_t* src, uint32_t count,
+                            uint32_t amount) {
+    for (uint32_t i = 0; i + 1 < count; i++)
+        dst[i] = (src[i] >> amount) | (src[i + 1] << (64 - amount));
+    if (count)
+        dst[count - 1] = src[count - 1] >> amount;
+}
+
+static void shiftLeftWords(uint64_t* dst, const uint64_t* src, uint32_t count,
+                           uint32_t amount) {
+    if (!count)
+        return;
+
+    for (uint32_t i = count - 1; i > 0; i--)
+        dst[i] = (src[i] << amount) | (src[i - 1] >> (64 - amount));
+    dst[0] = src[0] << amount;
+}
+
+static bool equalWords(const uint64_t* lhs, const uint64_t* rhs, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        if (lhs[i] != rhs[i])
+            return false;
+    }
+    return true;
+}
+
+static int32_t findLastDifference(const uint64_t* lhs, const uint64_t* rhs, uint32_t count) {
+    for (int32_t i = int32_t(count) - 1; i >= 0; i--) {
+        if (lhs[i] != rhs[i])
+            return i;
+    }
+    return -1;
+}
+
+} // namespace portable
+
+#if SLANG_SVINT_AVX2
+namespace avx2 {
+
+SLANG_AVX2_TARGET static inline __m256i load(const uint64_t* ptr) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+}
+
+SLANG_AVX2_TARGET static inline void store(uint64_t* ptr, __m256i value) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(ptr), value);
+}
+
+SLANG_AVX2_TARGET static inline __m256i loadOrZero(const uint64_t* ptr, uint32_t i) {
+    return ptr ? load(ptr + i) : _mm256_setzero_si256();
+}
+
+SLANG_AVX2_TARGET static void andWords(uint64_t* dst, const uint64_t* src, uint32_t count) {
+    uint32_t i = 0;
+    for (; i + 4 <= count; i += 4)
+        store(dst + i, _mm256_and_si256(load(dst + i), load(src + i)));
+    portable::andWords(dst + i, src + i, count - i);
+}
+
+SLANG_AVX2_TARGET static void orWords(uint64_t* dst, const uint64_t* src, uint32_t count) {
+    uint32_t i = 0;
+    for (; i + 4 <= count; i += 4)
+        store(dst + i, _mm256_or_si256(load(dst + i), load(src + i)));
+    portable::orWords(dst + i, src + i, count - i);
+}
+
+SLANG_AVX2_TARGET static void xorWords(uint64_t* dst, const uint64_t* src, uint32_t count) {
+    uint32_t i = 0;
+    for (; i + 4 <= count; i += 4)
+        store(dst + i, _mm256_xor_si256(load(dst + i), load(src + i)));
+    portable::xorWords(dst + i, src + i, count - i);
+}
+
+SLANG_AVX2_TARGET static void xnorWords(uint64_t* dst, const uint64_t* src, uint32_t count) {
+    const __m256i ones = _mm256_set1_epi64x(-1);
+    uint32_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256i x = _mm256_xor_si256(load(dst + i), load(src + i));
+        store(dst + i, _mm256_xor_si256(x, ones));
+    }
+    portable::xnorWords(dst + i, src + i, count - i);
+}
+
+SLANG_AVX2_TARGET static void and4State(uint64_t* lv, uint64_t* lu, const uint64_t* rv,
+                                        const uint64_t* ru, uint32_t count) {
+    uint32_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256i a = load(lv + i);
+        __m256i au = load(lu + i);
+        __m256i b = load(rv + i);
+        __m256i bu = loadOrZero(ru, i);
+        __m256i unknown = _mm256_and_si256(
+            _mm256_and_si256(_mm256_or_si256(au, bu), _mm256_or_si256(au, a)),
+            _mm256_or_si256(bu, b));
+        store(lu + i, unknown);
+        store(lv + i, _mm256_andnot_si256(unknown, _mm256_and_si256(a, b)));
+    }
+    portable::and4State(lv + i, lu + i, rv + i, ru ? ru + i : nullptr, count - i);
+}
+
+SLANG_AVX2_TARGET static void or4State(uint64_t* lv, uint64_t* lu, const uint64_t* rv,
+                                       const uint64_t* ru, uint32_t count) {
+    const __m256i ones = _mm256_set1_epi64x(-1);
+    uint32_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256i a = load(lv + i);
+        __m256i au = load(lu + i);
+        __m256i b = load(rv + i);
+        __m256i bu = loadOrZero(ru, i);
+        __m256i notB = _mm256_xor_si256(b, ones);
+        __m256i unknown = _mm256_or_si256(_mm256_and_si256(au, _mm256_or_si256(bu, notB)),
+                                          _mm256_andnot_si256(a, bu));
+        store(lu + i, unknown);
+        store(lv + i, _mm256_andnot_si256(unknown, _mm256_or_si256(a, b)));
+    }
+    portable::or4State(lv + i, lu + i, rv + i, ru ? ru + i : nullptr, count - i);
+}
+
+SLANG_AVX2_TARGET static void xor4State(uint64_t* lv, uint64_t* lu, const uint64_t* rv,
+                                        const uint64_t* ru, uint32_t count) {
+    uint32_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256i unknown = _mm256_or_si256(load(lu + i), loadOrZero(ru, i));
+        store(lu + i, unknown);
+        store(lv + i, _mm256_andnot_si256(unknown, _mm256_xor_si256(load(lv + i), load(rv + i))));
+    }
+    portable::xor4State(lv + i, lu + i, rv + i, ru ? ru + i : nullptr, count - i);
+}
+
+SLANG_AVX2_TARGET static void xnor4State(uint64_t* lv, uint64_t* lu, const uint64_t* rv,
+                                         const uint64_t* ru, uint32_t count) {
+    const __m256i ones = _mm256_set1_epi64x(-1);
+    uint32_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256i unknown = _mm256_or_si256(load(lu + i), loadOrZero(ru, i));
+        __m256i x = _mm256_xor_si256(_mm256_xor_si256(load(lv + i), load(rv + i)), ones);
+        store(lu + i, unknown);
+        store(lv + i, _mm256_andnot_si256(unknown, x));
+    }
+    portable::xnor4State(lv + i, lu + i, rv + i, ru ? ru + i : nullptr, count - i);
+}
+
+SLANG_AVX2_TARGET static void shiftRightWords(uint64_t* dst, const uint64_t* src,
+                                              uint32_t count, uint32_t amount) {
+    const __m128i right = _mm_cvtsi32_si128(int(amount));
+    const __m128i left = _mm_cvtsi32_si128(int(64 - amount));
+
+    // Each block reads one word past its end, so stop before the last word.
+    uint32_t i = 0;
+    for (; i + 4 < count; i += 4) {
+        __m256i lo = _mm256_srl_epi64(load(src + i), right);
+        __m256i hi = _mm256_sll_epi64(load(src + i + 1), left);
+        store(dst + i, _mm256_or_si256(lo, hi));
+    }
+    portable::shiftRightWords(dst + i, src + i, count - i, amount);
+}
+
+SLANG_AVX2_TARGET static void shiftLeftWords(uint64_t* dst, const uint64_t* src,
+                                             uint32_t count, uint32_t amount) {
+    if (!count)
+        return;
+
+    const __m128i left = _mm_cvtsi32_si128(int(amount));
+    const __m128i right = _mm_cvtsi32_si128(int(64 - amount));
+
+    // Each block reads one word before its start, so begin at the second word.
+    uint32_t i = 1;
+    for (; i + 4 <= count; i += 4) {
+        __m256i hi = _mm256_sll_epi64(load(src + i), left);
+        __m256i lo = _mm256_srl_epi64(load(src + i - 1), right);
+        store(dst + i, _mm256_or_si256(hi, lo));
+    }
+    for (; i < count; i++)
+        dst[i] = (src[i] << amount) | (src[i - 1] >> (64 - amount));
+    dst[0] = src[0] << amount;
+}
+
+SLANG_AVX2_TARGET static bool equalWords(const uint64_t* lhs, const uint64_t* rhs,
+                                         uint32_t count) {
+    uint32_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256i diff = _mm256_xor_si256(load(lhs + i), load(rhs + i));
+        if (!_mm256_testz_si256(diff, diff))
+            return false;
+    }
+    return portable::equalWords(lhs + i, rhs + i, count - i);
+}
+
+SLANG_AVX2_TARGET static int32_t findLastDifference(const uint64_t* lhs, const uint64_t* rhs,
+                                                    uint32_t count) {
+    uint32_t i = count;
+    while (i >= 4) {
+        i -= 4;
+        __m256i eq = _mm256_cmpeq_epi64(load(lhs + i), load(rhs + i));
+        auto diff = uint32_t(~_mm256_movemask_pd(_mm256_castsi256_pd(eq))) & 0xf;
+        if (diff)
+            return int32_t(i + 31 - uint32_t(std::countl_zero(diff)));
+    }
+    return portable::findLastDifference(lhs, rhs, i);
+}
+
+static bool isSupported() {
+#    ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return false;
+
+    // Check that the OS saves the AVX register state before checking for AVX2.
+    __cpuid(info, 1);
+    const int osxsave = 1 << 27;
+    const int avx = 1 << 28;
+    if ((info[2] & (osxsave | avx)) != (osxsave | avx) || (_xgetbv(0) & 6) != 6)
+        return false;
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#    else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#    endif
+}
+
+} // namespace avx2
+#endif
+
+#if SLANG_SVINT_NEON
+namespace neon {
+
+static inline uint64x2_t bitNot(uint64x2_t value) {
+    return vreinterpretq_u64_u32(vmvnq_u32(vreinterpretq_u32_u64(value)));
+}
+
+static inline uint64x2_t loadOrZero(const uint64_t* ptr, uint32_t i) {
+    return ptr ? vld1q_u64(ptr + i) : vdupq_n_u64(0);
+}
+
+static void andWords(uint64_t* dst, const uint64_t* src, uint32_t count) {
+    uint32_t i = 0;
+    for (; i + 2 <= count; i += 2)
+        vst1q_u64(dst + i, vandq_u64(vld1q_u64(dst + i), vld1q_u64(src + i)));
+    portable::andWords(dst + i, src + i, count - i);
+}
+
+static void orWords(uint64_t* dst, const uint64_t* src, uint32_t count) {
+    uint32_t i = 0;
+    for (; i + 2 <= count; i += 2)
+        vst1q_u64(dst + i, vorrq_u64(vld1q_u64(dst + i), vld1q_u64(src + i)));
+    portable::orWords(dst + i, src + i, count - i);
+}
+
+static void xorWords(uint64_t* dst, const uint64_t* src, uint32_t count) {
+    uint32_t i = 0;
+    for (; i + 2 <= count; i += 2)
+        vst1q_u64(dst + i, veorq_u64(vld1q_u64(dst + i), vld1q_u64(src + i)));
+    portable::xorWords(dst + i, src + i, count - i);
+}
+
+static void xnorWords(uint64_t* dst, const uint64_t* src, uint32_t count) {
+    uint32_t i = 0;
+    for (; i + 2 <= count; i += 2)
+        vst1q_u64(dst + i, bitNot(veorq_u64(vld1q_u64(dst + i), vld1q_u64(src + i))));
+    portable::xnorWords(dst + i, src + i, count - i);
+}
+
+static void and4State(uint64_t* lv, uint64_t* lu, const uint64_t* rv, const uint64_t* ru,
+                      uint32_t count) {
+    uint32_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        uint64x2_t a = vld1q_u64(lv + i);
+        uint64x2_t au = vld1q_u64(lu + i);
+        uint64x2_t b = vld1q_u64(rv + i);
+        uint64x2_t bu = loadOrZero(ru, i);
+        uint64x2_t unknown = vandq_u64(vandq_u64(vorrq_u64(au, bu), vorrq_u64(au, a)),
+                                       vorrq_u64(bu, b));
+        vst1q_u64(lu + i, unknown);
+        vst1q_u64(lv + i, vbicq_u64(vandq_u64(a, b), unknown));
+    }
+    portable::and4State(lv + i, lu + i, rv + i, ru ? ru + i : nullptr, count - i);
+}
+
+static void or4State(uint64_t* lv, uint64_t* lu, const uint64_t* rv, const uint64_t* ru,
+                     uint32_t count) {
+    uint32_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        uint64x2_t a = vld1q_u64(lv + i);
+        uint64x2_t au = vld1q_u64(lu + i);
+        uint64x2_t b = vld1q_u64(rv + i);
+        uint64x2_t bu = loadOrZero(ru, i);
+        uint64x2_t unknown = vorrq_u64(vandq_u64(au, vornq_u64(bu, b)), vbicq_u64(bu, a));
+        vst1q_u64(lu + i, unknown);
+        vst1q_u64(lv + i, vbicq_u64(vorrq_u64(a, b), unknown));
+    }
+    portable::or4State(lv + i, lu + i, rv + i, ru ? ru + i : nullptr, count - i);
+}
+
+static void xor4State(uint64_t* lv, uint64_t* lu, const uint64_t* rv, const uint64_t* ru,
+                      uint32_t count) {
+    uint32_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        uint64x2_t unknown = vorrq_u64(vld1q_u64(lu + i), loadOrZero(ru, i));
+        vst1q_u64(lu + i, unknown);
+        vst1q_u64(lv + i, vbicq_u64(veorq_u64(vld1q_u64(lv + i), vld1q_u64(rv + i)), unknown));
+    }
+    portable::xor4State(lv + i, lu + i, rv + i, ru ? ru + i : nullptr, count - i);
+}
+
+static void xnor4State(uint64_t* lv, uint64_t* lu, const uint64_t* rv, const uint64_t* ru,
+                       uint32_t count) {
+    uint32_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        uint64x2_t unknown = vorrq_u64(vld1q_u64(lu + i), loadOrZero(ru, i));
+        uint64x2_t x = bitNot(veorq_u64(vld1q_u64(lv + i), vld1q_u64(rv + i)));
+        vst1q_u64(lu + i, unknown);
+        vst1q_u64(lv + i, vbicq_u64(x, unknown));
+    }
+    portable::xnor4State(lv + i, lu + i, rv + i, ru ? ru + i : nullptr, count - i);
+}
+
+static void shiftRightWords(uint64_t* dst, const uint64_t* src, uint32_t count,
+                            uint32_t amount) {
+    // A negative shift amount shifts unsigned lanes to the right.
+    const int64x2_t right = vdupq_n_s64(-int64_t(amount));
+    const int64x2_t left = vdupq_n_s64(int64_t(64 - amount));
+
+    uint32_t i = 0;
+    for (; i + 2 < count; i += 2) {
+        uint64x2_t lo = vshlq_u64(vld1q_u64(src + i), right);
+        uint64x2_t hi = vshlq_u64(vld1q_u64(src + i + 1), left);
+        vst1q_u64(dst + i, vorrq_u64(lo, hi));
+    }
+    portable::shiftRightWords(dst + i, src + i, count - i, amount);
+}
+
+static void shiftLeftWords(uint64_t* dst, const uint64_t* src, uint32_t count,
+                           uint32_t amount) {
+    if (!count)
+        return;
+
+    const int64x2_t left = vdupq_n_s64(int64_t(amount));
+    const int64x2_t right = vdupq_n_s64(-int64_t(64 - amount));
+
+    uint32_t i = 1;
+    for (; i + 2 <= count; i += 2) {
+        uint64x2_t hi = vshlq_u64(vld1q_u64(src + i), left);
+        uint64x2_t lo = vshlq_u64(vld1q_u64(src + i - 1), right);
+        vst1q_u64(dst + i, vorrq_u64(hi, lo));
+    }
+    for (; i < count; i++)
+        dst[i] = (src[i] << amount) | (src[i - 1] >> (64 - amount));
+    dst[0] = src[0] << amount;
+}
+
+static bool equalWords(const uint64_t* lhs, const uint64_t* rhs, uint32_t count) {
+    uint32_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        uint64x2_t diff = veorq_u64(vld1q_u64(lhs + i), vld1q_u64(rhs + i));
+        if (vgetq_lane_u64(diff, 0) | vgetq_lane_u64(diff, 1))
+            return false;
+    }
+    return portable::equalWords(lhs + i, rhs + i, count - i);
+}
+
+static int32_t findLastDifference(const uint64_t* lhs, const uint64_t* rhs, uint32_t count) {
+    uint32_t i = count;
+    while (i >= 2) {
+        i -= 2;
+        uint64x2_t diff = veorq_u64(vld1q_u64(lhs + i), vld1q_u64(rhs + i));
+        if (vgetq_lane_u64(diff, 1))
+            return int32_t(i + 1);
+        if (vgetq_lane_u64(diff, 0))
+            return int32_t(i);
+    }
+    return portable::findLastDifference(lhs, rhs, i);
+}
+
+} // namespace neon
+#endif
+
+#define KERNEL_TABLE(ns)                                                                      \
+    SVIntKernels {                                                                            \
+        ns::andWords, ns::orWords, ns::xorWords, ns::xnorWords, ns::and4State, ns::or4State,  \
+            ns::xor4State, ns::xnor4State, ns::shiftRightWords, ns::shiftLeftWords,           \
+            ns::equalWords, ns::findLastDifference, #ns                                       \
+    }
+
+const SVIntKernels& SVIntKernels::portable() {
+    static const SVIntKernels kernels = KERNEL_TABLE(portable);
+    return kernels;
+}
+
+const SVIntKernels& SVIntKernels::best() {
+#if SLANG_SVINT_AVX2
+    static const SVIntKernels kernels = KERNEL_TABLE(avx2);
+    static const bool supported = avx2::isSupported();
+    if (supported)
+        return kernels;
+#elif SLANG_SVINT_NEON
+    // NEON is part of the baseline for 64-bit ARM so there's nothing to check.
+    static const SVIntKernels kernels = KERNEL_TABLE(neon);
+    return kernels;
+#endif
+    return portable();
+}
+
+static std::atomic<const SVIntKernels*>& selectedKernels() {
+    static std::atomic<const SVIntKernels*> selected{&SVIntKernels::best()};
+    return selected;
+}
+
+const SVIntKernels& SVIntKernels::get() {
+    return *selectedKernels().load(std::memory_order_relaxed);
+}
+
+void SVIntKernels::select(bool useBest) {
+    selectedKernels().store(useBest ? &best() : &portable(), std::memory_order_relaxed);
+}
+
+#undef KERNEL_TABLE
+
+} // namespace slang
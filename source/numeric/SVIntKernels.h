@@ -0,0 +1,82 @@
+//------------------------------------------------------------------------------
+// SVIntKernels.h
+// Bulk word operations used by SVInt for wide values
+//
+// SPDX-FileCopyrightText: Michael Popoloski
+// SPDX-License-Identifier: MIT
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace slang {
+
+/// A table of the word-at-a-time loops that dominate the cost of operating on
+/// wide SVInt values. There is a portable implementation that works everywhere,
+/// along with vectorized implementations that get selected at runtime based on
+/// what the host CPU supports.
+///
+/// The 4-state operations take separate value and unknown planes for each operand
+/// and implement the same X / Z propagation rules as the rest of SVInt. A null
+/// @a rhsUnknown pointer means the right hand side has no unknown bits.
+struct SVIntKernels {
+    using BitwiseFunc = void (*)(uint64_t* dst, const uint64_t* src, uint32_t count);
+    using Bitwise4StateFunc = void (*)(uint64_t* lhsValue, uint64_t* lhsUnknown,
+                                       const uint64_t* rhsValue, const uint64_t* rhsUnknown,
+                                       uint32_t count);
+    using ShiftFunc = void (*)(uint64_t* dst, const uint64_t* src, uint32_t count,
+                               uint32_t amount);
+
+    /// dst[i] = dst[i] & src[i]
+    BitwiseFunc andWords;
+
+    /// dst[i] = dst[i] | src[i]
+    BitwiseFunc orWords;
+
+    /// dst[i] = dst[i] ^ src[i]
+    BitwiseFunc xorWords;
+
+    /// dst[i] = ~(dst[i] ^ src[i])
+    BitwiseFunc xnorWords;
+
+    /// 4-state versions of the bitwise operators; the result is written
+    /// back into the left hand side planes.
+    Bitwise4StateFunc and4State;
+    Bitwise4StateFunc or4State;
+    Bitwise4StateFunc xor4State;
+    Bitwise4StateFunc xnor4State;
+
+    /// Shifts @a count words right by @a amount bits, where 0 < amount < 64,
+    /// shifting zeros in at the top: dst[i] = src[i] >> amount | src[i + 1] << (64 - amount)
+    ShiftFunc shiftRightWords;
+
+    /// Shifts @a count words left by @a amount bits, where 0 < amount < 64,
+    /// shifting zeros in at the bottom: dst[i] = src[i] << amount | src[i - 1] >> (64 - amount)
+    ShiftFunc shiftLeftWords;
+
+    /// Returns true if the two ranges of words are identical.
+    bool (*equalWords)(const uint64_t* lhs, const uint64_t* rhs, uint32_t count);
+
+    /// Returns the index of the most significant word that differs between
+    /// the two ranges, or -1 if they are identical.
+    int32_t (*findLastDifference)(const uint64_t* lhs, const uint64_t* rhs, uint32_t count);
+
+    /// A short name for the implementation, for diagnostic purposes.
+    std::string_view name;
+
+    /// Gets the currently selected set of kernels.
+    static const SVIntKernels& get();
+
+    /// Gets the portable implementation of the kernels.
+    static const SVIntKernels& portable();
+
+    /// Gets the best implementation supported by the host CPU.
+    static const SVIntKernels& best();
+
+    /// Selects between the best available implementation (the default) and the
+    /// portable one.
+    static void select(bool useBest);
+};
+
+} // namespace slang
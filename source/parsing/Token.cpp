@@ -37,6 +37,7 @@ struct Token::Info {
     std::string_view& stringText() { return *reinterpret_cast<std::string_view*>(extra()); }
     SyntaxKind& directiveKind() { return *reinterpret_cast<SyntaxKind*>(extra()); }
     KnownSystemName& systemName() { return *reinterpret_cast<KnownSystemName*>(extra()); }
+    IdentifierId& identifierId() { return *reinterpret_cast<IdentifierId*>(extra()); }
 };
 
 static constexpr size_t getExtraSize(TokenKind kind) {
@@ -63,6 +64,9 @@ static constexpr size_t getExtraSize(TokenKind kind) {
         case TokenKind::SystemIdentifier:
             size = sizeof(KnownSystemName);
             break;
+        case TokenKind::Identifier:
+            size = sizeof(IdentifierId);
+            break;
         default:
             return 0;
     }
@@ -251,8 +255,8 @@ Token::Token(BumpAllocator& alloc, TokenKind kind, std::span<Trivia const> trivi
     init(alloc, kind, trivia, rawText, location);
 
     SVIntStorage storage(value.getBitWidth(), value.isSigned(), value.hasUnknown());
-    if (value.isSingleWord())
-        storage.val = *value.getRawPtr();
+    if (storage.isInline())
+        memcpy(storage.inlineWords, value.getRawPtr(), sizeof(uint64_t) * value.getNumWords());
     else {
         storage.pVal = (uint64_t*)alloc.allocate(sizeof(uint64_t) * value.getNumWords(),
                                                  alignof(uint64_t));
@@ -390,6 +394,11 @@ KnownSystemName Token::systemName() const {
     return info->systemName();
 }
 
+IdentifierId Token::identifierId() const {
+    SLANG_ASSERT(kind == TokenKind::Identifier);
+    return info->identifierId();
+}
+
 bool Token::isOnSameLine() const {
     for (auto& t : trivia()) {
         switch (t.kind) {
@@ -433,7 +442,10 @@ Token Token::clone(BumpAllocator& alloc, std::span<Trivia const> trivia, std::st
     Token result(alloc, kind, trivia, rawText, location);
     result.missing = missing;
 
-    memcpy(result.info->extra(), info->extra(), getExtraSize(kind));
+    // Identifiers have already been interned by the constructor based on
+    // the (possibly new) raw text, so there's nothing to copy for them.
+    if (kind != TokenKind::Identifier)
+        memcpy(result.info->extra(), info->extra(), getExtraSize(kind));
     memcpy(&result.numFlags, &numFlags, 1);
 
     return result;
@@ -480,6 +492,14 @@ void Token::init(BumpAllocator& alloc, TokenKind kind_, std::span<Trivia const>
     info->location = location;
     info->rawTextPtr = rawText.data();
 
+    if (kind == TokenKind::Identifier) {
+        // Intern all identifiers as they are created so that later name
+        // lookups can work on integer IDs instead of strings.
+        if (!rawText.empty() && rawText[0] == '\\')
+            rawText = rawText.substr(1);
+        info->identifierId() = IdentifierTable::getDefault().intern(rawText);
+    }
+
     if (!trivia.empty()) {
         const Trivia* triviaPtr = trivia.data();
         byte* dest = info->extra() + extra;
@@ -14,6 +14,7 @@ namespace slang {
 BumpAllocator::BumpAllocator() {
     head = allocSegment(nullptr, INITIAL_SIZE);
     endPtr = (byte*)head + INITIAL_SIZE;
+    bytesReserved = INITIAL_SIZE;
 }
 
 BumpAllocator::~BumpAllocator() {
@@ -26,7 +27,8 @@ BumpAllocator::~BumpAllocator() {
 }
 
 BumpAllocator::BumpAllocator(BumpAllocator&& other) noexcept :
-    head(std::exchange(other.head, nullptr)), endPtr(other.endPtr) {
+    head(std::exchange(other.head, nullptr)), endPtr(other.endPtr),
+    bytesReserved(std::exchange(other.bytesReserved, 0)) {
 }
 
 BumpAllocator& BumpAllocator::operator=(BumpAllocator&& other) noexcept {
@@ -48,6 +50,14 @@ void BumpAllocator::steal(BumpAllocator&& other) {
 
     seg->prev = head->prev;
     head->prev = std::exchange(other.head, nullptr);
+    bytesReserved += std::exchange(other.bytesReserved, 0);
+}
+
+size_t BumpAllocator::getBytesUsed() const {
+    size_t result = 0;
+    for (Segment* seg = head; seg; seg = seg->prev)
+        result += size_t(seg->current - reinterpret_cast<byte*>(seg + 1));
+    return result;
 }
 
 byte* BumpAllocator::allocateSlow(size_t size, size_t alignment) {
@@ -55,12 +65,19 @@ byte* BumpAllocator::allocateSlow(size_t size, size_t alignment) {
     if (size > (SEGMENT_SIZE >> 1)) {
         size = (size + alignment - 1) & ~(alignment - 1);
         head->prev = allocSegment(head->prev, size + sizeof(Segment));
-        return alignPtr(head->prev->current, alignment);
+        bytesReserved += size + sizeof(Segment);
+
+        // Mark the segment as full so that it is accounted for
+        // when walking the list of segments.
+        byte* result = alignPtr(head->prev->current, alignment);
+        head->prev->current = result + size;
+        return result;
     }
 
     // otherwise, start a new block
     head = allocSegment(head, SEGMENT_SIZE);
     endPtr = (byte*)head + SEGMENT_SIZE;
+    bytesReserved += SEGMENT_SIZE;
     return allocate(size, alignment);
 }
 
@@ -0,0 +1,84 @@
+//------------------------------------------------------------------------------
+// IdentifierTable.cpp
+// Thread-safe interning of identifier names
+//
+// SPDX-FileCopyrightText: Michael Popoloski
+// SPDX-License-Identifier: MIT
+//------------------------------------------------------------------------------
+#include "slang/util/IdentifierTable.h"
+
+#include <mutex>
+#include <vector>
+
+#include "slang/util/BumpAllocator.h"
+#include "slang/util/ConcurrentMap.h"
+
+namespace slang {
+
+struct IdentifierTable::Storage {
+    concurrent_map<std::string_view, IdentifierId> idMap;
+
+    // Storage for the interned names; guarded by the mutex.
+    std::mutex mutex;
+    BumpAllocator alloc;
+    std::vector<std::string_view> names;
+};
+
+IdentifierTable::IdentifierTable() {
+    reset();
+}
+
+IdentifierTable::~IdentifierTable() = default;
+
+IdentifierId IdentifierTable::intern(std::string_view name) {
+    // Fast path: the name has already been interned, which is the
+    // overwhelmingly common case after the first few files are lexed.
+    if (auto id = find(name); id != IdentifierId::Unknown)
+        return id;
+
+    std::unique_lock lock(storage->mutex);
+
+    // Another thread may have raced us to insert the name.
+    if (auto id = find(name); id != IdentifierId::Unknown)
+        return id;
+
+    auto& names = storage->names;
+    auto id = IdentifierId(names.size());
+    SLANG_ASSERT(id != IdentifierId::Unknown);
+
+    auto text = storage->alloc.copyFrom(std::span<const char>(name.data(), name.size()));
+    std::string_view stored(text.data(), text.size());
+    names.push_back(stored);
+    storage->idMap.emplace(stored, id);
+    return id;
+}
+
+IdentifierId IdentifierTable::find(std::string_view name) const {
+    IdentifierId result = IdentifierId::Unknown;
+    storage->idMap.cvisit(name, [&](auto& item) { result = item.second; });
+    return result;
+}
+
+std::string_view IdentifierTable::getText(IdentifierId id) const {
+    std::unique_lock lock(storage->mutex);
+    SLANG_ASSERT(size_t(id) < storage->names.size());
+    return storage->names[size_t(id)];
+}
+
+size_t IdentifierTable::size() const {
+    std::unique_lock lock(storage->mutex);
+    return storage->names.size();
+}
+
+void IdentifierTable::reset() {
+    storage = std::make_unique<Storage>();
+    storage->names.push_back(""sv);
+    storage->idMap.emplace(""sv, IdentifierId::Empty);
+}
+
+IdentifierTable& IdentifierTable::getDefault() {
+    static IdentifierTable table;
+    return table;
+}
+
+} // namespace slang
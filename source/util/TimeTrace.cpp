@@ -57,9 +57,16 @@ struct Entry {
     std::string detail;
 };
 
+struct CounterEntry {
+    time_point<steady_clock> time;
+    std::string name;
+    std::vector<std::pair<std::string, uint64_t>> values;
+};
+
 struct TimeTrace::Profiler {
     static thread_local std::vector<Entry> stack;
     std::vector<Entry> entries;
+    std::vector<CounterEntry> counters;
     time_point<steady_clock> startTime;
     std::mutex mut;
 
@@ -89,6 +96,16 @@ struct TimeTrace::Profiler {
         stack.pop_back();
     }
 
+    void counter(std::string_view name,
+                 std::span<const std::pair<std::string_view, uint64_t>> values) {
+        CounterEntry entry{steady_clock::now(), std::string(name), {}};
+        for (auto& [key, value] : values)
+            entry.values.emplace_back(std::string(key), value);
+
+        std::scoped_lock<std::mutex> lock(mut);
+        counters.emplace_back(std::move(entry));
+    }
+
     void write(std::ostream& os) {
         SLANG_ASSERT(stack.empty());
         std::scoped_lock<std::mutex> lock(mut);
@@ -118,6 +135,20 @@ struct TimeTrace::Profiler {
                               escapeString(entry.detail));
         }
 
+        for (auto& entry : counters) {
+            std::string args;
+            for (auto& [key, value] : entry.values) {
+                if (!args.empty())
+                    args += ", ";
+                args += fmt::format("\"{}\":{}", escapeString(key), value);
+            }
+
+            auto timeUs = duration_cast<microseconds>(entry.time - startTime).count();
+            os << fmt::format("{{ \"pid\":1, \"tid\":0, \"ph\":\"C\", \"ts\":{}, "
+                              "\"name\":\"{}\", \"args\":{{ {} }} }},\n",
+                              timeUs, escapeString(entry.name), args);
+        }
+
         // Emit metadata event with process name.
         os << "{ \"cat\":\"\", \"pid\":1, \"tid\":0, \"ts\":0, \"ph\":\"M\", "
               "\"name\":\"process_name\", \"args\":{ \"name\":\"slang\" } }\n";
@@ -152,4 +183,10 @@ void TimeTrace::endTrace() {
         profiler->end();
 }
 
+void TimeTrace::counter(std::string_view name,
+                        std::span<const std::pair<std::string_view, uint64_t>> values) {
+    if (profiler)
+        profiler->counter(name, values);
+}
+
 } // namespace slang
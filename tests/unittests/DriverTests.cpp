@@ -595,6 +595,24 @@ TEST_CASE("Driver suppress macro warnings by path") {
     CHECK(stdoutContains("0 errors, 0 warnings"));
 }
 
+TEST_CASE("Driver parameter sweeps") {
+    auto guard = OS::captureOutput();
+
+    Driver driver;
+    driver.addStandardArgs();
+
+    auto args = fmt::format("testfoo \"{0}test5.sv\" -Wwidth-trunc", findTestDir());
+    CHECK(driver.parseCommandLine(args));
+    CHECK(driver.processOptions());
+    CHECK(driver.parseAllSources());
+
+    std::vector<std::string> sweeps = {"--top k", "--top k -GUNUSED=1", "--top k --bogus"};
+    CHECK(!driver.runSweeps(sweeps, true));
+    CHECK(stdoutContains("Sweep 1: --top k (0 errors, 1 warning)"));
+    CHECK(stdoutContains("Sweep 2: --top k -GUNUSED=1"));
+    CHECK(stderrContains("sweep 3: unknown command line arg"));
+}
+
 static bool contains(std::string_view str, std::string_view value) {
     return str.find(value) != std::string_view::npos;
 }
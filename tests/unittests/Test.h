@@ -13,7 +13,9 @@
 
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_templated.hpp>
+#include <chrono>
 #include <filesystem>
+#include <fmt/format.h>
 #include <initializer_list>
 
 #include "slang/ast/Compilation.h"
@@ -75,6 +77,20 @@ static constexpr std::initializer_list<DiagCode> DefaultIgnoreWarnings = {diag::
         }                                                                      \
     } while (0)
 
+// Reports a formatted result line from one of the hidden [benchmark] tests.
+#define BENCHMARK_REPORT(...) WARN(fmt::format(__VA_ARGS__))
+
+/// Runs @a func @a iterations times and returns the average wall-clock time per call,
+/// measured in units of @a TPeriod (milliseconds by default).
+template<typename TPeriod = std::milli, typename TFunc>
+double benchmarkTime(TFunc&& func, int iterations = 1) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++)
+        func();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, TPeriod>(elapsed).count() / iterations;
+}
+
 std::string findTestDir();
 void setupSourceManager(SourceManager& sourceManager);
 SourceManager& getSourceManager();
@@ -0,0 +1,343 @@
+// SPDX-FileCopyrightText: Michael Popoloski
+// SPDX-License-Identifier: MIT
+
+#include "AnalysisTests.h"
+
+#include "slang/analysis/AnalysisCache.h"
+
+static std::string analyzeCached(const std::vector<std::shared_ptr<SyntaxTree>>& trees,
+                                 AnalysisCache& cache,
+                                 std::unique_ptr<Compilation>& compilation,
+                                 std::unique_ptr<AnalysisManager>& analysisManager) {
+    compilation = std::make_unique<Compilation>();
+    for (auto& tree : trees)
+        compilation->addSyntaxTree(tree);
+
+    auto diags = compilation->getAllDiagnostics();
+    if (!std::ranges::all_of(diags, [](auto& diag) { return !diag.isError(); })) {
+        FAIL_CHECK(report(diags));
+        return {};
+    }
+
+    compilation->freeze();
+
+    analysisManager = std::make_unique<AnalysisManager>();
+    analysisManager->analyze(*compilation, &cache);
+    return report(analysisManager->getDiagnostics(compilation->getSourceManager()));
+}
+
+TEST_CASE("Analysis cache reuses procedures across compilations") {
+    auto modText = R"(
+module m #(parameter int W = 4)(input logic [W-1:0] a, output logic [W-1:0] b, output logic c);
+    logic [W-1:0] q;
+    logic r;
+    always_comb begin
+        if (a[0]) b = a;
+    end
+
+    always_comb q = a;
+    assign q = ~a;
+    always_comb top.w = a[0];
+    always_comb r = top.w;
+    assign c = ^q;
+endmodule
+)";
+
+    auto topText = R"(
+module top;
+    logic [3:0] x, y;
+    logic c, w;
+    m #(4) u1(x, y, c);
+endmodule
+)";
+
+    auto modTree = SyntaxTree::fromText(modText);
+    AnalysisCache cache;
+    std::unique_ptr<Compilation> compilation;
+    std::unique_ptr<AnalysisManager> analysisManager;
+
+    auto expected = analyzeCached({modTree, SyntaxTree::fromText(topText)}, cache, compilation,
+                                  analysisManager);
+    CHECK(expected.find("latch inferred for 'b'") != std::string::npos);
+    CHECK(expected.find("cannot mix continuous and procedural") != std::string::npos);
+    CHECK(cache.size() == 2);
+    CHECK(cache.getStats().reusedProcedures == 0);
+    CHECK(cache.getStats().analyzedProcedures == 6);
+    CHECK(cache.getStats().uncacheableProcedures == 2);
+
+    // Reparse the top module; everything in the child is reused, including the
+    // latch diagnostic, and the conflicting drivers are still detected.
+    auto diags = analyzeCached({modTree, SyntaxTree::fromText(topText)}, cache, compilation,
+                               analysisManager);
+    CHECK(diags == expected);
+    CHECK(cache.size() == 2);
+    CHECK(cache.getStats().reusedProcedures == 4);
+    CHECK(cache.getStats().analyzedProcedures == 2);
+    CHECK(cache.getStats().evictedScopes == 1);
+
+    // Reused drivers must refer to the new compilation's AST.
+    auto& u1 = compilation->getRoot().lookupName<InstanceSymbol>("top.u1");
+    auto& q = u1.body.find<VariableSymbol>("q");
+    auto drivers = analysisManager->getDrivers(q);
+    REQUIRE(drivers.size() == 2);
+    for (auto& [driver, bounds] : drivers) {
+        CHECK(driver->containingSymbol->getParentScope() == &u1.body);
+        CHECK(bounds == DriverBitRange{0, 3});
+    }
+
+    // A different parameterization doesn't match anything in the cache.
+    auto topText2 = R"(
+module top;
+    logic [7:0] x, y;
+    logic c, w;
+    m #(8) u1(x, y, c);
+endmodule
+)";
+
+    diags = analyzeCached({modTree, SyntaxTree::fromText(topText2)}, cache, compilation,
+                          analysisManager);
+    CHECK(cache.getStats().reusedProcedures == 0);
+    CHECK(cache.getStats().analyzedProcedures == 6);
+    CHECK(cache.getStats().evictedScopes == 2);
+
+    // Reparsing the child invalidates its results.
+    diags = analyzeCached({SyntaxTree::fromText(modText), SyntaxTree::fromText(topText2)}, cache,
+                          compilation, analysisManager);
+    CHECK(cache.getStats().reusedProcedures == 0);
+    CHECK(cache.getStats().analyzedProcedures == 6);
+    CHECK(cache.getStats().evictedScopes == 2);
+}
+
+TEST_CASE("Identical instance bodies share procedure results") {
+    // The upward reference prevents the instances from sharing
+    // a canonical body, but the other procedures can still be shared.
+    auto& text = R"(
+module m(input logic [3:0] a, output logic [3:0] b, output logic c);
+    logic r;
+    always_comb begin
+        if (a[0]) b = a;
+    end
+
+    always @(posedge a[1]) begin
+        if ($rose(a[2])) c <= 1;
+    end
+
+    always_comb r = top.w;
+endmodule
+
+module top;
+    logic [3:0] x1, y1, x2, y2, x3, y3;
+    logic c1, c2, c3, w;
+    m u1(x1, y1, c1);
+    m u2(x2, y2, c2);
+    m u3(x3, y3, c3);
+endmodule
+)";
+
+    Compilation compilation;
+    AnalysisManager analysisManager;
+    auto [diags, design] = analyze(text, compilation, analysisManager);
+    CHECK(report(diags).find("latch inferred for 'b'") != std::string::npos);
+
+    // The first instance is analyzed without tracking, the second one is
+    // recorded, and the third one reuses everything it can.
+    auto& stats = analysisManager.getCacheStats();
+    CHECK(stats.reusedProcedures == 2);
+    CHECK(stats.analyzedProcedures == 4);
+    CHECK(stats.uncacheableProcedures == 2);
+
+    auto& root = compilation.getRoot();
+    SmallVector<const AnalyzedScope*> scopes;
+    for (auto name : {"top.u1", "top.u2", "top.u3"}) {
+        auto& inst = root.lookupName<InstanceSymbol>(name);
+        REQUIRE(!inst.getCanonicalBody());
+        auto scope = analysisManager.getAnalyzedScope(inst.body);
+        REQUIRE(scope);
+        REQUIRE(scope->procedures.size() == 3);
+        scopes.push_back(scope);
+
+        auto clock = scope->procedures[1].getInferredClock();
+        REQUIRE(clock);
+        CHECK(clock->as<SignalEventControl>().expr.as<ElementSelectExpression>()
+                  .value().as<NamedValueExpression>().symbol.getParentScope() == &inst.body);
+
+        auto drivers = analysisManager.getDrivers(inst.body.find<ValueSymbol>("b"));
+        REQUIRE(drivers.size() == 1);
+        CHECK(drivers[0].first->containingSymbol->getParentScope() == &inst.body);
+    }
+}
+
+TEST_CASE("Bound checkers share assertion analysis results") {
+    auto& text = R"(
+module chk(input logic clk, req, ack);
+    property p_handshake(a, b);
+        @(posedge clk) a |-> ##[1:3] b;
+    endproperty
+
+    default clocking cb @(posedge clk); endclocking
+
+    assert property (p_handshake(req, ack));
+    assert property (req |=> ack);
+    assert property (@(posedge clk) req ##2 @(negedge clk) ack);
+
+    // This prevents the bound instances from sharing a canonical body.
+    logic r;
+    always_comb r = top.clk;
+endmodule
+
+module dut(input logic clk, req, ack);
+endmodule
+
+module top;
+    logic clk, r1, a1, r2, a2, r3, a3;
+    dut d1(clk, r1, a1);
+    dut d2(clk, r2, a2);
+    dut d3(clk, r3, a3);
+    bind dut chk c(.*);
+endmodule
+)";
+
+    Compilation compilation;
+    AnalysisManager analysisManager;
+    auto [diags, design] = analyze(text, compilation, analysisManager);
+    REQUIRE(diags.size() == 1);
+    CHECK(diags[0].code == diag::InvalidMulticlockedSeqOp);
+
+    auto& stats = analysisManager.getCacheStats();
+    CHECK(stats.reusedProcedures == 3);
+    CHECK(stats.analyzedProcedures == 5);
+    CHECK(stats.uncacheableProcedures == 2);
+
+    auto& root = compilation.getRoot();
+    for (auto name : {"top.d1.c", "top.d2.c", "top.d3.c"}) {
+        auto& inst = root.lookupName<InstanceSymbol>(name);
+        auto scope = analysisManager.getAnalyzedScope(inst.body);
+        REQUIRE(scope);
+        REQUIRE(scope->procedures.size() == 4);
+        for (size_t i = 0; i < 3; i++)
+            CHECK(scope->procedures[i].getAssertions().size() == 1);
+
+        auto& clocking = inst.body.find<ClockingBlockSymbol>("cb");
+        CHECK(scope->procedures[1].getInferredClock() == &clocking.getEvent());
+    }
+}
+
+TEST_CASE("Procedures calling subroutines from timing controls are not cached") {
+    // Drivers from calls in timing controls don't become part of the
+    // procedure's results, so reusing them would lose the second driver of g.
+    auto& text = R"(
+module m(input logic a);
+    logic g, q, r;
+    function automatic logic f(logic x);
+        g = x;
+        return x;
+    endfunction
+
+    always_comb g = a;
+    always @(posedge f(a)) q <= 1;
+    always_comb r = top.w;
+endmodule
+
+module top;
+    logic a1, a2, a3, w;
+    m u1(a1);
+    m u2(a2);
+    m u3(a3);
+endmodule
+)";
+
+    Compilation compilation;
+    AnalysisManager analysisManager;
+    auto [diags, design] = analyze(text, compilation, analysisManager);
+    REQUIRE(diags.size() == 1);
+    CHECK(diags[0].code == diag::MultipleAlwaysAssigns);
+
+    auto& stats = analysisManager.getCacheStats();
+    CHECK(stats.reusedProcedures == 1);
+    CHECK(stats.analyzedProcedures == 5);
+    CHECK(stats.uncacheableProcedures == 4);
+
+    auto numDrivers = [&](std::string_view name) {
+        auto& inst = compilation.getRoot().lookupName<InstanceSymbol>(name);
+        return analysisManager.getDrivers(inst.body.find<ValueSymbol>("g")).size();
+    };
+    CHECK(numDrivers("top.u1") > 1);
+    CHECK(numDrivers("top.u2") == numDrivers("top.u1"));
+    CHECK(numDrivers("top.u3") == numDrivers("top.u1"));
+}
+
+TEST_CASE("Wide parameter values are keyed exactly") {
+    // The masks differ only in their lowest bit, which an abbreviated
+    // printout of the values would lose, letting u3 reuse u2's results.
+    auto& text = R"(
+module m #(parameter logic [199:0] MASK)(input logic a, output logic b);
+    always_comb begin
+        if (MASK[0]) b = a;
+        else if (a) b = 1'b0;
+    end
+
+    logic r;
+    always_comb r = top.w;
+endmodule
+
+module top;
+    logic a, b1, b2, b3, w;
+    m #({4'hf, 196'h1}) u1(a, b1);
+    m #({4'hf, 196'h1}) u2(a, b2);
+    m #({4'hf, 196'h0}) u3(a, b3);
+endmodule
+)";
+
+    Compilation compilation;
+    AnalysisManager analysisManager;
+    auto [diags, design] = analyze(text, compilation, analysisManager);
+    REQUIRE(diags.size() == 1);
+    CHECK(diags[0].code == diag::InferredLatch);
+
+    auto& u3 = compilation.getRoot().lookupName<InstanceSymbol>("top.u3");
+    CHECK(diags[0].symbol == &u3);
+    CHECK(analysisManager.getCacheStats().reusedProcedures == 0);
+}
+
+TEST_CASE("Procedures calling subroutines from assertions are not cached") {
+    auto& text = R"(
+module m(input logic clk, a);
+    logic g, r;
+    function automatic logic f(logic x);
+        g = x;
+        return x;
+    endfunction
+
+    always_comb g = a;
+    assert property (@(posedge clk) disable iff (f(a)) a);
+    assert property (@(posedge clk) a |=> a);
+    always_comb r = top.w;
+endmodule
+
+module top;
+    logic clk, a1, a2, a3, w;
+    m u1(clk, a1);
+    m u2(clk, a2);
+    m u3(clk, a3);
+endmodule
+)";
+
+    Compilation compilation;
+    AnalysisManager analysisManager;
+    auto [diags, design] = analyze(text, compilation, analysisManager);
+    REQUIRE(diags.size() == 1);
+    CHECK(diags[0].code == diag::MultipleAlwaysAssigns);
+
+    auto& stats = analysisManager.getCacheStats();
+    CHECK(stats.reusedProcedures == 2);
+    CHECK(stats.analyzedProcedures == 6);
+    CHECK(stats.uncacheableProcedures == 4);
+
+    auto numDrivers = [&](std::string_view name) {
+        auto& inst = compilation.getRoot().lookupName<InstanceSymbol>(name);
+        return analysisManager.getDrivers(inst.body.find<ValueSymbol>("g")).size();
+    };
+    CHECK(numDrivers("top.u1") > 1);
+    CHECK(numDrivers("top.u2") == numDrivers("top.u1"));
+    CHECK(numDrivers("top.u3") == numDrivers("top.u1"));
+}
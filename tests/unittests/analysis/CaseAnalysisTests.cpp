@@ -24,20 +24,30 @@ static void testDag(const std::vector<std::string>& clauses, uint32_t bitWidth,
             fmt::format("{}'b{}", bitWidth, *expectedCounterexample));
     }
 
-    CaseDecisionDag dag(svClauses, bitWidth, wildcardX, 8192);
-
-    CHECK(dag.gaveUp == expectGaveUp);
-    if (dag.gaveUp)
-        return;
-
-    CHECK(dag.unreachableClauses == expectedUnreachable);
-    CHECK(dag.overlappingClauses == expectedOverlaps);
-
-    // This works around some kind of GCC miscompilation when trying
-    // to use the normal std::optional operator==
-    CHECK(dag.counterexample.has_value() == svCounterexample.has_value());
-    if (svCounterexample)
-        CHECK(*dag.counterexample == *svCounterexample);
+    for (auto engine : {CaseAnalysisEngine::Dag, CaseAnalysisEngine::Cube}) {
+        CaseDecisionDag dag(svClauses, bitWidth, wildcardX, 8192, engine);
+        CHECK(dag.engine == engine);
+
+        // The expected results only describe the DAG giving up; the cube
+        // engine is expected to finish these and is checked separately.
+        if (expectGaveUp && engine == CaseAnalysisEngine::Cube) {
+            CHECK(!dag.gaveUp);
+            continue;
+        }
+
+        CHECK(dag.gaveUp == expectGaveUp);
+        if (dag.gaveUp)
+            continue;
+
+        CHECK(dag.unreachableClauses == expectedUnreachable);
+        CHECK(dag.overlappingClauses == expectedOverlaps);
+
+        // This works around some kind of GCC miscompilation when trying
+        // to use the normal std::optional operator==
+        CHECK(dag.counterexample.has_value() == svCounterexample.has_value());
+        if (svCounterexample)
+            CHECK(*dag.counterexample == *svCounterexample);
+    }
 }
 
 TEST_CASE("Case Dag Exhaustiveness") {
@@ -200,41 +210,53 @@ TEST_CASE("Case Dag Large List 2") {
 }
 
 TEST_CASE("Case Dag Hard Variant") {
-    testDag(
-        {
-            "????0???????1?1?????", "????1???0???0???????", "?0??????0???0???????",
-            "???????????????0?11?", "????10???????1??????", "???1??0???1?????????",
-            "?????????????10???1?", "??0???????????????01", "????????0?0????????0",
-            "?1???0???0??????????", "??1??0??????1???????", "???????01?1?????????",
-            "??????1?0?????????0?", "???????????1????0??0", "???1???????????00???",
-            "????0?0????????????1", "???0?????01?????????", "0???1???1???????????",
-            "0???????????????1?1?", "00???0??????????????", "??????????????1?1?0?",
-            "?????????????01??1??", "??????????????00??1?", "?????1????????00????",
-            "??0?1??????????????0", "?????????0?????1???1", "?????00?????????1???",
-            "?1????1????????0????", "????1???????1????0??", "???????????11???0???",
-            "?????0?????0?0??????", "?0??????0????1??????", "??1??????????0??0???",
-            "0????0???????????1??", "???????0?????1???0??", "??0???1???????????0?",
-            "????0????????????0?0", "???????????1??1????1", "??1?1?????????1?????",
-            "?????0?????????1?0??", "????1??1?????????0??", "???1?1????????0?????",
-            "??11?1??????????????", "????????1?00????????", "????1???1??1????????",
-            "???1???0?????????1??", "1??????0???????1????", "1?1???0?????????????",
-            "???0????0?????1?????", "??0?0????0??????????", "???????????0???0??0?",
-            "??0????????1???0????", "???1?0???????????0??", "??0?1?0?????????????",
-            "0???0?????????1?????", "????????11?????0????", "????1???0???????1???",
-            "?0?1?????1??????????", "????????1?0????1????", "1?????0???????0?????",
-            "??1????0???????????0", "??1?????1???????1???", "?????1??1?0?????????",
-            "???????1???????1??1?", "?10????1????????????", "????0?????????1??1??",
-            "11?????????????1????", "????????0?0??????0??", "????1?1????0????????",
-            "?????????0??0??????1", "1?????????1????????0", "?1??????????0?????1?",
-            "??0???????????1?1???", "?0?1????????1???????", "????1??????1??????0?",
-            "????0?1????0????????", "?1?0??????????????1?", "????0????1???0??????",
-            "0????0?????0????????", "??????????0??????0?1", "???1?????????1?1????",
-            "????1????0?1????????", "??1??0???1??????????", "??0?1?????????0?????",
-            "0??????????10???????", "???????00??????????1", "?????0???0???????1??",
-            "???????????1???1?0??", "?0???????????01?????", "??1??????1????????1?",
-            "????????????1?1????1", "????????????????????", "????????????????????",
-        },
-        20, {}, {}, {}, false, true);
+    std::vector<std::string> clauses = {
+        "????0???????1?1?????", "????1???0???0???????", "?0??????0???0???????",
+        "???????????????0?11?", "????10???????1??????", "???1??0???1?????????",
+        "?????????????10???1?", "??0???????????????01", "????????0?0????????0",
+        "?1???0???0??????????", "??1??0??????1???????", "???????01?1?????????",
+        "??????1?0?????????0?", "???????????1????0??0", "???1???????????00???",
+        "????0?0????????????1", "???0?????01?????????", "0???1???1???????????",
+        "0???????????????1?1?", "00???0??????????????", "??????????????1?1?0?",
+        "?????????????01??1??", "??????????????00??1?", "?????1????????00????",
+        "??0?1??????????????0", "?????????0?????1???1", "?????00?????????1???",
+        "?1????1????????0????", "????1???????1????0??", "???????????11???0???",
+        "?????0?????0?0??????", "?0??????0????1??????", "??1??????????0??0???",
+        "0????0???????????1??", "???????0?????1???0??", "??0???1???????????0?",
+        "????0????????????0?0", "???????????1??1????1", "??1?1?????????1?????",
+        "?????0?????????1?0??", "????1??1?????????0??", "???1?1????????0?????",
+        "??11?1??????????????", "????????1?00????????", "????1???1??1????????",
+        "???1???0?????????1??", "1??????0???????1????", "1?1???0?????????????",
+        "???0????0?????1?????", "??0?0????0??????????", "???????????0???0??0?",
+        "??0????????1???0????", "???1?0???????????0??", "??0?1?0?????????????",
+        "0???0?????????1?????", "????????11?????0????", "????1???0???????1???",
+        "?0?1?????1??????????", "????????1?0????1????", "1?????0???????0?????",
+        "??1????0???????????0", "??1?????1???????1???", "?????1??1?0?????????",
+        "???????1???????1??1?", "?10????1????????????", "????0?????????1??1??",
+        "11?????????????1????", "????????0?0??????0??", "????1?1????0????????",
+        "?????????0??0??????1", "1?????????1????????0", "?1??????????0?????1?",
+        "??0???????????1?1???", "?0?1????????1???????", "????1??????1??????0?",
+        "????0?1????0????????", "?1?0??????????????1?", "????0????1???0??????",
+        "0????0?????0????????", "??????????0??????0?1", "???1?????????1?1????",
+        "????1????0?1????????", "??1??0???1??????????", "??0?1?????????0?????",
+        "0??????????10???????", "???????00??????????1", "?????0???0???????1??",
+        "???????????1???1?0??", "?0???????????01?????", "??1??????1????????1?",
+        "????????????1?1????1", "????????????????????", "????????????????????",
+    };
+    testDag(clauses, 20, {}, {}, {}, false, true);
+
+    // The cube engine finishes well within the step limit the DAG exceeds.
+    std::vector<SVInt> svClauses;
+    for (const auto& clause : clauses)
+        svClauses.emplace_back(SVInt::fromString("20'b" + clause));
+
+    CaseDecisionDag dag(svClauses, 20, false, 8192, CaseAnalysisEngine::Cube);
+    CHECK(!dag.gaveUp);
+    CHECK(dag.getSteps() <= 8192);
+    CHECK(!dag.counterexample);
+    CHECK(dag.unreachableClauses ==
+          flat_hash_set<uint32_t>{51, 62, 72, 73, 74, 78, 79, 80, 81, 83, 86, 88, 89, 90, 92});
+    CHECK(dag.overlappingClauses.size() == 2361);
 }
 
 TEST_CASE("Inferred latches with 4-state case statements") {
@@ -599,6 +621,7 @@ endmodule
 
     AnalysisOptions options;
     options.maxCaseAnalysisSteps = 1024;
+    options.caseAnalysisEngine = CaseAnalysisEngine::Dag;
 
     Compilation compilation;
     AnalysisManager analysisManager(options);
@@ -606,6 +629,44 @@ endmodule
     auto [diags, design] = analyze(code, compilation, analysisManager);
     REQUIRE(diags.size() == 1);
     CHECK(diags[0].code == diag::CaseComplex);
+
+    // The cube engine finishes within the same limit and finds
+    // the missing values and the overlap between items 7 and 9.
+    options.caseAnalysisEngine = CaseAnalysisEngine::Cube;
+
+    Compilation compilation2;
+    AnalysisManager analysisManager2(options);
+
+    auto [diags2, design2] = analyze(code, compilation2, analysisManager2);
+    REQUIRE(diags2.size() == 2);
+    CHECK(diags2[0].code == diag::CaseIncomplete);
+    CHECK(diags2[1].code == diag::CaseOverlap);
+}
+
+TEST_CASE("Case analysis of wide decoders with the cube engine") {
+    // A 64-bit priority decoder with a few hundred items: an odd-value
+    // clause, then one clause per leading one (the last of which is
+    // covered by the first), then redundant copies of all of them.
+    std::vector<SVInt> clauses;
+    clauses.emplace_back(SVInt::fromString("64'b" + std::string(63, '?') + "1"));
+    for (int i = 0; i < 64; i++) {
+        std::string str(64, '?');
+        std::fill(str.begin(), str.begin() + i, '0');
+        str[size_t(i)] = '1';
+        clauses.emplace_back(SVInt::fromString("64'b" + str));
+    }
+    for (int i = 0; i < 256; i++)
+        clauses.push_back(clauses[size_t(i % 65)]);
+
+    CaseDecisionDag dag(clauses, 64, false, 8192, CaseAnalysisEngine::Auto);
+    CHECK(dag.engine == CaseAnalysisEngine::Cube);
+    CHECK(!dag.gaveUp);
+    CHECK(dag.unreachableClauses.size() == 257);
+    CHECK(dag.unreachableClauses.contains(64));
+    CHECK(dag.overlappingClauses.size() == 63);
+    CHECK(dag.overlappingClauses.contains({0, 1}));
+    REQUIRE(dag.counterexample);
+    CHECK(*dag.counterexample == SVInt(64, 0, false));
 }
 
 TEST_CASE("Case DFA with all constants and no matching entries") {
@@ -3,6 +3,8 @@
 
 #include "AnalysisTests.h"
 
+#include "slang/analysis/DataFlowAnalysis.h"
+
 class TestAnalysis : public AbstractFlowAnalysis<TestAnalysis, int> {
 public:
     TestAnalysis(const Symbol& symbol) : AbstractFlowAnalysis(symbol, {}) {}
@@ -669,3 +671,212 @@ endmodule
         CHECK(diags[0].code == diag::AlwaysWithoutTimingControl);
     }
 }
+
+TEST_CASE("Data flow state dense bit tracking") {
+    DataFlowState state;
+    CHECK(!state.allDense(0, 0));
+    CHECK(!state.findDenseRun(0, 1000));
+
+    state.setDense(3, 5);
+    state.setDense(60, 200);
+    CHECK(state.dense.size() == 4);
+    CHECK(state.allDense(3, 5));
+    CHECK(!state.allDense(2, 5));
+    CHECK(state.allDense(60, 200));
+    CHECK(state.allDense(64, 127));
+    CHECK(!state.allDense(60, 201));
+    CHECK(!state.allDense(300, 310));
+
+    CHECK(state.findDenseRun(0, 1000) == std::pair<uint64_t, uint64_t>{3, 5});
+    CHECK(state.findDenseRun(6, 1000) == std::pair<uint64_t, uint64_t>{60, 200});
+    CHECK(state.findDenseRun(100, 150) == std::pair<uint64_t, uint64_t>{100, 150});
+    CHECK(!state.findDenseRun(201, 1000));
+    CHECK(!state.findDenseRun(6, 59));
+
+    state.setDense(201, 255);
+    CHECK(state.findDenseRun(64, 1000) == std::pair<uint64_t, uint64_t>{64, 255});
+}
+
+TEST_CASE("Inferred latch with densely and sparsely tracked symbols") {
+    auto& code = R"(
+module m(input [3:0] sel, input logic [7:0] in);
+    logic [7:0] arr[4];
+    logic [7:0] big[1024];
+    logic [1023:0] wide;
+    logic [2047:0] huge;
+    logic [3:0] a, b, c, d;
+
+    always_comb begin
+        a = '0;
+        for (int i = 0; i < 4; i++)
+            arr[i] = in;
+        wide[1023:512] = '0;
+        huge[2047:1024] = '0;
+        case (sel)
+            0: begin
+                b = 1;
+                big[5] = in;
+                wide[511:0] = '1;
+                huge[1023:0] = '1;
+            end
+            1: begin
+                b = 2;
+                c[1:0] = 1;
+                big[5] = in;
+                wide[511:0] = '0;
+                huge[1023:0] = '0;
+            end
+            default: begin
+                b = 3;
+                c[1:0] = 2;
+                c[3:2] = 3;
+                big[5] = 0;
+                wide[511:0] = 'x;
+                huge[1023:1] = 'x;
+            end
+        endcase
+        d = c;
+    end
+endmodule
+)";
+
+    Compilation compilation;
+    AnalysisManager analysisManager;
+
+    auto [diags, design] = analyze(code, compilation, analysisManager);
+    std::string result = "\n" + report(diags);
+    CHECK(result == R"(
+source:20:17: warning: latch inferred for 'huge[1023:0]' because it is not assigned on all control paths [-Winferred-latch]
+                huge[1023:0] = '1;
+                ^~~~~~~~~~~~
+source:24:17: warning: latch inferred for 'c[1:0]' because it is not assigned on all control paths [-Winferred-latch]
+                c[1:0] = 1;
+                ^~~~~~
+source:32:17: warning: latch inferred for 'c[3:2]' because it is not assigned on all control paths [-Winferred-latch]
+                c[3:2] = 3;
+                ^~~~~~
+)");
+}
+
+TEST_CASE("Widened for loops in data flow analysis") {
+    auto& code = R"(
+module m(input logic c, input logic [7:0] in);
+    logic [7:0] mem[4096];
+    logic [7:0] lo[2048];
+    logic [7:0] cond[1000];
+    logic [1023:0] vec;
+    logic [7:0] down[1000];
+
+    always_comb begin
+        for (int i = 0; i < 4096; i++)
+            mem[i] = in;
+
+        for (int unsigned i = 0; i < 1024; i++)
+            lo[i] = in;
+        for (int i = 2047; i >= 1024; --i)
+            lo[i] = in;
+
+        for (int i = 0; i < 1000; i++) begin
+            if (c)
+                cond[i] = in;
+        end
+
+        for (int i = 0; i <= 1023; i += 1)
+            vec[i] = in[0];
+
+        for (int i = 1; i <= 1000; i = i + 1)
+            down[1000 - i] = mem[i - 1];
+    end
+endmodule
+)";
+
+    for (auto mode : {LoopAnalysisMode::Auto, LoopAnalysisMode::Widen}) {
+        AnalysisOptions options;
+        options.loopAnalysisMode = mode;
+
+        Compilation compilation;
+        AnalysisManager analysisManager(options);
+
+        auto [diags, design] = analyze(code, compilation, analysisManager);
+        REQUIRE(diags.size() == 1);
+        CHECK(diags[0].code == diag::InferredLatch);
+    }
+}
+
+TEST_CASE("Analysis profile records scopes, procedures, case statements, and loops") {
+    auto& code = R"(
+module m(input logic [7:0] a, output logic [7:0] b, output logic c);
+    always_comb begin
+        b = 0;
+        for (int i = 0; i < 8; i++) begin
+            for (int j = 0; j < 4; j++)
+                b[i] ^= a[j];
+        end
+    end
+
+    always_comb begin
+        casez (a)
+            8'b1???????: c = 1;
+            8'b01??????: c = 0;
+            default: c = 0;
+        endcase
+    end
+
+    function automatic int f(int x);
+        return x + 1;
+    endfunction
+endmodule
+
+module top;
+    logic [7:0] a, b;
+    logic c;
+    m u(a, b, c);
+endmodule
+)";
+
+    AnalysisOptions options;
+    options.flags |= AnalysisFlags::Profile;
+    options.numThreads = 4;
+    options.scopeSplitCost = 1;
+
+    Compilation compilation;
+    AnalysisManager analysisManager(options);
+
+    auto [diags, design] = analyze(code, compilation, analysisManager);
+    CHECK_DIAGS_EMPTY;
+
+    auto& body = compilation.getRoot().lookupName<InstanceSymbol>("top.u").body;
+    auto profile = analysisManager.getProfile();
+
+    // The instance body is split into batches, but they're merged back into a single entry.
+    auto scopeIt = std::ranges::find(profile.scopes, &body,
+                                     [](auto& entry) { return entry.symbol; });
+    REQUIRE(scopeIt != profile.scopes.end());
+    CHECK(scopeIt->count > 1);
+    CHECK(std::ranges::is_sorted(profile.scopes, std::ranges::greater(),
+                                 [](auto& entry) { return entry.time; }));
+
+    REQUIRE(profile.procedures.size() == 3);
+    for (auto& entry : profile.procedures) {
+        CHECK(entry.symbol->getParentScope() == &body);
+        CHECK(entry.count == 1);
+    }
+
+    REQUIRE(profile.caseStatements.size() == 1);
+    auto& caseEntry = profile.caseStatements[0];
+    CHECK(caseEntry.statement->kind == StatementKind::Case);
+    CHECK(caseEntry.steps > 0);
+    CHECK(caseEntry.engine == CaseAnalysisEngine::Dag);
+
+    // The inner loop is unrolled once per iteration of the outer loop,
+    // and the outer loop's steps include the inner loop's.
+    REQUIRE(profile.loops.size() == 2);
+    auto outer = profile.loops[0].count == 1 ? &profile.loops[0] : &profile.loops[1];
+    auto inner = outer == &profile.loops[0] ? &profile.loops[1] : &profile.loops[0];
+    CHECK(outer->count == 1);
+    CHECK(inner->count == 8);
+    CHECK(inner->steps == 32);
+    CHECK(outer->steps == 40);
+    CHECK(outer->symbol == &*body.membersOfType<ProceduralBlockSymbol>().begin());
+    CHECK(AnalysisManager::describeProcedure(*outer->symbol) == "always_comb in top.u");
+}
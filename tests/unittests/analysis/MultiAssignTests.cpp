@@ -703,6 +703,7 @@ endmodule
     AnalysisManager analysisManager;
 
     auto [diags, design] = analyze(code, compilation, analysisManager);
+    INFO(report(diags));
     REQUIRE(diags.size() == 2);
     CHECK(diags[0].code == diag::MultipleAlwaysAssigns);
     CHECK(diags[1].code == diag::MultipleAlwaysAssigns);
@@ -1168,3 +1169,268 @@ endmodule
     auto [diags, design] = analyze(code, compilation, analysisManager);
     CHECK_DIAGS_EMPTY;
 }
+
+TEST_CASE("Driver checking with a scope split across analysis workers") {
+    auto& code = R"(
+module m;
+    int a[16];
+    for (genvar i = 0; i < 16; i++) begin
+        always_comb a[i] = i;
+    end
+    always_comb a[3] = 1;
+
+    logic [7:0] b;
+    always_comb begin
+        b = 0;
+        for (int i = 0; i < 8; i++)
+            b[i] = a[i][0];
+    end
+endmodule
+)";
+
+    AnalysisOptions options;
+    options.numThreads = 4;
+    options.scopeSplitCost = 1;
+
+    Compilation compilation;
+    AnalysisManager analysisManager(options);
+
+    auto [diags, design] = analyze(code, compilation, analysisManager);
+    REQUIRE(diags.size() == 1);
+    CHECK(diags[0].code == diag::MultipleAlwaysAssigns);
+
+    // The procedures are still listed in declaration order.
+    std::vector<const Symbol*> expected;
+    REQUIRE(design.topInstances.size() == 1);
+    design.topInstances[0].symbol->visit(
+        makeVisitor([&](auto&, const ProceduralBlockSymbol& block) { expected.push_back(&block); }));
+
+    auto scope = design.topInstances[0].tryGet();
+    REQUIRE(scope);
+    REQUIRE(scope->procedures.size() == 18);
+    REQUIRE(expected.size() == 18);
+    for (size_t i = 0; i < expected.size(); i++)
+        CHECK(scope->procedures[i].analyzedSymbol == expected[i]);
+
+    // Besides the compilation unit and the module itself there
+    // should be several batches of procedures.
+    auto stats = analysisManager.getWorkerStats();
+    REQUIRE(stats.size() == 4);
+
+    uint64_t tasks = 0;
+    for (auto& s : stats)
+        tasks += s.tasks;
+    CHECK(tasks > 3);
+}
+
+TEST_CASE("Multiple driver diagnostics don't depend on thread count") {
+    auto& code = R"(
+interface I;
+    logic [3:0] v;
+    modport m(output v);
+endinterface
+
+module n(I.m i, output logic [3:0] o);
+    assign i.v[0] = 1;
+    always_comb i.v[1] = 0;
+    assign o = 1;
+endmodule
+
+module m;
+    I i1(), i2();
+    logic [3:0] o1, o2;
+    n n1(i1, o1);
+    n n2(i2, o2);
+    assign o1[2] = 0;
+    always_comb i2.v[0] = 1;
+
+    int a[16];
+    for (genvar g = 0; g < 16; g++) begin
+        always_comb a[g] = g;
+        always_ff @(posedge o1[3]) a[(g + 1) % 16] <= 0;
+    end
+endmodule
+)";
+
+    auto run = [&](uint32_t numThreads) {
+        AnalysisOptions options;
+        options.numThreads = numThreads;
+        options.scopeSplitCost = 1;
+
+        Compilation compilation;
+        AnalysisManager analysisManager(options);
+
+        auto [diags, design] = analyze(code, compilation, analysisManager);
+        return report(diags);
+    };
+
+    auto expected = run(1);
+    CHECK(!expected.empty());
+    for (uint32_t threads : {2, 8})
+        CHECK(run(threads) == expected);
+}
+
+TEST_CASE("Driver tracking scaling benchmark", "[.][benchmark]") {
+    std::string code = R"(
+module leaf #(parameter int P) (input logic clk, input logic [63:0] d, output logic [63:0] q);
+    logic [63:0] r[32];
+    for (genvar g = 0; g < 32; g++) begin
+        always_ff @(posedge clk) r[g] <= d ^ 64'(g + P);
+        assign q[g] = ^r[g];
+    end
+    always_comb q[63:32] = d[31:0];
+endmodule
+
+module top(input logic clk, input logic [63:0] d);
+)";
+    for (int i = 0; i < 512; i++)
+        code += fmt::format("    logic [63:0] q{0};\n    leaf #({0}) l{0}(clk, d, q{0});\n", i);
+    code += "endmodule\n";
+
+    for (uint32_t threads : {1, 2, 4, 8, 16, 32, 64}) {
+        AnalysisOptions options;
+        options.numThreads = threads;
+
+        Compilation compilation;
+        AnalysisManager analysisManager(options);
+
+        auto tree = SyntaxTree::fromText(code);
+        compilation.addSyntaxTree(tree);
+        compilation.getAllDiagnostics();
+        compilation.freeze();
+
+        auto ms = benchmarkTime([&] { analysisManager.analyze(compilation); });
+
+        CHECK(analysisManager.getDiagnostics(compilation.getSourceManager()).empty());
+        BENCHMARK_REPORT("{} threads: {:.1f}ms", threads, ms);
+    }
+}
+
+TEST_CASE("Drivers of widened for loops") {
+    auto& code = R"(
+module m;
+    int foo[4096];
+    always_comb begin
+        for (int i = 0; i < 2048; i++)
+            foo[i] = i;
+    end
+    always_comb foo[3000] = 1;
+
+    int bar[4096];
+    always_comb begin
+        for (int i = 1000; i < 2000; i++)
+            bar[i + 1] = i;
+    end
+    always_comb bar[1] = 1;
+    always_comb bar[2000] = 1; // error
+endmodule
+)";
+
+    AnalysisOptions options;
+    options.loopAnalysisMode = LoopAnalysisMode::Widen;
+
+    Compilation compilation;
+    AnalysisManager analysisManager(options);
+
+    auto [diags, design] = analyze(code, compilation, analysisManager);
+    REQUIRE(diags.size() == 1);
+    CHECK(diags[0].code == diag::MultipleAlwaysAssigns);
+
+    // Widening is turned off along with unrolling when the step limit is zero.
+    options.maxLoopAnalysisSteps = 0;
+
+    Compilation compilation2;
+    AnalysisManager analysisManager2(options);
+
+    auto [diags2, design2] = analyze(code, compilation2, analysisManager2);
+    CHECK(diags2.size() == 3);
+}
+
+TEST_CASE("Drivers of for loops too long to unroll") {
+    auto& code = R"(
+module m;
+    int foo[131072];
+    always_comb begin
+        for (int i = 0; i < 100000; i++)
+            foo[i] = i;
+    end
+    always_comb foo[100000] = 1;
+
+    // Selects past the end of the array cover the whole array.
+    int bar[16];
+    always_comb begin
+        for (longint i = 0; i < 64'h7fffffff_ffffffff; i++)
+            bar[i] = 1;
+    end
+    always_comb bar[3] = 1; // error
+endmodule
+)";
+
+    // Unrolling gives up on the first loop and falls back to treating
+    // all of foo as driven, while widening keeps the driven range precise.
+    for (auto mode : {LoopAnalysisMode::Unroll, LoopAnalysisMode::Auto}) {
+        AnalysisOptions options;
+        options.loopAnalysisMode = mode;
+
+        Compilation compilation;
+        AnalysisManager analysisManager(options);
+
+        auto [diags, design] = analyze(code, compilation, analysisManager);
+        CHECK(diags.size() == (mode == LoopAnalysisMode::Unroll ? 2 : 1));
+        for (auto& d : diags)
+            CHECK(d.code == diag::MultipleAlwaysAssigns);
+    }
+}
+
+TEST_CASE("Auto loop analysis unrolls loops that fit within the step limit") {
+    auto& code = R"(
+module m;
+    logic [1023:0] y, z;
+    always_comb begin
+        for (int i = 0; i < 1024; i += 2)
+            y[i] = 1'b1;
+    end
+    always_comb begin
+        for (int i = 1; i < 1024; i += 2)
+            y[i] = 1'b0;
+    end
+
+    always_comb begin
+        for (int i = 0; i < 1024; i++)
+            if (i % 2 == 0) z[i] = 1'b1;
+    end
+    always_comb begin
+        for (int i = 0; i < 1024; i++)
+            if (i % 2 == 1) z[i] = 1'b0;
+    end
+endmodule
+)";
+
+    for (auto mode : {LoopAnalysisMode::Auto, LoopAnalysisMode::Unroll}) {
+        AnalysisOptions options;
+        options.loopAnalysisMode = mode;
+
+        Compilation compilation;
+        AnalysisManager analysisManager(options);
+
+        auto [diags, design] = analyze(code, compilation, analysisManager);
+        CHECK(diags.empty());
+    }
+
+    // Widening can't tell the even and odd elements apart, and selects in the
+    // diagnostics are printed as written since the loop variable has no value.
+    AnalysisOptions options;
+    options.loopAnalysisMode = LoopAnalysisMode::Widen;
+
+    Compilation compilation;
+    AnalysisManager analysisManager(options);
+
+    auto [diags, design] = analyze(code, compilation, analysisManager);
+    CHECK(diags.size() == 4);
+    CHECK(std::ranges::count(diags, diag::MultipleAlwaysAssigns, &Diagnostic::code) == 2);
+
+    auto result = report(diags);
+    CHECK(result.find("variable 'z[i]' driven by always_comb") != std::string::npos);
+    CHECK(result.find("latch inferred for 'z[i]'") != std::string::npos);
+    CHECK(result.find("<unset>") == std::string::npos);
+}
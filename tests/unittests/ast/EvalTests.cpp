@@ -9,6 +9,7 @@ using Catch::Approx;
 #include "slang/ast/ScriptSession.h"
 #include "slang/ast/symbols/CompilationUnitSymbols.h"
 #include "slang/ast/symbols/ParameterSymbols.h"
+#include "slang/ast/symbols/SubroutineSymbols.h"
 
 TEST_CASE("Simple eval") {
     ScriptSession session;
@@ -2203,6 +2204,81 @@ endfunction
     NO_SESSION_ERRORS;
 }
 
+TEST_CASE("Wide streaming operator evaluation") {
+    ScriptSession session;
+    session.eval(R"(
+typedef logic [299:0] vec_t;
+
+function automatic vec_t pattern();
+    for (int i = 0; i < $bits(vec_t); i++)
+        pattern[i] = ((i * 7) % 5) < 2;
+    pattern[17] = 1'bx;
+    pattern[130] = 1'bz;
+    pattern[299] = 1'bx;
+endfunction
+
+// Reorders the low bits of v one bit at a time, for comparison.
+function automatic vec_t reference(vec_t v, int size, int width);
+    int pos = width;
+    reference = '0;
+    for (int lsb = 0; lsb < width; lsb += size) begin
+        for (int i = lsb + size - 1; i >= lsb; i--) begin
+            if (i < width) begin
+                pos--;
+                reference[pos] = v[i];
+            end
+        end
+    end
+endfunction
+
+function automatic int mismatches();
+    vec_t v = pattern();
+    vec_t w, expected;
+    logic [255:0] x;
+    logic [39:0] y;
+    logic [9:0] a;
+    logic [12:0] b;
+    logic [3:0] c;
+    logic [26:0] abc;
+    byte q[$] = '{8'h12, 8'h34, 8'h56, 8'h78, 8'h9a};
+
+    mismatches = 0;
+    w = {<<{v}};   if (w !== reference(v, 1, 300)) mismatches |= 1 << 0;
+    w = {<<3{v}};  if (w !== reference(v, 3, 300)) mismatches |= 1 << 1;
+    w = {<<8{v}};  if (w !== reference(v, 8, 300)) mismatches |= 1 << 2;
+    w = {<<13{v}}; if (w !== reference(v, 13, 300)) mismatches |= 1 << 3;
+    w = {<<24{v}}; if (w !== reference(v, 24, 300)) mismatches |= 1 << 4;
+    w = {<<64{v}}; if (w !== reference(v, 64, 300)) mismatches |= 1 << 5;
+    w = {<<65{v}}; if (w !== reference(v, 65, 300)) mismatches |= 1 << 6;
+
+    x = {<<8{v[255:0]}};
+    expected = reference(v, 8, 256);
+    if (x !== expected[255:0]) mismatches |= 1 << 7;
+
+    x = {<<16{v[255:0]}};
+    expected = reference(v, 16, 256);
+    if (x !== expected[255:0]) mismatches |= 1 << 8;
+
+    y = {<<3{q}};
+    expected = reference(40'h123456789a, 3, 40);
+    if (y !== expected[39:0]) mismatches |= 1 << 9;
+
+    // Unpacking is the inverse of packing, including when the first
+    // block is shorter than the slice size.
+    {<<5{a, b, c}} = v;
+    abc = {<<5{a, b, c}};
+    if (abc !== v[299:273]) mismatches |= 1 << 10;
+
+    {<<8{a, b, c}} = v[26:0];
+    abc = {<<8{a, b, c}};
+    if (abc !== v[26:0]) mismatches |= 1 << 11;
+endfunction
+)");
+
+    CHECK(session.eval("mismatches()").integer() == 0);
+    NO_SESSION_ERRORS;
+}
+
 TEST_CASE("Array reduction methods") {
     ScriptSession session;
     session.eval("byte b[] = { 1, 2, 3, 4 };");
@@ -2650,3 +2726,821 @@ TEST_CASE("Eval bad statement") {
     ScriptSession session;
     CHECK(!session.eval("fork=L:for"));
 }
+
+static std::string evalWithEngine(const std::shared_ptr<SyntaxTree>& tree, bool useBytecode,
+                                  std::span<const std::string_view> params,
+                                  uint32_t maxSteps = 20000) {
+    CompilationOptions co;
+    co.maxConstexprSteps = maxSteps;
+    if (!useBytecode)
+        co.flags |= CompilationFlags::DisableConstEvalBytecode;
+
+    Bag options;
+    options.set(co);
+
+    Compilation compilation(options);
+    compilation.addSyntaxTree(tree);
+
+    std::string result;
+    for (auto name : params) {
+        auto& param = compilation.getRoot().lookupName<ParameterSymbol>(name);
+        result += fmt::format("{} = {}\n", name, param.getValue().toString());
+    }
+    return result + report(compilation.getAllDiagnostics());
+}
+
+TEST_CASE("Constant function bytecode matches tree walker") {
+    auto tree = SyntaxTree::fromText(R"(
+module m;
+    function automatic logic [31:0] crc32(logic [31:0] data, int rounds);
+        logic [31:0] crc = '1;
+        for (int r = 0; r < rounds; r++) begin
+            for (int i = 0; i < 32; i++) begin
+                if (crc[31] ^ data[i])
+                    crc = (crc << 1) ^ 32'h04C11DB7;
+                else
+                    crc <<= 1;
+            end
+            data = {data[15:0], data[31:16]} + r;
+        end
+        return ~crc;
+    endfunction
+
+    function automatic int loops(int n);
+        int total = 0, j = 0;
+        repeat (n) total += 2;
+        while (j < n) begin
+            j++;
+            if (j == 3) continue;
+            else if (j > 7) break;
+            total += j;
+        end
+        do total--; while (total > 40);
+        forever begin
+            total = total * 3;
+            if (total > 1000 || total == 0) break;
+        end
+        return total;
+    endfunction
+
+    function automatic int fib(int n);
+        return n < 2 ? n : fib(n - 1) + fib(n - 2);
+    endfunction
+
+    function automatic logic [7:0] unknowns(logic [3:0] a, logic sel);
+        logic [3:0] b = sel ? a : ~a;
+        if (sel && a[0])
+            b = b + 1'bx;
+        return {b, a} | (sel ? 8'h0f : 8'hf0);
+    endfunction
+
+    function automatic int oob(int idx);
+        logic [7:0] v = 8'hA5;
+        return v[idx];
+    endfunction
+
+    function automatic int spin(int n);
+        int k = 0;
+        while (1) k += n;
+        return k;
+    endfunction
+
+    function automatic int badRepeat(logic [3:0] n);
+        int k = 0;
+        repeat (n) k++;
+        return k;
+    endfunction
+
+    localparam logic [31:0] CRC = crc32(32'hdeadbeef, 4);
+    localparam int L = loops(10);
+    localparam int F = fib(15);
+    localparam logic [7:0] U0 = unknowns(4'b1010, 1'b0);
+    localparam logic [7:0] U1 = unknowns(4'b1011, 1'b1);
+    localparam logic [7:0] UX = unknowns(4'b1011, 1'bx);
+    localparam int O = oob(9);
+    localparam int S = spin(1);
+    localparam int R = badRepeat(4'bx1x0);
+endmodule
+)");
+
+    std::string_view params[] = {"m.CRC", "m.L", "m.F", "m.U0", "m.U1",
+                                 "m.UX",  "m.O", "m.S", "m.R"};
+    auto bytecode = evalWithEngine(tree, true, params);
+    auto treeWalk = evalWithEngine(tree, false, params);
+    CHECK(bytecode == treeWalk);
+    CHECK(bytecode.find("m.F = 610") != std::string::npos);
+}
+
+TEST_CASE("Constant function bytecode benchmark", "[.][benchmark]") {
+    auto tree = SyntaxTree::fromText(R"(
+module m;
+    function automatic int work(int n);
+        int acc = 0;
+        for (int i = 0; i < n; i++) begin
+            for (int j = 0; j < 64; j++)
+                acc = (acc << 1) ^ (i * j) ^ (acc >> 7);
+        end
+        return acc;
+    endfunction
+
+    localparam int P = work(2000);
+endmodule
+)");
+
+    // Both engines count steps the same way, so get the total from a profiled
+    // run and then time each engine without the profiler's overhead.
+    CompilationOptions co;
+    co.maxConstexprSteps = 10'000'000;
+    co.flags |= CompilationFlags::ProfileConstEval;
+    Bag options;
+    options.set(co);
+
+    Compilation compilation(options);
+    compilation.addSyntaxTree(tree);
+    NO_COMPILATION_ERRORS;
+
+    auto profile = compilation.getConstEvalProfile();
+    REQUIRE(profile.callSites.size() == 1);
+    auto steps = double(profile.callSites[0].cost.totalSteps);
+
+    std::string_view params[] = {"m.P"};
+    std::string treeResult, byteResult;
+    auto treeSec = benchmarkTime<std::ratio<1>>(
+        [&] { treeResult = evalWithEngine(tree, false, params, 10'000'000); });
+    auto byteSec = benchmarkTime<std::ratio<1>>(
+        [&] { byteResult = evalWithEngine(tree, true, params, 10'000'000); });
+
+    CHECK(treeResult == byteResult);
+    BENCHMARK_REPORT("{:.0f} steps; tree walker: {:.2f}M steps/s, bytecode: {:.2f}M steps/s",
+                     steps, steps / treeSec / 1e6, steps / byteSec / 1e6);
+}
+
+TEST_CASE("Constant function call memoization") {
+    auto tree = SyntaxTree::fromText(R"(
+package p;
+    function automatic int clog2(int value);
+        int result = 0;
+        for (value = value - 1; value > 0; value >>= 1)
+            result++;
+        return result;
+    endfunction
+endpackage
+
+module m #(parameter int DEPTH)();
+    localparam int W = p::clog2(DEPTH);
+    localparam int B = p::clog2(64);
+endmodule
+
+module top;
+    int counter;
+    function automatic int impure(int a);
+        return a + $bits(counter);
+    endfunction
+
+    function automatic logic oob(int i);
+        logic [3:0] v = '0;
+        return v[i];
+    endfunction
+
+    localparam int X = impure(1);
+    localparam int Y = impure(1);
+    localparam logic O1 = oob(8);
+    localparam logic O2 = oob(8);
+
+    m #(16) m1();
+    m #(32) m2();
+endmodule
+)");
+
+    Compilation compilation;
+    compilation.addSyntaxTree(tree);
+
+    auto& diags = compilation.getAllDiagnostics();
+    CHECK(std::ranges::all_of(diags, [](auto& d) { return d.code == diag::IndexOOB; }));
+
+    auto& root = compilation.getRoot();
+    CHECK(root.lookupName<ParameterSymbol>("top.m1.W").getValue().integer() == 4);
+    CHECK(root.lookupName<ParameterSymbol>("top.m2.W").getValue().integer() == 5);
+    CHECK(root.lookupName<ParameterSymbol>("top.m1.B").getValue().integer() == 6);
+    CHECK(root.lookupName<ParameterSymbol>("top.m2.B").getValue().integer() == 6);
+    CHECK(root.lookupName<ParameterSymbol>("top.Y").getValue().integer() == 33);
+
+    // The second call to clog2(64) is a hit. Calls to oob issue diagnostics so
+    // they aren't stored, and impure isn't memoizable at all.
+    auto stats = compilation.getCallMemoStats();
+    CHECK(stats.hits == 1);
+    CHECK(stats.misses == 5);
+    CHECK(stats.entries == 3);
+}
+
+TEST_CASE("Memoized calls still count toward evaluation limits") {
+    auto tree = SyntaxTree::fromText(R"(
+module m;
+    function automatic int f(int n);
+        return n == 0 ? 0 : f(n - 1) + 1;
+    endfunction
+
+    function automatic int g(int n);
+        return n == 0 ? f(2) : g(n - 1);
+    endfunction
+
+    localparam int A = f(2);
+    localparam int B = g(3);
+endmodule
+)");
+
+    CompilationOptions co;
+    co.maxConstexprDepth = 4;
+    Bag options;
+    options.set(co);
+
+    Compilation compilation(options);
+    compilation.addSyntaxTree(tree);
+
+    // f(2) is memoized by A, but calling it from four frames deep in B
+    // must still exceed the depth limit just as evaluating it would.
+    auto& diags = compilation.getAllDiagnostics();
+    REQUIRE(diags.size() == 1);
+    CHECK(diags[0].code == diag::ConstEvalExceededMaxCallDepth);
+    CHECK(compilation.getCallMemoStats().hits == 1);
+}
+
+TEST_CASE("Dense unpacked array eval") {
+    auto tree = SyntaxTree::fromText(R"(
+module m;
+    typedef logic [7:0] rom_t [256];
+    typedef logic [2047:0] flat_t;
+    typedef int ints_t [100];
+
+    function automatic rom_t makeRom();
+        rom_t r;
+        foreach (r[i])
+            r[i] = 8'($unsigned(i * 7 + 3));
+        r[5][3:0] = 4'bx1z0;
+        return r;
+    endfunction
+
+    function automatic rom_t rotate(rom_t r);
+        rom_t result;
+        result[0:127] = r[128:255];
+        result[128:255] = r[0:127];
+        return result;
+    endfunction
+
+    function automatic int countX(rom_t r);
+        int count = 0;
+        foreach (r[i]) begin
+            if ($isunknown(r[i]))
+                count++;
+        end
+        return count;
+    endfunction
+
+    function automatic int countDefaultX();
+        rom_t r;
+        return countX(r);
+    endfunction
+
+    localparam rom_t ROM = makeRom();
+    localparam logic [7:0] E0 = ROM[0];
+    localparam logic [7:0] E5 = ROM[5];
+    localparam logic [7:0] E255 = ROM[255];
+    localparam int Bits = $bits(ROM);
+    localparam flat_t Flat = flat_t'(ROM);
+    localparam rom_t Back = rom_t'(Flat);
+    localparam bit Same = Back === ROM;
+    localparam rom_t Rot = rotate(ROM);
+    localparam logic [7:0] R128 = Rot[128];
+    localparam logic [7:0] R133 = Rot[133];
+    localparam int X = countX(makeRom());
+    localparam int XDefault = countDefaultX();
+    localparam ints_t Ints = '{default: 42};
+    localparam int I99 = Ints[99];
+endmodule
+)");
+
+    Compilation compilation;
+    compilation.addSyntaxTree(tree);
+    NO_COMPILATION_ERRORS;
+
+    auto& root = compilation.getRoot();
+    auto get = [&](std::string_view name) -> const ConstantValue& {
+        return root.lookupName<ParameterSymbol>(name).getValue();
+    };
+
+    auto& rom = get("m.ROM");
+    CHECK(rom.isDenseArray());
+    CHECK(rom.size() == 256);
+    CHECK(get("m.E0").integer() == 3);
+    CHECK(get("m.E5").integer().toString() == "8'b10x1z0");
+    CHECK(get("m.E255").integer() == 0xfc);
+    CHECK(get("m.Bits").integer() == 2048);
+    CHECK(get("m.Flat").integer().slice(2047, 2040) == 3);
+    CHECK(get("m.Back").isDenseArray());
+    CHECK(get("m.Same").integer() == 1);
+    CHECK(get("m.R128").integer() == 3);
+    CHECK(get("m.R133").integer().toString() == "8'b10x1z0");
+    CHECK(get("m.X").integer() == 1);
+    CHECK(get("m.XDefault").integer() == 256);
+    CHECK(get("m.Ints").isRunArray());
+    CHECK(get("m.I99").integer() == 42);
+
+    // Dense arrays are interchangeable with the equivalent array of elements.
+    ConstantValue::Elements elems;
+    rom.forEachElement([&](const ConstantValue& elem) { elems.push_back(elem); });
+    ConstantValue expanded = std::move(elems);
+    CHECK(!expanded.isDenseArray());
+    CHECK(expanded.size() == 256);
+    CHECK(rom.elementAt(5) == expanded.elementAt(5));
+    CHECK(rom.elementAt(255).integer() == 0xfc);
+    CHECK(expanded == rom);
+    CHECK(rom == expanded);
+    CHECK(expanded.hash() == rom.hash());
+    CHECK(expanded.toString() == rom.toString());
+    CHECK(rom != get("m.Rot"));
+}
+
+TEST_CASE("Dense unpacked array benchmark", "[.][benchmark]") {
+    auto tree = SyntaxTree::fromText(R"(
+module m;
+    typedef logic [7:0] rom_t [1 << 20];
+
+    function automatic rom_t makeRom();
+        rom_t r;
+        foreach (r[i])
+            r[i] = 8'($unsigned(i ^ (i >> 8)));
+        return r;
+    endfunction
+
+    function automatic logic [7:0] checksum(rom_t r);
+        logic [7:0] sum = '0;
+        for (int i = 0; i < $size(r); i += 4096)
+            sum ^= r[i];
+        return sum;
+    endfunction
+
+    localparam rom_t ROM = makeRom();
+    localparam logic [7:0] C = checksum(ROM);
+endmodule
+)");
+
+    CompilationOptions co;
+    co.maxConstexprSteps = 100'000'000;
+    Bag options;
+    options.set(co);
+
+    Compilation compilation(options);
+    auto ms = benchmarkTime([&] {
+        compilation.addSyntaxTree(tree);
+        CHECK(compilation.getRoot().lookupName<ParameterSymbol>("m.C").getValue().isInteger());
+    });
+    BENCHMARK_REPORT("1M element ROM: {:.1f}ms", ms);
+}
+
+TEST_CASE("Run-length array eval") {
+    auto tree = SyntaxTree::fromText(R"(
+module m;
+    typedef struct { int a; real b; } s_t;
+    typedef s_t mem_t [1 << 20];
+    typedef logic [7:0] rom_t [4096];
+
+    function automatic int sumMem();
+        mem_t mem = '{default: s_t'{a: 3, b: 1.5}};
+        int sum = 0;
+        mem[12].a = 5;
+        mem[1000].b = 2.0;
+        for (int i = 0; i < $size(mem); i += 1024)
+            sum += mem[i].a;
+        return sum + mem[12].a + int'(mem[1000].b) + int'(mem[1001].b);
+    endfunction
+
+    function automatic int dynSum();
+        int d[];
+        int sum = 0;
+        d = new[100000];
+        d[5] = 7;
+        d = new[200000](d);
+        for (int i = 0; i < d.size(); i += 1000)
+            sum += d[i] + 1;
+        return sum + d[5] + d[199999];
+    endfunction
+
+    function automatic rom_t fillRom();
+        rom_t r = '{default: 8'h5a};
+        foreach (r[i])
+            r[i] = 8'($unsigned(i));
+        return r;
+    endfunction
+
+    localparam int MemSum = sumMem();
+    localparam int DynSum = dynSum();
+    localparam rom_t Zeros = '{default: '0};
+    localparam rom_t Repl = '{2048{8'h1, 8'h2}};
+    localparam rom_t Filled = fillRom();
+    localparam logic [7:0] Z = Zeros[4095];
+    localparam logic [7:0] R = Repl[4095];
+    localparam logic [7:0] F = Filled[4095];
+    localparam int Bits = $bits(Zeros);
+endmodule
+)");
+
+    Compilation compilation;
+    compilation.addSyntaxTree(tree);
+    NO_COMPILATION_ERRORS;
+
+    auto& root = compilation.getRoot();
+    auto get = [&](std::string_view name) -> const ConstantValue& {
+        return root.lookupName<ParameterSymbol>(name).getValue();
+    };
+
+    CHECK(get("m.MemSum").integer() == 3 * 1024 + 5 + 2 + 2);
+    CHECK(get("m.DynSum").integer() == 200 + 7);
+    CHECK(get("m.Zeros").isRunArray());
+    CHECK(get("m.Zeros").runArray()->runs.size() == 1);
+    CHECK(get("m.Repl").isDenseArray());
+    CHECK(get("m.Filled").isDenseArray());
+    CHECK(get("m.Z").integer() == 0);
+    CHECK(get("m.R").integer() == 2);
+    CHECK(get("m.F").integer() == 0xff);
+    CHECK(get("m.Bits").integer() == 4096 * 8);
+
+    // Run-length arrays are interchangeable with the equivalent array of elements.
+    auto& zeros = get("m.Zeros");
+    auto elems = zeros.elements();
+    ConstantValue expanded = ConstantValue::Elements(elems.begin(), elems.end());
+    CHECK(expanded == zeros);
+    CHECK(zeros == expanded);
+    CHECK(expanded.hash() == zeros.hash());
+    CHECK(zeros.getSlice(10, 3, nullptr) == expanded.getSlice(10, 3, nullptr));
+}
+
+TEST_CASE("Array assignment patterns with side effects") {
+    auto tree = SyntaxTree::fromText(R"(
+module m;
+    typedef int arr_t [100];
+
+    function automatic int one();
+        return 1;
+    endfunction
+
+    function automatic int defaultIncr();
+        int k = 0;
+        arr_t a = '{default: k++};
+        return a[0] + a[99] + k * 1000;
+    endfunction
+
+    function automatic int replIncr();
+        int k = 0;
+        arr_t a = '{50{k++, 7}};
+        return a[0] + a[98] + a[99] + k * 1000;
+    endfunction
+
+    function automatic int calls();
+        arr_t a = '{default: one()};
+        arr_t b = '{25{one(), 2, 3, 4}};
+        return a[99] + b[96];
+    endfunction
+
+    localparam int D = defaultIncr();
+    localparam int R = replIncr();
+    localparam int C = calls();
+endmodule
+)");
+
+    CompilationOptions co;
+    co.flags |= CompilationFlags::ProfileConstEval;
+    Bag options;
+    options.set(co);
+
+    Compilation compilation(options);
+    compilation.addSyntaxTree(tree);
+    NO_COMPILATION_ERRORS;
+
+    // Each element covered by the default or replication has to get its own
+    // evaluation, rather than sharing the value of the first one.
+    auto& root = compilation.getRoot();
+    CHECK(root.lookupName<ParameterSymbol>("m.D").getValue().integer() == 99 + 100 * 1000);
+    CHECK(root.lookupName<ParameterSymbol>("m.R").getValue().integer() == 49 + 7 + 50 * 1000);
+    CHECK(root.lookupName<ParameterSymbol>("m.C").getValue().integer() == 2);
+
+    auto profile = compilation.getConstEvalProfile();
+    auto it = std::ranges::find_if(profile.functions,
+                                   [](auto& entry) { return entry.subroutine->name == "one"; });
+    REQUIRE(it != profile.functions.end());
+    CHECK(it->cost.calls + it->cost.memoHits == 125);
+}
+
+TEST_CASE("Associative array traversal eval") {
+    auto tree = SyntaxTree::fromText(R"(
+module m;
+    typedef int table_t[int];
+
+    function automatic table_t build();
+        table_t arr;
+        for (int i = 0; i < 1000; i++)
+            arr[(i * 7919) % 1009 - 500] = i;
+        return arr;
+    endfunction
+
+    function automatic int walk(table_t arr, bit backward);
+        int k, prevKey;
+        int count = 0;
+        if (backward ? arr.last(k) : arr.first(k)) begin
+            do begin
+                if (count > 0 && (backward ? k >= prevKey : k <= prevKey))
+                    return -1;
+                prevKey = k;
+                count++;
+            end while (backward ? arr.prev(k) : arr.next(k));
+        end
+        return count;
+    endfunction
+
+    function automatic int bounds(table_t arr, bit last);
+        int k;
+        if (last)
+            void'(arr.last(k));
+        else
+            void'(arr.first(k));
+        return k;
+    endfunction
+
+    function automatic bit misses();
+        int arr[string];
+        string s = "zzz";
+        if (arr.first(s) || arr.last(s) || s != "zzz")
+            return 0;
+        arr["a"] = 1;
+        arr["c"] = 2;
+        s = "b";
+        if (!arr.prev(s) || s != "a" || arr.prev(s) || s != "a")
+            return 0;
+        s = "b";
+        return arr.next(s) && s == "c" && !arr.next(s) && s == "c";
+    endfunction
+
+    localparam table_t Table = build();
+    localparam int Forward = walk(Table, 0);
+    localparam int Backward = walk(Table, 1);
+    localparam int First = bounds(Table, 0);
+    localparam int Last = bounds(Table, 1);
+    localparam int Size = Table.size();
+    localparam int Lookup = Table[-500];
+    localparam bit Misses = misses();
+endmodule
+)");
+
+    Compilation compilation;
+    compilation.addSyntaxTree(tree);
+    NO_COMPILATION_ERRORS;
+
+    auto& root = compilation.getRoot();
+    auto get = [&](std::string_view name) -> const ConstantValue& {
+        return root.lookupName<ParameterSymbol>(name).getValue();
+    };
+
+    // 1000 distinct keys, since 7919 is coprime with 1009.
+    CHECK(get("m.Size").integer() == 1000);
+    CHECK(get("m.Forward").integer() == 1000);
+    CHECK(get("m.Backward").integer() == 1000);
+    CHECK(get("m.First").integer() == -500);
+    CHECK(get("m.Last").integer() == 508);
+    CHECK(get("m.Lookup").integer() == 0);
+    CHECK(get("m.Misses").integer() == 1);
+
+    // Iteration is in index order no matter what order things were inserted.
+    auto& table = *get("m.Table").map();
+    CHECK(std::ranges::is_sorted(table, {}, [](auto& entry) { return entry.first; }));
+
+    // Equal arrays hash the same no matter how they were built.
+    AssociativeArray a, b;
+    for (int i = 0; i < 100; i++) {
+        a.try_emplace(SVInt(32, uint64_t(i), true), SVInt(8, uint64_t(i), false));
+        b.try_emplace(SVInt(32, uint64_t(99 - i), true), SVInt(8, uint64_t(99 - i), false));
+    }
+    CHECK(a == b);
+    CHECK(ConstantValue(a).hash() == ConstantValue(b).hash());
+    b.erase(SVInt(32, 50, true));
+    CHECK(a != b);
+    CHECK(a.find(SVInt(32, 50, true)));
+    CHECK(!b.find(SVInt(32, 50, true)));
+}
+
+TEST_CASE("Wildcard associative array keys") {
+    auto tree = SyntaxTree::fromText(R"(
+module m;
+    function automatic int keys();
+        int w[*];
+        w[-1] = 1;
+        w[32'hFFFFFFFF] = 2;
+        w[8'hFF] = 3;
+        w[16'h00FF] = 4;
+        return w.num() * 100 + w[-1] * 10 + w[8'hFF];
+    endfunction
+
+    localparam int K = keys();
+endmodule
+)");
+
+    Compilation compilation;
+    compilation.addSyntaxTree(tree);
+    NO_COMPILATION_ERRORS;
+
+    // Wildcard indices are treated as unsigned values, so a signed -1 and
+    // 32'hFFFFFFFF are the same index, as are 8'hFF and 16'h00FF.
+    auto& k = compilation.getRoot().lookupName<ParameterSymbol>("m.K").getValue();
+    CHECK(k.integer() == 2 * 100 + 2 * 10 + 4);
+
+    AssociativeArray::KeyEqual equal;
+    AssociativeArray::KeyHash hash;
+    ConstantValue minusOne = SVInt(32, uint64_t(-1), true);
+    ConstantValue allOnes = SVInt(32, 0xFFFFFFFF, false);
+    ConstantValue narrow = SVInt(8, 0xFF, true);
+    CHECK(equal(minusOne, allOnes));
+    CHECK(hash(minusOne) == hash(allOnes));
+    CHECK(!equal(minusOne, narrow));
+    CHECK(equal(narrow, SVInt(16, 0xFF, false)));
+    CHECK(hash(narrow) == hash(SVInt(16, 0xFF, false)));
+}
+
+TEST_CASE("Associative array benchmark", "[.][benchmark]") {
+    auto tree = SyntaxTree::fromText(R"(
+module m;
+    function automatic int buildTable(int n);
+        int tbl[int];
+        int hits = 0;
+        for (int i = 0; i < n; i++)
+            tbl[i * 40503] = i;
+        for (int i = 0; i < n; i++) begin
+            if (tbl.exists(i * 40503))
+                hits++;
+        end
+        return hits + tbl.size();
+    endfunction
+
+    function automatic int buildNames(int n);
+        int tbl[string];
+        for (int i = 0; i < n; i++)
+            tbl[$sformatf("sym_%0d", i)] = i;
+        return tbl.size();
+    endfunction
+
+    localparam int T = buildTable(200000);
+    localparam int S = buildNames(50000);
+endmodule
+)");
+
+    CompilationOptions co;
+    co.maxConstexprSteps = 100'000'000;
+    Bag options;
+    options.set(co);
+
+    Compilation compilation(options);
+    compilation.addSyntaxTree(tree);
+    auto& root = compilation.getRoot();
+
+    const ConstantValue* t = nullptr;
+    const ConstantValue* s = nullptr;
+    auto intMs = benchmarkTime([&] { t = &root.lookupName<ParameterSymbol>("m.T").getValue(); });
+    auto stringMs = benchmarkTime([&] { s = &root.lookupName<ParameterSymbol>("m.S").getValue(); });
+
+    CHECK(t->integer() == 400000);
+    CHECK(s->integer() == 50000);
+    BENCHMARK_REPORT("200K int-keyed entries: {:.1f}ms, 50K string-keyed entries: {:.1f}ms",
+                     intMs, stringMs);
+}
+
+TEST_CASE("Constant evaluation profile") {
+    auto tree = SyntaxTree::fromText(R"(
+module top;
+    function automatic int fib(int n);
+        if (n < 2)
+            return n;
+        return fib(n - 1) + fib(n - 2);
+    endfunction
+
+    function automatic int sum(int n);
+        int s = 0;
+        for (int i = 0; i < n; i++)
+            s += i;
+        return s;
+    endfunction
+
+    function automatic int both(int n);
+        return fib(n) + sum(n * 10);
+    endfunction
+
+    localparam int F = fib(10);
+    localparam int S1 = sum(100);
+    localparam int S2 = sum(100);
+    localparam int B = both(5);
+endmodule
+)");
+
+    CompilationOptions co;
+    co.flags |= CompilationFlags::ProfileConstEval;
+    Bag options;
+    options.set(co);
+
+    Compilation compilation(options);
+    compilation.addSyntaxTree(tree);
+    NO_COMPILATION_ERRORS;
+
+    auto profile = compilation.getConstEvalProfile();
+    auto find = [&](std::string_view name) -> const ConstEvalCost& {
+        auto it = std::ranges::find_if(profile.functions,
+                                       [&](auto& entry) { return entry.subroutine->name == name; });
+        REQUIRE(it != profile.functions.end());
+        return it->cost;
+    };
+
+    // fib(0) through fib(10) are each evaluated once; the rest of the
+    // recursive calls, plus the one from both(), are memoized.
+    auto& fib = find("fib");
+    CHECK(fib.calls == 11);
+    CHECK(fib.memoHits == 9);
+    CHECK(fib.totalSteps == fib.selfSteps);
+
+    auto& sum = find("sum");
+    CHECK(sum.calls == 2);
+    CHECK(sum.memoHits == 1);
+
+    auto& both = find("both");
+    CHECK(both.calls == 1);
+    CHECK(both.totalSteps > both.selfSteps);
+
+    // The loop in sum() is the most expensive thing here.
+    REQUIRE(profile.functions.size() == 3);
+    CHECK(profile.functions[0].subroutine->name == "sum");
+    CHECK(std::ranges::is_sorted(profile.functions, std::ranges::greater(),
+                                 [](auto& entry) { return entry.cost.selfSteps; }));
+
+    // Each call site is tracked separately. The most expensive is S1,
+    // which evaluated sum(100); S2 got the memoized result.
+    CHECK(std::ranges::is_sorted(profile.callSites, std::ranges::greater(),
+                                 [](auto& entry) { return entry.cost.totalSteps; }));
+    REQUIRE(!profile.callSites.empty());
+    CHECK(profile.callSites[0].subroutine->name == "sum");
+    CHECK(profile.callSites[0].cost.calls == 1);
+    CHECK(std::ranges::count_if(profile.callSites, [](auto& entry) {
+              return entry.subroutine->name == "sum" && entry.cost.memoHits == 1;
+          }) == 1);
+
+    // Without the flag nothing is recorded.
+    Compilation plain;
+    plain.addSyntaxTree(tree);
+    plain.getAllDiagnostics();
+    CHECK(plain.getConstEvalProfile().functions.empty());
+}
+
+TEST_CASE("Streaming operator benchmark", "[.][benchmark]") {
+    for (int bytes : {1024, 8192, 65536}) {
+        auto tree = SyntaxTree::fromText(fmt::format(R"(
+module m;
+    localparam int N = {};
+    typedef logic [N*8-1:0] vec_t;
+    typedef byte unsigned bytes_t[N];
+
+    function automatic int run();
+        vec_t u, v, w;
+        bytes_t b;
+        for (int i = 0; i < N; i++)
+            v[i*8 +: 8] = 8'(i * 7);
+
+        w = {{<<{{v}}}};
+        w = {{<<{{w}}}};
+        run += int'(w === v);
+
+        w = {{<<8{{v}}}};
+        w = {{<<8{{w}}}};
+        run += int'(w === v);
+
+        u = {{<<24{{v}}}};
+        {{<<24{{w}}}} = u;
+        run += int'(w === v);
+
+        b = bytes_t'(v);
+        w = vec_t'(b);
+        run += int'(w === v);
+
+        {{<<8{{b}}}} = v;
+        w = {{<<8{{b}}}};
+        run += int'(w === v);
+    endfunction
+
+    localparam int R = run();
+endmodule
+)",
+                                                     bytes));
+
+        Compilation compilation;
+        compilation.addSyntaxTree(tree);
+        auto& root = compilation.getRoot();
+
+        const ConstantValue* r = nullptr;
+        auto ms = benchmarkTime([&] { r = &root.lookupName<ParameterSymbol>("m.R").getValue(); });
+
+        CHECK(r->integer() == 5);
+        BENCHMARK_REPORT("{} byte payloads: {:.1f}ms", bytes, ms);
+    }
+}
@@ -2172,3 +2172,47 @@ endmodule
     REQUIRE(diags.size() == 1);
     CHECK(diags[0].code == diag::InfinitelyRecursiveHierarchy);
 }
+
+TEST_CASE("Compilation memory stats") {
+    auto tree = SyntaxTree::fromText(R"(
+module m #(parameter int P = 1)(input logic [P-1:0] a, output logic [P-1:0] b);
+    assign b = a + 1'b1;
+endmodule
+
+module top;
+    logic [3:0] x, y;
+    m #(4) m1(x, y);
+    m #(4) m2(x, y);
+endmodule
+)");
+
+    Compilation compilation;
+    compilation.addSyntaxTree(tree);
+    NO_COMPILATION_ERRORS;
+
+    auto stats = compilation.getMemoryStats();
+    REQUIRE(!stats.arenas.empty());
+    CHECK(stats.arenas[0].name == "main");
+    CHECK(stats.arenas[0].used > 0);
+    CHECK(stats.arenas[0].used <= stats.arenas[0].reserved);
+    CHECK(stats.syntaxTrees > 0);
+    CHECK(stats.types > 0);
+    CHECK(stats.sideTables > 0);
+    CHECK(stats.getTotalReserved() > stats.syntaxTrees);
+
+    auto findKind = [](auto& list, auto kind) {
+        return std::ranges::find_if(list, [&](auto& usage) { return usage.kind == kind; });
+    };
+
+    auto instIt = findKind(stats.symbols, SymbolKind::Instance);
+    REQUIRE(instIt != stats.symbols.end());
+    CHECK(instIt->count >= 3);
+    CHECK(instIt->bytes == instIt->count * sizeof(InstanceSymbol));
+
+    auto binIt = findKind(stats.expressions, ExpressionKind::BinaryOp);
+    REQUIRE(binIt != stats.expressions.end());
+    CHECK(binIt->count > 0);
+
+    for (size_t i = 1; i < stats.symbols.size(); i++)
+        CHECK(stats.symbols[i - 1].bytes >= stats.symbols[i].bytes);
+}
@@ -785,6 +785,50 @@ endmodule
     CHECK(j.getValue().integer() == 14);
 }
 
+TEST_CASE("Forked compilations with different param overrides") {
+    auto tree = SyntaxTree::fromText(R"(
+module n;
+    m m1();
+endmodule
+
+module m #(parameter int foo = 1);
+    localparam int j = foo * 2;
+endmodule
+
+module top #(parameter int bar = 1);
+    m #(bar) m1();
+endmodule
+)");
+
+    CompilationOptions options;
+    options.topModules.emplace("n");
+    options.paramOverrides.push_back("n.m1.foo=3");
+
+    Compilation compilation(options);
+    compilation.addSyntaxTree(tree);
+    NO_COMPILATION_ERRORS;
+    CHECK(compilation.getRoot().lookupName<ParameterSymbol>("n.m1.j").getValue().integer() == 6);
+
+    // The fork shares the syntax tree but not the parent's overrides, including
+    // the defparam tree that was synthesized for the hierarchical override.
+    CompilationOptions forkOptions;
+    forkOptions.topModules.emplace("top");
+    forkOptions.paramOverrides.push_back("bar=5");
+
+    auto fork = compilation.fork(forkOptions);
+    REQUIRE(fork->getSyntaxTrees().size() == 1);
+    CHECK(fork->getSyntaxTrees()[0] == tree);
+
+    auto& root = fork->getRoot();
+    CHECK(fork->getAllDiagnostics().empty());
+    REQUIRE(root.topInstances.size() == 1);
+    CHECK(root.topInstances[0]->name == "top");
+    CHECK(root.lookupName<ParameterSymbol>("top.m1.j").getValue().integer() == 10);
+
+    // The parent is unaffected.
+    CHECK(compilation.getRoot().lookupName<ParameterSymbol>("n.m1.j").getValue().integer() == 6);
+}
+
 TEST_CASE("Invalid param override option handling") {
     auto tree = SyntaxTree::fromText(R"(
 module m #(parameter int foo, string bar, real baz);
@@ -1066,6 +1110,46 @@ endmodule
     checkChild(3, "dut2", 5678);
 }
 
+TEST_CASE("defparams from nested and unrelated hierarchies") {
+    auto tree = SyntaxTree::fromText(R"(
+module leaf #(parameter int w = 1);
+    localparam int x = w;
+endmodule
+
+module mid;
+    leaf l1();
+    leaf l2();
+endmodule
+
+module setter;
+    defparam top.m1.l1.w = 7;
+endmodule
+
+module outer;
+    module inner;
+        defparam top.m2.l2.w = 9;
+    endmodule
+endmodule
+
+module top;
+    mid m1();
+    mid m2();
+    setter s();
+    outer o();
+endmodule
+)");
+
+    Compilation compilation;
+    compilation.addSyntaxTree(tree);
+    NO_COMPILATION_ERRORS;
+
+    auto& root = compilation.getRoot();
+    CHECK(root.lookupName<ParameterSymbol>("top.m1.l1.x").getValue().integer() == 7);
+    CHECK(root.lookupName<ParameterSymbol>("top.m1.l2.x").getValue().integer() == 1);
+    CHECK(root.lookupName<ParameterSymbol>("top.m2.l1.x").getValue().integer() == 1);
+    CHECK(root.lookupName<ParameterSymbol>("top.m2.l2.x").getValue().integer() == 9);
+}
+
 TEST_CASE("defparam in infinite recursion") {
     auto tree = SyntaxTree::fromText(R"(
 module m;
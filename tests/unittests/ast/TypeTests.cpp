@@ -534,6 +534,44 @@ endmodule
     CHECK(e.as<QueueType>().maxBound == 9999);
 }
 
+TEST_CASE("Structurally identical array types are shared") {
+    auto tree = SyntaxTree::fromText(R"(
+module m;
+    wire [31:0] a [4];
+    wire [31:0] b [4];
+    logic [31:0] c;
+    logic [3:0][7:0] d, e;
+    int f[$], g[$];
+    int h[string], i[string];
+    int j[], k[];
+    wire [31:0] l [5];
+endmodule
+)");
+
+    Compilation compilation;
+    compilation.addSyntaxTree(tree);
+    NO_COMPILATION_ERRORS;
+
+    auto& root = compilation.getRoot();
+    auto getType = [&](std::string_view name) -> const Type& {
+        return root.lookupName<ValueSymbol>(name).getType();
+    };
+
+    CHECK(&getType("m.a") == &getType("m.b"));
+    CHECK(getType("m.a").getArrayElementType() == &getType("m.c"));
+    CHECK(&getType("m.c") == &compilation.getType(32, IntegralFlags::FourState));
+    CHECK(&getType("m.d") == &getType("m.e"));
+    CHECK(&getType("m.f") == &getType("m.g"));
+    CHECK(&getType("m.h") == &getType("m.i"));
+    CHECK(&getType("m.j") == &getType("m.k"));
+    CHECK(&getType("m.a") != &getType("m.l"));
+    CHECK(!getType("m.a").isMatching(getType("m.l")));
+
+    // Shared types don't point back at any one declaration's syntax.
+    CHECK(!getType("m.a").getSyntax());
+    CHECK(!getType("m.f").getSyntax());
+}
+
 TEST_CASE("Associative array -- invalid index type") {
     auto tree = SyntaxTree::fromText(R"(
 module m;
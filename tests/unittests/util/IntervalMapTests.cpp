@@ -4,7 +4,6 @@
 #define CATCH_CONFIG_ENABLE_ALL_STRINGMAKERS
 
 #include "Test.h"
-#include <fmt/format.h>
 #include <random>
 
 #include "slang/util/IntervalMap.h"
@@ -269,3 +268,129 @@ TEST_CASE("IntervalMap -- intersection") {
         {1, 2}, {5, 5}, {8, 10}, {15, 18}, {20, 24}};
     CHECK(std::ranges::equal(result, expected));
 }
+
+TEST_CASE("IntervalMap -- bulk load") {
+    BumpAllocator ba;
+    IntervalMap<int32_t, int32_t, 2>::allocator_type alloc(ba);
+
+    std::mt19937 mt;
+    for (int32_t count : {0, 2, 3, 30, 1000}) {
+        std::vector<std::pair<std::pair<int32_t, int32_t>, int32_t>> items;
+        for (int32_t i = 0; i < count; i++) {
+            int32_t left = i * 4;
+            items.push_back({{left, left + getUniformIntDist(mt, 0, 20)}, i});
+        }
+
+        IntervalMap<int32_t, int32_t, 2> map(items, alloc);
+        map.verify();
+        CHECK(std::ranges::distance(map.begin(), map.end()) == count);
+
+        auto it = map.begin();
+        for (auto& [key, value] : items) {
+            REQUIRE(it != map.end());
+            CHECK(it.bounds() == key);
+            CHECK(*it == value);
+            ++it;
+        }
+
+        // The loaded map can still be modified as normal.
+        map.insert(5, 6, -1, alloc);
+        map.unionWith(8, 9, -2, alloc);
+        map.erase(map.begin(), alloc);
+        map.verify();
+        map.clear(alloc);
+    }
+}
+
+TEST_CASE("IntervalMap -- batched overlap queries") {
+    IntervalMap<int32_t, int32_t> map;
+    BumpAllocator ba;
+    IntervalMap<int32_t, int32_t>::allocator_type alloc(ba);
+
+    std::mt19937 mt;
+    for (int32_t i = 0; i < 500; i++) {
+        int32_t left = getUniformIntDist(mt, 0, 2000);
+        map.insert(left, left + getUniformIntDist(mt, 0, 30), i, alloc);
+    }
+
+    std::vector<std::pair<int32_t, int32_t>> queries = {{-10, -1}, {3000, 3100}, {0, 2100}};
+    for (int32_t i = 0; i < 200; i++) {
+        int32_t left = getUniformIntDist(mt, 0, 2100);
+        queries.push_back({left, left + getUniformIntDist(mt, 0, 50)});
+    }
+
+    std::vector<std::vector<std::pair<std::pair<int32_t, int32_t>, int32_t>>> results(
+        queries.size());
+    map.findAll(queries, [&](size_t index, std::pair<int32_t, int32_t> bounds, int32_t value) {
+        results[index].push_back({bounds, value});
+    });
+
+    for (size_t i = 0; i < queries.size(); i++) {
+        std::vector<std::pair<std::pair<int32_t, int32_t>, int32_t>> expected;
+        for (auto it = map.find(queries[i]); it != map.end(); ++it)
+            expected.push_back({it.bounds(), *it});
+
+        CHECK(results[i] == expected);
+    }
+
+    CHECK(results[0].empty());
+    CHECK(results[1].empty());
+    CHECK(results[2].size() == 500);
+}
+
+TEST_CASE("IntervalMap driver workload benchmark", "[.][benchmark]") {
+    // Mirrors how the driver tracker uses its maps: each driver's range
+    // is checked for overlaps with existing drivers and then inserted.
+    using Map = IntervalMap<uint64_t, const void*, 5>;
+    BumpAllocator ba;
+    Map::allocator_type alloc(ba);
+
+    std::mt19937_64 rng(1234);
+    for (uint64_t count : {16u, 256u, 4096u, 65536u}) {
+        std::vector<std::pair<uint64_t, uint64_t>> ranges;
+        for (uint64_t i = 0; i < count; i++)
+            ranges.push_back({i * 8, i * 8 + 7});
+        std::ranges::shuffle(ranges, rng);
+
+        const int iterations = std::max(1, int((1u << 20) / count));
+        size_t sink = 0;
+        auto time = [&](auto&& func) {
+            return benchmarkTime<std::nano>(func, iterations) / double(count);
+        };
+
+        auto incremental = time([&] {
+            Map map;
+            for (auto& range : ranges) {
+                for (auto it = map.find(range); it != map.end(); ++it)
+                    sink++;
+                map.insert(range, nullptr, alloc);
+            }
+            map.clear(alloc);
+        });
+
+        std::vector<std::pair<std::pair<uint64_t, uint64_t>, const void*>> items;
+        for (auto& range : ranges)
+            items.push_back({range, nullptr});
+        std::ranges::sort(items);
+
+        auto bulk = time([&] {
+            Map map(items, alloc);
+            map.findAll(ranges, [&](size_t, auto, auto) { sink++; });
+            map.clear(alloc);
+        });
+
+        Map map(items, alloc);
+        auto single = time([&] {
+            for (auto& range : ranges) {
+                for (auto it = map.find(range); it != map.end(); ++it)
+                    sink++;
+            }
+        });
+        auto batched = time([&] { map.findAll(ranges, [&](size_t, auto, auto) { sink++; }); });
+        map.clear(alloc);
+
+        BENCHMARK_REPORT("{} intervals: insert+find {:.1f}ns, bulk load+findAll {:.1f}ns, "
+                         "find {:.1f}ns, findAll {:.1f}ns (per interval, {})",
+                         count, incremental, bulk, single, batched, sink);
+    }
+}
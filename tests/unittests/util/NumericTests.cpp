@@ -4,6 +4,7 @@
 #include "Test.h"
 #include <catch2/catch_approx.hpp>
 #include <cmath>
+#include <random>
 #include <sstream>
 using Catch::Approx;
 
@@ -675,6 +676,19 @@ TEST_CASE("SVInt misc functions") {
     CHECK_THAT("129'b1x10"_si.shl(125).reverse(), exactlyEquals("129'b1x1"_si));
     CHECK_THAT("128'b1x10"_si.shl(124).reverse(), exactlyEquals("128'b1x1"_si));
 
+    CHECK("6'b110101"_si.reverseSlices(4, 4) == "6'b010111"_si);
+    CHECK("10'b1011001101"_si.reverseSlices(4, 2) == "10'b0100111011"_si);
+    CHECK("16'h1234"_si.reverseSlices(8, 8) == "16'h3412"_si);
+    CHECK("24'h123456"_si.reverseSlices(8, 8) == "24'h563412"_si);
+    CHECK("8'hab"_si.reverseSlices(8, 8) == "8'hab"_si);
+    CHECK("136'h0102030405060708090a0b0c0d0e0f1011"_si.reverseSlices(8, 8) ==
+          "136'h11100f0e0d0c0b0a090807060504030201"_si);
+    CHECK_THAT("72'h123456789abcdefx0"_si.reverseSlices(8, 8),
+               exactlyEquals("72'hx0efcdab8967452301"_si));
+    CHECK_THAT("130'b1x10"_si.shl(126).reverseSlices(1, 1), exactlyEquals("130'b1x1"_si));
+    CHECK_THAT("200'h123456789abcdefzfedcba98765432100123456789abcdef01"_si.reverseSlices(64, 8),
+               exactlyEquals("200'h010123456789abcdeffedcba9876543210123456789abcdefz"_si));
+
     CHECK("192'hzzxx000000zz0000"_si.countLeadingUnknowns() == 144);
     CHECK("192'hzzxx000000zz0000"_si.countLeadingZs() == 136);
     CHECK(a.countLeadingZs() == 0);
@@ -848,3 +862,230 @@ value = value >> 1
     compilation.addSyntaxTree(tree);
     compilation.getAllDiagnostics();
 }
+
+// Checks whether the value's words are stored within the SVInt object itself
+// rather than in a separate heap allocation.
+static bool isStoredInline(const SVInt& value) {
+    auto words = reinterpret_cast<const std::byte*>(value.getRawPtr());
+    auto object = reinterpret_cast<const std::byte*>(&value);
+    return words >= object && words < object + sizeof(SVInt);
+}
+
+TEST_CASE("SVInt small values are stored inline") {
+    // 4-state values up to 64 bits and 2-state values up to 128 bits
+    // shouldn't need any heap storage.
+    SVInt x(logic_t::x);
+    SVInt a = "32'b10x1z"_si;
+    SVInt b = "32'd12345"_si;
+    SVInt c = "100'hfffffffffffffffffffffffff"_si;
+    SVInt d = "100'd98765432109876543210"_si;
+
+    SVInt r1 = a + b;
+    SVInt r2 = (a & b) | (a ^ x.extend(32, false));
+    SVInt r3 = c * d + c;
+    SVInt r4 = (c - d).lshr(3).shl(7);
+    SVInt r5 = r3;
+    r5 = r2;
+    r5.set(3, 0, "4'bx01z"_si);
+    for (auto v : {&x, &a, &b, &c, &d, &r1, &r2, &r3, &r4, &r5})
+        CHECK(isStoredInline(*v));
+
+    CHECK_THAT(r1, exactlyEquals("32'bx"_si));
+    CHECK(r3 == "100'hffffffffaa55ab2c71ad98115"_si);
+    CHECK_THAT(r5, exactlyEquals("32'b1x01z"_si));
+
+    // Changing between 2-state and 4-state has to keep the value intact,
+    // including when that moves it to or from the heap.
+    SVInt v(16, 0xffff, false);
+    v.set(3, 0, "4'bx01z"_si);
+    CHECK_THAT(v, exactlyEquals("16'b111111111111x01z"_si));
+
+    SVInt w = "72'hffffffffffffffffff"_si;
+    w.set(0, 0, "1'bz"_si);
+    CHECK(exactlyEqual(w[0], logic_t::z));
+    CHECK(w.countOnes() == 71);
+    w.set(0, 0, "1'b0"_si);
+    CHECK(w == "72'hfffffffffffffffffe"_si);
+    CHECK(!w.hasUnknown());
+
+    // Wider values still go to the heap.
+    SVInt e = c.extend(200, false) + d.extend(200, false);
+    CHECK(!isStoredInline(e));
+    CHECK(e.getBitWidth() == 200);
+}
+
+TEST_CASE("SVInt allocation benchmark", "[.][benchmark]") {
+    auto run = [](std::string_view name, const SVInt& lhs, const SVInt& rhs) {
+        SVInt acc = lhs;
+        auto ns = benchmarkTime<std::nano>(
+            [&] {
+                SVInt sum = acc + rhs;
+                SVInt mixed = (sum & lhs) ^ rhs;
+                acc = mixed.lshr(1) | lhs;
+            },
+            1'000'000);
+
+        BENCHMARK_REPORT("{} ({} storage): {:.1f}ns per iteration", name,
+                         isStoredInline(acc) ? "inline" : "heap", ns);
+    };
+
+    run("2-state 32-bit", "32'd123456"_si, "32'd789"_si);
+    run("4-state 1-bit", SVInt(logic_t::x), SVInt(logic_t(1)));
+    run("4-state 64-bit", "64'hx000000000000001"_si, "64'd12345"_si);
+    run("2-state 128-bit", "128'hffffffffffffffffffffffff"_si, "128'd987654321"_si);
+    run("4-state 128-bit", "128'hx0000000000000000000000001"_si, "128'd987654321"_si);
+}
+
+static SVInt randomSVInt(std::mt19937_64& rng, bitwidth_t bits, bool fourState) {
+    std::vector<logic_t> digits;
+    digits.reserve(bits);
+    for (bitwidth_t i = 0; i < bits; i++) {
+        auto r = rng() % 16;
+        if (fourState && r == 0)
+            digits.push_back(logic_t::x);
+        else if (fourState && r == 1)
+            digits.push_back(logic_t::z);
+        else
+            digits.push_back(logic_t(r & 1));
+    }
+    return SVInt::fromDigits(bits, LiteralBase::Binary, false, fourState, digits);
+}
+
+TEST_CASE("SVInt vectorized kernels match the portable ones") {
+    std::mt19937_64 rng(1234);
+    auto evaluate = [](const SVInt& a, const SVInt& b, bitwidth_t shift) {
+        SVInt nearlyA = a;
+        nearlyA.set(0, 0, SVInt(logic_t(!a[0])));
+
+        return std::vector<SVInt>{a & b,
+                                  a | b,
+                                  a ^ b,
+                                  a.xnor(b),
+                                  a.shl(shift),
+                                  a.lshr(shift),
+                                  a.shl(shift % 64),
+                                  a.lshr(shift % 64),
+                                  SVInt(a < b),
+                                  SVInt(a == b),
+                                  SVInt(a == nearlyA),
+                                  SVInt(a < nearlyA)};
+    };
+
+    for (bitwidth_t bits : {65u, 128u, 200u, 256u, 300u, 1000u, 4099u}) {
+        for (int kind = 0; kind < 4; kind++) {
+            SVInt a = randomSVInt(rng, bits, kind & 1);
+            SVInt b = randomSVInt(rng, bits, kind & 2);
+            auto shift = bitwidth_t(rng() % bits);
+
+            SVInt::setVectorizedKernels(true);
+            auto vectorized = evaluate(a, b, shift);
+
+            SVInt::setVectorizedKernels(false);
+            CHECK(SVInt::getKernelName() == "portable");
+            auto portable = evaluate(a, b, shift);
+
+            REQUIRE(vectorized.size() == portable.size());
+            for (size_t i = 0; i < vectorized.size(); i++)
+                CHECK_THAT(vectorized[i], exactlyEquals(portable[i]));
+        }
+    }
+
+    SVInt::setVectorizedKernels(true);
+}
+
+TEST_CASE("SVInt kernel benchmark", "[.][benchmark]") {
+    std::mt19937_64 rng(1234);
+    for (bitwidth_t bits : {64u, 1024u, 16384u, 262144u, 1u << 20}) {
+        SVInt a = randomSVInt(rng, bits, false);
+        SVInt b = randomSVInt(rng, bits, false);
+        SVInt a4 = randomSVInt(rng, bits, true);
+        SVInt b4 = randomSVInt(rng, bits, true);
+        const int iterations = std::max(1, int((1u << 24) / bits));
+
+        auto time = [&](bool vectorized) {
+            SVInt::setVectorizedKernels(vectorized);
+
+            size_t sink = 0;
+            auto us = benchmarkTime<std::micro>(
+                [&] {
+                    sink += (a & b).getBitWidth();
+                    sink += (a4 | b4).getBitWidth();
+                    sink += (a4 ^ b).getBitWidth();
+                    sink += a.shl(13).getBitWidth();
+                    sink += a4.lshr(77).getBitWidth();
+                    sink += size_t(bool(a < b)) + size_t(bool(a == b));
+                },
+                iterations);
+
+            CHECK(sink > 0);
+            return us;
+        };
+
+        double portable = time(false);
+        double vectorized = time(true);
+        BENCHMARK_REPORT("{} bits: portable {:.2f}us, {} {:.2f}us per iteration", bits, portable,
+                         SVInt::getKernelName(), vectorized);
+    }
+
+    SVInt::setVectorizedKernels(true);
+}
+
+TEST_CASE("SVInt wide multiplication and division") {
+    std::mt19937_64 rng(5678);
+    auto randomWide = [&](bitwidth_t bits, bitwidth_t width) {
+        // Make sure the top bit is set so that the value really is this wide.
+        SVInt result = randomSVInt(rng, bits, false);
+        result.set(int32_t(bits - 1), int32_t(bits - 1), SVInt(logic_t(1)));
+        return result.resize(width);
+    };
+
+    // Compare the fast multiplication algorithms against schoolbook multiplication
+    // by single words, including very unbalanced operand sizes.
+    for (auto [xbits, ybits] : {std::pair{600u, 700u}, {3000u, 520u}, {5000u, 4000u},
+                                {20000u, 1100u}, {1000u, 9000u}}) {
+        bitwidth_t width = xbits + ybits;
+        SVInt x = randomWide(xbits, width);
+        SVInt y = randomWide(ybits, width);
+
+        SVInt expected(width, 0, false);
+        for (bitwidth_t i = 0; i < ybits; i += 64)
+            expected += (x * y.lshr(i).trunc(64).zext(width)).shl(i);
+
+        CHECK_THAT(x * y, exactlyEquals(expected));
+    }
+
+    // Division results are checked against their definition. The larger sizes
+    // are big enough to divide by way of a reciprocal.
+    for (auto [abits, bbits] : {std::pair{5000u, 3000u}, {26000u, 12500u}, {40000u, 13000u},
+                                {30000u, 12300u}}) {
+        SVInt a = randomWide(abits, abits);
+        SVInt b = randomWide(bbits, abits);
+        SVInt q = a / b;
+        SVInt r = a % b;
+        CHECK_THAT(q * b + r, exactlyEquals(a));
+        CHECK(r < b);
+        CHECK(q.getActiveBits() >= abits - bbits);
+    }
+
+    // Exact multiples end up with a zero remainder.
+    SVInt b = randomWide(13000, 40000);
+    SVInt q = randomWide(25000, 40000);
+    CHECK_THAT((q * b) / b, exactlyEquals(q));
+    CHECK((q * b) % b == 0);
+}
+
+TEST_CASE("SVInt wide arithmetic benchmark", "[.][benchmark]") {
+    std::mt19937_64 rng(1234);
+    for (bitwidth_t bits : {1024u, 4096u, 16384u, 65536u, 262144u}) {
+        SVInt a = randomSVInt(rng, bits, false).zext(bits * 2);
+        SVInt b = randomSVInt(rng, bits, false).zext(bits * 2);
+        SVInt n = randomSVInt(rng, bits * 2, false);
+        const int iterations = std::max(1, int((1u << 24) / bits));
+
+        double mul = benchmarkTime<std::micro>(
+            [&] { CHECK((a * b).getBitWidth() == bits * 2); }, iterations);
+        double div = benchmarkTime<std::micro>(
+            [&] { CHECK((n / b).getBitWidth() == bits * 2); }, iterations);
+        BENCHMARK_REPORT("{} bits: multiply {:.2f}us, divide {:.2f}us", bits, mul, div);
+    }
+}
@@ -6,6 +6,7 @@
 #include <catch2/matchers/catch_matchers_string.hpp>
 #include <sstream>
 
+#include "slang/util/IdentifierTable.h"
 #include "slang/util/Random.h"
 #include "slang/util/TimeTrace.h"
 
@@ -68,3 +69,57 @@ TEST_CASE("TimeTrace tests") {
 }
 
 #endif
+
+TEST_CASE("IdentifierTable interning") {
+    IdentifierTable table;
+    CHECK(table.intern("") == IdentifierId::Empty);
+    CHECK(table.find("foo") == IdentifierId::Unknown);
+
+    std::string name = "foo";
+    auto id = table.intern(name);
+    CHECK(id != IdentifierId::Empty);
+    CHECK(table.intern("foo") == id);
+    CHECK(table.find("foo") == id);
+    CHECK(table.intern("bar") != id);
+
+    // The table owns its own copy of the text.
+    name = "baz";
+    CHECK(table.getText(id) == "foo");
+    CHECK(table.size() == 3);
+
+    table.reset();
+    CHECK(table.size() == 1);
+    CHECK(table.find("foo") == IdentifierId::Unknown);
+    CHECK(table.intern("bar") == id);
+    CHECK(table.getText(id) == "bar");
+
+    auto tree = SyntaxTree::fromText("module m; wire foo; wire \\foo ; endmodule");
+    auto& unit = tree->root().as<CompilationUnitSyntax>();
+    auto& module = unit.members[0]->as<ModuleDeclarationSyntax>();
+    auto& first = module.members[0]->as<NetDeclarationSyntax>().declarators[0]->name;
+    auto& second = module.members[1]->as<NetDeclarationSyntax>().declarators[0]->name;
+    CHECK(first.identifierId() == IdentifierTable::getDefault().find("foo"));
+    CHECK(first.identifierId() == second.identifierId());
+}
+
+TEST_CASE("BumpAllocator memory accounting") {
+    BumpAllocator alloc;
+    CHECK(alloc.getBytesUsed() == 0);
+    auto initial = alloc.getBytesReserved();
+    CHECK(initial > 0);
+
+    alloc.allocate(16, 8);
+    CHECK(alloc.getBytesUsed() == 16);
+
+    // Large allocations get their own segment but are still counted.
+    alloc.allocate(10000, 8);
+    CHECK(alloc.getBytesUsed() == 10016);
+    CHECK(alloc.getBytesReserved() > initial + 10000);
+
+    BumpAllocator other;
+    other.allocate(32, 8);
+    auto reserved = alloc.getBytesReserved() + other.getBytesReserved();
+    alloc.steal(std::move(other));
+    CHECK(alloc.getBytesUsed() == 10048);
+    CHECK(alloc.getBytesReserved() == reserved);
+}
@@ -12,11 +12,17 @@
 #include "slang/analysis/AnalysisManager.h"
 #include "slang/ast/ASTSerializer.h"
 #include "slang/ast/Compilation.h"
+#include "slang/ast/Expression.h"
+#include "slang/ast/Statement.h"
+#include "slang/ast/symbols/BlockSymbols.h"
 #include "slang/ast/symbols/CompilationUnitSymbols.h"
+#include "slang/ast/symbols/SubroutineSymbols.h"
 #include "slang/diagnostics/TextDiagnosticClient.h"
 #include "slang/driver/Driver.h"
 #include "slang/syntax/CSTSerializer.h"
+#include "slang/text/CharInfo.h"
 #include "slang/text/Json.h"
+#include "slang/text/SourceManager.h"
 #include "slang/util/TimeTrace.h"
 #include "slang/util/VersionInfo.h"
 
@@ -80,6 +86,173 @@ void printCSTJson(Driver& driver, const std::string& fileName,
     OS::writeFile(fileName, writer.view());
 }
 
+void traceCallMemoStats(const Compilation& compilation) {
+    auto stats = compilation.getCallMemoStats();
+    std::pair<std::string_view, uint64_t> values[] = {{"hits"sv, stats.hits},
+                                                      {"misses"sv, stats.misses},
+                                                      {"entries"sv, stats.entries}};
+    TimeTrace::counter("constEvalCallMemo"sv, values);
+}
+
+void printMemoryStats(const Compilation& compilation) {
+    auto stats = compilation.getMemoryStats();
+    auto kib = [](size_t bytes) { return (bytes + 1023) / 1024; };
+
+    std::string result = "Memory usage (KiB):\n  Arenas (used / reserved):\n";
+    for (auto& arena : stats.arenas) {
+        result += fmt::format("    {:<20} {:>10} / {:>10}\n", arena.name, kib(arena.used),
+                              kib(arena.reserved));
+    }
+
+    result += "  Categories:\n";
+    auto addCategory = [&](std::string_view name, size_t bytes) {
+        result += fmt::format("    {:<20} {:>10}\n", name, kib(bytes));
+    };
+    addCategory("syntax trees", stats.syntaxTrees);
+    addCategory("types", stats.types);
+    addCategory("constants", stats.constants);
+    addCategory("diagnostics", stats.diagnostics);
+    addCategory("side tables", stats.sideTables);
+    addCategory("total reserved", stats.getTotalReserved());
+
+    constexpr size_t MaxKinds = 10;
+    auto addKinds = [&](std::string_view title, auto& list) {
+        result += fmt::format("  {} (count / KiB):\n", title);
+        for (size_t i = 0; i < std::min(list.size(), MaxKinds); i++) {
+            auto& usage = list[i];
+            result += fmt::format("    {:<28} {:>10} / {:>10}\n", toString(usage.kind),
+                                  usage.count, kib(usage.bytes));
+        }
+    };
+    addKinds("Top symbol kinds", stats.symbols);
+    addKinds("Top expression kinds", stats.expressions);
+
+    OS::print(result);
+}
+
+void writeConstEvalProfile(const Compilation& compilation, const std::string& fileName) {
+    auto profile = compilation.getConstEvalProfile();
+    auto sm = compilation.getSourceManager();
+    auto ms = [](std::chrono::nanoseconds time) {
+        return std::chrono::duration<double, std::milli>(time).count();
+    };
+
+    std::string result = "Constant functions (by steps in the function itself):\n";
+    result += fmt::format("  {:>10} {:>10} {:>12} {:>12} {:>10} {:>10}  {}\n", "calls",
+                          "memo hits", "self steps", "total steps", "self ms", "total ms",
+                          "function");
+    for (auto& entry : profile.functions) {
+        auto& cost = entry.cost;
+        result += fmt::format("  {:>10} {:>10} {:>12} {:>12} {:>10.3f} {:>10.3f}  {}\n",
+                              cost.calls, cost.memoHits, cost.selfSteps, cost.totalSteps,
+                              ms(cost.selfTime), ms(cost.totalTime),
+                              entry.subroutine->getHierarchicalPath());
+    }
+
+    result += "\nCall sites (by total steps under the call):\n";
+    result += fmt::format("  {:>10} {:>10} {:>12} {:>10}  {}\n", "calls", "memo hits",
+                          "total steps", "total ms", "location");
+    for (auto& entry : profile.callSites) {
+        auto& cost = entry.cost;
+        std::string location;
+        if (sm) {
+            auto loc = sm->getFullyOriginalLoc(entry.callLocation);
+            location = fmt::format("{}:{}:{}", sm->getFileName(loc), sm->getLineNumber(loc),
+                                   sm->getColumnNumber(loc));
+        }
+
+        result += fmt::format("  {:>10} {:>10} {:>12} {:>10.3f}  {} ({})\n", cost.calls,
+                              cost.memoHits, cost.totalSteps, ms(cost.totalTime), location,
+                              entry.subroutine->name);
+    }
+
+    OS::writeFile(fileName, result);
+}
+
+void writeAnalysisReport(const analysis::AnalysisManager& analysisManager,
+                         const Compilation& compilation, const std::string& fileName,
+                         size_t limit) {
+    auto profile = analysisManager.getProfile();
+    auto sm = compilation.getSourceManager();
+    auto ms = [](std::chrono::nanoseconds time) {
+        return std::chrono::duration<double, std::milli>(time).count();
+    };
+    auto getLocation = [&](SourceLocation loc) -> std::string {
+        if (!sm)
+            return {};
+
+        loc = sm->getFullyOriginalLoc(loc);
+        return fmt::format("{}:{}:{}", sm->getFileName(loc), sm->getLineNumber(loc),
+                           sm->getColumnNumber(loc));
+    };
+    auto top = [&](auto& entries) {
+        return std::span(entries).first(std::min(entries.size(), limit));
+    };
+    auto describe = &analysis::AnalysisManager::describeProcedure;
+
+    std::string result = fmt::format("Scopes (top {} by time):\n", limit);
+    result += fmt::format("  {:>10} {:>10}  {}\n", "count", "total ms", "scope");
+    for (auto& entry : top(profile.scopes)) {
+        result += fmt::format("  {:>10} {:>10.3f}  {}\n", entry.count, ms(entry.time),
+                              entry.symbol->getHierarchicalPath());
+    }
+
+    result += fmt::format("\nProcedures (top {} by time):\n", limit);
+    result += fmt::format("  {:>10} {:>10}  {}\n", "count", "total ms", "procedure");
+    for (auto& entry : top(profile.procedures)) {
+        result += fmt::format("  {:>10} {:>10.3f}  {} ({})\n", entry.count, ms(entry.time),
+                              describe(*entry.symbol),
+                              getLocation(entry.symbol->location));
+    }
+
+    result += fmt::format("\nCase statements (top {} by time):\n", limit);
+    result += fmt::format("  {:>10} {:>12} {:>6} {:>10}  {}\n", "count", "steps", "engine",
+                          "total ms", "location");
+    for (auto& entry : top(profile.caseStatements)) {
+        result += fmt::format("  {:>10} {:>12} {:>6} {:>10.3f}  {} ({})\n", entry.count,
+                              entry.steps, toString(entry.engine), ms(entry.time),
+                              getLocation(entry.statement->sourceRange.start()),
+                              describe(*entry.symbol));
+    }
+
+    result += fmt::format("\nLoops (top {} by time):\n", limit);
+    result += fmt::format("  {:>10} {:>12} {:>10}  {}\n", "count", "steps", "total ms",
+                          "location");
+    for (auto& entry : top(profile.loops)) {
+        result += fmt::format("  {:>10} {:>12} {:>10.3f}  {} ({})\n", entry.count, entry.steps,
+                              ms(entry.time), getLocation(entry.statement->sourceRange.start()),
+                              describe(*entry.symbol));
+    }
+
+    OS::writeFile(fileName, result);
+}
+
+bool readSweepFile(const std::string& fileName, std::vector<std::string>& sweeps) {
+    SmallVector<char> buffer;
+    if (OS::readFile(fileName, buffer))
+        return false;
+
+    if (!buffer.empty() && buffer.back() == '\0')
+        buffer.pop_back();
+
+    // Each non-empty line that isn't a comment describes one sweep.
+    std::string_view text(buffer.data(), buffer.size());
+    while (!text.empty()) {
+        auto end = text.find('\n');
+        auto line = text.substr(0, end);
+        text = end == std::string_view::npos ? ""sv : text.substr(end + 1);
+
+        while (!line.empty() && isWhitespace(line.back()))
+            line.remove_suffix(1);
+        while (!line.empty() && isWhitespace(line.front()))
+            line.remove_prefix(1);
+
+        if (!line.empty() && line[0] != '#')
+            sweeps.emplace_back(line);
+    }
+    return true;
+}
+
 template<typename TArgs>
 int driverMain(int argc, TArgs argv) {
     SLANG_TRY {
@@ -178,6 +351,38 @@ int driverMain(int argc, TArgs argv) {
                            "the results to the given file in Chrome Event Tracing JSON format",
                            "<path>");
 
+        std::optional<std::string> sweepFile;
+        driver.cmdLine.add("--sweep", sweepFile,
+                           "Elaborate the design once for each line in the given file, where "
+                           "each line holds the --top and -G options for that run. Parsed "
+                           "sources are shared and the runs execute concurrently",
+                           "<file>", CommandLineFlags::FilePath);
+
+        std::optional<std::string> constexprProfile;
+        driver.cmdLine.add("--constexpr-profile", constexprProfile,
+                           "Profile constant function evaluation and write the number of calls, "
+                           "statements executed, and time taken per function and per call site "
+                           "to the given file, or '-' for stdout",
+                           "<file>", CommandLineFlags::FilePath);
+
+        std::optional<std::string> analysisReport;
+        driver.cmdLine.add("--analysis-report", analysisReport,
+                           "Profile the analysis pass and write the most expensive scopes, "
+                           "procedures, case statements, and loops to the given file, "
+                           "or '-' for stdout",
+                           "<file>", CommandLineFlags::FilePath);
+
+        std::optional<uint32_t> analysisReportLimit;
+        driver.cmdLine.add("--analysis-report-limit", analysisReportLimit,
+                           "The number of entries to list in each section of the "
+                           "--analysis-report output (default 20)",
+                           "<count>");
+
+        std::optional<bool> memoryStats;
+        driver.cmdLine.add("--memory-stats", memoryStats,
+                           "Print a breakdown of the memory used by the compilation, "
+                           "grouped by arena and by category");
+
         if (!driver.parseCommandLine(argc, argv))
             return 1;
 
@@ -212,9 +417,31 @@ int driverMain(int argc, TArgs argv) {
             return 3;
         }
 
+        std::vector<std::string> sweeps;
+        if (sweepFile) {
+            if (onlyParse || onlyPreprocess || onlyMacros) {
+                OS::printE(fg(driver.textDiagClient->errorColor), "error: ");
+                OS::printE("cannot use --sweep with --preprocess, --macros-only, or --parse-only");
+                return 3;
+            }
+
+            if (!readSweepFile(*sweepFile, sweeps)) {
+                OS::printE(fg(driver.textDiagClient->errorColor), "error: ");
+                OS::printE(fmt::format("unable to read sweep file '{}'\n", *sweepFile));
+                return 3;
+            }
+        }
+
         if (timeTrace)
             TimeTrace::initialize();
 
+        // Profiling constant functions also adds their calls to the time trace.
+        if (constexprProfile || timeTrace)
+            driver.options.compilationFlags[CompilationFlags::ProfileConstEval] = true;
+
+        if (analysisReport)
+            driver.options.analysisFlags[analysis::AnalysisFlags::Profile] = true;
+
         auto runStages = [&]() {
             bool ok = true;
             if (onlyPreprocess == true) {
@@ -256,6 +483,12 @@ int driverMain(int argc, TArgs argv) {
             if (onlyParse == true)
                 return ok && driver.reportParseDiags();
 
+            if (sweepFile) {
+                TimeTraceScope timeScope("sweeps"sv, ""sv);
+                ok &= driver.runSweeps(sweeps, !disableAnalysis.value_or(false), quiet == true);
+                return driver.reportDiagnostics(quiet == true) && ok;
+            }
+
             std::unique_ptr<Compilation> compilation;
             {
                 TimeTraceScope timeScope("elaboration"sv, ""sv);
@@ -263,13 +496,30 @@ int driverMain(int argc, TArgs argv) {
                 driver.reportCompilation(*compilation, quiet == true);
             }
 
+            if (TimeTrace::isEnabled())
+                traceCallMemoStats(*compilation);
+
+            if (constexprProfile)
+                writeConstEvalProfile(*compilation, *constexprProfile);
+
             if (!disableAnalysis.value_or(false)) {
-                TimeTraceScope timeScope("semanticAnalysis"sv, ""sv);
-                driver.runAnalysis(*compilation);
+                std::unique_ptr<analysis::AnalysisManager> analysisManager;
+                {
+                    TimeTraceScope timeScope("semanticAnalysis"sv, ""sv);
+                    analysisManager = driver.runAnalysis(*compilation);
+                }
+
+                if (analysisReport) {
+                    writeAnalysisReport(*analysisManager, *compilation, *analysisReport,
+                                        analysisReportLimit.value_or(20));
+                }
             }
 
             ok &= driver.reportDiagnostics(quiet == true);
 
+            if (memoryStats == true)
+                printMemoryStats(*compilation);
+
             if (astJsonFile) {
                 TimeTraceScope timeScope("astSerialization"sv, ""sv);
                 printASTJson(*compilation, *astJsonFile, astJsonScopes, includeSourceInfo == true,
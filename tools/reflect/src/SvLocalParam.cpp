@@ -5,15 +5,17 @@
 
 #include <SvType.h>
 
-static void unwrapUnpackedArray(const std::span<const slang::ConstantValue> constantValues,
+static void unwrapUnpackedArray(const slang::ConstantValue& array,
                                 std::vector<std::vector<uint64_t>>& values,
                                 uint64_t& biggestElementSize) {
-    if (constantValues.front().isUnpacked())
-        for (const auto& unpackedArray : constantValues)
-            unwrapUnpackedArray(unpackedArray.elements(), values, biggestElementSize);
-    else if (constantValues.front().isInteger()) {
+    auto front = array.elementAt(0);
+    if (front.isUnpacked())
+        array.forEachElement([&](const slang::ConstantValue& unpackedArray) {
+            unwrapUnpackedArray(unpackedArray, values, biggestElementSize);
+        });
+    else if (front.isInteger()) {
         std::vector<uint64_t> collectedValues;
-        for (const auto& value : constantValues) {
+        array.forEachElement([&](const slang::ConstantValue& value) {
             if (!value.isInteger())
                 SLANG_THROW(std::runtime_error(
                     "Found a non integer member while reflecting this parameter"));
@@ -22,7 +24,7 @@ static void unwrapUnpackedArray(const std::span<const slang::ConstantValue> cons
                     "Found a value bigger than 64 bits while reflecting this parameter"));
             biggestElementSize = std::max(biggestElementSize, value.getBitstreamWidth());
             collectedValues.emplace_back(*value.integer().getRawPtr());
-        }
+        });
         values.emplace_back(collectedValues);
     }
 }
@@ -34,7 +36,7 @@ void SvLocalParam::toCpp(HppFile& hppFile, std::string_view, const SvAliases&, b
         std::vector<std::vector<uint64_t>> unpackedArrays;
         uint64_t biggestSize = 0;
         SLANG_TRY {
-            unwrapUnpackedArray(parameter.getValue().elements(), unpackedArrays, biggestSize);
+            unwrapUnpackedArray(parameter.getValue(), unpackedArrays, biggestSize);
         }
         SLANG_CATCH(const std::runtime_error& error) {
 #if __cpp_exceptions